@@ -112,7 +112,7 @@ bool GuiImguiGfx<Vulkan>::Initialize(uintptr_t windowHandle, TextureFormat rende
         init_info.Device = m_GfxApi.m_VulkanDevice;
         init_info.QueueFamily = m_GfxApi.m_VulkanQueues[Vulkan::eGraphicsQueue].QueueFamilyIndex;
         init_info.Queue = m_GfxApi.m_VulkanQueues[Vulkan::eGraphicsQueue].Queue;
-        init_info.PipelineCache = nullptr;// g_PipelineCache;
+        init_info.PipelineCache = m_GfxApi.GetPipelineCache();
         init_info.DescriptorPool = m_DescriptorPool;
         init_info.Allocator = nullptr;// g_Allocator;
         init_info.MinImageCount = m_GfxApi.m_SwapchainImageCount;   //unused?
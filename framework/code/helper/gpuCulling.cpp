@@ -0,0 +1,206 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "gpuCulling.hpp"
+#include "vulkan/commandBuffer.hpp"
+#include "vulkan/extensionLib.hpp"
+#include "texture/vulkan/texture.hpp"
+#include "material/vulkan/computable.hpp"
+#include "material/vulkan/materialManager.hpp"
+#include "memory/vulkan/drawIndirectBufferObject.hpp"
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+bool GpuCulling::Init( Vulkan* pVulkan, const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>* const pCullShader, const Texture<Vulkan>& hierarchicalZ )
+//-----------------------------------------------------------------------------
+{
+    assert( pCullShader );
+    if (pVulkan->GetExtension<ExtensionLib::Ext_VK_KHR_draw_indirect_count>() == nullptr)
+    {
+        LOGE( "GpuCulling requires VK_KHR_draw_indirect_count" );
+        return false;
+    }
+
+    m_MaterialManager = &materialManager;
+    m_CullShader = pCullShader;
+    m_HierarchicalZ = &hierarchicalZ;
+
+    m_Params.HierarchicalZSize = glm::vec2( float( hierarchicalZ.Width ), float( hierarchicalZ.Height ) );
+    m_Params.HierarchicalZMips = hierarchicalZ.MipLevels;
+    if (!CreateUniformBuffer( pVulkan, m_ParamsUniform, &m_Params ))
+    {
+        LOGE( "GpuCulling unable to create uniform buffer" );
+        return false;
+    }
+    m_HasPrevView = false;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GpuCulling::Release( Vulkan* pVulkan )
+//-----------------------------------------------------------------------------
+{
+    m_Groups.clear();
+    ReleaseUniformBuffer( pVulkan, m_ParamsUniform );
+    m_HierarchicalZ = nullptr;
+    m_CullShader = nullptr;
+    m_MaterialManager = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool GpuCulling::CreateDrawIndirectBuffer( MemoryManager<Vulkan>& memoryManager, size_t maxDraws, std::optional<DrawIndirectBuffer<Vulkan>>& drawIndirectBufferOut )
+//-----------------------------------------------------------------------------
+{
+    // Draw count lives in the 'prequel' at the start of the buffer, Drawable uses it as the vkCmdDrawIndexedIndirectCount count buffer.
+    auto& drawIndirectBuffer = drawIndirectBufferOut.emplace( DrawIndirectBuffer<Vulkan>::eType::IndexedDraw );
+    if (!drawIndirectBuffer.Initialize<VkDrawIndexedIndirectCommand, uint32_t>( &memoryManager, maxDraws, nullptr, nullptr, BufferUsageFlags::Indirect | BufferUsageFlags::Storage | BufferUsageFlags::TransferDst ))
+    {
+        LOGE( "GpuCulling unable to create draw indirect buffer (%zu draws)", maxDraws );
+        drawIndirectBufferOut.reset();
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+int GpuCulling::AddGroup( Vulkan* pVulkan, std::span<const CullObject> objects, const DrawIndirectBuffer<Vulkan>& drawIndirectOutput )
+//-----------------------------------------------------------------------------
+{
+    assert( m_CullShader && m_HierarchicalZ );
+    if (objects.empty())
+        return -1;
+    if (drawIndirectOutput.GetIndirectBufferType() != DrawIndirectBuffer<Vulkan>::eType::IndexedDraw || drawIndirectOutput.GetBufferOffset() < sizeof( uint32_t ) || drawIndirectOutput.GetNumDraws() < objects.size())
+    {
+        LOGE( "GpuCulling::AddGroup output buffer must be created with GpuCulling::CreateDrawIndirectBuffer and have room for %zu draws", objects.size() );
+        return -1;
+    }
+
+    CullGroup group;
+    group.NumObjects = (uint32_t) objects.size();
+    group.Output = drawIndirectOutput.GetVkBuffer();
+
+    // Objects buffer is the object count (padded to 16 bytes) followed by the objects.
+    std::vector<uint8_t> objectData( 16 + objects.size_bytes(), 0 );
+    memcpy( objectData.data(), &group.NumObjects, sizeof( group.NumObjects ) );
+    memcpy( objectData.data() + 16, objects.data(), objects.size_bytes() );
+    if (!group.Objects.Initialize( &pVulkan->GetMemoryManager(), objectData.size(), BufferUsageFlags::Storage, objectData.data() ))
+    {
+        LOGE( "GpuCulling::AddGroup unable to create objects buffer" );
+        return -1;
+    }
+
+    auto material = m_MaterialManager->CreateMaterial( *m_CullShader, NUM_VULKAN_BUFFERS,
+        [this]( const std::string& textureName ) -> const MaterialManagerBase::tPerFrameTexInfo {
+            if (textureName == "HierarchicalZ")
+                return { m_HierarchicalZ };
+            assert( 0 );
+            return {};
+        },
+        [this, &group]( const std::string& bufferName ) -> PerFrameBufferVulkan {
+            if (bufferName == "CullParams")
+                return { m_ParamsUniform.bufferHandles };
+            else if (bufferName == "CullObjects")
+                return { group.Objects.GetVkBuffer() };
+            else if (bufferName == "CullOutput")
+                return { group.Output };
+            assert( 0 );
+            return {};
+        }
+    );
+
+    group.CullComputable = std::make_unique<Computable<Vulkan>>( *pVulkan, std::move( material ) );
+    if (!group.CullComputable->Init())
+    {
+        LOGE( "GpuCulling::AddGroup unable to initialize culling computable" );
+        return -1;
+    }
+    group.CullComputable->SetDispatchThreadCount( 0, { group.NumObjects, 1, 1 } );
+
+    m_Groups.emplace_back( std::move( group ) );
+    return int( m_Groups.size() - 1 );
+}
+
+//-----------------------------------------------------------------------------
+void GpuCulling::SetView( Vulkan* pVulkan, const glm::mat4& viewProjection, uint32_t bufferIdx )
+//-----------------------------------------------------------------------------
+{
+    m_Params.PrevViewProjection = m_HasPrevView ? m_Params.ViewProjection : viewProjection;
+    m_Params.ViewProjection = viewProjection;
+
+    // Same plane extraction as ViewFrustum (octree.hpp)
+    const auto viewT = glm::transpose( viewProjection );
+    m_Params.FrustumPlanes[0/*Left*/]   = viewT[3] + viewT[0];
+    m_Params.FrustumPlanes[1/*Right*/]  = viewT[3] - viewT[0];
+    m_Params.FrustumPlanes[2/*Bottom*/] = viewT[3] + viewT[1];
+    m_Params.FrustumPlanes[3/*Top*/]    = viewT[3] - viewT[1];
+    m_Params.FrustumPlanes[4/*Near*/]   = viewT[3] + viewT[2];
+    m_Params.FrustumPlanes[5/*Far*/]    = viewT[3] - viewT[2];
+    for (auto& plane : m_Params.FrustumPlanes)
+        plane /= glm::length( glm::vec3( plane ) );
+
+    // Hierarchical z is from the previous frame, so only usable once we have a previous view.
+    m_Params.OcclusionEnabled = (m_OcclusionEnabled && m_HasPrevView) ? 1 : 0;
+    m_HasPrevView = true;
+
+    UpdateUniformBuffer( pVulkan, m_ParamsUniform, m_Params, bufferIdx );
+}
+
+//-----------------------------------------------------------------------------
+void GpuCulling::UpdateCommandBuffer( CommandList<Vulkan>& commandList, uint32_t bufferIdx )
+//-----------------------------------------------------------------------------
+{
+    if (m_Groups.empty())
+        return;
+
+    std::vector<VkBufferMemoryBarrier> countBarriers;
+    countBarriers.reserve( m_Groups.size() );
+    for (const auto& group : m_Groups)
+        countBarriers.push_back( {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, nullptr, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, group.Output, 0, sizeof( uint32_t )} );
+
+    // Previous frame's indirect draws must have read the draw count before we clear it.
+    vkCmdPipelineBarrier( commandList,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,    // srcMask,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,         // dstMask,
+        0,
+        0, nullptr,
+        (uint32_t)countBarriers.size(), countBarriers.data(),
+        0, nullptr );
+
+    for (const auto& group : m_Groups)
+        vkCmdFillBuffer( commandList, group.Output, 0, sizeof( uint32_t ), 0 );
+
+    for (auto& barrier : countBarriers)
+    {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    vkCmdPipelineBarrier( commandList,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,         // srcMask,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,   // dstMask,
+        0,
+        0, nullptr,
+        (uint32_t)countBarriers.size(), countBarriers.data(),
+        0, nullptr );
+
+    // Groups are independent (different output buffers) so no barriers needed between the dispatches.
+    for (const auto& group : m_Groups)
+        group.CullComputable->DispatchPass( commandList, group.CullComputable->GetPasses()[0], bufferIdx );
+
+    // Culled commands and count are consumed by the indirect draws.
+    std::vector<VkBufferMemoryBarrier> outputBarriers;
+    outputBarriers.reserve( m_Groups.size() );
+    for (const auto& group : m_Groups)
+        outputBarriers.push_back( {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, group.Output, 0, VK_WHOLE_SIZE} );
+    vkCmdPipelineBarrier( commandList,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,   // srcMask,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,    // dstMask,
+        0,
+        0, nullptr,
+        (uint32_t)outputBarriers.size(), outputBarriers.data(),
+        0, nullptr );
+}
@@ -0,0 +1,105 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include "vulkan/vulkan.hpp"
+#include "memory/vulkan/bufferObject.hpp"
+#include "memory/vulkan/uniform.hpp"
+#include "system/glm_common.hpp"
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Forward declarations
+template<typename T_GFXAPI> class CommandList;
+template<typename T_GFXAPI> class Computable;
+template<typename T_GFXAPI> class DrawIndirectBuffer;
+template<typename T_GFXAPI> class MaterialManager;
+template<typename T_GFXAPI> class MemoryManager;
+template<typename T_GFXAPI> class Shader;
+template<typename T_GFXAPI> class Texture;
+
+/// @brief Class to implement GPU driven culling (frustum and hierarchical-z occlusion) of indexed draws.
+/// Each 'group' is a list of objects (bounds and draw command) that all draw with the same pipeline/Drawable.  Every frame a compute pass tests
+/// each object's bounds against the view frustum and against the previous frame's hierarchical z (as generated by ZBufferReduce) and writes the
+/// surviving draw commands (compacted) plus a draw count in to the group's DrawIndirectBuffer.
+/// The DrawIndirectBuffer is created with a count 'prequel' (see CreateDrawIndirectBuffer) so the Drawable it is given to submits with vkCmdDrawIndexedIndirectCount.
+///
+/// The culling shader is supplied by the application and is expected to have (one pass, with "WorkGroup": { "LocalSize": [64,1,1] } or similar):
+///   "CullParams"      UniformBuffer   - GpuCulling::CullParams
+///   "CullObjects"     StorageBuffer   - uint NumObjects; uint pad[3]; GpuCulling::CullObject Objects[];
+///   "CullOutput"      StorageBuffer   - uint DrawCount; VkDrawIndexedIndirectCommand Commands[];  (DrawCount incremented with atomicAdd)
+///   "HierarchicalZ"   ImageSampled    - farthest depth in each texel, mipmapped (ZBufferReduce::GetHierarchicalZTexture)
+class GpuCulling
+{
+    GpuCulling( const GpuCulling& ) = delete;
+    GpuCulling& operator=( const GpuCulling& ) = delete;
+public:
+    /// Object to be culled, layout matches the std430 struct in the culling shader.
+    struct CullObject
+    {
+        glm::vec4                       BoundsCenter;       ///< world space axis aligned bounding box center (w unused)
+        glm::vec4                       BoundsHalfSize;     ///< world space axis aligned bounding box half size (w unused)
+        VkDrawIndexedIndirectCommand    DrawCommand;        ///< command written to the output if the object is visible (typically instanceCount=1 and firstInstance selects the per instance data)
+        uint32_t                        Pad[3] = {};
+    };
+    static_assert(sizeof( CullObject ) == 64);
+
+    /// Per frame culling parameters (uniform buffer), layout matches the std140 block in the culling shader.
+    struct CullParams
+    {
+        glm::mat4   ViewProjection;                 ///< current frame, used for frustum culling
+        glm::mat4   PrevViewProjection;             ///< previous frame, the hierarchical z was rendered with this
+        glm::vec4   FrustumPlanes[6];               ///< current frame, normalized, pointing inwards
+        glm::vec2   HierarchicalZSize;              ///< size (in texels) of mip 0 of the hierarchical z
+        uint32_t    HierarchicalZMips = 0;
+        uint32_t    OcclusionEnabled = 0;           ///< 0 when the hierarchical z is not valid (eg first frame)
+    };
+
+    GpuCulling() = default;
+    bool Init( Vulkan* pVulkan, const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>* const pCullShader, const Texture<Vulkan>& hierarchicalZ );
+    void Release( Vulkan* pVulkan );
+
+    /// @brief Create a DrawIndirectBuffer (of VkDrawIndexedIndirectCommand) with room for the draw count ahead of the commands, suitable for use as a culling output and to be passed in to Drawable::Init.
+    static bool CreateDrawIndirectBuffer( MemoryManager<Vulkan>& memoryManager, size_t maxDraws, std::optional<DrawIndirectBuffer<Vulkan>>& drawIndirectBufferOut );
+
+    /// @brief Add a group of objects to be culled in to the given output buffer (typically the buffer owned by the Drawable that will draw the results).
+    /// @param drawIndirectOutput must have been created with CreateDrawIndirectBuffer (with at least objects.size() draws) and must outlive this GpuCulling.
+    /// @return index of the group, or -1 on error
+    int AddGroup( Vulkan* pVulkan, std::span<const CullObject> objects, const DrawIndirectBuffer<Vulkan>& drawIndirectOutput );
+
+    /// @brief Set the view for this frame's culling.  The previous call's viewProjection is used for the hierarchical z test.
+    void SetView( Vulkan* pVulkan, const glm::mat4& viewProjection, uint32_t bufferIdx );
+    /// @brief Enable/disable the hierarchical z occlusion test (frustum test is always done).  Disable if the hierarchical z was not updated last frame.
+    void SetOcclusionEnabled( bool enabled ) { m_OcclusionEnabled = enabled; }
+
+    /// @brief Add the commands to reset the draw counts and run the culling (all groups) to the command buffer.  Must be outside of a render pass and before the Drawables using the output are drawn.
+    void UpdateCommandBuffer( CommandList<Vulkan>& commandList, uint32_t bufferIdx );
+
+    size_t GetNumGroups() const { return m_Groups.size(); }
+
+protected:
+    struct CullGroup
+    {
+        Buffer<Vulkan>                      Objects;            ///< 'CullObjects' buffer (count header and CullObject array)
+        VkBuffer                            Output = VK_NULL_HANDLE;///< 'CullOutput' buffer (not owned)
+        uint32_t                            NumObjects = 0;
+        std::unique_ptr<Computable<Vulkan>> CullComputable;
+    };
+
+    const MaterialManager<Vulkan>*                          m_MaterialManager = nullptr;
+    const Shader<Vulkan>*                                   m_CullShader = nullptr;
+    const Texture<Vulkan>*                                  m_HierarchicalZ = nullptr;
+    UniformArrayT<Vulkan, CullParams, NUM_VULKAN_BUFFERS>   m_ParamsUniform;
+    CullParams                                              m_Params;
+    std::vector<CullGroup>                                  m_Groups;
+    bool                                                    m_OcclusionEnabled = true;
+    bool                                                    m_HasPrevView = false;
+};
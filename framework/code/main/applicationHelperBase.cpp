@@ -20,6 +20,7 @@
 #include "texture/vulkan/texture.hpp"
 #include "texture/vulkan/loaderKtx.hpp"
 #include "texture/vulkan/textureManager.hpp"
+#include "vulkan/asyncImageCapture.hpp"
 #include "vulkan/commandBuffer.hpp"
 #include "vulkan/renderTarget.hpp"
 #include "vulkan/timerPool.hpp"
@@ -34,6 +35,11 @@ using namespace std::string_literals;
 extern "C" {
 VAR(float, gCameraRotateSpeed, 0.25f, kVariableNonpersistent);
 VAR(float, gCameraMoveSpeed, 4.0f, kVariableNonpersistent);
+VAR(char*, gTextureCacheDirectory, "Cache/Textures", kVariableNonpersistent);   // directory for the transcoded (ktx2/Basis) texture cache, empty to disable
+VAR(uint32_t, gTextureCacheMaxMB, 512, kVariableNonpersistent);
+VAR(char*, gPipelineCacheFile, "Cache/pipeline.cache", kVariableNonpersistent);  // file the Vulkan pipeline cache is saved to (and loaded from on startup), empty to disable
+VAR(uint32_t, gCaptureFrameInterval, 0, kVariableNonpersistent);   // capture every Nth presented frame to file (asynchronously, see AsyncImageCapture), 0 to disable
+VAR(char*, gCaptureFile, "capture.png", kVariableNonpersistent);    // capture file name, the frame number is inserted before the extension
 }; //extern "C"
 
 static const uint32_t cClickTimeMs = 400;           //max time we count as a single 'click' (finger/button down and up)
@@ -63,7 +69,11 @@ bool ApplicationHelperBase::Initialize(uintptr_t hWnd, uintptr_t hInstance)
 
     if (!pVulkan || !pVulkan->Init(hWnd, hInstance,
                                    [this](std::span<const SurfaceFormat> x) { return PreInitializeSelectSurfaceFormat(x); },
-                                   [this](Vulkan::AppConfiguration& x) { return PreInitializeSetVulkanConfiguration(x); }))
+                                   [this](Vulkan::AppConfiguration& x) {
+                                       if (gPipelineCacheFile != nullptr && *gPipelineCacheFile != '\0')
+                                           x.PipelineCacheFile = m_AssetManager->GetDevicePath(gPipelineCacheFile);
+                                       return PreInitializeSetVulkanConfiguration(x);
+                                   }))
     {
         LOGE("Unable to initialize Vulkan!!");
         return false;
@@ -83,6 +93,11 @@ bool ApplicationHelperBase::Initialize(uintptr_t hWnd, uintptr_t hInstance)
     auto textureManagerVulkan = std::make_unique<TextureManagerVulkan>(*pVulkan, *m_AssetManager);
     if (!textureManagerVulkan->Initialize())
         return false;
+    if (gTextureCacheDirectory != nullptr && *gTextureCacheDirectory != '\0')
+    {
+        // Cache failures are not fatal, textures are just transcoded every run.
+        textureManagerVulkan->GetLoader()->InitializeTranscodeCache(m_AssetManager->GetDevicePath(gTextureCacheDirectory), uint64_t(gTextureCacheMaxMB) * 1024 * 1024);
+    }
     m_TextureManager = std::move(textureManagerVulkan);
 
     m_SamplerRepeat = CreateSampler(*pVulkan, SamplerAddressMode::Repeat, SamplerFilter::Linear, SamplerBorderColor::TransparentBlackFloat, 0.0f/*mipBias*/);
@@ -99,6 +114,21 @@ bool ApplicationHelperBase::Initialize(uintptr_t hWnd, uintptr_t hInstance)
 
     m_MaterialManager = std::make_unique<MaterialManager>(*pVulkan);
 
+    if (gCaptureFrameInterval > 0)
+    {
+        // Capture failures are not fatal, frames are just not captured.
+        if ((pVulkan->GetSwapchainImageUsage() & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) == 0)
+        {
+            LOGW("gCaptureFrameInterval is set but the swapchain images cannot be copied from (surface format %d has no transfer/blit src support), frame capture disabled", (int) pVulkan->GetSurfaceFormat());
+        }
+        else
+        {
+            auto imageCapture = std::make_unique<AsyncImageCapture>(*pVulkan);
+            if (imageCapture->Initialize(size_t(pVulkan->GetSurfaceWidth()) * pVulkan->GetSurfaceHeight() * FormatBytesPerPixel(pVulkan->GetSurfaceFormat())))
+                m_ImageCapture = std::move(imageCapture);
+        }
+    }
+
     return true;
 }
 
@@ -145,6 +175,7 @@ void ApplicationHelperBase::Destroy()
     ReleaseSampler(*pVulkan, &m_SamplerEdgeClamp);
     ReleaseSampler(*pVulkan, &m_SamplerRepeat);
 
+    m_ImageCapture.reset();
     m_TextureManager.reset();
     m_MaterialManager.reset();
     m_ShaderManager.reset();
@@ -347,7 +378,26 @@ bool ApplicationHelperBase::PresentQueue( const std::span<const VkSemaphore> Wai
 //-----------------------------------------------------------------------------
 {
     auto& vulkan = *GetVulkan();
-    if (!vulkan.PresentQueue( WaitSemaphores, SwapchainPresentIndx ))
+
+    // Asynchronous capture of every Nth frame (copy is chained between the rendering and the present, written to file on a later frame).
+    std::span<const VkSemaphore> presentWaitSemaphores = WaitSemaphores;
+    VkSemaphore captureSemaphore = VK_NULL_HANDLE;
+    if (m_ImageCapture)
+    {
+        m_ImageCapture->Update();
+        // Swapchain may have been recreated (in a different format) since Initialize, only capture while it can be copied from.
+        if (gCaptureFrameInterval != 0 && m_CaptureFrameNumber % gCaptureFrameInterval == 0 && (vulkan.GetSwapchainImageUsage() & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0)
+        {
+            std::string fileName( gCaptureFile );
+            size_t extPos = fileName.rfind( '.' );
+            fileName.insert( extPos == std::string::npos ? fileName.size() : extPos, std::to_string( m_CaptureFrameNumber ) );
+            if (m_ImageCapture->Capture( vulkan.GetSwapchainImage( SwapchainPresentIndx ), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, vulkan.GetSurfaceFormat(), vulkan.GetSurfaceWidth(), vulkan.GetSurfaceHeight(), fileName.c_str(), WaitSemaphores, captureSemaphore ))
+                presentWaitSemaphores = { &captureSemaphore, 1 };
+        }
+        ++m_CaptureFrameNumber;
+    }
+
+    if (!vulkan.PresentQueue( presentWaitSemaphores, SwapchainPresentIndx ))
         return false;
 #if OS_WINDOWS
     {
@@ -18,6 +18,7 @@
 #include "vulkan/renderContext.hpp"
 #include "vulkan/renderTarget.hpp"
 
+class AsyncImageCapture;
 class CameraControllerBase;
 class CommandListBase;
 class ComputableBase;
@@ -197,7 +198,7 @@ protected:
     }
 
     /// @brief Present the given queue to the swapchain
-    /// Helper calls down into Vulkan::PresentQueue but also handles screen 'dump' (screenshot) if required/requested
+    /// Helper calls down into Vulkan::PresentQueue but also handles screen 'dump' (screenshot) if required/requested, and asynchronous capture of every gCaptureFrameInterval frames
     /// @returns false on present error
     bool    PresentQueue( const std::span<const VkSemaphore> WaitSemaphore, uint32_t SwapchainPresentIndx );
     /// Run the PresentQueue (simplified helper)
@@ -255,6 +256,10 @@ protected:
     Sampler<tGfxApi>                       m_SamplerRepeat;
     Sampler<tGfxApi>                       m_SamplerEdgeClamp;
     Sampler<tGfxApi>                       m_SamplerMirroredRepeat;
+
+    // Asynchronous frame capture (when gCaptureFrameInterval is set)
+    std::unique_ptr<AsyncImageCapture>     m_ImageCapture;
+    uint32_t                               m_CaptureFrameNumber = 0;
 };
 
 //
@@ -7,8 +7,10 @@
 //============================================================================================================
 #pragma once
 
+#include <algorithm>
 #include <optional>
 #include <span>
+#include "camera/camera.hpp"
 #include "texture/textureFormat.hpp" //for Msaa
 
 // Forward Declarations
@@ -19,6 +21,7 @@ template<typename T_GFXAPI> class DrawIndirectBuffer;
 template<typename T_GFXAPI> class Material;
 template<typename T_GFXAPI> class Mesh;
 template<typename T_GFXAPI> class Pipeline;
+template<typename T_GFXAPI> class PipelineBatch;
 template<typename T_GFXAPI> class RenderContext;
 template<typename T_GFXAPI> class RenderPass;
 template<typename T_GFXAPI> class VertexBuffer;
@@ -48,6 +51,7 @@ class Drawable
     using Mesh = Mesh<T_GFXAPI>;
     using Material = Material<T_GFXAPI>;
     using Pipeline = Pipeline<T_GFXAPI>;
+    using PipelineBatch = PipelineBatch<T_GFXAPI>;
     using RenderContext = RenderContext<T_GFXAPI>;
     using RenderPass = RenderPass<T_GFXAPI>;
     using VertexBuffer = VertexBuffer<T_GFXAPI>;
@@ -64,7 +68,8 @@ public:
     /// Initialize this Drawable with the given mesh and single render pass.
     bool Init( const RenderContext& renderPass, Mesh meshObject, std::optional<VertexBuffer> vertexInstanceBuffer = std::nullopt, std::optional<DrawIndirectBuffer> indirectDrawBuffer = std::nullopt, int nodeId = -1 );
     /// Initialize this Drawable with the given mesh and render passes.
-    bool Init( std::span<const RenderContext> renderPasses, uint32_t passMask, Mesh meshObject, std::optional<VertexBuffer> vertexInstanceBuffer = std::nullopt, std::optional<DrawIndirectBuffer> indirectDrawBuffer = std::nullopt, int nodeId = -1 );
+    /// @param pPipelineBatch if set the pass pipelines are added to this batch (rather than being created immediately) and are not valid until the batch is compiled.
+    bool Init( std::span<const RenderContext> renderPasses, uint32_t passMask, Mesh meshObject, std::optional<VertexBuffer> vertexInstanceBuffer = std::nullopt, std::optional<DrawIndirectBuffer> indirectDrawBuffer = std::nullopt, int nodeId = -1, PipelineBatch* pPipelineBatch = nullptr );
     /// Initialize this Drawable without a mesh
     bool Init( std::span<const RenderContext> renderPasses, uint32_t passMask, std::optional<DrawIndirectBuffer> indirectDrawBuffer = std::nullopt, int nodeId = -1 );
     /// Initialize the mesh shader variant of the pipeline.
@@ -73,7 +78,8 @@ public:
     /// Re-initialize the drawable.  Used internally by Init but can be used by the user when the render pass has been modified.
     bool ReInit( const RenderContext& renderPass );
     /// Re-initialize the drawable.  Used internally by Init but can be used by the user when the render passes have been modified.
-    bool ReInit( std::span<const RenderContext> renderPasses, uint32_t passMask );
+    /// @param pPipelineBatch if set the pass pipelines are added to this batch (to be created later, possibly multithreaded, by PipelineBatch::Compile).  The render passes must outlive the Compile.
+    bool ReInit( std::span<const RenderContext> renderPasses, uint32_t passMask, PipelineBatch* pPipelineBatch = nullptr );
 
     bool ReInitMeshShader(std::span<const RenderContext> renderPasses, uint32_t passMask);
 
@@ -86,6 +92,7 @@ public:
     const auto& GetDrawablePasses() const       { return mPasses; };
     uint32_t GetPassMask() const                { return mPassMask; }
     const auto& GetMaterial() const             { return mMaterial; }
+    auto& GetMaterial()                         { return mMaterial; }
     const auto& GetMeshObject() const { return mMeshObject; }
     auto& GetMeshObject()                       { return mMeshObject; }
     const auto& GetInstances() const            { return mVertexInstanceBuffer; }
@@ -97,6 +104,23 @@ public:
     void SetDispatchGroupCount(std::array<uint32_t, 3> count) { mDispatchGroupCount = count; }
     const auto& GetDispatchGroupCount() const   { return mDispatchGroupCount; }
 
+    /// Set the mesh level of detail drawn by DrawPass (clamped to the levels the mesh has).
+    /// @returns true if the level of detail changed (any pre-recorded command buffers containing this drawable need re-recording).
+    bool SetLod( uint32_t lod );
+    uint32_t GetLod() const                     { return mLod; }
+    uint32_t GetNumLods() const                 { return mMeshObject.m_Lods.empty() ? 1 : (uint32_t)mMeshObject.m_Lods.size(); }
+    /// Select the least detailed level of detail whose simplification error projects to no more than maxPixelError pixels on screen.
+    /// @param distance distance from the camera to the drawable (world units)
+    /// @param pixelsPerUnit screen pixels covered by one world unit at a distance of 1 (for a perspective camera: 0.5 * viewportHeight * projectionMatrix[1][1])
+    /// @returns level of detail index (pass to SetLod)
+    uint32_t SelectLod( float distance, float pixelsPerUnit, float maxPixelError = 1.0f ) const;
+    /// Select the least detailed level of detail for the drawable as seen by the given (perspective) camera.
+    /// Distance is measured to the closest point of the world space bounding box (zero when the camera is inside the box).
+    /// @param worldBoundsMin/worldBoundsMax world space bounding box of this drawable (mMeshObject.m_BoundsMin/Max transformed by the drawable's model matrix)
+    /// @param viewportHeight height (in pixels) of the viewport being rendered to
+    /// @returns level of detail index (pass to SetLod)
+    uint32_t SelectLod( const Camera& camera, const glm::vec3& worldBoundsMin, const glm::vec3& worldBoundsMax, float viewportHeight, float maxPixelError = 1.0f ) const;
+
 public:
     Material                                    mMaterial;
     Mesh                                        mMeshObject;
@@ -107,6 +131,7 @@ protected:
     uint32_t                                    mPassMask = 0;
     int                                         mNodeId = -1;       // Identifier used by application to determine what this drawable is attached to, eg for attaching to animations.  Not used by Drawable.
     std::array<uint32_t, 3>                     mDispatchGroupCount{1u,1u,1u};
+    uint32_t                                    mLod = 0;           // Index in to mMeshObject.m_Lods (ignored if the mesh has no lods)
 
     std::optional<VertexBuffer>                 mVertexInstanceBuffer;
     std::optional<DrawIndirectBuffer>           mDrawIndirectBuffer;
@@ -162,6 +187,7 @@ Drawable<T_GFXAPI>::Drawable( Drawable<T_GFXAPI>&& other ) noexcept
     , mPasses( std::move( other.mPasses ) )
     , mPassNameToIndex( std::move( other.mPassNameToIndex ) )
     , mPassMask( other.mPassMask )
+    , mLod( other.mLod )
     , mVertexInstanceBuffer( std::move( other.mVertexInstanceBuffer ) )
     , mDrawIndirectBuffer( std::move( other.mDrawIndirectBuffer ) )
 {
@@ -185,13 +211,13 @@ bool Drawable<T_GFXAPI>::Init( const RenderContext& renderPass, Mesh meshObject,
 }
 
 template<typename T_GFXAPI>
-bool Drawable<T_GFXAPI>::Init( std::span<const RenderContext> renderPasses, uint32_t passMask, Mesh meshObject, std::optional<VertexBuffer> vertexInstanceBuffer, std::optional<DrawIndirectBuffer> drawIndirectBuffer, int nodeId )
+bool Drawable<T_GFXAPI>::Init( std::span<const RenderContext> renderPasses, uint32_t passMask, Mesh meshObject, std::optional<VertexBuffer> vertexInstanceBuffer, std::optional<DrawIndirectBuffer> drawIndirectBuffer, int nodeId, PipelineBatch* pPipelineBatch )
 {
     mMeshObject = std::move( meshObject );
     mVertexInstanceBuffer = std::move( vertexInstanceBuffer );
     mDrawIndirectBuffer = std::move( drawIndirectBuffer );
     mNodeId = nodeId;
-    return ReInit( renderPasses, passMask );
+    return ReInit( renderPasses, passMask, pPipelineBatch );
 }
 
 template<typename T_GFXAPI>
@@ -222,6 +248,42 @@ bool Drawable<T_GFXAPI>::ReInit( const RenderContext& renderPass )
     return ReInit( {&renderPass,1}, 1);
 }
 
+template<typename T_GFXAPI>
+bool Drawable<T_GFXAPI>::SetLod( uint32_t lod )
+{
+    lod = std::min( lod, GetNumLods() - 1 );
+    if (lod == mLod)
+        return false;
+    mLod = lod;
+    return true;
+}
+
+template<typename T_GFXAPI>
+uint32_t Drawable<T_GFXAPI>::SelectLod( float distance, float pixelsPerUnit, float maxPixelError ) const
+{
+    const auto& lods = mMeshObject.m_Lods;
+    if (lods.empty() || distance <= 0.0f || pixelsPerUnit <= 0.0f)
+        return 0;
+    // Largest (object space) error we can get away with at this distance.
+    const float maxError = maxPixelError * distance / pixelsPerUnit;
+    for (uint32_t lod = (uint32_t)lods.size() - 1; lod > 0; --lod)
+    {
+        if (lods[lod].error <= maxError)
+            return lod;
+    }
+    return 0;
+}
+
+template<typename T_GFXAPI>
+uint32_t Drawable<T_GFXAPI>::SelectLod( const Camera& camera, const glm::vec3& worldBoundsMin, const glm::vec3& worldBoundsMax, float viewportHeight, float maxPixelError ) const
+{
+    const glm::vec3 cameraPos = camera.Position();
+    const float distance = glm::length( glm::clamp( cameraPos, worldBoundsMin, worldBoundsMax ) - cameraPos );
+    // Projection may be y-flipped (Vulkan clip space), we only care about the scale.
+    const float pixelsPerUnit = 0.5f * viewportHeight * std::abs( camera.ProjectionMatrix()[1][1] );
+    return SelectLod( distance, pixelsPerUnit, maxPixelError );
+}
+
 template<typename T_GFXAPI>
 const DrawablePass<T_GFXAPI>* Drawable<T_GFXAPI>::GetDrawablePass( const std::string& passName ) const
 {
@@ -52,9 +52,21 @@ public:
         None = 0,
         FindInstances = 0x1,    // useInstancing pass true if drawable loader should try to find duplicated instances of meshes(same MaterialDef, same vertex uv sets, vertex positions onlly differing by rotation and translation). Can take a little time to process.
         BakeTransforms = 0x2,   // bake world transform in to mesh data (and clear the m_Transform for all baked drawables)
-        IgnoreHierarchy = 0x4   // Ignore the gltf node hierarchy when loading model
+        IgnoreHierarchy = 0x4,  // Ignore the gltf node hierarchy when loading model
+        GenerateLods = 0x8,     // generate simplified levels of detail for each (unique) mesh, selected at runtime with Drawable::SelectLod/SetLod.  Can take a little time to process.
+        OptimizeMeshes = 0x10,  // weld duplicate vertices, use the narrowest index type and split meshes too large for 16bit indices (see MeshObjectIntermediate::OptimizeMeshes)
+        StaticBatch = 0x20      // merge meshes that share a material in to combined meshes, baking their transforms (see MeshObjectIntermediate::BatchStatic).  Only for meshes that do not move independently!
     };
 
+    /// Maximum number of additional levels of detail generated when using LoaderFlags::GenerateLods
+    static constexpr uint32_t cGenerateLodsMaxLods = 4;
+    /// Maximum simplification error (relative to the mesh extents) when using LoaderFlags::GenerateLods
+    static constexpr float cGenerateLodsMaxError = 0.05f;
+    /// Vertex attribute epsilon used to weld vertices when using LoaderFlags::OptimizeMeshes
+    static constexpr float cOptimizeMeshesWeldEpsilon = 1.0e-5f;
+    /// Maximum number of vertices in each batched mesh when using LoaderFlags::StaticBatch
+    static constexpr uint32_t cStaticBatchMaxVertices = 1024 * 1024;
+
     /// @brief Print some combined statistics about the given meshObjects.
     /// @param meshObjects span of the objects we want to gather the statistics for.
     static void PrintStatistics( const std::span<MeshObjectIntermediate> meshObjects );
@@ -119,7 +131,8 @@ public:
 
     /// @brief Create @Drawables() for rendering the given @MeshInstance objects.
     /// Identical to CreateDrawables but does not generate the MeshInstance data (is required to be already generated).
-    static bool CreateDrawables(T_GFXAPI&, std::vector<MeshInstance>&& intermediateMeshInstances, std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>(const MeshObjectIntermediate::MaterialDef&)>& materialLoader, std::vector<Drawable>& drawables, /*DrawableLoader::LoaderFlags*/uint32_t loaderFlags);
+    /// @param pPipelineBatch if set the drawable pipelines are added to this batch and are not valid until the caller compiles it (drawables must not be reallocated before then), otherwise they are created before returning
+    static bool CreateDrawables(T_GFXAPI&, std::vector<MeshInstance>&& intermediateMeshInstances, std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>(const MeshObjectIntermediate::MaterialDef&)>& materialLoader, std::vector<Drawable>& drawables, /*DrawableLoader::LoaderFlags*/uint32_t loaderFlags, PipelineBatch<T_GFXAPI>* pPipelineBatch = nullptr);
 
     /// @brief Create @Drawables() for rendering the given @MeshInstance objects.
     /// Identical to CreateDrawables but for a single pass only (helper to save end-user from creating spans with a single entry)
@@ -193,21 +206,42 @@ bool DrawableLoader<T_GFXAPI>::LoadDrawables( T_GFXAPI& gfxApi, AssetManager& as
 template<typename T_GFXAPI>
 bool DrawableLoader<T_GFXAPI>::CreateDrawables( T_GFXAPI& gfxapi, std::vector<MeshObjectIntermediate>&& intermediateMeshObjects, std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>( const MeshObjectIntermediate::MaterialDef& )>& materialLoader, std::vector<Drawable>& drawables, /*DrawableLoader::LoaderFlags*/uint32_t loaderFlags )
 {
+    if (loaderFlags & LoaderFlags::OptimizeMeshes)
+    {
+        intermediateMeshObjects = MeshObjectIntermediate::OptimizeMeshes( std::move( intermediateMeshObjects ), cOptimizeMeshesWeldEpsilon );
+    }
+
+    // Drawables only support a single material, split (or batch) the meshes so each has one material.
+    if (loaderFlags & LoaderFlags::StaticBatch)
+        intermediateMeshObjects = MeshObjectIntermediate::BatchStatic( std::move( intermediateMeshObjects ), cStaticBatchMaxVertices );
+    else
+        intermediateMeshObjects = MeshObjectIntermediate::SplitMeshesByMaterial( std::move( intermediateMeshObjects ) );
+
     // See if we can find instances, we assume there is no instance information in the gltf!
     auto instancedFatObjects = (loaderFlags & LoaderFlags::FindInstances) ? MeshInstanceGenerator::FindInstances( std::move( intermediateMeshObjects ) ) : MeshInstanceGenerator::NullFindInstances( std::move( intermediateMeshObjects ) );
     intermediateMeshObjects.clear();
 
+    if (loaderFlags & LoaderFlags::GenerateLods)
+    {
+        // Generate lods after finding instances so we only simplify each unique mesh once.
+        for (auto& [fatObject, instances] : instancedFatObjects)
+        {
+            fatObject.GenerateLods( cGenerateLodsMaxLods, cGenerateLodsMaxError );
+        }
+    }
+
     return CreateDrawables( gfxapi, std::move( instancedFatObjects ), renderPasses, materialLoader, drawables, loaderFlags );
 }
 
 template<typename T_GFXAPI>
-bool DrawableLoader<T_GFXAPI>::CreateDrawables( T_GFXAPI& gfxapi, std::vector<MeshInstance>&& intermediateMeshInstances, std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>( const MeshObjectIntermediate::MaterialDef& )>& materialLoader, std::vector<Drawable>& drawables, /*DrawableLoader::LoaderFlags*/uint32_t loaderFlags )
+bool DrawableLoader<T_GFXAPI>::CreateDrawables( T_GFXAPI& gfxapi, std::vector<MeshInstance>&& intermediateMeshInstances, std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>( const MeshObjectIntermediate::MaterialDef& )>& materialLoader, std::vector<Drawable>& drawables, /*DrawableLoader::LoaderFlags*/uint32_t loaderFlags, PipelineBatch<T_GFXAPI>* pPipelineBatch )
 {
-    // Create a pipeline container for each render pass, dont create the underlying pipeline until we know it is needed
-    std::vector<Pipeline<T_GFXAPI>> pipelines;
-    pipelines.resize( renderPasses.size() );
+    // Drawable pipelines are gathered up and created together (multithreaded) once all the drawables are initialized.
+    // Batched pipelines point in to the drawables, so drawables must not be reallocated until the batch is compiled.
+    PipelineBatch<T_GFXAPI> localPipelineBatch{ gfxapi };
+    PipelineBatch<T_GFXAPI>& pipelineBatch = pPipelineBatch ? *pPipelineBatch : localPipelineBatch;
 
-    drawables.reserve( intermediateMeshInstances.size() );
+    drawables.reserve( drawables.size() + intermediateMeshInstances.size() );
     for (auto& [fatObject, instances] : intermediateMeshInstances)
     {
         // Get the material for this mesh
@@ -223,7 +257,7 @@ bool DrawableLoader<T_GFXAPI>::CreateDrawables( T_GFXAPI& gfxapi, std::vector<Me
         {
             if (fatObject.m_Materials.size() > 1)
             {
-                LOGE( "  Drawable loader does not support per-face materials, using first material" );
+                LOGE( "  Drawable loader does not support per-face materials, using first material (use MeshObjectIntermediate::SplitMeshesByMaterial before creating MeshInstances)" );
             }
             auto loadedMaterial = materialLoader( fatObject.m_Materials[0] );
             if (loadedMaterial.has_value())
@@ -244,26 +278,7 @@ bool DrawableLoader<T_GFXAPI>::CreateDrawables( T_GFXAPI& gfxapi, std::vector<Me
             const char* pRenderPassName = renderPasses[pass].name.c_str();
             const auto* pShaderPass = shader.GetShaderPass( pRenderPassName ); ///TODO: std::string generated here!
             if (pShaderPass)
-            {
                 passMask |= 1 << pass;
-                // Make sure we have pipeline for this pass
-                if (!pipelines[pass])
-                {
-                    const auto* materialPass = material->GetMaterialPass( pRenderPassName );
-                    assert( materialPass );
-
-                    PipelineRasterizationState rasterizationState{pShaderPass->m_shaderPassDescription};
-                    pipelines[pass] = ::CreatePipeline( gfxapi,
-                                                      pShaderPass->m_shaderPassDescription,
-                                                      pShaderPass->GetPipelineLayout(),
-                                                      pShaderPass->GetPipelineVertexInputState(),
-                                                      rasterizationState,
-                                                      materialPass->GetSpecializationConstants(),
-                                                      pShaderPass->m_shaders,
-                                                      renderPasses[pass],
-                                                      renderPasses[pass].msaa );
-                }
-            }
             if (!pFirstPass)
                 pFirstPass = pShaderPass;
         }
@@ -344,13 +359,13 @@ bool DrawableLoader<T_GFXAPI>::CreateDrawables( T_GFXAPI& gfxapi, std::vector<Me
             }
 
             // Create the drawable
-            if (!drawables.emplace_back( gfxapi, std::move( material.value() ) ).Init( renderPasses, passMask, std::move( meshObject ), std::move( vertexInstanceBuffer ), std::nullopt, nodeId ))
+            if (!drawables.emplace_back( gfxapi, std::move( material.value() ) ).Init( renderPasses, passMask, std::move( meshObject ), std::move( vertexInstanceBuffer ), std::nullopt, nodeId, &pipelineBatch ))
             {
                 return false;
             }
         }
     }
-    return true;
+    return pPipelineBatch ? true : pipelineBatch.Compile();
 }
 
 template<typename T_GFXAPI>
@@ -0,0 +1,491 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "drawableLoader.hpp"
+#include "graphicsApi/graphicsApiBase.hpp"
+#include "mesh/instanceGenerator.hpp"
+#include "mesh/meshIntermediate.hpp"
+#include "system/glm_common.hpp"
+#include "system/os_common.h"
+#include "texture/textureManager.hpp"
+
+// Forward Declarations
+class AssetManager;
+class SamplerBase;
+class TextureBase;
+
+
+/// Progressive (streaming) version of DrawableLoader::LoadDrawables.
+///
+/// The mesh file is loaded (and optimized, instanced, simplified as requested by the LoaderFlags) on a background thread.
+/// Meshes are handed over to the render thread in priority order (nearest to the camera first, meshes behind the camera last) and turned in to
+/// @Drawable(s) a few at a time by Update, so rendering can start as soon as the first meshes are ready rather than when the whole scene is loaded.
+/// Each mesh is optimized and simplified on its own as it is processed, unless StaticBatch or FindInstances is requested (those need the whole
+/// scene, so nothing is handed over until they are done).
+/// Textures requested (through GetOrQueueTexture) while a material is being created are bound as a placeholder and loaded on the texture
+/// manager's loading threads (TextureManagerBase::LoadTextureAsync), after which Update patches the material descriptor sets to point at the loaded texture.
+///
+/// Device objects (buffers, materials, textures) are only ever created on the thread calling Update.
+/// @ingroup Material
+template<typename T_GFXAPI>
+class DrawableStreamLoader
+{
+    DrawableStreamLoader( const DrawableStreamLoader<T_GFXAPI>& ) = delete;
+    DrawableStreamLoader<T_GFXAPI>& operator=( const DrawableStreamLoader<T_GFXAPI>& ) = delete;
+    using Drawable = Drawable<T_GFXAPI>;
+    using Material = Material<T_GFXAPI>;
+    using RenderContext = RenderContext<T_GFXAPI>;
+public:
+    /// @param pTextureManager texture manager used to load textures requested through GetOrQueueTexture (may be null if GetOrQueueTexture is not used)
+    DrawableStreamLoader( T_GFXAPI& gfxApi, TextureManagerBase* pTextureManager ) noexcept : m_GfxApi( gfxApi ), m_pTextureManager( pTextureManager ) {}
+    ~DrawableStreamLoader() { Cancel(); }
+
+    /// @brief Start loading a mesh object in the background.
+    /// @param assetManager asset manager used to load the mesh file (must outlive the loading thread)
+    /// @param meshFilename name of the mesh filename to load (via assetManager)
+    /// @param loaderFlags loader feature enables (@ref DrawableLoaderBase::LoaderFlags)
+    /// @param globalScale global scale applied to every loaded Drawable object
+    /// @param priorityPosition initial (camera) position used to prioritise meshes, can be changed with SetPriorityView
+    /// @return true if the loading thread was started
+    bool Start( AssetManager& assetManager, const std::string& meshFilename, /*LoaderFlags*/uint32_t loaderFlags, const glm::vec3 globalScale = glm::vec3( 1.0f, 1.0f, 1.0f ), const glm::vec3 priorityPosition = glm::vec3( 0.0f, 0.0f, 0.0f ) );
+
+    /// @brief Stop loading (waits for the mesh currently being processed) and discard any meshes not yet turned in to Drawables.
+    void Cancel();
+
+    /// @brief Set the camera position and view direction used to prioritise which meshes are processed next.  Can be called every frame.
+    /// @param viewDirection camera forward direction (zero length to prioritise on distance alone)
+    void SetPriorityView( const glm::vec3 position, const glm::vec3 viewDirection = glm::vec3( 0.0f, 0.0f, 0.0f ) );
+
+    /// @brief Create @Drawable(s) from meshes that have finished loading and patch any placeholder textures that have now been loaded.
+    /// Expected to be called once per frame on the render thread, at the point the application would normally update descriptor sets for the frame.
+    /// @param renderPasses span of render pass contexts that we may want to create DrawablePasses for (as LoadDrawables)
+    /// @param materialLoader user supplied function that returns a Material for each mesh material (as LoadDrawables).  May call GetOrQueueTexture.
+    /// @param drawables output vector of @Drawable objects, new drawables are appended (the application should not remove drawables while streaming is active)
+    /// @param bufferIdx frame buffer index whose descriptor sets are not in use by the gpu (placeholder textures are patched one buffer index at a time)
+    /// @param maxNewDrawables maximum number of meshes to turn in to Drawables this call (their pipelines are compiled together)
+    /// @param maxTextureLoads maximum number of loaded textures to upload this call (TextureManagerBase::UpdateAsyncLoads)
+    /// @return number of Drawables appended to drawables
+    size_t Update( std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>( const MeshObjectIntermediate::MaterialDef& )>& materialLoader, std::vector<Drawable>& drawables, uint32_t bufferIdx, uint32_t maxNewDrawables = 16, uint32_t maxTextureLoads = 4 );
+
+    /// @brief Texture loader helper, for use by the materialLoader passed to Update.
+    /// Returns the texture if it is already loaded, otherwise starts loading the texture (in the background) and returns pPlaceholder, which is swapped for the loaded texture by a later Update.
+    /// Outside of Update this is a (blocking) TextureManagerBase::GetOrLoadTexture.
+    /// @param bindingName material binding name being loaded (the name passed in to the material textureLoader)
+    /// @param textureSlotName name of texture (key in the texture manager)
+    /// @param filename texture filename to load
+    /// @param sampler sampler to load the texture with (must outlive the loading)
+    /// @param pPlaceholder texture bound until the requested texture is loaded (eg a 1x1 white or flat normal texture)
+    const TextureBase* GetOrQueueTexture( const std::string& bindingName, const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler, const TextureBase* pPlaceholder );
+
+    /// @return true once every mesh has been turned in to a Drawable and every queued texture has been loaded and patched (or loading failed)
+    bool IsComplete() const;
+    /// @return true if the mesh file failed to load
+    bool HasFailed() const { return m_LoadFailed; }
+    /// @return number of loaded meshes waiting to be processed or turned in to Drawables
+    size_t GetNumPendingMeshes() const;
+    /// @return number of textures queued but not yet loaded
+    size_t GetNumPendingTextures() const { return m_LoadingTextureSlots.size(); }
+
+    /// Scale applied to the priority distance of meshes that are entirely behind the camera
+    static constexpr float cBehindCameraPriorityScale = 4.0f;
+
+protected:
+    struct PendingMesh
+    {
+        MeshInstance            meshInstance;
+        std::vector<glm::vec3>  centers;    ///< world space bounding sphere center of each instance
+        float                   radius = 0.0f;  ///< bounding sphere radius (of the untransformed mesh)
+    };
+    struct TexturePatch
+    {
+        size_t                  drawableIndex;
+        std::string             bindingName;
+        std::string             slotName;
+        uint64_t                patchedBufferMask;  ///< bit set for each frame buffer index already patched
+    };
+
+    void LoadThread( AssetManager& assetManager, std::string meshFilename, const glm::vec3 globalScale );
+    /// Optimize (and split by material) a single pending mesh, as DrawableLoader::CreateDrawables does for the whole scene
+    std::vector<MeshInstance> ProcessMesh( MeshInstance&& meshInstance ) const;
+    static PendingMesh MakePendingMesh( MeshInstance&& meshInstance );
+    static float PriorityScore( const PendingMesh& pendingMesh, const glm::vec3 position, const glm::vec3 viewDirection );
+    bool PatchTexture( const Drawable& drawable, uint32_t bufferIdx, const TexturePatch& patch, const TextureBase& texture ) const;
+
+protected:
+    T_GFXAPI&                           m_GfxApi;
+    TextureManagerBase*                 m_pTextureManager;
+    uint32_t                            m_LoaderFlags = 0;
+
+    std::thread                         m_LoadThread;
+    std::atomic<bool>                   m_CancelRequested = false;
+    std::atomic<bool>                   m_LoadThreadFinished = true;
+    std::atomic<bool>                   m_LoadFailed = false;
+
+    // Shared between the loading thread and the render thread (guarded by m_Mutex)
+    mutable std::mutex                  m_Mutex;
+    std::vector<PendingMesh>            m_PendingMeshes;    ///< loaded meshes waiting to be prioritised and processed
+    std::deque<MeshInstance>            m_ReadyMeshes;      ///< processed meshes waiting to be turned in to Drawables
+    glm::vec3                           m_PriorityPosition = glm::vec3( 0.0f, 0.0f, 0.0f );
+    glm::vec3                           m_PriorityDirection = glm::vec3( 0.0f, 0.0f, 0.0f );
+
+    // Render thread only
+    std::unordered_set<std::string>     m_LoadingTextureSlots;  ///< textures being loaded by the texture manager (LoadTextureAsync)
+    std::vector<TexturePatch>           m_TexturePatches;
+    std::vector<std::pair<std::string, std::string>> m_MaterialTextureRequests;  ///< (bindingName, slotName) requested by the material currently being created
+    bool                                m_InMaterialLoader = false;
+};
+
+
+template<typename T_GFXAPI>
+bool DrawableStreamLoader<T_GFXAPI>::Start( AssetManager& assetManager, const std::string& meshFilename, /*LoaderFlags*/uint32_t loaderFlags, const glm::vec3 globalScale, const glm::vec3 priorityPosition )
+{
+    if (m_LoadThread.joinable() && !m_LoadThreadFinished)
+    {
+        LOGE( "DrawableStreamLoader is already loading a mesh object" );
+        return false;
+    }
+    Cancel();
+
+    LOGI( "Streaming Object mesh: %s...", meshFilename.c_str() );
+    m_LoaderFlags = loaderFlags;
+    m_PriorityPosition = priorityPosition;
+    m_CancelRequested = false;
+    m_LoadFailed = false;
+    m_LoadThreadFinished = false;
+    m_LoadThread = std::thread( &DrawableStreamLoader<T_GFXAPI>::LoadThread, this, std::ref( assetManager ), meshFilename, globalScale );
+    return true;
+}
+
+template<typename T_GFXAPI>
+void DrawableStreamLoader<T_GFXAPI>::Cancel()
+{
+    m_CancelRequested = true;
+    if (m_LoadThread.joinable())
+        m_LoadThread.join();
+    m_LoadThreadFinished = true;
+
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    m_PendingMeshes.clear();
+    m_ReadyMeshes.clear();
+}
+
+template<typename T_GFXAPI>
+void DrawableStreamLoader<T_GFXAPI>::SetPriorityView( const glm::vec3 position, const glm::vec3 viewDirection )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    m_PriorityPosition = position;
+    m_PriorityDirection = viewDirection;
+}
+
+template<typename T_GFXAPI>
+bool DrawableStreamLoader<T_GFXAPI>::IsComplete() const
+{
+    return m_LoadThreadFinished && GetNumPendingMeshes() == 0 && m_LoadingTextureSlots.empty() && m_TexturePatches.empty();
+}
+
+template<typename T_GFXAPI>
+size_t DrawableStreamLoader<T_GFXAPI>::GetNumPendingMeshes() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_PendingMeshes.size() + m_ReadyMeshes.size();
+}
+
+template<typename T_GFXAPI>
+typename DrawableStreamLoader<T_GFXAPI>::PendingMesh DrawableStreamLoader<T_GFXAPI>::MakePendingMesh( MeshInstance&& meshInstance )
+{
+    PendingMesh pendingMesh{ std::move( meshInstance ), {}, 0.0f };
+    const auto& mesh = pendingMesh.meshInstance.mesh;
+
+    glm::vec3 boundsMin( std::numeric_limits<float>::max() );
+    glm::vec3 boundsMax( -std::numeric_limits<float>::max() );
+    for (const auto& vertex : mesh.m_VertexBuffer)
+    {
+        const glm::vec3 position( vertex.position[0], vertex.position[1], vertex.position[2] );
+        boundsMin = glm::min( boundsMin, position );
+        boundsMax = glm::max( boundsMax, position );
+    }
+    if (mesh.m_VertexBuffer.empty())
+        boundsMin = boundsMax = glm::vec3( 0.0f );
+
+    // Sphere around the object space bounding box.  Radius is not scaled by the transforms (good enough for prioritising).
+    const glm::vec3 objectCenter = glm::vec3( mesh.m_Transform * glm::vec4( (boundsMin + boundsMax) * 0.5f, 1.0f ) );
+    pendingMesh.radius = glm::length( boundsMax - boundsMin ) * 0.5f;
+
+    const auto& instances = pendingMesh.meshInstance.instances;
+    if (instances.empty())
+        pendingMesh.centers.push_back( objectCenter );
+    for (const auto& instance : instances)
+        pendingMesh.centers.push_back( glm::vec4( objectCenter, 1.0f ) * instance.transform );  // instance transform is transposed (row major)
+    return pendingMesh;
+}
+
+template<typename T_GFXAPI>
+float DrawableStreamLoader<T_GFXAPI>::PriorityScore( const PendingMesh& pendingMesh, const glm::vec3 position, const glm::vec3 viewDirection )
+{
+    // Lower is higher priority.  Use the nearest instance.
+    float bestScore = std::numeric_limits<float>::max();
+    for (const auto& center : pendingMesh.centers)
+    {
+        const glm::vec3 toCenter = center - position;
+        float score = std::max( glm::length( toCenter ) - pendingMesh.radius, 0.0f );
+        if (glm::dot( toCenter, viewDirection ) < -pendingMesh.radius * glm::length( viewDirection ))
+            score *= cBehindCameraPriorityScale;
+        bestScore = std::min( bestScore, score );
+    }
+    return bestScore;
+}
+
+template<typename T_GFXAPI>
+void DrawableStreamLoader<T_GFXAPI>::LoadThread( AssetManager& assetManager, std::string meshFilename, const glm::vec3 globalScale )
+{
+    std::vector<MeshObjectIntermediate> fatObjects;
+    if (meshFilename.size() > 4 && meshFilename.substr( meshFilename.size() - 4 ) == std::string( ".obj" ))
+    {
+        // Load .obj file
+        fatObjects = MeshObjectIntermediate::LoadObj( assetManager, meshFilename );
+    }
+    else
+    {
+        // Load .gltf file
+        fatObjects = MeshObjectIntermediate::LoadGLTF( assetManager, meshFilename, (m_LoaderFlags & DrawableLoaderBase::LoaderFlags::IgnoreHierarchy) != 0, globalScale );
+    }
+    if (fatObjects.size() == 0)
+    {
+        LOGE( "Error loading Object mesh: %s", meshFilename.c_str() );
+        m_LoadFailed = true;
+        m_LoadThreadFinished = true;
+        return;
+    }
+    DrawableLoaderBase::PrintStatistics( fatObjects );
+
+    // Static batching and instancing work across the whole scene (same processing as DrawableLoader::CreateDrawables), otherwise each
+    // (unprocessed) mesh is pending straight away and is optimized and split when it comes up in the priority order.
+    const bool wholeSceneProcessing = (m_LoaderFlags & (DrawableLoaderBase::LoaderFlags::StaticBatch | DrawableLoaderBase::LoaderFlags::FindInstances)) != 0;
+    if (wholeSceneProcessing)
+    {
+        if (m_LoaderFlags & DrawableLoaderBase::LoaderFlags::OptimizeMeshes)
+            fatObjects = MeshObjectIntermediate::OptimizeMeshes( std::move( fatObjects ), DrawableLoaderBase::cOptimizeMeshesWeldEpsilon );
+        if (m_LoaderFlags & DrawableLoaderBase::LoaderFlags::StaticBatch)
+            fatObjects = MeshObjectIntermediate::BatchStatic( std::move( fatObjects ), DrawableLoaderBase::cStaticBatchMaxVertices );
+        else
+            fatObjects = MeshObjectIntermediate::SplitMeshesByMaterial( std::move( fatObjects ) );
+    }
+    auto meshInstances = (m_LoaderFlags & DrawableLoaderBase::LoaderFlags::FindInstances) ? MeshInstanceGenerator::FindInstances( std::move( fatObjects ) ) : MeshInstanceGenerator::NullFindInstances( std::move( fatObjects ) );
+
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        m_PendingMeshes.reserve( meshInstances.size() );
+        for (auto& meshInstance : meshInstances)
+            m_PendingMeshes.push_back( MakePendingMesh( std::move( meshInstance ) ) );
+    }
+    meshInstances.clear();
+
+    // Process meshes one at a time in priority order (priority view may change between meshes).
+    while (!m_CancelRequested)
+    {
+        PendingMesh pendingMesh;
+        {
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            if (m_PendingMeshes.empty())
+                break;
+            size_t bestIdx = 0;
+            float bestScore = std::numeric_limits<float>::max();
+            for (size_t idx = 0; idx < m_PendingMeshes.size(); ++idx)
+            {
+                const float score = PriorityScore( m_PendingMeshes[idx], m_PriorityPosition, m_PriorityDirection );
+                if (score < bestScore)
+                {
+                    bestScore = score;
+                    bestIdx = idx;
+                }
+            }
+            pendingMesh = std::move( m_PendingMeshes[bestIdx] );
+            if (bestIdx != m_PendingMeshes.size() - 1)
+                m_PendingMeshes[bestIdx] = std::move( m_PendingMeshes.back() );
+            m_PendingMeshes.pop_back();
+        }
+
+        std::vector<MeshInstance> processedMeshes;
+        if (wholeSceneProcessing)
+            processedMeshes.push_back( std::move( pendingMesh.meshInstance ) );
+        else
+            processedMeshes = ProcessMesh( std::move( pendingMesh.meshInstance ) );
+
+        for (auto& processedMesh : processedMeshes)
+        {
+            if (m_LoaderFlags & DrawableLoaderBase::LoaderFlags::GenerateLods)
+                processedMesh.mesh.GenerateLods( DrawableLoaderBase::cGenerateLodsMaxLods, DrawableLoaderBase::cGenerateLodsMaxError );
+
+            // Hand over each mesh as soon as it is ready.
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            m_ReadyMeshes.push_back( std::move( processedMesh ) );
+        }
+    }
+    m_LoadThreadFinished = true;
+}
+
+template<typename T_GFXAPI>
+std::vector<MeshInstance> DrawableStreamLoader<T_GFXAPI>::ProcessMesh( MeshInstance&& meshInstance ) const
+{
+    std::vector<MeshObjectIntermediate> fatObjects;
+    fatObjects.push_back( std::move( meshInstance.mesh ) );
+    if (m_LoaderFlags & DrawableLoaderBase::LoaderFlags::OptimizeMeshes)
+        fatObjects = MeshObjectIntermediate::OptimizeMeshes( std::move( fatObjects ), DrawableLoaderBase::cOptimizeMeshesWeldEpsilon );
+    fatObjects = MeshObjectIntermediate::SplitMeshesByMaterial( std::move( fatObjects ) );
+
+    // Split meshes share the instance(s) of the mesh they came from.
+    std::vector<MeshInstance> meshInstances;
+    meshInstances.reserve( fatObjects.size() );
+    for (auto& fatObject : fatObjects)
+        meshInstances.push_back( { std::move( fatObject ), meshInstance.instances } );
+    return meshInstances;
+}
+
+template<typename T_GFXAPI>
+const TextureBase* DrawableStreamLoader<T_GFXAPI>::GetOrQueueTexture( const std::string& bindingName, const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler, const TextureBase* pPlaceholder )
+{
+    assert( m_pTextureManager );
+    if (textureSlotName.empty())
+        return pPlaceholder;
+    if (!m_InMaterialLoader)
+    {
+        const auto* pTexture = m_pTextureManager->GetOrLoadTexture( textureSlotName, filename, sampler );
+        return pTexture ? pTexture : pPlaceholder;
+    }
+
+    const auto* pTexture = m_pTextureManager->GetTexture( textureSlotName );
+    if (pTexture)
+        return pTexture;
+    if (filename.empty())
+        return pPlaceholder;
+
+    if (!m_LoadingTextureSlots.contains( textureSlotName ))
+    {
+        if (!m_pTextureManager->LoadTextureAsync( textureSlotName, filename, sampler ))
+            return pPlaceholder;
+        m_LoadingTextureSlots.insert( textureSlotName );
+    }
+    m_MaterialTextureRequests.emplace_back( bindingName, textureSlotName );
+    return pPlaceholder;
+}
+
+template<typename T_GFXAPI>
+bool DrawableStreamLoader<T_GFXAPI>::PatchTexture( const Drawable& drawable, uint32_t bufferIdx, const TexturePatch& patch, const TextureBase& texture ) const
+{
+    // Only update the passes that use this binding (Material::UpdateDescriptorSetBinding expects every pass to have it).
+    bool success = true;
+    for (const auto& materialPass : drawable.GetMaterial().GetMaterialPasses())
+    {
+        const auto& setLayouts = materialPass.GetShaderPass().GetDescriptorSetLayouts();
+        if (std::any_of( setLayouts.begin(), setLayouts.end(), [&patch]( const auto& setLayout ) { return setLayout.GetNameToBinding().contains( patch.bindingName ); } ))
+            success &= materialPass.UpdateDescriptorSetBinding( bufferIdx, patch.bindingName, apiCast<T_GFXAPI>( texture ) );
+    }
+    return success;
+}
+
+template<typename T_GFXAPI>
+size_t DrawableStreamLoader<T_GFXAPI>::Update( std::span<const RenderContext> renderPasses, const std::function<std::optional<Material>( const MeshObjectIntermediate::MaterialDef& )>& materialLoader, std::vector<Drawable>& drawables, uint32_t bufferIdx, uint32_t maxNewDrawables, uint32_t maxTextureLoads )
+{
+    //
+    // Grab the next (highest priority) meshes that are ready.
+    //
+    std::vector<MeshInstance> readyMeshes;
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        while (!m_ReadyMeshes.empty() && readyMeshes.size() < maxNewDrawables)
+        {
+            readyMeshes.push_back( std::move( m_ReadyMeshes.front() ) );
+            m_ReadyMeshes.pop_front();
+        }
+    }
+
+    //
+    // Create the Drawables (one at a time, so we know which drawable requested which textures).
+    // Their pipelines are compiled together once they are all created (batched pipelines point in to drawables, so it must not reallocate until then).
+    //
+    const size_t firstNewDrawable = drawables.size();
+    drawables.reserve( drawables.size() + readyMeshes.size() );
+    PipelineBatch<T_GFXAPI> pipelineBatch{ m_GfxApi };
+    for (auto& readyMesh : readyMeshes)
+    {
+        const size_t numDrawables = drawables.size();
+        m_MaterialTextureRequests.clear();
+        m_InMaterialLoader = true;
+        std::vector<MeshInstance> meshInstance;
+        meshInstance.push_back( std::move( readyMesh ) );
+        if (!DrawableLoader<T_GFXAPI>::CreateDrawables( m_GfxApi, std::move( meshInstance ), renderPasses, materialLoader, drawables, m_LoaderFlags, &pipelineBatch ))
+        {
+            LOGE( "Error initializing streamed Drawable" );
+        }
+        m_InMaterialLoader = false;
+
+        if (drawables.size() > numDrawables)
+        {
+            for (auto& [bindingName, slotName] : m_MaterialTextureRequests)
+                m_TexturePatches.push_back( { drawables.size() - 1, std::move( bindingName ), std::move( slotName ), 0 } );
+        }
+    }
+    m_MaterialTextureRequests.clear();
+    if (!pipelineBatch.Compile())
+    {
+        LOGE( "Error compiling streamed Drawable pipelines" );
+    }
+
+    //
+    // Add textures that have finished loading (in the background) to the texture manager.
+    //
+    if (!m_LoadingTextureSlots.empty())
+    {
+        for (const auto& slotName : m_pTextureManager->UpdateAsyncLoads( maxTextureLoads ))
+        {
+            if (m_LoadingTextureSlots.erase( slotName ) && !m_pTextureManager->GetTexture( slotName ))
+            {
+                LOGW( "Unable to load streamed texture %s (leaving placeholder)", slotName.c_str() );
+                std::erase_if( m_TexturePatches, [&slotName]( const TexturePatch& patch ) { return patch.slotName == slotName; } );
+            }
+        }
+        // Loads may also have been finished by someone else calling UpdateAsyncLoads (or GetOrLoadTexture)
+        std::erase_if( m_LoadingTextureSlots, [this]( const std::string& slotName ) { return m_pTextureManager->GetTexture( slotName ) != nullptr; } );
+    }
+
+    //
+    // Swap placeholders for loaded textures in the descriptor sets for this frame buffer index.
+    //
+    std::erase_if( m_TexturePatches, [&]( TexturePatch& patch ) -> bool
+    {
+        const auto* pTexture = m_pTextureManager->GetTexture( patch.slotName );
+        if (!pTexture)
+            return false;   // not loaded yet
+        const auto& drawable = drawables[patch.drawableIndex];
+        const uint32_t numFrameBuffers = drawable.GetMaterial().GetNumFrameBuffers();
+        assert( numFrameBuffers <= 64 );
+        if (bufferIdx < numFrameBuffers && (patch.patchedBufferMask & (1ull << bufferIdx)) == 0)
+        {
+            if (!PatchTexture( drawable, bufferIdx, patch, *pTexture ))
+                return true;    // give up on this one
+            patch.patchedBufferMask |= 1ull << bufferIdx;
+        }
+        return patch.patchedBufferMask == ((numFrameBuffers >= 64) ? ~0ull : ((1ull << numFrameBuffers) - 1));
+    } );
+
+    return drawables.size() - firstNewDrawable;
+}
@@ -134,7 +134,7 @@ bool Drawable<Dx12>::ReInit(std::span<const RenderPass> renderPasses, std::span<
             if (mMeshObject.m_IndexBuffer)
             {
                 indexBuffer = mMeshObject.m_IndexBuffer->GetIndexBufferView();
-                indexCount = mMeshObject.m_IndexBuffer->GetNumIndices();
+                indexCount = mMeshObject.m_Lods.empty() ? mMeshObject.m_IndexBuffer->GetNumIndices() : mMeshObject.m_Lods[0].numIndices;
             }
 
             // Indirect Draw buffer is optional
@@ -243,7 +243,8 @@ void Drawable<Dx12>::DrawPass(CommandList& cmdList, const DrawablePass& drawable
 //        else
         {
             // Everything is set up, draw the mesh
-            dxCmdList->DrawIndexedInstanced(drawablePass.mNumIndices, GetInstances() ? (uint32_t)GetInstances()->GetNumVertices() : 1, 0, 0, 0);
+            const auto* pLod = mMeshObject.m_Lods.empty() ? nullptr : &mMeshObject.m_Lods[mLod];
+            dxCmdList->DrawIndexedInstanced(pLod ? pLod->numIndices : drawablePass.mNumIndices, GetInstances() ? (uint32_t)GetInstances()->GetNumVertices() : 1, pLod ? pLod->firstIndex : 0, 0, 0);
         }
     }
     else
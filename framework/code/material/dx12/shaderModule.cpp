@@ -8,6 +8,7 @@
 
 #include "shaderModule.hpp"
 #include <vector>
+#include "material/shaderBundle.hpp"
 #include "material/shaderDescription.hpp"
 //#include "material/vertexDescription.hpp"
 #include "system/assetManager.hpp"
@@ -30,7 +31,7 @@ void ShaderModule<Dx12>::Destroy(Dx12& dx12)
     ShaderModuleBase::Destroy();
 }
 
-bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const std::string& filename)
+bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const std::string& filename, const ShaderBundle* pShaderBundle)
 {
     bool success = true;
     Destroy(dx12);
@@ -39,7 +40,13 @@ bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const std:
 
     if (!m_filename.empty())
     {
-        if ( assetManager.LoadFileIntoMemory(m_filename.c_str(), m_Shader) )
+        // Use the copy in the shader bundle if there is one, otherwise load the file.
+        if (const auto code = pShaderBundle ? pShaderBundle->GetShaderModuleCode(m_filename) : std::span<const uint32_t>{}; !code.empty())
+        {
+            const auto bytes = std::as_bytes(code);
+            m_Shader.assign(bytes.begin(), bytes.end());
+        }
+        else if ( assetManager.LoadFileIntoMemory(m_filename.c_str(), m_Shader) )
         {
         }
         else
@@ -50,7 +57,7 @@ bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const std:
     return success;
 }
 
-bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const ShaderPassDescription& shaderDescription, const ShaderType shaderType)
+bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const ShaderPassDescription& shaderDescription, const ShaderType shaderType, const ShaderBundle* pShaderBundle)
 {
     const std::string* shaderFileName = nullptr;
     switch (shaderType)
@@ -79,5 +86,5 @@ bool ShaderModule<Dx12>::Load(Dx12& dx12, AssetManager& assetManager, const Shad
     }
 
     assert(shaderFileName!=nullptr);
-    return Load(dx12, assetManager, *shaderFileName);    ///TODO: better return code / error handling
+    return Load(dx12, assetManager, *shaderFileName, pShaderBundle);    ///TODO: better return code / error handling
 }
@@ -17,6 +17,7 @@
 // Forward declarations
 class AssetManager;
 class DescriptorSetLayoutBase;
+class ShaderBundle;
 class ShaderPassDescription;
 class VertexDescription;
 class VertexFormat;
@@ -37,13 +38,13 @@ public:
     /// Free up the shader memory.
     void Destroy(Dx12&);
 
-    /// Load the shader binary with the given shader name
+    /// Load the shader binary with the given shader name (from pShaderBundle if it contains the shader, otherwise from file)
     /// @returns true on success
-    bool Load(Dx12& vulkan, AssetManager& assetManager, const std::string& filename);
+    bool Load(Dx12& vulkan, AssetManager& assetManager, const std::string& filename, const ShaderBundle* pShaderBundle = nullptr);
 
     /// Load the shader binary for the given shader type (using ShaderPassDescription to get the appropriate shader name).
     /// @returns true on success
-    bool Load(Dx12&, AssetManager&, const ShaderPassDescription&, const ShaderType);
+    bool Load(Dx12&, AssetManager&, const ShaderPassDescription&, const ShaderType, const ShaderBundle* pShaderBundle = nullptr);
 
     const tData& GetShaderData() const { return m_Shader; }
 private:
@@ -69,4 +69,35 @@ Pipeline<T_GFXAPI> CreatePipeline( T_GFXAPI&,
     static_assert(sizeof( T_GFXAPI ) != sizeof( T_GFXAPI ), "Must use the specialized version of this function.  Your are likely missing #include \"material/<GFXAPI>/pipeline.hpp\"");
     assert( 0 && "Expecting CreatePipeline (per graphics api) to be used" );
     return {};
-}
\ No newline at end of file
+}
+
+/// Batch of pipelines to be created together (across multiple threads).
+/// This template class expected to be specialized (if this template throws compiler errors then the code is not using the specialization classes which is an issue!)
+/// @ingroup Material
+template<typename T_GFXAPI>
+class PipelineBatch
+{
+    PipelineBatch& operator=(const PipelineBatch<T_GFXAPI>&) = delete;
+    PipelineBatch(const PipelineBatch<T_GFXAPI>&) = delete;
+public:
+    PipelineBatch() noexcept = delete;
+    ~PipelineBatch() = delete;
+
+    static_assert(sizeof( PipelineBatch<T_GFXAPI> ) >= 1, "Must use the specialized version of this class.  Your are likely missing #include \"material/<GFXAPI>/pipelineBatch.hpp\"");
+};
+
+
+/// Registry of created pipelines, for sharing pipelines with identical state.
+/// This template class expected to be specialized (if this template throws compiler errors then the code is not using the specialization classes which is an issue!)
+/// @ingroup Material
+template<typename T_GFXAPI>
+class PipelineRegistry
+{
+    PipelineRegistry& operator=(const PipelineRegistry<T_GFXAPI>&) = delete;
+    PipelineRegistry(const PipelineRegistry<T_GFXAPI>&) = delete;
+public:
+    PipelineRegistry() noexcept = delete;
+    ~PipelineRegistry() = delete;
+
+    static_assert(sizeof( PipelineRegistry<T_GFXAPI> ) >= 1, "Must use the specialized version of this class.  Your are likely missing #include \"material/<GFXAPI>/pipelineRegistry.hpp\"");
+};
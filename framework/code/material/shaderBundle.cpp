@@ -0,0 +1,630 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "shaderBundle.hpp"
+#include "shaderDescription.hpp"
+#include "system/crc32c.hpp"
+#include "system/os_common.h"
+#include "texture/sampler.hpp"
+#include <cstring>
+#include <type_traits>
+
+//
+// Bundle file layout (native endian, everything written field by field):
+//   uint32 magic, uint32 version, uint32 numShaders, uint32 numModules
+//   numShaders x { string shaderName, string sourceFilename, uint64 sourceSize, uint32 sourceHash, uint64 offset, uint64 size }  - serialized ShaderDescription (source is the json description)
+//   numModules x { string moduleName, string sourceFilename, uint64 sourceSize, uint32 sourceHash, uint64 offset, uint64 size }  - shader binary (source is the module file)
+//   (padding to 4 byte alignment)
+//   data (offsets are relative to the start of the data, module data is 4 byte aligned)
+// Strings are a uint32 length followed by the characters (no terminator).
+//
+
+namespace
+{
+    /// Appends fields to a byte buffer.
+    class BundleWriter
+    {
+    public:
+        explicit BundleWriter(std::vector<char>& data) : m_Data(data) {}
+
+        template<typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+            const char* pValue = reinterpret_cast<const char*>(&value);
+            m_Data.insert(m_Data.end(), pValue, pValue + sizeof(T));
+        }
+        void Write(bool value) { Write(uint8_t(value ? 1 : 0)); }
+        void Write(const std::string& value)
+        {
+            Write((uint32_t)value.size());
+            m_Data.insert(m_Data.end(), value.begin(), value.end());
+        }
+        void Align(size_t alignment)
+        {
+            m_Data.resize((m_Data.size() + alignment - 1) & ~(alignment - 1), 0);
+        }
+    private:
+        std::vector<char>& m_Data;
+    };
+
+    /// Reads fields from a byte span.  Reads past the end return zeros and set the failed flag (checked once at the end, rather than after every read).
+    class BundleReader
+    {
+    public:
+        explicit BundleReader(std::span<const char> data) : m_Data(data) {}
+
+        template<typename T>
+        T Read()
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+            T value{};
+            if (m_Position + sizeof(T) > m_Data.size())
+            {
+                m_Failed = true;
+                return value;
+            }
+            memcpy(&value, m_Data.data() + m_Position, sizeof(T));
+            m_Position += sizeof(T);
+            return value;
+        }
+        bool ReadBool() { return Read<uint8_t>() != 0; }
+        std::string ReadString()
+        {
+            const uint32_t size = Read<uint32_t>();
+            if (m_Position + size > m_Data.size())
+            {
+                m_Failed = true;
+                return {};
+            }
+            std::string value(m_Data.data() + m_Position, size);
+            m_Position += size;
+            return value;
+        }
+        /// Number of elements in an array (each element at least minElementSize bytes), 0 (and fails) if the array cannot fit in the remaining data.
+        uint32_t ReadCount(size_t minElementSize = 1)
+        {
+            const uint32_t count = Read<uint32_t>();
+            if (count * minElementSize > m_Data.size() - m_Position)
+            {
+                m_Failed = true;
+                return 0;
+            }
+            return count;
+        }
+        void Align(size_t alignment) { m_Position = (m_Position + alignment - 1) & ~(alignment - 1); }
+
+        size_t Position() const { return m_Position; }
+        bool Failed() const { return m_Failed || m_Position > m_Data.size(); }
+    private:
+        std::span<const char>   m_Data;
+        size_t                  m_Position = 0;
+        bool                    m_Failed = false;
+    };
+
+
+    void WriteShaderPassDescription(BundleWriter& writer, const ShaderPassDescription& pass)
+    {
+        writer.Write((uint32_t)pass.m_sets.size());
+        for (const auto& set : pass.m_sets)
+        {
+            writer.Write(set.m_name);
+            writer.Write(set.m_setIndex);
+            writer.Write((uint32_t)set.m_descriptorTypes.size());
+            for (const auto& descriptor : set.m_descriptorTypes)
+            {
+                writer.Write(descriptor.type);
+                writer.Write(DescriptorSetDescription::StageFlag::t(descriptor.stages));
+                writer.Write((uint32_t)descriptor.names.size());
+                for (const auto& name : descriptor.names)
+                    writer.Write(name);
+                writer.Write(descriptor.count);
+                writer.Write(descriptor.readOnly);
+                writer.Write(descriptor.descriptorIndex);
+            }
+        }
+
+        writer.Write((uint32_t)pass.m_outputs.size());
+        for (const auto& output : pass.m_outputs)
+        {
+            writer.Write(output.blendEnable);
+            writer.Write(output.srcColorBlendFactor);
+            writer.Write(output.dstColorBlendFactor);
+            writer.Write(output.srcAlphaBlendFactor);
+            writer.Write(output.dstAlphaBlendFactor);
+            writer.Write(output.colorWriteMask);
+        }
+
+        writer.Write(pass.m_taskName);
+        writer.Write(pass.m_meshName);
+        writer.Write(pass.m_computeName);
+        writer.Write(pass.m_vertexName);
+        writer.Write(pass.m_fragmentName);
+        writer.Write(pass.m_rayGenerationName);
+        writer.Write(pass.m_rayClosestHitName);
+        writer.Write(pass.m_rayAnyHitName);
+        writer.Write(pass.m_rayMissName);
+
+        const auto& fixedFunction = pass.m_fixedFunctionSettings;
+        writer.Write(fixedFunction.depthTestEnable);
+        writer.Write(fixedFunction.depthWriteEnable);
+        writer.Write(fixedFunction.depthCompareOp);
+        writer.Write(fixedFunction.depthClampEnable);
+        writer.Write(fixedFunction.depthBiasEnable);
+        writer.Write(fixedFunction.depthBiasConstant);
+        writer.Write(fixedFunction.depthBiasClamp);
+        writer.Write(fixedFunction.depthBiasSlope);
+        writer.Write(fixedFunction.cullFrontFace);
+        writer.Write(fixedFunction.cullBackFace);
+
+        writer.Write(pass.m_sampleShadingSettings.sampleShadingEnable);
+        writer.Write(pass.m_sampleShadingSettings.forceCenterSample);
+        writer.Write(pass.m_sampleShadingSettings.sampleShadingMask);
+
+        for (uint32_t localSize : pass.m_workGroupSettings.localSize)
+            writer.Write(localSize);
+        writer.Write(pass.m_workGroupSettings.perTileDispatch);
+
+        writer.Write(pass.m_rayTracingSettings.maxRayRecursionDepth);
+
+        writer.Write((uint32_t)pass.m_vertexFormatBindings.size());
+        for (uint32_t binding : pass.m_vertexFormatBindings)
+            writer.Write(binding);
+
+        writer.Write((uint32_t)pass.m_constants.size());
+        for (const auto& constant : pass.m_constants)
+        {
+            writer.Write(constant.name);
+            writer.Write(constant.constantIndex);
+            writer.Write(VertexFormat::Element::ElementType::t(constant.type));
+        }
+
+        writer.Write((uint32_t)pass.m_rootSamplers.size());
+        for (const auto& sampler : pass.m_rootSamplers)
+        {
+            writer.Write(sampler.Mode);
+            writer.Write(sampler.Filter);
+            writer.Write(sampler.MipFilter);
+            writer.Write(sampler.BorderColor);
+            writer.Write(sampler.UnnormalizedCoordinates);
+            writer.Write(sampler.MipBias);
+            writer.Write(sampler.MinLod);
+            writer.Write(sampler.MaxLod);
+            writer.Write(sampler.Anisotropy);
+        }
+    }
+
+    ShaderPassDescription ReadShaderPassDescription(BundleReader& reader)
+    {
+        std::vector<DescriptorSetDescription> sets;
+        sets.resize(reader.ReadCount());
+        for (auto& set : sets)
+        {
+            set.m_name = reader.ReadString();
+            set.m_setIndex = reader.Read<uint32_t>();
+            const uint32_t numDescriptorTypes = reader.ReadCount();
+            set.m_descriptorTypes.reserve(numDescriptorTypes);
+            for (uint32_t i = 0; i < numDescriptorTypes; ++i)
+            {
+                const auto type = reader.Read<DescriptorSetDescription::DescriptorType>();
+                const auto stages = reader.Read<DescriptorSetDescription::StageFlag::t>();
+                std::vector<std::string> names;
+                names.resize(reader.ReadCount(sizeof(uint32_t)));
+                for (auto& name : names)
+                    name = reader.ReadString();
+                const uint32_t count = reader.Read<uint32_t>();
+                const bool readOnly = reader.ReadBool();
+                const int descriptorIndex = reader.Read<int>();
+                set.m_descriptorTypes.emplace_back(type, stages, std::move(names), (int)count, readOnly, descriptorIndex);
+            }
+        }
+
+        std::vector<ShaderPassDescription::Output> outputs;
+        outputs.resize(reader.ReadCount());
+        for (auto& output : outputs)
+        {
+            output.blendEnable = reader.ReadBool();
+            output.srcColorBlendFactor = reader.Read<ShaderPassDescription::BlendFactor>();
+            output.dstColorBlendFactor = reader.Read<ShaderPassDescription::BlendFactor>();
+            output.srcAlphaBlendFactor = reader.Read<ShaderPassDescription::BlendFactor>();
+            output.dstAlphaBlendFactor = reader.Read<ShaderPassDescription::BlendFactor>();
+            output.colorWriteMask = reader.Read<uint32_t>();
+        }
+
+        std::string taskName = reader.ReadString();
+        std::string meshName = reader.ReadString();
+        std::string computeName = reader.ReadString();
+        std::string vertexName = reader.ReadString();
+        std::string fragmentName = reader.ReadString();
+        std::string rayGenerationName = reader.ReadString();
+        std::string rayClosestHitName = reader.ReadString();
+        std::string rayAnyHitName = reader.ReadString();
+        std::string rayMissName = reader.ReadString();
+
+        ShaderPassDescription::FixedFunctionSettings fixedFunction;
+        fixedFunction.depthTestEnable = reader.ReadBool();
+        fixedFunction.depthWriteEnable = reader.ReadBool();
+        fixedFunction.depthCompareOp = reader.Read<ShaderPassDescription::DepthCompareOp>();
+        fixedFunction.depthClampEnable = reader.ReadBool();
+        fixedFunction.depthBiasEnable = reader.ReadBool();
+        fixedFunction.depthBiasConstant = reader.Read<float>();
+        fixedFunction.depthBiasClamp = reader.Read<float>();
+        fixedFunction.depthBiasSlope = reader.Read<float>();
+        fixedFunction.cullFrontFace = reader.ReadBool();
+        fixedFunction.cullBackFace = reader.ReadBool();
+
+        ShaderPassDescription::SampleShadingSettings sampleShading;
+        sampleShading.sampleShadingEnable = reader.ReadBool();
+        sampleShading.forceCenterSample = reader.ReadBool();
+        sampleShading.sampleShadingMask = reader.Read<uint32_t>();
+
+        ShaderPassDescription::WorkGroupSettings workGroup;
+        for (uint32_t& localSize : workGroup.localSize)
+            localSize = reader.Read<uint32_t>();
+        workGroup.perTileDispatch = reader.ReadBool();
+
+        ShaderPassDescription::RayTracingSettings rayTracing;
+        rayTracing.maxRayRecursionDepth = reader.Read<uint32_t>();
+
+        std::vector<uint32_t> vertexFormatBindings;
+        vertexFormatBindings.resize(reader.ReadCount(sizeof(uint32_t)));
+        for (uint32_t& binding : vertexFormatBindings)
+            binding = reader.Read<uint32_t>();
+
+        std::vector<SpecializationConstantDescription> constants;
+        const uint32_t numConstants = reader.ReadCount();
+        constants.reserve(numConstants);
+        for (uint32_t i = 0; i < numConstants; ++i)
+        {
+            std::string name = reader.ReadString();
+            const uint32_t constantIndex = reader.Read<uint32_t>();
+            const auto type = reader.Read<VertexFormat::Element::ElementType::t>();
+            constants.push_back(SpecializationConstantDescription{ std::move(name), constantIndex, type });
+        }
+
+        std::vector<CreateSamplerObjectInfo> rootSamplers;
+        rootSamplers.resize(reader.ReadCount());
+        for (auto& sampler : rootSamplers)
+        {
+            sampler.Mode = reader.Read<SamplerAddressMode>();
+            sampler.Filter = reader.Read<SamplerFilter>();
+            sampler.MipFilter = reader.Read<SamplerFilter>();
+            sampler.BorderColor = reader.Read<SamplerBorderColor>();
+            sampler.UnnormalizedCoordinates = reader.ReadBool();
+            sampler.MipBias = reader.Read<float>();
+            sampler.MinLod = reader.Read<float>();
+            sampler.MaxLod = reader.Read<float>();
+            sampler.Anisotropy = reader.Read<float>();
+        }
+
+        return ShaderPassDescription(std::move(sets), std::move(outputs), std::move(taskName), std::move(meshName), std::move(computeName), std::move(vertexName), std::move(fragmentName),
+                                     std::move(rayGenerationName), std::move(rayClosestHitName), std::move(rayAnyHitName), std::move(rayMissName),
+                                     std::move(fixedFunction), std::move(sampleShading), std::move(workGroup), std::move(rayTracing),
+                                     std::move(vertexFormatBindings), std::move(constants), std::move(rootSamplers));
+    }
+
+    void WriteShaderDescription(BundleWriter& writer, const ShaderDescription& shaderDescription)
+    {
+        writer.Write((uint32_t)shaderDescription.m_vertexFormats.size());
+        for (const auto& vertexFormat : shaderDescription.m_vertexFormats)
+        {
+            writer.Write(vertexFormat.span);
+            writer.Write(vertexFormat.inputRate);
+            writer.Write((uint32_t)vertexFormat.elements.size());
+            for (const auto& element : vertexFormat.elements)
+            {
+                writer.Write(element.offset);
+                writer.Write(VertexFormat::Element::ElementType::t(element.type));
+            }
+            writer.Write((uint32_t)vertexFormat.elementIds.size());
+            for (const auto& elementId : vertexFormat.elementIds)
+                writer.Write(elementId);
+        }
+
+        writer.Write((uint32_t)shaderDescription.m_descriptionPerPass.size());
+        for (const auto& pass : shaderDescription.m_descriptionPerPass)
+            WriteShaderPassDescription(writer, pass);
+
+        writer.Write((uint32_t)shaderDescription.m_passNameToIndex.size());
+        for (const auto& [passName, passIdx] : shaderDescription.m_passNameToIndex)
+        {
+            writer.Write(passName);
+            writer.Write(passIdx);
+        }
+    }
+
+    std::optional<ShaderDescription> ReadShaderDescription(BundleReader& reader)
+    {
+        std::vector<VertexFormat> vertexFormats;
+        const uint32_t numVertexFormats = reader.ReadCount();
+        vertexFormats.reserve(numVertexFormats);
+        for (uint32_t i = 0; i < numVertexFormats; ++i)
+        {
+            const uint32_t span = reader.Read<uint32_t>();
+            const auto inputRate = reader.Read<VertexFormat::eInputRate>();
+            std::vector<VertexFormat::Element> elements;
+            const uint32_t numElements = reader.ReadCount(sizeof(uint32_t) * 2);
+            elements.reserve(numElements);
+            for (uint32_t e = 0; e < numElements; ++e)
+            {
+                const uint32_t offset = reader.Read<uint32_t>();
+                const auto type = reader.Read<VertexFormat::Element::ElementType::t>();
+                elements.emplace_back(VertexFormat::Element{ offset, type });
+            }
+            std::vector<std::string> elementIds;
+            elementIds.resize(reader.ReadCount(sizeof(uint32_t)));
+            for (auto& elementId : elementIds)
+                elementId = reader.ReadString();
+            vertexFormats.emplace_back(VertexFormat{ span, inputRate, std::move(elements), std::move(elementIds) });
+        }
+
+        std::vector<ShaderPassDescription> passes;
+        const uint32_t numPasses = reader.ReadCount();
+        passes.reserve(numPasses);
+        for (uint32_t i = 0; i < numPasses && !reader.Failed(); ++i)
+            passes.emplace_back(ReadShaderPassDescription(reader));
+
+        ShaderDescription shaderDescription{ std::move(vertexFormats), std::move(passes), {}, false };
+        const uint32_t numPassNames = reader.ReadCount();
+        for (uint32_t i = 0; i < numPassNames; ++i)
+        {
+            std::string passName = reader.ReadString();
+            const uint32_t passIdx = reader.Read<uint32_t>();
+            if (passIdx >= shaderDescription.m_descriptionPerPass.size())
+                return std::nullopt;
+            shaderDescription.m_passNameToIndex.try_emplace(std::move(passName), passIdx);
+        }
+
+        if (reader.Failed())
+            return std::nullopt;
+        return std::make_optional(std::move(shaderDescription));
+    }
+}
+
+
+uint32_t ShaderBundle::HashSource(std::span<const char> sourceData)
+{
+    return crc32c(0, std::string_view(sourceData.data(), sourceData.size()));
+}
+
+bool ShaderBundle::Load(AssetManager& assetManager, const std::string& filename, bool verifySources)
+{
+    Release();
+    if (!assetManager.MapFile(filename, m_File))
+    {
+        LOGE("ShaderBundle - unable to load \"%s\"", filename.c_str());
+        return false;
+    }
+
+    BundleReader reader({ m_File.data(), m_File.size() });
+    if (reader.Read<uint32_t>() != cMagic || reader.Read<uint32_t>() != cVersion)
+    {
+        LOGE("ShaderBundle - \"%s\" is not a shader bundle (or is a different version)", filename.c_str());
+        Release();
+        return false;
+    }
+    const uint32_t numShaders = reader.ReadCount();
+    const uint32_t numModules = reader.ReadCount();
+
+    struct IndexEntry { std::string name; std::string sourceFilename; uint64_t sourceSize; uint32_t sourceHash; uint64_t offset; uint64_t size; };
+    auto readIndex = [&reader](uint32_t numEntries) {
+        std::vector<IndexEntry> entries;
+        entries.reserve(numEntries);
+        for (uint32_t i = 0; i < numEntries && !reader.Failed(); ++i)
+        {
+            auto& entry = entries.emplace_back();
+            entry.name = reader.ReadString();
+            entry.sourceFilename = reader.ReadString();
+            entry.sourceSize = reader.Read<uint64_t>();
+            entry.sourceHash = reader.Read<uint32_t>();
+            entry.offset = reader.Read<uint64_t>();
+            entry.size = reader.Read<uint64_t>();
+        }
+        return entries;
+    };
+    const auto shaderEntries = readIndex(numShaders);
+    const auto moduleEntries = readIndex(numModules);
+    reader.Align(sizeof(uint32_t));
+
+    const size_t dataOffset = reader.Position();
+    if (reader.Failed() || dataOffset > m_File.size())
+    {
+        LOGE("ShaderBundle - \"%s\" index is corrupt", filename.c_str());
+        Release();
+        return false;
+    }
+
+    for (const auto* pEntries : { &shaderEntries, &moduleEntries })
+        for (const auto& entry : *pEntries)
+            m_Sources.push_back({ entry.sourceFilename, entry.sourceSize, entry.sourceHash });
+
+    // A bundle built from different sources would silently serve old shaders, reject it (so the application falls back to the sources, or rebuilds the bundle).
+    if (verifySources)
+    {
+        for (const auto& source : m_Sources)
+        {
+            size_t sourceSize = 0;
+            if (!assetManager.GetFileSize(source.filename, sourceSize) || sourceSize != source.size)
+            {
+                LOGW("ShaderBundle - \"%s\" is stale (\"%s\" is missing or has changed since the bundle was built)", filename.c_str(), source.filename.c_str());
+                Release();
+                return false;
+            }
+        }
+    }
+    const std::span<const char> data{ m_File.data() + dataOffset, m_File.size() - dataOffset };
+
+    auto addEntries = [&data](const std::vector<IndexEntry>& entries, auto& entryMap) {
+        for (const auto& entry : entries)
+        {
+            if (entry.offset > data.size() || entry.size > data.size() - entry.offset)
+                return false;
+            entryMap.try_emplace(entry.name, data.subspan((size_t)entry.offset, (size_t)entry.size));
+        }
+        return true;
+    };
+    if (!addEntries(shaderEntries, m_Descriptions) || !addEntries(moduleEntries, m_Modules))
+    {
+        LOGE("ShaderBundle - \"%s\" is truncated", filename.c_str());
+        Release();
+        return false;
+    }
+    return true;
+}
+
+bool ShaderBundle::VerifySourceHashes(AssetManager& assetManager) const
+{
+    std::vector<char> sourceData;
+    for (const auto& source : m_Sources)
+    {
+        sourceData.clear();
+        if (!assetManager.LoadFileIntoMemory(source.filename, sourceData) || sourceData.size() != source.size || HashSource(sourceData) != source.hash)
+        {
+            LOGW("ShaderBundle - \"%s\" is missing or has changed since the bundle was built", source.filename.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void ShaderBundle::Release()
+{
+    m_Descriptions.clear();
+    m_Modules.clear();
+    m_Sources.clear();
+    m_File.Release();
+}
+
+std::vector<std::string> ShaderBundle::GetShaderNames() const
+{
+    std::vector<std::string> shaderNames;
+    shaderNames.reserve(m_Descriptions.size());
+    for (const auto& it : m_Descriptions)
+        shaderNames.push_back(it.first);
+    return shaderNames;
+}
+
+std::optional<ShaderDescription> ShaderBundle::GetShaderDescription(const std::string& shaderName) const
+{
+    auto it = m_Descriptions.find(shaderName);
+    if (it == m_Descriptions.end())
+        return std::nullopt;
+    BundleReader reader(it->second);
+    auto shaderDescription = ReadShaderDescription(reader);
+    if (!shaderDescription)
+        LOGE("ShaderBundle - description of shader \"%s\" is corrupt", shaderName.c_str());
+    return shaderDescription;
+}
+
+std::span<const uint32_t> ShaderBundle::GetShaderModuleCode(const std::string& moduleName) const
+{
+    auto it = m_Modules.find(moduleName);
+    if (it == m_Modules.end())
+        return {};
+    // Module data is 4 byte aligned in the file (and mappings/allocations are at least 4 byte aligned).
+    return { reinterpret_cast<const uint32_t*>(it->second.data()), it->second.size() / sizeof(uint32_t) };
+}
+
+
+bool ShaderBundleWriter::AddShader(AssetManager& assetManager, const std::string& shaderName, const std::string& filename)
+{
+    auto shaderDescription = ShaderDescriptionLoader::Load(assetManager, filename);
+    if (!shaderDescription)
+    {
+        LOGE("ShaderBundleWriter - unable to load shader description \"%s\"", filename.c_str());
+        return false;
+    }
+
+    // Grab all the shader modules this shader references (modules shared between shaders are only stored once).
+    for (const auto& pass : shaderDescription->m_descriptionPerPass)
+    {
+        for (const std::string* pModuleName : { &pass.m_taskName, &pass.m_meshName, &pass.m_computeName, &pass.m_vertexName, &pass.m_fragmentName,
+                                                &pass.m_rayGenerationName, &pass.m_rayClosestHitName, &pass.m_rayAnyHitName, &pass.m_rayMissName })
+        {
+            if (pModuleName->empty() || m_Modules.contains(*pModuleName))
+                continue;
+            std::vector<char> moduleData;
+            if (!assetManager.LoadFileIntoMemory(*pModuleName, moduleData))
+            {
+                LOGE("ShaderBundleWriter - unable to load shader module \"%s\" (used by \"%s\")", pModuleName->c_str(), filename.c_str());
+                return false;
+            }
+            const uint32_t moduleHash = ShaderBundle::HashSource(moduleData);
+            const uint64_t moduleSize = moduleData.size();
+            m_Modules.try_emplace(*pModuleName, Entry{ *pModuleName, moduleSize, moduleHash, std::move(moduleData) });
+        }
+    }
+
+    // Size and hash the json description, so ShaderBundle can tell when it has changed
+    std::vector<char> sourceData;
+    if (!assetManager.LoadFileIntoMemory(filename, sourceData))
+    {
+        LOGE("ShaderBundleWriter - unable to load shader description \"%s\"", filename.c_str());
+        return false;
+    }
+
+    Entry entry{ filename, sourceData.size(), ShaderBundle::HashSource(sourceData), {} };
+    BundleWriter writer(entry.data);
+    WriteShaderDescription(writer, *shaderDescription);
+    if (!m_Descriptions.try_emplace(shaderName, std::move(entry)).second)
+    {
+        LOGE("ShaderBundleWriter - duplicate shader name \"%s\"", shaderName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ShaderBundleWriter::Save(AssetManager& assetManager, const std::string& filename) const
+{
+    // Lay out the data (descriptions then modules) so the index can be written with its final offsets.
+    std::vector<char> data;
+    BundleWriter dataWriter(data);
+    struct IndexEntry { const std::string* pName; const Entry* pEntry; uint64_t offset; };
+    std::vector<IndexEntry> shaderEntries;
+    std::vector<IndexEntry> moduleEntries;
+    for (const auto& [shaderName, description] : m_Descriptions)
+    {
+        shaderEntries.push_back({ &shaderName, &description, data.size() });
+        data.insert(data.end(), description.data.begin(), description.data.end());
+    }
+    for (const auto& [moduleName, module] : m_Modules)
+    {
+        dataWriter.Align(sizeof(uint32_t));
+        moduleEntries.push_back({ &moduleName, &module, data.size() });
+        data.insert(data.end(), module.data.begin(), module.data.end());
+    }
+
+    std::vector<char> fileData;
+    BundleWriter writer(fileData);
+    writer.Write(ShaderBundle::cMagic);
+    writer.Write(ShaderBundle::cVersion);
+    writer.Write((uint32_t)shaderEntries.size());
+    writer.Write((uint32_t)moduleEntries.size());
+    for (const auto* pEntries : { &shaderEntries, &moduleEntries })
+    {
+        for (const auto& entry : *pEntries)
+        {
+            writer.Write(*entry.pName);
+            writer.Write(entry.pEntry->sourceFilename);
+            writer.Write(entry.pEntry->sourceSize);
+            writer.Write(entry.pEntry->sourceHash);
+            writer.Write(entry.offset);
+            writer.Write((uint64_t)entry.pEntry->data.size());
+        }
+    }
+    writer.Align(sizeof(uint32_t));
+    fileData.insert(fileData.end(), data.begin(), data.end());
+
+    if (!assetManager.SaveMemoryToFile(filename, fileData))
+    {
+        LOGE("ShaderBundleWriter - unable to save \"%s\"", filename.c_str());
+        return false;
+    }
+    LOGI("ShaderBundleWriter - saved \"%s\" (%zu shaders, %zu shader modules, %zu bytes)", filename.c_str(), shaderEntries.size(), moduleEntries.size(), fileData.size());
+    return true;
+}
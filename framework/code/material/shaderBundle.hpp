@@ -0,0 +1,108 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include "system/assetManager.hpp"
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Forward declarations
+class ShaderDescription;
+
+
+/// Packed set of shaders: pre-parsed ShaderDescriptions (in a flat binary form) and all the shader module binaries (SPIR-V) they reference, in a single file.
+/// Loading a bundle is a single (memory mapped) file read and no json parsing; see ShaderManagerBase::AddShaderBundle.
+/// Bundles are created (offline or by a 'first run') with ShaderBundleWriter.
+/// The bundle index has the size and a content hash of every source file (json description and shader module) it was built from.  Load can (cheaply) check
+/// the sizes to reject a stale bundle without reading the sources; tools and build steps can check the hashes (VerifySourceHashes) to decide when to rebuild.
+/// If neither is checked the bundle must be rebuilt whenever a shader changes.
+/// @ingroup Material
+class ShaderBundle
+{
+    ShaderBundle(const ShaderBundle&) = delete;
+    ShaderBundle& operator=(const ShaderBundle&) = delete;
+public:
+    ShaderBundle() noexcept = default;
+
+    static constexpr uint32_t cMagic = 0x44424853;  // 'SHBD'
+    static constexpr uint32_t cVersion = 3;         // bump when the ShaderDescription serialization (or bundle layout) changes
+
+    /// @brief Map the bundle file and read its index.
+    /// @param verifySources check every source file the bundle was built from still exists with the same size (opens, but does not read, each source file).
+    /// Catches most shader changes during development; applications that do not ship the sources must leave this false.
+    /// @return true on success (false if the file is missing, not a bundle, a different version, or verifySources is set and a source file is missing or a different size)
+    bool Load(AssetManager& assetManager, const std::string& filename, bool verifySources = false);
+
+    /// @brief Check the content hash of every source file the (loaded) bundle was built from.  Reads every source file, so intended for tools and build steps deciding whether to rebuild the bundle.
+    /// @return true if every source file matches
+    bool VerifySourceHashes(AssetManager& assetManager) const;
+
+    /// Content hash of a bundle source file (as stored in the bundle index)
+    static uint32_t HashSource(std::span<const char> sourceData);
+
+    /// Unmap the bundle (any spans returned by GetShaderModuleCode are no longer valid).
+    void Release();
+
+    /// @return names of the shaders in this bundle (the names they were added to the ShaderBundleWriter with)
+    std::vector<std::string> GetShaderNames() const;
+
+    /// @brief Rebuild the ShaderDescription of the named shader from the bundle
+    /// @return description, or nullopt if the shader is not in the bundle (or its data is corrupt)
+    std::optional<ShaderDescription> GetShaderDescription(const std::string& shaderName) const;
+
+    /// @param moduleName shader module file name (as referenced by the ShaderPassDescription, eg m_vertexName)
+    /// @return shader binary (pointing in to the mapped bundle), empty if the module is not in the bundle
+    std::span<const uint32_t> GetShaderModuleCode(const std::string& moduleName) const;
+
+private:
+    /// File a bundle entry was built from
+    struct Source
+    {
+        std::string     filename;
+        uint64_t        size = 0;
+        uint32_t        hash = 0;
+    };
+
+    AssetMappedFile                                             m_File;
+    std::vector<Source>                                         m_Sources;
+    std::map<std::string, std::span<const char>, std::less<>>   m_Descriptions;
+    std::map<std::string, std::span<const char>, std::less<>>   m_Modules;
+};
+
+
+/// Builds a ShaderBundle file from shader json descriptions (and the shader modules they reference).
+/// @ingroup Material
+class ShaderBundleWriter
+{
+public:
+    /// @brief Load the (json) shader description and all the shader modules it references and add them to the bundle.
+    /// @param shaderName name the shader will be registered with (by ShaderManagerBase::AddShaderBundle)
+    /// @param filename json shader description file (same as would be passed to ShaderManagerBase::AddShader)
+    /// @return true on success
+    bool AddShader(AssetManager& assetManager, const std::string& shaderName, const std::string& filename);
+
+    /// @brief Write the bundle file.
+    /// @return true on success
+    bool Save(AssetManager& assetManager, const std::string& filename) const;
+
+private:
+    struct Entry
+    {
+        std::string         sourceFilename;     ///< file the data came from (json description or shader module)
+        uint64_t            sourceSize = 0;     ///< size (bytes) of that file
+        uint32_t            sourceHash = 0;     ///< ShaderBundle::HashSource of that file
+        std::vector<char>   data;
+    };
+    std::map<std::string, Entry>    m_Descriptions;     ///< serialized ShaderDescription, by shader name
+    std::map<std::string, Entry>    m_Modules;          ///< shader binary, by module file name
+};
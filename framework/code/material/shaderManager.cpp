@@ -7,6 +7,7 @@
 //============================================================================================================
 
 #include "shaderManager.hpp"
+#include "shaderBundle.hpp"
 #include "shaderDescription.hpp"
 #include "shaderModule.hpp"
 #include "shader.hpp"
@@ -59,6 +60,32 @@ bool ShaderManagerBase::AddShader(
     return AddShader(assetManager, shaderName, filename.string(), source_dir);
 }
 
+bool ShaderManagerBase::AddShaderBundle(
+    AssetManager& assetManager,
+    const std::string& bundleFilename,
+    bool verifySources)
+{
+    ShaderBundle shaderBundle;
+    if (!shaderBundle.Load(assetManager, bundleFilename, verifySources))
+    {
+        return false;
+    }
+
+    bool success = true;
+    m_pShaderBundle = &shaderBundle;
+    for (const auto& shaderName : shaderBundle.GetShaderNames())
+    {
+        auto shaderDescription = shaderBundle.GetShaderDescription(shaderName);
+        if (!shaderDescription || !AddShader(assetManager, shaderName, std::move(*shaderDescription)))
+        {
+            LOGE("ShaderManager::AddShaderBundle - unable to add shader \"%s\" from \"%s\"", shaderName.c_str(), bundleFilename.c_str());
+            success = false;
+        }
+    }
+    m_pShaderBundle = nullptr;  // shader modules have copied what they need, bundle is unmapped on return
+    return success;
+}
+
 //const ShaderDescription* ShaderManagerBase::GetShaderDescription(const std::string& shaderName) const
 //{
 //    auto it = m_shaderDescriptionsByName.find(shaderName);
@@ -18,6 +18,7 @@ class AssetManager;
 class GraphicsApiBase;
 class ShaderDescription;
 class ShaderBase;
+class ShaderBundle;
 class ShaderModuleBase;
 template<typename T_GFXAPI> class ShaderManager;
 
@@ -50,6 +51,13 @@ public:
 	/// @return true if everything loaded correctly.
 	bool AddShader(AssetManager& assetManager, const std::string& shaderName, const std::filesystem::path& filename, const std::filesystem::path& source_dir = std::filesystem::path());
 
+	/// @brief Load all the shaders (and their shader modules) from a shader bundle (built with ShaderBundleWriter) with a single file read and no json parsing.
+	/// Each shader is registered with the name it was given when added to the bundle.  Shader modules missing from the bundle are loaded from file.
+	/// @param bundleFilename name of the shader bundle file.
+	/// @param verifySources reject the bundle if any of the json descriptions or shader modules it was built from have changed (see ShaderBundle::Load).
+	/// @return true if everything loaded correctly (false if the bundle could not be loaded or is stale, in which case the application can fall back to AddShader).
+	bool AddShaderBundle(AssetManager& assetManager, const std::string& bundleFilename, bool verifySources = false);
+
 	// Get ShaderBase for the given shader name
 	/// @returns nullptr if shaderName unknown
 	const ShaderBase* GetShader(const std::string& shaderName) const;
@@ -59,6 +67,7 @@ protected:
 
 protected:
     GraphicsApiBase& m_GraphicsApi;
+	const ShaderBundle*                                     m_pShaderBundle = nullptr;	// Bundle shader modules are loaded from (only set during AddShaderBundle)
 	std::map<const std::string, ShaderDescription>          m_shaderDescriptionsByName;	// Contains descriptions (module names, inputs etc) for all the passes of a given 'shader'
 	std::map<std::string, std::unique_ptr<ShaderModuleBase>>    m_shaderModulesByName;	    // Contains the ShaderModule (one per hardware shader program)
 	std::map<std::string, std::unique_ptr<ShaderBase>>          m_shadersByName;			// Contains all the passes of a given ShaderBase (this contains what is described by m_shaderDescriptionsByName although is not the material)
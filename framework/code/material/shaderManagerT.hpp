@@ -208,7 +208,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
             // Create the unique_ptr object (is not already loaded)
             auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
             // Load the physical shader file
-            if (!pShaderModule->Load( rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Mesh ))
+            if (!pShaderModule->Load( rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Mesh, m_pShaderBundle ))
             {
                 // Failed to load, remove the unloaded Shader class!
                 m_shaderModulesByName.erase( shaderPassDescription.m_meshName );
@@ -230,7 +230,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
             // Create the unique_ptr object (is not already loaded)
             auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
             // Load the physical shader file
-            if (!pShaderModule->Load( rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Fragment ))
+            if (!pShaderModule->Load( rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Fragment, m_pShaderBundle ))
             {
                 // Failed to load, remove the unloaded Shader class!
                 m_shaderModulesByName.erase( shaderPassDescription.m_fragmentName );
@@ -249,7 +249,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
                 // Create the unique_ptr object (is not already loaded)
                 auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
                 // Load the physical shader file
-                if (!pShaderModule->Load( rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Task ))
+                if (!pShaderModule->Load( rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Task, m_pShaderBundle ))
                 {
                     // Failed to load, remove the unloaded Shader class!
                     m_shaderModulesByName.erase( shaderPassDescription.m_taskName );
@@ -279,7 +279,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
             // Create the unique_ptr object (is not already loaded)
             auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
             // Load the physical shader file
-            if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Vertex))
+            if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Vertex, m_pShaderBundle))
             {
                 // Failed to load, remove the unloaded ShaderBase class!
                 m_shaderModulesByName.erase(shaderPassDescription.m_vertexName);
@@ -302,7 +302,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
                 // Create the unique_ptr object (is not already loaded)
                 auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
                 // Load the physical shader file
-                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Fragment))
+                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Fragment, m_pShaderBundle))
                 {
                     // Failed to load, remove the unloaded ShaderBase class!
                     m_shaderModulesByName.erase(shaderPassDescription.m_fragmentName);
@@ -324,7 +324,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
             // Create the unique_ptr object (is not already loaded)
             auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
             // Load the physical shader file
-            if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Compute))
+            if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::Compute, m_pShaderBundle))
             {
                 // Failed to load, remove the unloaded ShaderBase class!
                 m_shaderModulesByName.erase(shaderPassDescription.m_computeName);
@@ -344,7 +344,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
             // Create the unique_ptr object (is not already loaded)
             auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
             // Load the physical shader file
-            if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayGeneration))
+            if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayGeneration, m_pShaderBundle))
             {
                 // Failed to load, remove the unloaded ShaderBase class!
                 m_shaderModulesByName.erase(shaderPassDescription.m_rayGenerationName);
@@ -366,7 +366,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
                 // Create the unique_ptr object (is not already loaded)
                 auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
                 // Load the physical shader file
-                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayClosestHit))
+                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayClosestHit, m_pShaderBundle))
                 {
                     // Failed to load, remove the unloaded ShaderBase class!
                     m_shaderModulesByName.erase(shaderPassDescription.m_rayClosestHitName);
@@ -384,7 +384,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
                 // Create the unique_ptr object (is not already loaded)
                 auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
                 // Load the physical shader file
-                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayAnyHit))
+                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayAnyHit, m_pShaderBundle))
                 {
                     // Failed to load, remove the unloaded ShaderBase class!
                     m_shaderModulesByName.erase(shaderPassDescription.m_rayAnyHitName);
@@ -402,7 +402,7 @@ std::optional<ShaderModules<T_GFXAPI>> ShaderManager<T_GFXAPI>::LoadShaderModule
                 // Create the unique_ptr object (is not already loaded)
                 auto pShaderModule = std::make_unique<ShaderModule<T_GFXAPI>>();
                 // Load the physical shader file
-                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayMiss))
+                if (!pShaderModule->Load(rGfxApi, assetManager, shaderPassDescription, ShaderModuleBase::ShaderType::RayMiss, m_pShaderBundle))
                 {
                     // Failed to load, remove the unloaded ShaderBase class!
                     m_shaderModulesByName.erase(shaderPassDescription.m_rayMissName);
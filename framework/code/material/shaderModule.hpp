@@ -16,6 +16,7 @@
 // Forward declarations
 class AssetManager;
 class DescriptorSetLayoutBase;
+class ShaderBundle;
 class ShaderPassDescription;
 class VertexDescription;
 class VertexFormat;
@@ -57,13 +58,13 @@ public:
     /// Free up the vkShaderModule resource.
     void Destroy(T_GFXAPI&) = delete;
 
-    /// Load the shader binary with the given shader name
+    /// Load the shader binary with the given shader name (from pShaderBundle if it contains the shader, otherwise from file)
     /// @returns true on success
-    bool Load(T_GFXAPI& vulkan, AssetManager& assetManager, const std::string& filename);
+    bool Load(T_GFXAPI& vulkan, AssetManager& assetManager, const std::string& filename, const ShaderBundle* pShaderBundle = nullptr);
 
     /// Load the shader binary for the given shader type (using ShaderPassDescription to get the appropriate shader name).
     /// @returns true on success
-    bool Load(T_GFXAPI&, AssetManager&, const ShaderPassDescription&, const ShaderType);
+    bool Load(T_GFXAPI&, AssetManager&, const ShaderPassDescription&, const ShaderType, const ShaderBundle* pShaderBundle = nullptr);
 
     static_assert(sizeof(ShaderModule<T_GFXAPI>) != sizeof(ShaderModuleBase));   // Ensure this class template is specialized (and not used as-is)
 };
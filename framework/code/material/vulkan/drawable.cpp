@@ -32,7 +32,7 @@ Drawable<Vulkan>::~Drawable()
 }
 
 template<>
-bool Drawable<Vulkan>::ReInit( std::span<const RenderContext> renderContexts, uint32_t passMask )
+bool Drawable<Vulkan>::ReInit( std::span<const RenderContext> renderContexts, uint32_t passMask, PipelineBatch* pPipelineBatch )
 {
     mPassMask = passMask;
     mPassNameToIndex.clear();
@@ -116,7 +116,7 @@ bool Drawable<Vulkan>::ReInit( std::span<const RenderContext> renderContexts, ui
             {
                 indexBuffer = mMeshObject.m_IndexBuffer->GetVkBuffer();
                 indexBufferType = mMeshObject.m_IndexBuffer->GetVkIndexType();
-                indexCount = mMeshObject.m_IndexBuffer->GetNumIndices();
+                indexCount = mMeshObject.m_Lods.empty() ? mMeshObject.m_IndexBuffer->GetNumIndices() : mMeshObject.m_Lods[0].numIndices;
             }
 
             // Indirect Draw buffer is optional
@@ -136,7 +136,8 @@ bool Drawable<Vulkan>::ReInit( std::span<const RenderContext> renderContexts, ui
                 // We (probably) have a valid pipeline we can (re)use
                 pipeline = !renderContext.IsDynamic() ? renderContext.GetOverridePipeline() : Pipeline();
             }
-            if (!pipeline)
+            const bool batchPipeline = !pipeline && pPipelineBatch;
+            if (!pipeline && !batchPipeline)
             {
                 PipelineRasterizationState<Vulkan> pipelineRasterizationState { shaderPass.m_shaderPassDescription };
                 pipeline = CreatePipeline( mGfxApi, shaderPass.m_shaderPassDescription, pipelineLayout, shaderPass.GetPipelineVertexInputState(), pipelineRasterizationState, pMaterialPass->GetSpecializationConstants(), shaderPass.m_shaders, renderContext, renderContext.msaa);
@@ -160,6 +161,11 @@ bool Drawable<Vulkan>::ReInit( std::span<const RenderContext> renderContexts, ui
                                                         (uint32_t)drawIndirectOffset,
                                                         passIdx
                                                       );
+            if (batchPipeline)
+            {
+                // Pipeline is created (in to the DrawablePass) when the batch is compiled.  mPasses was reserved up-front so 'pass' does not move.
+                pPipelineBatch->Add( &pass.mPipeline, shaderPass.m_shaderPassDescription, pipelineLayout, shaderPass.GetPipelineVertexInputState(), pMaterialPass->GetSpecializationConstants(), shaderPass.m_shaders, renderContext, renderContext.msaa );
+            }
         }
     }
     return true;
@@ -315,8 +321,9 @@ void Drawable<Vulkan>::DrawPass(CommandList& cmdBuffer, const DrawablePass& draw
             }
             else
             {
-                // Everything is set up, draw the mesh
-                vkCmdDrawIndexed(vkCmdBuffer, drawablePass.mNumIndices, GetInstances() ? (uint32_t)GetInstances()->GetNumVertices() : 1, 0, 0, 0);
+                // Everything is set up, draw the mesh (current level of detail)
+                const auto* pLod = mMeshObject.m_Lods.empty() ? nullptr : &mMeshObject.m_Lods[mLod];
+                vkCmdDrawIndexed(vkCmdBuffer, pLod ? pLod->numIndices : drawablePass.mNumIndices, GetInstances() ? (uint32_t)GetInstances()->GetNumVertices() : 1, pLod ? pLod->firstIndex : 0, 0, 0);
             }
         }
         else
@@ -16,6 +16,7 @@
 #include "memory/vulkan/indexBufferObject.hpp"
 #include "memory/vulkan/vertexBufferObject.hpp"
 #include "pipeline.hpp"
+#include "pipelineBatch.hpp"
 #include "pipelineVertexInputState.hpp"
 #include "vulkan/renderContext.hpp"
 
@@ -10,11 +10,14 @@
 #include "vulkan/renderContext.hpp"
 #include "pipeline.hpp"
 #include "pipelineLayout.hpp"
+#include "pipelineRegistry.hpp"
 #include "pipelineVertexInputState.hpp"
 #include "shader.hpp"
 #include "shaderModule.hpp"
 #include "specializationConstants.hpp"
 #include "../shaderDescription.hpp"
+#include "system/os_common.h"
+#include <optional>
 
 // Forward declarations
 class Vulkan;
@@ -54,6 +57,108 @@ static VkBlendFactor EnumToVk( ShaderPassDescription::BlendFactor bf)
     return VK_BLEND_FACTOR_ZERO;
 }
 
+/// Build the registry key from the (final) Vulkan creation state.
+/// @return key, or nothing if the state has extension structures chained on that the key cannot describe (pipeline should not be shared)
+static std::optional<PipelineStateKey> MakePipelineStateKey( const VkPipelineVertexInputStateCreateInfo& visci,
+                                              uint64_t pipelineLayoutId,
+                                              const RenderContext<Vulkan>& renderingPassContext,
+                                              const VkPipelineRasterizationStateCreateInfo& rs,
+                                              const VkPipelineDepthStencilStateCreateInfo& ds,
+                                              std::span<const VkPipelineColorBlendAttachmentState> blendStates,
+                                              const VkPipelineMultisampleStateCreateInfo& ms,
+                                              bool forceCenterSample,
+                                              std::span<const uint64_t> shaderModuleIds,
+                                              const VkSpecializationInfo* pSpecializationInfo )
+{
+    // ms.pNext is our own sample locations (covered by forceCenterSample), ds is built by CreatePipeline without a pNext chain.
+    if (visci.pNext || rs.pNext)
+        return std::nullopt;
+
+    PipelineStateKey key;
+    for (uint64_t shaderModuleId : shaderModuleIds)
+        key.Add( shaderModuleId );
+    key.Add( pipelineLayoutId );
+
+    key.Add( visci.vertexBindingDescriptionCount );
+    for (const auto& binding : std::span( visci.pVertexBindingDescriptions, visci.vertexBindingDescriptionCount ))
+    {
+        key.Add( binding.binding );
+        key.Add( binding.stride );
+        key.Add( binding.inputRate );
+    }
+    key.Add( visci.vertexAttributeDescriptionCount );
+    for (const auto& attribute : std::span( visci.pVertexAttributeDescriptions, visci.vertexAttributeDescriptionCount ))
+    {
+        key.Add( attribute.location );
+        key.Add( attribute.binding );
+        key.Add( attribute.format );
+        key.Add( attribute.offset );
+    }
+
+    key.Add( rs.depthClampEnable );
+    key.Add( rs.rasterizerDiscardEnable );
+    key.Add( rs.polygonMode );
+    key.Add( rs.cullMode );
+    key.Add( rs.frontFace );
+    key.Add( rs.depthBiasEnable );
+    key.Add( rs.depthBiasConstantFactor );
+    key.Add( rs.depthBiasClamp );
+    key.Add( rs.depthBiasSlopeFactor );
+    key.Add( rs.lineWidth );
+
+    key.Add( ds.depthTestEnable );
+    key.Add( ds.depthWriteEnable );
+    key.Add( ds.depthCompareOp );
+
+    key.Add( blendStates.size() );
+    for (const auto& blendState : blendStates)
+    {
+        key.Add( blendState.blendEnable );
+        key.Add( blendState.srcColorBlendFactor );
+        key.Add( blendState.dstColorBlendFactor );
+        key.Add( blendState.colorBlendOp );
+        key.Add( blendState.srcAlphaBlendFactor );
+        key.Add( blendState.dstAlphaBlendFactor );
+        key.Add( blendState.alphaBlendOp );
+        key.Add( blendState.colorWriteMask );
+    }
+
+    key.Add( ms.rasterizationSamples );
+    key.Add( ms.sampleShadingEnable );
+    key.Add( ms.pSampleMask ? *ms.pSampleMask : ~VkSampleMask( 0 ) );
+    key.Add( forceCenterSample );
+
+    if (pSpecializationInfo)
+    {
+        key.Add( pSpecializationInfo->mapEntryCount );
+        for (const auto& mapEntry : std::span( pSpecializationInfo->pMapEntries, pSpecializationInfo->mapEntryCount ))
+        {
+            key.Add( mapEntry.constantID );
+            key.Add( mapEntry.offset );
+            key.Add( mapEntry.size );
+        }
+        key.AddBytes( pSpecializationInfo->pData, pSpecializationInfo->dataSize );
+    }
+    else
+        key.Add( uint32_t( 0 ) );
+
+    key.Add( renderingPassContext.IsDynamic() );
+    if (renderingPassContext.IsDynamic())
+    {
+        const auto& dynamicContext = std::get<RenderContext<Vulkan>::DynamicRenderContextData>( renderingPassContext.v );
+        key.Add( renderingPassContext.viewMask );
+        key.AddBytes( dynamicContext.colorAttachmentFormats.data(), dynamicContext.colorAttachmentFormats.size() * sizeof( VkFormat ) );
+        key.Add( dynamicContext.depthAttachmentFormat );
+        key.Add( dynamicContext.stencilAttachmentFormat );
+    }
+    else
+    {
+        key.AddRenderPass( renderingPassContext.GetRenderPass().mRenderPass );
+        key.Add( renderingPassContext.subPass );
+    }
+    return key;
+}
+
 template<>
 Pipeline<Vulkan> CreatePipeline( Vulkan& vulkan,
                                  const ShaderPassDescription& shaderPassDescription,
@@ -147,6 +252,7 @@ Pipeline<Vulkan> CreatePipeline( Vulkan& vulkan,
     VkShaderModule vkFragShader = VK_NULL_HANDLE;
     VkShaderModule vkTaskShader = VK_NULL_HANDLE;
     VkShaderModule vkMeshShader = VK_NULL_HANDLE;
+    uint64_t shaderModuleIds[4] = {};   // task, mesh, vert, frag
     std::visit( [&]( auto& m )
                 {
                     using T = std::decay_t<decltype(m)>;
@@ -154,21 +260,29 @@ Pipeline<Vulkan> CreatePipeline( Vulkan& vulkan,
                     {
                         vkVertShader = m.vert.GetVkShaderModule();
                         vkFragShader = m.frag.GetVkShaderModule();
+                        shaderModuleIds[2] = m.vert.GetUniqueId();
+                        shaderModuleIds[3] = m.frag.GetUniqueId();
                     }
                     else if constexpr (std::is_same_v<T, GraphicsShaderModuleVertOnly<Vulkan>>)
                     {
                         vkVertShader = m.vert.GetVkShaderModule();
+                        shaderModuleIds[2] = m.vert.GetUniqueId();
                     }
                     else if constexpr (std::is_same_v<T, GraphicsMeshShaderModules<Vulkan>>)
                     {
                         vkMeshShader = m.mesh.GetVkShaderModule();
                         vkFragShader = m.frag.GetVkShaderModule();
+                        shaderModuleIds[1] = m.mesh.GetUniqueId();
+                        shaderModuleIds[3] = m.frag.GetUniqueId();
                     }
                     else if constexpr (std::is_same_v<T, GraphicsTaskMeshShaderModules<Vulkan>>)
                     {
                         vkTaskShader = m.task.GetVkShaderModule();
                         vkMeshShader = m.mesh.GetVkShaderModule();
                         vkFragShader = m.frag.GetVkShaderModule();
+                        shaderModuleIds[0] = m.task.GetUniqueId();
+                        shaderModuleIds[1] = m.mesh.GetUniqueId();
+                        shaderModuleIds[3] = m.frag.GetUniqueId();
                     }                    
                     else
                     {
@@ -176,6 +290,23 @@ Pipeline<Vulkan> CreatePipeline( Vulkan& vulkan,
                     }
                 }, shaderModules.m_modules );
 
+    // Share an existing pipeline if one was already created with identical state.
+    auto& pipelineRegistry = vulkan.GetPipelineRegistry();
+    const std::optional<PipelineStateKey> pipelineStateKey = MakePipelineStateKey( pipelineVertexInputState.GetVkPipelineVertexInputStateCreateInfo(),
+                                                              pipelineLayout.GetUniqueId(),
+                                                              renderingPassContext,
+                                                              pipelineRasterizationState.mPipelineRasterizationStateCreateInfo,
+                                                              ds,
+                                                              BlendStates,
+                                                              ms,
+                                                              sampleShadingSettings.forceCenterSample,
+                                                              shaderModuleIds,
+                                                              specializationConstants.GetVkSpecializationInfo() );
+    if (!pipelineStateKey)
+        LOGW( "CreatePipeline: rasterization or vertex input state has a pNext chain, pipeline is not shared" );
+    else if (auto existingPipeline = pipelineRegistry.Find( *pipelineStateKey ))
+        return existingPipeline;
+
     VkPipeline pipeline = VK_NULL_HANDLE;
     if (!vulkan.CreatePipeline( vulkan.GetPipelineCache(),
                                 &pipelineVertexInputState.GetVkPipelineVertexInputStateCreateInfo(),
@@ -198,9 +329,13 @@ Pipeline<Vulkan> CreatePipeline( Vulkan& vulkan,
                                 &pipeline))
     {
         // Error
+        if (pipelineStateKey)
+            pipelineRegistry.Add( *pipelineStateKey, {} );
         return {};
     }
-    return Pipeline<Vulkan>(vulkan.m_VulkanDevice, pipeline);
+    if (!pipelineStateKey)
+        return Pipeline<Vulkan>( vulkan.m_VulkanDevice, pipeline );
+    return pipelineRegistry.Add( *pipelineStateKey, Pipeline<Vulkan>( vulkan.m_VulkanDevice, pipeline ) );
 }
 
 void ReleasePipeline(Vulkan& vulkan, Pipeline<Vulkan>& pipeline)
@@ -41,6 +41,8 @@ public:
     operator bool() const { return mPipeline != VK_NULL_HANDLE; }
 
     VkPipeline GetVkPipeline() const { return mPipeline.get(); }
+    /// @return number of Pipeline objects sharing this VkPipeline
+    uint32_t GetRefCount() const { return mPipeline.use_count(); }
 
 private:
     Pipeline( const Pipeline<Vulkan>& src ) noexcept {
@@ -0,0 +1,71 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "pipelineBatch.hpp"
+#include "vulkan/vulkan.hpp"
+#include "vulkan/renderContext.hpp"
+#include "pipelineVertexInputState.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include "../shaderDescription.hpp"
+#include <atomic>
+
+PipelineBatch<Vulkan>::PipelineBatch( Vulkan& vulkan ) noexcept : mVulkan( vulkan )
+{
+}
+
+PipelineBatch<Vulkan>::~PipelineBatch()
+{
+    // Requests that were never compiled (eg the owner bailed out on an error) are dropped, their pipelines are left empty.
+}
+
+void PipelineBatch<Vulkan>::Add( Pipeline<Vulkan>* pOutput,
+                                 const ShaderPassDescription& shaderPassDescription,
+                                 const PipelineLayout<Vulkan>& pipelineLayout,
+                                 const PipelineVertexInputState<Vulkan>& pipelineVertexInputState,
+                                 const SpecializationConstants<Vulkan>& specializationConstants,
+                                 const ShaderModules<Vulkan>& shaderModules,
+                                 const RenderContext<Vulkan>& renderContext,
+                                 Msaa msaa )
+{
+    assert( pOutput );
+    mRequests.push_back( { pOutput, &shaderPassDescription, &pipelineLayout, &pipelineVertexInputState, &specializationConstants, &shaderModules, &renderContext, msaa } );
+}
+
+bool PipelineBatch<Vulkan>::Compile( ThreadWorker& worker )
+{
+    if (mRequests.empty())
+        return true;
+
+    const std::vector<Request> requests = std::move( mRequests );
+    mRequests.clear();
+
+    std::atomic<bool> failed = false;
+    worker.ParallelFor( requests.size(), [&]( size_t requestIdx ) {
+        const auto& request = requests[requestIdx];
+        PipelineRasterizationState<Vulkan> rasterizationState{ *request.pShaderPassDescription };
+        *request.pOutput = CreatePipeline( mVulkan, *request.pShaderPassDescription, *request.pPipelineLayout, *request.pPipelineVertexInputState, rasterizationState,
+                                           *request.pSpecializationConstants, *request.pShaderModules, *request.pRenderContext, request.msaa );
+        if (!*request.pOutput)
+            failed = true;
+    } );
+
+    if (failed)
+    {
+        LOGE( "PipelineBatch: failed to create one or more of %zu pipelines", requests.size() );
+        return false;
+    }
+    return true;
+}
+
+bool PipelineBatch<Vulkan>::Compile()
+{
+    if (mRequests.empty())
+        return true;
+    return Compile( mVulkan.GetPipelineCompileWorker() );
+}
@@ -0,0 +1,74 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include "pipeline.hpp"
+#include <vector>
+
+// Forward declarations
+class ShaderPassDescription;
+class ThreadWorker;
+class Vulkan;
+enum class Msaa;
+template<typename T_GFXAPI> class PipelineLayout;
+template<typename T_GFXAPI> class PipelineVertexInputState;
+template<typename T_GFXAPI> class RenderContext;
+template<typename T_GFXAPI> class ShaderModules;
+template<typename T_GFXAPI> class SpecializationConstants;
+
+
+/// Collects graphics pipeline creation requests and creates them all at once, spread across worker threads
+/// (vkCreateGraphicsPipelines is free threaded, and the framework pipeline cache is internally synchronized).
+/// Each created pipeline is written to the Pipeline<Vulkan> given when the request was added (eg DrawablePass::mPipeline).
+/// Specialization of PipelineBatch<T_GFXAPI>
+/// @ingroup Material
+template<>
+class PipelineBatch<Vulkan> final
+{
+    PipelineBatch( const PipelineBatch<Vulkan>& ) = delete;
+    PipelineBatch& operator=( const PipelineBatch<Vulkan>& ) = delete;
+public:
+    PipelineBatch( Vulkan& vulkan ) noexcept;
+    ~PipelineBatch();
+
+    /// @brief Add a pipeline to be created by Compile (parameters as for CreatePipeline)
+    /// The referenced state must stay alive (and pOutput must not move) until Compile returns.
+    /// @param pOutput pipeline written by Compile (left empty if creation failed)
+    void Add( Pipeline<Vulkan>* pOutput,
+              const ShaderPassDescription& shaderPassDescription,
+              const PipelineLayout<Vulkan>& pipelineLayout,
+              const PipelineVertexInputState<Vulkan>& pipelineVertexInputState,
+              const SpecializationConstants<Vulkan>& specializationConstants,
+              const ShaderModules<Vulkan>& shaderModules,
+              const RenderContext<Vulkan>& renderContext,
+              Msaa msaa );
+
+    /// @brief Create all the added pipelines, on the calling thread and the worker's threads.  Batch is empty afterwards.
+    /// @return true if all pipelines were created
+    bool Compile( ThreadWorker& worker );
+    /// @brief Create all the added pipelines, using the Vulkan pipeline compile worker (see Vulkan::GetPipelineCompileWorker).
+    bool Compile();
+
+    size_t size() const { return mRequests.size(); }
+    bool empty() const { return mRequests.empty(); }
+
+private:
+    struct Request
+    {
+        Pipeline<Vulkan>*                       pOutput;
+        const ShaderPassDescription*            pShaderPassDescription;
+        const PipelineLayout<Vulkan>*           pPipelineLayout;
+        const PipelineVertexInputState<Vulkan>* pPipelineVertexInputState;
+        const SpecializationConstants<Vulkan>*  pSpecializationConstants;
+        const ShaderModules<Vulkan>*            pShaderModules;
+        const RenderContext<Vulkan>*            pRenderContext;
+        Msaa                                    msaa;
+    };
+    Vulkan&                 mVulkan;
+    std::vector<Request>    mRequests;
+};
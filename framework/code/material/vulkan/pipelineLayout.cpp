@@ -8,8 +8,12 @@
 
 #include "pipelineLayout.hpp"
 #include "descriptorSetLayout.hpp"
+#include "pipelineRegistry.hpp"
 #include "vulkan/vulkan.hpp"
 #include "texture/sampler.hpp"
+#include <atomic>
+
+static std::atomic<uint64_t> sNextPipelineLayoutId = 1;
 
 PipelineLayout<Vulkan>::PipelineLayout() noexcept
 {}
@@ -17,7 +21,9 @@ PipelineLayout<Vulkan>::PipelineLayout() noexcept
 PipelineLayout<Vulkan>::PipelineLayout(PipelineLayout<Vulkan>&& other) noexcept
 {
 	m_pipelineLayout = other.m_pipelineLayout;
+	m_uniqueId = other.m_uniqueId;
 	other.m_pipelineLayout = VK_NULL_HANDLE;
+	other.m_uniqueId = 0;
 }
 
 PipelineLayout<Vulkan>::~PipelineLayout()
@@ -31,6 +37,9 @@ void PipelineLayout<Vulkan>::Destroy(Vulkan& vulkan)
 	{
 		vkDestroyPipelineLayout(vulkan.m_VulkanDevice, m_pipelineLayout, nullptr);
 		m_pipelineLayout = VK_NULL_HANDLE;
+		m_uniqueId = 0;
+		// Release registered pipelines that were only being kept for this layout
+		vulkan.GetPipelineRegistry().Prune();
 	}
 }
 
@@ -63,5 +72,6 @@ bool PipelineLayout<Vulkan>::Init(Vulkan& vulkan, const std::span<const VkDescri
 	{
 		return false;
 	}
+	m_uniqueId = sNextPipelineLayoutId++;
 	return true;
 }
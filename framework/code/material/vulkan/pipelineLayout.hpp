@@ -39,6 +39,9 @@ public:
 	void Destroy(Vulkan& vulkan);
 
 	const auto& GetVkPipelineLayout() const { return m_pipelineLayout; }
+	/// @return id of this pipeline layout, never reused (unlike the VkPipelineLayout handle).  0 if not initialized.
+	uint64_t GetUniqueId() const { return m_uniqueId; }
 private:
 	VkPipelineLayout	m_pipelineLayout = VK_NULL_HANDLE;
+	uint64_t			m_uniqueId = 0;
 };
@@ -0,0 +1,89 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "pipelineRegistry.hpp"
+#include "system/crc32c.hpp"
+#include "system/os_common.h"
+#include <cassert>
+
+
+size_t PipelineStateKey::Hasher::operator()( const PipelineStateKey& key ) const
+{
+    return FnvHash32( key.mData );
+}
+
+PipelineRegistry<Vulkan>::~PipelineRegistry()
+{
+    Clear();
+}
+
+Pipeline<Vulkan> PipelineRegistry<Vulkan>::Find( const PipelineStateKey& key )
+{
+    std::unique_lock<std::mutex> lock( mMutex );
+    ++mRequests;
+    for (;;)
+    {
+        auto [it, inserted] = mPipelines.try_emplace( key );
+        if (inserted)
+            return {};  // miss, caller creates the pipeline
+        if (!it->second.pending)
+        {
+            ++mHits;
+            return it->second.pipeline.Copy();
+        }
+        // Another thread is creating this pipeline, wait for it (and look again, creation may have failed and the entry been removed).
+        mPendingCondition.wait( lock );
+    }
+}
+
+Pipeline<Vulkan> PipelineRegistry<Vulkan>::Add( const PipelineStateKey& key, Pipeline<Vulkan> pipeline )
+{
+    Pipeline<Vulkan> registeredPipeline;
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        auto it = mPipelines.find( key );
+        assert( it != mPipelines.end() && it->second.pending );     // expecting Find to have reserved this state
+        if (!pipeline)
+            mPipelines.erase( it );     // failed to create, let the next request try again
+        else
+        {
+            it->second.pipeline = std::move( pipeline );
+            it->second.pending = false;
+            registeredPipeline = it->second.pipeline.Copy();
+        }
+    }
+    mPendingCondition.notify_all();
+    return registeredPipeline;
+}
+
+size_t PipelineRegistry<Vulkan>::Prune()
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+    return std::erase_if( mPipelines, []( const auto& it ) { return !it.second.pending && it.second.pipeline.GetRefCount() == 1; } );
+}
+
+void PipelineRegistry<Vulkan>::Clear()
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+    std::erase_if( mPipelines, []( const auto& it ) { return !it.second.pending; } );
+}
+
+PipelineRegistry<Vulkan>::Stats PipelineRegistry<Vulkan>::GetStats() const
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+    return { mRequests, mHits, mPipelines.size() };
+}
+
+void PipelineRegistry<Vulkan>::LogStats() const
+{
+    const auto stats = GetStats();
+    if (stats.requests == 0)
+        return;
+    LOGI( "Pipeline registry: %llu of %llu pipeline requests shared an existing pipeline (%.1f%% hit rate), %zu unique pipelines registered",
+          (unsigned long long) stats.hits, (unsigned long long) stats.requests, 100.0 * double( stats.hits ) / double( stats.requests ), stats.numPipelines );
+}
@@ -0,0 +1,114 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include "pipeline.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class Vulkan;
+
+
+/// Flattened (byte for byte) copy of everything that goes in to creating a graphics pipeline.
+/// Built by CreatePipeline from the Vulkan create structures, so two keys compare equal only if the pipelines they describe would be identical.
+/// Shader modules and pipeline layouts are stored as their unique ids (handle values can be reused once destroyed).
+/// Render passes are stored by handle value and the key keeps a reference to them, so the handle cannot be reused while the key exists.
+class PipelineStateKey
+{
+public:
+    template<typename T>
+    void Add( const T& value )
+    {
+        static_assert(std::is_scalar_v<T>, "Add structure fields one at a time (avoids hashing padding or pNext pointers)");
+        mData.append( reinterpret_cast<const char*>(&value), sizeof( T ) );
+    }
+    void AddBytes( const void* pData, size_t size )
+    {
+        Add( size );
+        mData.append( static_cast<const char*>(pData), size );
+    }
+    void AddRenderPass( const RefHandle<VkRenderPass>& renderPass )
+    {
+        Add( renderPass.get() );
+        mRenderPasses.push_back( renderPass );
+    }
+
+    bool operator==( const PipelineStateKey& other ) const { return mData == other.mData; }
+
+    struct Hasher
+    {
+        size_t operator()( const PipelineStateKey& key ) const;
+    };
+
+private:
+    std::string                             mData;
+    std::vector<RefHandle<VkRenderPass>>    mRenderPasses;  ///< held (not compared) so the render pass handles in mData stay unique
+};
+
+
+/// Registry of created graphics pipelines, keyed by their full creation state (@ref PipelineStateKey).
+/// Pipeline creation requests (through CreatePipeline) with state identical to an existing pipeline get a (ref counted) copy of that pipeline
+/// rather than creating a new one, so drawables sharing shader pass, vertex layout, render pass and rasterization settings share one VkPipeline.
+/// Thread safe (CreatePipeline is called from multiple threads by PipelineBatch); a thread requesting state that another thread is already creating waits for that pipeline rather than creating a duplicate.
+/// Registered pipelines (and the render passes their keys hold) are kept until Prune finds nothing else using them.  Prune is called when shader modules,
+/// pipeline layouts or the swapchain render pass are destroyed; applications that recreate their own render passes should call it once the old drawables are released.
+/// Specialization of PipelineRegistry<T_GFXAPI>
+/// @ingroup Material
+template<>
+class PipelineRegistry<Vulkan> final
+{
+    PipelineRegistry( const PipelineRegistry<Vulkan>& ) = delete;
+    PipelineRegistry& operator=( const PipelineRegistry<Vulkan>& ) = delete;
+public:
+    PipelineRegistry() noexcept = default;
+    ~PipelineRegistry();
+
+    struct Stats
+    {
+        uint64_t    requests = 0;       ///< number of Find calls
+        uint64_t    hits = 0;           ///< number of Find calls that returned an existing pipeline
+        size_t      numPipelines = 0;   ///< number of unique pipelines currently registered
+    };
+
+    /// @brief Find the registered pipeline with the given state.
+    /// On a miss the state is reserved for the caller, who MUST then create the pipeline and call Add (with an empty pipeline if creation failed).
+    /// @return copy of the registered pipeline, or an empty pipeline if there is none (counted as a miss)
+    Pipeline<Vulkan> Find( const PipelineStateKey& key );
+
+    /// @brief Register a newly created pipeline (for a state reserved by Find) and wake any threads waiting for it.
+    /// @return the registered pipeline
+    Pipeline<Vulkan> Add( const PipelineStateKey& key, Pipeline<Vulkan> pipeline );
+
+    /// @brief Release the registered pipelines that are no longer being used outside of the registry.
+    /// @return number of pipelines released
+    size_t Prune();
+
+    /// Release all the registered pipelines (pipelines still being used elsewhere are not destroyed until their last user releases them).
+    void Clear();
+
+    Stats GetStats() const;
+    /// Log the hit rate (LOGI)
+    void LogStats() const;
+
+private:
+    struct Entry
+    {
+        Pipeline<Vulkan>    pipeline;
+        bool                pending = true;     ///< being created (by the thread whose Find missed)
+    };
+    mutable std::mutex                                                  mMutex;
+    std::condition_variable                                             mPendingCondition;  ///< signalled when a pending entry is added
+    std::unordered_map<PipelineStateKey, Entry, PipelineStateKey::Hasher> mPipelines;
+    uint64_t                                                            mRequests = 0;
+    uint64_t                                                            mHits = 0;
+};
@@ -7,13 +7,18 @@
 //============================================================================================================
 
 #include "shaderModule.hpp"
+#include "pipelineRegistry.hpp"
+#include <atomic>
 #include <vector>
+#include "material/shaderBundle.hpp"
 #include "material/shaderDescription.hpp"
 #include "vertexDescription.hpp"
 #include "vulkan/vulkan.hpp"
 #include "system/assetManager.hpp"
 
 
+static std::atomic<uint64_t> sNextShaderModuleId = 1;
+
 ShaderModule<Vulkan>::ShaderModule() noexcept : ShaderModuleBase()
     , m_shader(VK_NULL_HANDLE)
 {
@@ -31,11 +36,14 @@ void ShaderModule<Vulkan>::Destroy(Vulkan& vulkan)
     {
         vkDestroyShaderModule(vulkan.m_VulkanDevice, m_shader, nullptr);
         m_shader = VK_NULL_HANDLE;
+        m_uniqueId = 0;
+        // Release registered pipelines that were only being kept for this module
+        vulkan.GetPipelineRegistry().Prune();
     }
     ShaderModuleBase::Destroy();
 }
 
-bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, const std::string& filename)
+bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, const std::string& filename, const ShaderBundle* pShaderBundle)
 {
     bool success = true;
     Destroy(vulkan);
@@ -44,13 +52,17 @@ bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, cons
 
     if (!m_filename.empty())
     {
+        // Use the (already mapped) copy in the shader bundle if there is one, otherwise load the file.
+        std::span<const uint32_t> code = pShaderBundle ? pShaderBundle->GetShaderModuleCode(m_filename) : std::span<const uint32_t>{};
         std::vector<char> data;
-        if ( assetManager.LoadFileIntoMemory(m_filename.c_str(), data) )
+        if ( !code.empty() || assetManager.LoadFileIntoMemory(m_filename.c_str(), data) )
         {
+            if (code.empty())
+                code = { reinterpret_cast<const uint32_t*>(data.data()), data.size() / sizeof(uint32_t) };
             VkShaderModuleCreateInfo createInfo = {};
             createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-            createInfo.codeSize = data.size();
-            createInfo.pCode = reinterpret_cast<const uint32_t*>(data.data());
+            createInfo.codeSize = code.size_bytes();
+            createInfo.pCode = code.data();
             VkShaderModule shaderModule;
             if (vkCreateShaderModule(vulkan.m_VulkanDevice, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
             {
@@ -60,6 +72,7 @@ bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, cons
             else
             {
                 m_shader = shaderModule;
+                m_uniqueId = sNextShaderModuleId++;
             }
             vulkan.SetDebugObjectName(shaderModule, m_filename.c_str());
 
@@ -72,7 +85,7 @@ bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, cons
     return success;
 }
 
-bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, const ShaderPassDescription& shaderDescription, const ShaderType shaderType)
+bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, const ShaderPassDescription& shaderDescription, const ShaderType shaderType, const ShaderBundle* pShaderBundle)
 {
     const std::string* shaderFileName = nullptr;
     switch (shaderType)
@@ -107,5 +120,5 @@ bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, cons
     }
 
     assert(shaderFileName!=nullptr);
-    return Load(vulkan, assetManager, *shaderFileName);    ///TODO: better return code / error handling
+    return Load(vulkan, assetManager, *shaderFileName, pShaderBundle);    ///TODO: better return code / error handling
 }
@@ -18,6 +18,7 @@
 // Forward declarations
 class AssetManager;
 class DescriptorSetLayoutBase;
+class ShaderBundle;
 class ShaderPassDescription;
 class VertexDescription;
 class VertexFormat;
@@ -37,15 +38,18 @@ public:
     /// Free up the vkShaderModule resource.
     void Destroy(Vulkan&);
 
-    /// Load the shader binary with the given shader name
+    /// Load the shader binary with the given shader name (from pShaderBundle if it contains the shader, otherwise from file)
     /// @returns true on success
-    bool Load(Vulkan& vulkan, AssetManager& assetManager, const std::string& filename);
+    bool Load(Vulkan& vulkan, AssetManager& assetManager, const std::string& filename, const ShaderBundle* pShaderBundle = nullptr);
 
     /// Load the shader binary for the given shader type (using ShaderPassDescription to get the appropriate shader name).
     /// @returns true on success
-    bool Load(Vulkan&, AssetManager&, const ShaderPassDescription&, const ShaderType);
+    bool Load(Vulkan&, AssetManager&, const ShaderPassDescription&, const ShaderType, const ShaderBundle* pShaderBundle = nullptr);
 
     const VkShaderModule& GetVkShaderModule() const { return m_shader; }
+    /// @return id of the currently loaded shader module, never reused (unlike the VkShaderModule handle).  0 if nothing is loaded.
+    uint64_t GetUniqueId() const { return m_uniqueId; }
 private:
     VkShaderModule      m_shader;
+    uint64_t            m_uniqueId = 0;
 };
@@ -76,6 +76,25 @@ bool VertexBuffer<Dx12>::Initialize(MemoryManager* pManager, size_t span, size_t
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool VertexBuffer<Dx12>::Initialize(MemoryManager* pManager, size_t span, size_t numVerts, MemoryUsage memoryUsage, const BufferUsageFlags usage )
+{
+    mNumVertices = numVerts;
+    mSpan = span;
+    mDspUsable = false;
+
+    mView = {};
+
+    if (!Buffer<Dx12>::Initialize(pManager, static_cast<size_t>(mSpan * mNumVertices), usage, memoryUsage))
+        return false;
+
+    mView.BufferLocation = mAllocatedBuffer.GetResource()->GetGPUVirtualAddress();
+    mView.SizeInBytes = mNumVertices * mSpan;
+    mView.StrideInBytes = mSpan;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void VertexBuffer<Dx12>::Destroy()
 {
     mView = {};
@@ -30,6 +30,8 @@ public:
     virtual ~VertexBuffer();
 
     bool Initialize(MemoryManager* pManager, size_t span, size_t numVerts, const void* initialData, const bool dspUsable = false, const BufferUsageFlags usage = BufferUsageFlags::Vertex );
+    /// Initialize without initial data, with the given memory usage (eg MemoryUsage::CpuToGpu so the vertex data can be written directly in to the mapped buffer).
+    bool Initialize(MemoryManager* pManager, size_t span, size_t numVerts, MemoryUsage memoryUsage, const BufferUsageFlags usage = BufferUsageFlags::Vertex );
     template<typename T>
     bool Initialize(MemoryManager* pManager, const std::span<const T> initialData, const bool dspUsable = false, const BufferUsageFlags usage = BufferUsageFlags::Vertex);
 
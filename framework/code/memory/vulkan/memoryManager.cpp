@@ -457,6 +457,12 @@ void MemoryManager<Vulkan>::UnmapInternal(void* vmaAllocation, void* cpuLocation
     vmaUnmapMemory(mVmaAllocator, static_cast<VmaAllocation>(vmaAllocation));
 }
 
+void MemoryManager<Vulkan>::InvalidateMapped(const MemoryCpuMappedUntyped<Vulkan>& mapped, size_t offset, size_t size)
+{
+    assert(mapped.mCpuLocation);
+    vmaInvalidateAllocation(mVmaAllocator, static_cast<VmaAllocation>(mapped.mAllocation.allocation), offset, size);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 MemoryPool<Vulkan> MemoryManager<Vulkan>::CreateCustomPool( uint32_t typeIndex, uint32_t poolAllocationSize, uint32_t maxPoolAllocations, uint32_t bufferUsageFlag, uint32_t imageUsageFlag ) const
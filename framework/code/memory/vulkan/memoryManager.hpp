@@ -148,6 +148,10 @@ public:
     template<typename T_VKTYPE>
     void Unmap(MemoryAllocatedBuffer<Vulkan, T_VKTYPE>& buffer, MemoryCpuMappedUntyped<Vulkan> allocation);
 
+    /// Make gpu writes to (currently) mapped memory visible to the cpu (needed for memory that is not host coherent, eg GpuToCpu readback buffers kept mapped).
+    /// Call after the gpu writes have completed and before reading them.
+    void InvalidateMapped(const MemoryCpuMappedUntyped<Vulkan>& mapped, size_t offset, size_t size);
+
     /// Copy data in one buffer into another.  Assumes buffers created with appropriate VK_BUFFER_USAGE_TRANSFER_SRC_BIT and VK_BUFFER_USAGE_TRANSFER_DST_BIT
     bool CopyData(VkCommandBuffer vkCommandBuffer, const MemoryAllocatedBuffer<Vulkan, VkBuffer>& src, MemoryAllocatedBuffer<Vulkan, VkBuffer>& dst, size_t copySize, size_t srcOffset = 0, size_t dstOffset = 0);
 
@@ -74,6 +74,16 @@ bool VertexBuffer<Vulkan>::Initialize(MemoryManager* pManager, size_t span, size
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool VertexBuffer<Vulkan>::Initialize(MemoryManager* pManager, size_t span, size_t numVerts, MemoryUsage memoryUsage, const BufferUsageFlags usage )
+{
+    mNumVertices = numVerts;
+    mSpan = span;
+    mDspUsable = false;
+    return Buffer::Initialize(pManager, static_cast<size_t>(mSpan * mNumVertices), usage, memoryUsage);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool VertexBuffer<Vulkan>::Update(MemoryManager* pManager, size_t dataSize, const void* newData)
 {
     return Buffer::Update(pManager, dataSize, newData);
@@ -0,0 +1,333 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include "octree.hpp"
+
+/// Loose octree supporting moving objects.
+/// Designed for culling of dynamic objects (animated nodes, spawned objects etc) that would need the (static) Octree rebuilding every frame.
+///
+/// Objects are placed using the same rules as Octree (the deepest cell that is at least twice the object size, chosen by the object center), so a
+/// cell's objects can overhang the cell by up to half the cell size and queries should use the same (expanding) test functors as Octree.
+/// Nodes and objects are held in pools (vectors with free lists) and the objects in a node are a linked list, so Insert, Remove and Move are O(T_MAXDEPTH)
+/// and do not move other objects.  Move is cheap if the object stays in the same cell.
+/// Query traversal is not as cache friendly as Octree (nodes are not stored in traversal order), prefer Octree for static geometry.
+///
+/// @tparam T_OBJECT object contained in the octree.  Must be move assignable.
+/// @tparam T_MAXDEPTH maximum depth (levels of nodes).
+/// @ingroup Mesh
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+class DynamicOctree : public OctreeBase
+{
+    static constexpr uint32_t cNone = ~0u;
+
+    /// Data describing an octree node (2x2x2 grid of cells) and the objects stored at this node level.
+    struct Node
+    {
+        std::array<uint32_t, 8> Children;           ///< node index for each of the cells (or cNone)
+        uint32_t                Parent;             ///< parent node index (or cNone for the root)
+        uint32_t                FirstObject;        ///< head of the linked list of objects at this node level (or cNone)
+        uint32_t                SubtreeObjectCount; ///< number of objects at this node level AND below
+    };
+
+    /// Pooled object
+    struct ObjectSlot
+    {
+        T_OBJECT                Object;
+        uint32_t                NodeIdx;            ///< node containing this object (or cNone if the slot is free)
+        uint32_t                Prev;               ///< linked list of objects in the node
+        uint32_t                Next;               ///< linked list of objects in the node (or the free list)
+    };
+
+public:
+    typedef T_OBJECT tObject;
+    /// Handle returned by Insert, used to Remove and Move the object
+    typedef uint32_t tHandle;
+    static constexpr tHandle cInvalidHandle = cNone;
+
+    /// Constructor
+    /// @param center Center position of the octree (nodes will split in 3 dimensions around this center)
+    /// @param octreeSize Dimensions of octree (not halfsize)
+    /// @param expectedObjects Number of objects to reserve space for (can grow beyond this)
+    DynamicOctree( const glm::vec3 center, const glm::vec3 octreeSize, uint32_t expectedObjects )
+        : m_Center( center, 1.0f )
+        , m_HalfSize( octreeSize * 0.5f, 0.0f )
+    {
+        m_Objects.reserve( expectedObjects );
+        m_Nodes.reserve( expectedObjects / 2 + 1 );
+        AllocNode( cNone );
+    }
+
+    /// Add object to the octree.
+    /// @return handle to the inserted object (valid until the object is removed)
+    tHandle Insert( const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/, T_OBJECT&& object );
+
+    /// Remove an object from the octree.
+    /// @return the removed object
+    T_OBJECT Remove( tHandle handle );
+
+    /// Update the position and/or size of an object already in the octree.
+    void Move( tHandle handle, const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/ );
+
+    /// Query against this octree and output all contained objects (same interface as Octree::Query).
+    template<typename T_TEST, typename T_OUTPUT>
+    void Query( const T_TEST& testFn, T_OUTPUT&& outputFn ) const;
+
+    const T_OBJECT& GetObject( tHandle handle ) const { assert( m_Objects[handle].NodeIdx != cNone ); return m_Objects[handle].Object; }
+    T_OBJECT& GetObject( tHandle handle ) { assert( m_Objects[handle].NodeIdx != cNone ); return m_Objects[handle].Object; }
+    size_t GetNumObjects() const { return m_Nodes[0].SubtreeObjectCount; }
+    size_t GetNumNodes() const { return m_Nodes.size() - m_NumFreeNodes; }
+
+private:
+    // Find (creating if needed) the node an object with the given position and size should be stored in.
+    uint32_t FindOrCreateNode( const glm::vec4& objectPosition, const glm::vec4& objectSize );
+
+    uint32_t AllocNode( uint32_t parentNodeIdx );
+    void LinkObject( uint32_t nodeIdx, tHandle handle );
+    void UnlinkObject( tHandle handle );
+    // Free the node (and its parents) if they no longer contain any objects.
+    void FreeEmptyNodes( uint32_t nodeIdx );
+
+    template<typename T_TEST, typename T_OUTPUT>
+    void Query( const T_TEST& testFn, T_OUTPUT&& outputFn, uint32_t nodeIdx, glm::vec4 center, glm::vec4 halfSize ) const;
+    template<typename T_OUTPUT>
+    void OutputAll( T_OUTPUT&& outputFn, uint32_t nodeIdx ) const;
+
+private:
+    std::vector<Node>       m_Nodes;        ///< node pool, m_Nodes[0] is the root
+    std::vector<ObjectSlot> m_Objects;      ///< object pool
+    uint32_t                m_FirstFreeNode = cNone;    ///< free list (linked through Node::Parent)
+    uint32_t                m_FirstFreeObject = cNone;  ///< free list (linked through ObjectSlot::Next)
+    uint32_t                m_NumFreeNodes = 0;
+
+    glm::vec4               m_Center;
+    glm::vec4               m_HalfSize;     // size (width, height, depth) of the octree (halved)
+};
+
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+uint32_t DynamicOctree<T_OBJECT, T_MAXDEPTH>::AllocNode( uint32_t parentNodeIdx )
+{
+    uint32_t nodeIdx = m_FirstFreeNode;
+    if( nodeIdx != cNone )
+    {
+        m_FirstFreeNode = m_Nodes[nodeIdx].Parent;
+        --m_NumFreeNodes;
+    }
+    else
+    {
+        nodeIdx = (uint32_t) m_Nodes.size();
+        m_Nodes.emplace_back();
+    }
+    Node& node = m_Nodes[nodeIdx];
+    node.Children.fill( cNone );
+    node.Parent = parentNodeIdx;
+    node.FirstObject = cNone;
+    node.SubtreeObjectCount = 0;
+    return nodeIdx;
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+uint32_t DynamicOctree<T_OBJECT, T_MAXDEPTH>::FindOrCreateNode( const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/ )
+{
+    // Same placement rules as Octree::AddObject.
+    uint32_t nodeIdx = 0;
+    if( !(objectSize.x < m_HalfSize.x && objectSize.y < m_HalfSize.y && objectSize.z < m_HalfSize.z) )
+    {
+        // Object too big to go in to any cells.  Will always be returned by a query!
+        return nodeIdx;
+    }
+
+    glm::vec4 relativePosition = objectPosition - m_Center;
+    glm::vec4 scaledObjectSize = objectSize * 2.0f;
+    for( uint32_t depth = 0;; ++depth )
+    {
+        uint32_t cellIndex = 0;
+        cellIndex |= (relativePosition.x >= 0.0f) ? 1 : 0;
+        cellIndex |= (relativePosition.y >= 0.0f) ? 2 : 0;
+        cellIndex |= (relativePosition.z >= 0.0f) ? 4 : 0;
+
+        // Objects are stored in the node for the cell they are in (Octree stores these 'in the cell' with no node).
+        uint32_t childNodeIdx = m_Nodes[nodeIdx].Children[cellIndex];
+        if( childNodeIdx == cNone )
+        {
+            childNodeIdx = AllocNode( nodeIdx );    // may move m_Nodes
+            m_Nodes[nodeIdx].Children[cellIndex] = childNodeIdx;
+        }
+        nodeIdx = childNodeIdx;
+
+        if( !(depth < T_MAXDEPTH && scaledObjectSize.x < m_HalfSize.x && scaledObjectSize.y < m_HalfSize.y && scaledObjectSize.z < m_HalfSize.z) )
+            break;
+        relativePosition = 2.0f * relativePosition - m_HalfSize * sCellOffsets[cellIndex];
+        scaledObjectSize = scaledObjectSize * 2.0f;
+    }
+    return nodeIdx;
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::LinkObject( uint32_t nodeIdx, tHandle handle )
+{
+    ObjectSlot& slot = m_Objects[handle];
+    Node& node = m_Nodes[nodeIdx];
+    slot.NodeIdx = nodeIdx;
+    slot.Prev = cNone;
+    slot.Next = node.FirstObject;
+    if( node.FirstObject != cNone )
+        m_Objects[node.FirstObject].Prev = handle;
+    node.FirstObject = handle;
+
+    for( uint32_t idx = nodeIdx; idx != cNone; idx = m_Nodes[idx].Parent )
+        ++m_Nodes[idx].SubtreeObjectCount;
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::UnlinkObject( tHandle handle )
+{
+    ObjectSlot& slot = m_Objects[handle];
+    const uint32_t nodeIdx = slot.NodeIdx;
+    assert( nodeIdx != cNone );
+
+    if( slot.Prev != cNone )
+        m_Objects[slot.Prev].Next = slot.Next;
+    else
+        m_Nodes[nodeIdx].FirstObject = slot.Next;
+    if( slot.Next != cNone )
+        m_Objects[slot.Next].Prev = slot.Prev;
+    slot.NodeIdx = cNone;
+
+    for( uint32_t idx = nodeIdx; idx != cNone; idx = m_Nodes[idx].Parent )
+        --m_Nodes[idx].SubtreeObjectCount;
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::FreeEmptyNodes( uint32_t nodeIdx )
+{
+    // Never free the root.  Children of an empty node will have already been freed.
+    while( nodeIdx != 0 && m_Nodes[nodeIdx].SubtreeObjectCount == 0 )
+    {
+        Node& node = m_Nodes[nodeIdx];
+        const uint32_t parentNodeIdx = node.Parent;
+        auto& siblings = m_Nodes[parentNodeIdx].Children;
+        *std::find( siblings.begin(), siblings.end(), nodeIdx ) = cNone;
+
+        node.Parent = m_FirstFreeNode;
+        m_FirstFreeNode = nodeIdx;
+        ++m_NumFreeNodes;
+        nodeIdx = parentNodeIdx;
+    }
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+typename DynamicOctree<T_OBJECT, T_MAXDEPTH>::tHandle DynamicOctree<T_OBJECT, T_MAXDEPTH>::Insert( const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/, T_OBJECT&& object )
+{
+    tHandle handle = m_FirstFreeObject;
+    if( handle != cNone )
+    {
+        m_FirstFreeObject = m_Objects[handle].Next;
+        m_Objects[handle].Object = std::move( object );
+    }
+    else
+    {
+        handle = (tHandle) m_Objects.size();
+        m_Objects.push_back( { std::move( object ), cNone, cNone, cNone } );
+    }
+    LinkObject( FindOrCreateNode( objectPosition, objectSize ), handle );
+    return handle;
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+T_OBJECT DynamicOctree<T_OBJECT, T_MAXDEPTH>::Remove( tHandle handle )
+{
+    const uint32_t nodeIdx = m_Objects[handle].NodeIdx;
+    UnlinkObject( handle );
+    FreeEmptyNodes( nodeIdx );
+
+    ObjectSlot& slot = m_Objects[handle];
+    slot.Next = m_FirstFreeObject;
+    m_FirstFreeObject = handle;
+    return std::move( slot.Object );
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::Move( tHandle handle, const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/ )
+{
+    // Finding the node does not create any nodes if the object stays in the same cell (its current path already exists).
+    const uint32_t nodeIdx = FindOrCreateNode( objectPosition, objectSize );
+    const uint32_t oldNodeIdx = m_Objects[handle].NodeIdx;
+    if( nodeIdx == oldNodeIdx )
+        return;
+
+    // Free the old node(s) after linking in to the new node, the new node may be a child of the old node (and would be freed with it).
+    UnlinkObject( handle );
+    LinkObject( nodeIdx, handle );
+    FreeEmptyNodes( oldNodeIdx );
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+template<typename T_TEST, typename T_OUTPUT>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::Query( const T_TEST& testFn, T_OUTPUT&& outputFn ) const
+{
+    Query( testFn, outputFn, 0, m_Center, m_HalfSize );
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+template<typename T_OUTPUT>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::OutputAll( T_OUTPUT&& outputFn, uint32_t nodeIdx ) const
+{
+    const Node& node = m_Nodes[nodeIdx];
+    for( uint32_t childNodeIdx : node.Children )
+    {
+        if( childNodeIdx != cNone )
+            OutputAll( outputFn, childNodeIdx );
+    }
+    for( uint32_t objectIdx = node.FirstObject; objectIdx != cNone; objectIdx = m_Objects[objectIdx].Next )
+        outputFn( m_Objects[objectIdx].Object );
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+template<typename T_TEST, typename T_OUTPUT>
+void DynamicOctree<T_OBJECT, T_MAXDEPTH>::Query( const T_TEST& testFn, T_OUTPUT&& outputFn, uint32_t nodeIdx, glm::vec4 center, glm::vec4 halfSize ) const
+{
+    halfSize *= 0.5f;
+    const Node& node = m_Nodes[nodeIdx];
+
+    for( uint32_t cell = 0; cell < 8; ++cell )
+    {
+        const uint32_t childNodeIdx = node.Children[cell];
+        if( childNodeIdx == cNone )
+        {
+            // No need to test anything if there are no objects in this cell.
+            continue;
+        }
+
+        // Get the center co-ordinates of this cell.
+        const auto cellCenter = center + sCellOffsets[cell] * halfSize;
+
+        // Call our user supplied 'test' function for this cell.
+        switch( testFn( cellCenter, halfSize ) )
+        {
+        case eQueryResult::Inside:  // The cell is completely 'inside' the test area.
+            OutputAll( outputFn, childNodeIdx );
+            break;
+        case eQueryResult::Partial: // The cell is 'partially' inside the test area.
+            Query( testFn, outputFn, childNodeIdx, cellCenter, halfSize );
+            break;
+        case eQueryResult::Outside: // The cell is completely outside the test area.
+            break;
+        }
+    }
+
+    // output everything that is at the current node level (ie not at a lower level).
+    for( uint32_t objectIdx = node.FirstObject; objectIdx != cNone; objectIdx = m_Objects[objectIdx].Next )
+        outputFn( m_Objects[objectIdx].Object );
+}
@@ -8,12 +8,14 @@
 
 #include "instanceGenerator.hpp"
 #include "system/crc32c.hpp"
+#include "system/Worker.h"
 #include <glm/gtx/norm.hpp>
 #define EIGEN_INITIALIZE_MATRICES_BY_ZERO
 #define EIGEN_MPL2_ONLY
 #include <eigen/Eigen/Dense>
-#include <map>
 #include <algorithm>
+#include <numeric>
+#include <thread>
 
 // Calculate the 'centroid' of the object mesh.
 static glm::vec3 ComputeMeshCenter( const std::span<MeshObjectIntermediate::FatVertex> vertices )
@@ -102,110 +104,221 @@ std::vector<MeshInstance> MeshInstanceGenerator::NullFindInstances(std::vector<M
     return out;
 }
 
+// Maximum (squared) distance between a transformed vertex and the vertex it should match, for two meshes to be considered instances of each other.
+static constexpr float cMaxInstanceVertexDistance2 = 1.0f;
+
+// Cheap rotation (and translation) invariant description of a mesh's vertex positions.
+// Used to reject candidate instance pairs before doing the (relatively expensive) SVD and vertex verification.
+struct MeshSignature
+{
+    double meanCenterDistance = 0.0;    // distance of vertices from the mesh center (as calculated by ComputeMeshCenter)
+    double rmsCenterDistance = 0.0;
+    double maxCenterDistance = 0.0;
+    double meanEdgeLength = 0.0;        // 'edge' between consecutive vertices (vertex order is what the verification compares, so use that rather than the index buffer)
+    double maxEdgeLength = 0.0;
+
+    // Return false if the two meshes cannot possibly pass the vertex verification in FindInstances.
+    // If every vertex of a matching instance is within d of its transformed counterpart then the centers are also within d, so each center distance and
+    // each edge length can differ by at most 2d (and so can the mean, rms and max of those values).  Small additional tolerance allows for float precision.
+    bool MayMatch( const MeshSignature& other ) const
+    {
+        const double maxDifference = 2.0 * std::sqrt( (double) cMaxInstanceVertexDistance2 );
+        const auto close = [maxDifference]( double a, double b ) { return std::abs( a - b ) <= maxDifference + 1.0e-4 * std::max( std::abs( a ), std::abs( b ) ); };
+        return close( meanCenterDistance, other.meanCenterDistance ) && close( rmsCenterDistance, other.rmsCenterDistance ) && close( maxCenterDistance, other.maxCenterDistance ) &&
+               close( meanEdgeLength, other.meanEdgeLength ) && close( maxEdgeLength, other.maxEdgeLength );
+    }
+};
+
+static MeshSignature ComputeMeshSignature( const std::span<const MeshObjectIntermediate::FatVertex> vertices, const glm::vec3 center )
+{
+    MeshSignature signature;
+    if (vertices.empty())
+        return signature;
+    const glm::highp_dvec3 centerd( center );
+    glm::highp_dvec3 prevPosition{};
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const glm::highp_dvec3 position( vertices[i].position[0], vertices[i].position[1], vertices[i].position[2] );
+        const double centerDistance = glm::distance( position, centerd );
+        signature.meanCenterDistance += centerDistance;
+        signature.rmsCenterDistance += centerDistance * centerDistance;
+        signature.maxCenterDistance = std::max( signature.maxCenterDistance, centerDistance );
+        if (i > 0)
+        {
+            const double edgeLength = glm::distance( position, prevPosition );
+            signature.meanEdgeLength += edgeLength;
+            signature.maxEdgeLength = std::max( signature.maxEdgeLength, edgeLength );
+        }
+        prevPosition = position;
+    }
+    signature.meanCenterDistance /= (double) vertices.size();
+    signature.rmsCenterDistance = std::sqrt( signature.rmsCenterDistance / (double) vertices.size() );
+    if (vertices.size() > 1)
+        signature.meanEdgeLength /= (double) (vertices.size() - 1);
+    return signature;
+}
+
 std::vector<MeshInstance> MeshInstanceGenerator::FindInstances(std::vector<MeshObjectIntermediate> objects)
 {
-    std::multimap<uint32_t, MeshObjectIntermediate> matchingSets;
+    // Worker threads plus the calling thread give one thread per core.
+    ThreadWorker worker;
+    const uint32_t numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+    if (numThreads > 1)
+        worker.Initialize( "InstanceGenerator", numThreads - 1 );
+    auto instances = FindInstances( std::move( objects ), worker );
+    worker.Terminate();
+    return instances;
+}
 
+std::vector<MeshInstance> MeshInstanceGenerator::FindInstances(std::vector<MeshObjectIntermediate> objects, ThreadWorker& worker)
+{
     // Go through and match based on a CRC (of UV positions and materials).
-    // Normals and postions are not a reliable indicator as they will be rotated/translated differently for matching instances. 
-    // Move the objects in to this map!
-    for (auto& object : objects)
-    {
+    // Normals and postions are not a reliable indicator as they will be rotated/translated differently for matching instances.
+    std::vector<uint32_t> objectCrcs( objects.size() );
+    worker.ParallelFor( objects.size(), [&]( size_t objectIdx ) {
+        const auto& object = objects[objectIdx];
         size_t bufferSize = object.m_VertexBuffer.size();
         uint32_t crc = crc32c(0, { (uint8_t*)&bufferSize, sizeof(bufferSize) });
         for (const auto& vert : object.m_VertexBuffer)
             crc = crc32c(crc, { (uint8_t*)vert.uv0, sizeof(vert.uv0) });
         for (const MeshObjectIntermediate::MaterialDef& material : object.m_Materials)
             crc = crc32c(crc, material.diffuseFilename);
-        matchingSets.emplace( crc, std::move(object) );
-    }
+        objectCrcs[objectIdx] = crc;
+    } );
 
-    // Find how many unique crc values there were (gives a good start for number of truely unique mesh instances).
-    uint32_t lastCrc = 0xffffffff;
-    uint32_t numUniqueCrc = 0;
-    for (const auto& [crc, object] : matchingSets)
+    // Bucket the objects by crc (ordered by crc, and by original object order within each bucket).
+    std::vector<uint32_t> sortedObjects( objects.size() );
+    std::iota( sortedObjects.begin(), sortedObjects.end(), 0 );
+    std::stable_sort( sortedObjects.begin(), sortedObjects.end(), [&objectCrcs]( uint32_t a, uint32_t b ) { return objectCrcs[a] < objectCrcs[b]; } );
+    std::vector<std::span<const uint32_t>> buckets;
+    for (size_t first = 0; first < sortedObjects.size(); )
     {
-        if (crc == lastCrc)
-            ++numUniqueCrc;
-        lastCrc = crc;
+        size_t last = first + 1;
+        while (last < sortedObjects.size() && objectCrcs[sortedObjects[last]] == objectCrcs[sortedObjects[first]])
+            ++last;
+        buckets.push_back( std::span<const uint32_t>( sortedObjects ).subspan( first, last - first ) );
+        first = last;
     }
-    std::vector<MeshInstance> instances;
-    instances.reserve(numUniqueCrc);
 
-    // Go through the 'unique' sets and determine the transform for each instance (to map it to the position of the 'original').
-    // Build a list of unique MeshObjects and their instances (with transforms).
-    // We repeat until 'matchingSets' has been emptied.  Worse case becomes N^2, where all the meshes have identical CRC values but their meshes dont match.
-    while (!matchingSets.empty())
-    {
-        uint32_t setCrc = 0xffffffff;
-        glm::vec3 setFirstCenter{};
-        for (auto it = matchingSets.begin(); it != matchingSets.end(); )
+    // Within each bucket determine the transform for each instance (to map it to the position of the 'original').
+    // The first remaining object in a bucket becomes a new unique mesh, the other remaining objects are tested against it and removed from the bucket if they are an instance.  Repeat until the bucket is empty.
+    // Buckets are independent so are processed in parallel (largest first, for better load balancing).  Worst case (all meshes have identical CRC values but their meshes dont match) is still N^2
+    // but most candidate pairs are rejected by a cheap signature test before having to do the SVD.
+    std::vector<std::vector<MeshInstance>> bucketInstances( buckets.size() );
+    std::vector<uint32_t> bucketOrder( buckets.size() );
+    std::iota( bucketOrder.begin(), bucketOrder.end(), 0 );
+    std::stable_sort( bucketOrder.begin(), bucketOrder.end(), [&buckets]( uint32_t a, uint32_t b ) { return buckets[a].size() > buckets[b].size(); } );
+    worker.ParallelFor( buckets.size(), [&]( size_t orderIdx ) {
+        const uint32_t bucketIdx = bucketOrder[orderIdx];
+        std::vector<uint32_t> remaining( buckets[bucketIdx].begin(), buckets[bucketIdx].end() );
+
+        std::vector<glm::vec3> centers( remaining.size() );
+        std::vector<MeshSignature> signatures( remaining.size() );
+        if (remaining.size() > 1)
+        {
+            for (size_t i = 0; i < remaining.size(); ++i)
+            {
+                centers[i] = ComputeMeshCenter( objects[remaining[i]].m_VertexBuffer );
+                signatures[i] = ComputeMeshSignature( objects[remaining[i]].m_VertexBuffer, centers[i] );
+            }
+        }
+        else
         {
-            const auto crc = it->first;
-            auto& object = it->second;
+            centers[0] = ComputeMeshCenter( objects[remaining[0]].m_VertexBuffer );
+        }
+        std::vector<uint32_t> remainingSlots( remaining.size() );   // index in to centers/signatures for each remaining object
+        std::iota( remainingSlots.begin(), remainingSlots.end(), 0 );
 
-            glm::vec3 center = ComputeMeshCenter(object.m_VertexBuffer);
+        auto& instances = bucketInstances[bucketIdx];
+        while (!remaining.empty())
+        {
+            // First item in a new set of matches.
+            // Add it as a new set of 'instances' and remove from the 'remaining'.
+            auto& setFirstObject = objects[remaining[0]];
+            const glm::vec3 setFirstCenter = centers[remainingSlots[0]];
+            const MeshSignature& setFirstSignature = signatures[remainingSlots[0]];
 
-            if (crc != setCrc)
-            {
-                // First item in a new set of matches.
-                // Add it as a new set of 'instances' and remove from the 'matchingSets'.
-                setCrc = crc;
-                setFirstCenter = center;
+            TransformToCenter( setFirstObject.m_VertexBuffer, setFirstCenter );
 
-                TransformToCenter( object.m_VertexBuffer, center );
+            glm::mat4 m = glm::identity<glm::mat4>();
+            m[3].x = setFirstCenter.x;
+            m[3].y = setFirstCenter.y;
+            m[3].z = setFirstCenter.z;
+            m = setFirstObject.m_Transform * m;
 
-                glm::mat4 m = glm::identity<glm::mat4>();
-                m[3].x = center.x;
-                m[3].y = center.y;
-                m[3].z = center.z;
-                m = object.m_Transform * m;
+            MeshInstance& set = instances.emplace_back( MeshInstance{ std::move( setFirstObject ), {{glm::transpose( m ), -1}} } );
 
-                instances.push_back({ std::move(object), {{glm::transpose(m), -1}} });
-                it = matchingSets.erase(it);
-            }
-            else
+            size_t numStillRemaining = 0;
+            for (size_t r = 1; r < remaining.size(); ++r)
             {
-                // First 'duplicate' in the set.
-
-                //
-                // Use SVD to determine the rotation between the 2 sets of vertices.
-                //
-                const MeshObjectIntermediate& setFirstObject = instances.rbegin()->mesh;
-                auto transform = ComputeTransformationBetweenVertexPositions(setFirstObject.m_VertexBuffer, object.m_VertexBuffer, glm::vec3(0.0f), center);
-
-                //
-                // Sanity check that the transform really does map between the 2 sets of vertices.
-                // This will fail if the mesh positions are not truely identical (outside of translation/rotation).
-                //
-                bool verificationFailed = false;
-                for (int i = 0; i < object.m_VertexBuffer.size(); ++i)
+                auto& object = objects[remaining[r]];
+                const uint32_t slot = remainingSlots[r];
+
+                bool matched = object.m_VertexBuffer.size() == set.mesh.m_VertexBuffer.size() && setFirstSignature.MayMatch( signatures[slot] );
+                glm::mat4 transform;
+                if (matched)
                 {
-                    const glm::vec3 p0 = glm::vec3(setFirstObject.m_VertexBuffer[i].position[0], setFirstObject.m_VertexBuffer[i].position[1], setFirstObject.m_VertexBuffer[i].position[2]);
-                    const glm::vec3 ptest2 = transform * glm::vec4(p0, 1.0f);
-                    const glm::vec3 p1 = glm::vec3(object.m_VertexBuffer[i].position[0], object.m_VertexBuffer[i].position[1], object.m_VertexBuffer[i].position[2]);
-                    auto pdist2 = glm::distance2(p1, ptest2);
-                    if (pdist2 > 1.0f)
+                    //
+                    // Use SVD to determine the rotation between the 2 sets of vertices.
+                    //
+                    transform = ComputeTransformationBetweenVertexPositions( set.mesh.m_VertexBuffer, object.m_VertexBuffer, glm::vec3( 0.0f ), centers[slot] );
+
+                    //
+                    // Sanity check that the transform really does map between the 2 sets of vertices.
+                    // This will fail if the mesh positions are not truely identical (outside of translation/rotation).
+                    //
+                    for (size_t i = 0; i < object.m_VertexBuffer.size(); ++i)
                     {
-                        // assume too much error!
-                        verificationFailed = true;
-                        break;
+                        const glm::vec3 p0 = glm::vec3( set.mesh.m_VertexBuffer[i].position[0], set.mesh.m_VertexBuffer[i].position[1], set.mesh.m_VertexBuffer[i].position[2] );
+                        const glm::vec3 ptest2 = transform * glm::vec4( p0, 1.0f );
+                        const glm::vec3 p1 = glm::vec3( object.m_VertexBuffer[i].position[0], object.m_VertexBuffer[i].position[1], object.m_VertexBuffer[i].position[2] );
+                        auto pdist2 = glm::distance2( p1, ptest2 );
+                        if (pdist2 > cMaxInstanceVertexDistance2)
+                        {
+                            // assume too much error!
+                            matched = false;
+                            break;
+                        }
                     }
                 }
-                if (verificationFailed)
+                if (matched)
                 {
-                    // Transform failed to transform vertices correctly - assume the meshes aren't matches (either aren't based on each other or are scaled, which we dont currently handle)
-                    // Leave this instance in the 'matchSets' list.
-                    ++it;
+                    // Transform looks good.  Add this as a new instance of the current instances set.
+                    glm::mat4 instanceTransform = object.m_Transform * transform;
+                    set.instances.push_back( { glm::transpose( instanceTransform ), -1 } );
+                    object.Release();
                 }
                 else
                 {
-                    // Transform looks good.  Add this as a new instance of the current instances set.
-                    glm::mat4 m = object.m_Transform * transform;
-                    instances.rbegin()->instances.push_back({ glm::transpose(m), -1 });
-                    it = matchingSets.erase(it);
+                    // Transform failed to transform vertices correctly (or the signatures were too different) - assume the meshes aren't matches (either aren't based on each other or are scaled, which we dont currently handle)
+                    // Leave this object in the 'remaining' list.
+                    remaining[numStillRemaining] = remaining[r];
+                    remainingSlots[numStillRemaining] = slot;
+                    ++numStillRemaining;
                 }
             }
+            remaining.resize( numStillRemaining );
+            remainingSlots.resize( numStillRemaining );
+        }
+    } );
+
+    // Build the output list of unique MeshObjects and their instances (with transforms).
+    // Ordered the same as a sequential pass through the crc ordered buckets would generate, repeated until all the buckets are empty (ie the first unique mesh from every bucket, then the second unique mesh from every bucket etc).
+    size_t numInstances = 0;
+    size_t maxSetsPerBucket = 0;
+    for (const auto& sets : bucketInstances)
+    {
+        numInstances += sets.size();
+        maxSetsPerBucket = std::max( maxSetsPerBucket, sets.size() );
+    }
+    std::vector<MeshInstance> instances;
+    instances.reserve( numInstances );
+    for (size_t setIdx = 0; setIdx < maxSetsPerBucket; ++setIdx)
+    {
+        for (auto& sets : bucketInstances)
+        {
+            if (setIdx < sets.size())
+                instances.push_back( std::move( sets[setIdx] ) );
         }
     }
 
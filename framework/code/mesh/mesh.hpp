@@ -7,6 +7,9 @@
 //==============================================================================
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <optional>
 #include <vector>
 
@@ -30,10 +33,31 @@ public:
 
     void Destroy();
 
+    /// Range of m_IndexBuffer making up one level of detail (see MeshObjectIntermediate::GenerateLods)
+    struct Lod
+    {
+        uint32_t    firstIndex = 0;
+        uint32_t    numIndices = 0;
+        float       error = 0.0f;       ///< simplification error (in object space units) compared to lod 0
+    };
+
+    /// Range of m_IndexBuffer that was a separate mesh before static batching (see MeshObjectIntermediate::BatchStatic)
+    struct SubMesh
+    {
+        uint32_t    firstIndex = 0;
+        uint32_t    numIndices = 0;
+        float       boundsMin[3] = {};
+        float       boundsMax[3] = {};
+    };
+
 public:
     size_t                                  m_NumVertices = 0;
     std::vector<VertexBuffer<T_GFXAPI>>     m_VertexBuffers;
     std::optional<IndexBuffer<T_GFXAPI>>    m_IndexBuffer;
+    std::vector<Lod>                        m_Lods;         ///< levels of detail, most detailed first (empty if only the entire m_IndexBuffer is drawn)
+    std::vector<SubMesh>                    m_SubMeshes;    ///< meshes this (static batched) mesh was built from (empty if not batched)
+    float                                   m_BoundsMin[3] = {};    ///< object space bounding box of the vertices (eg for occlusion culling)
+    float                                   m_BoundsMax[3] = {};
 };
 
 template<typename T_GFXAPI>
@@ -45,4 +69,8 @@ void Mesh<T_GFXAPI>::Destroy()
     m_NumVertices = 0;
     m_VertexBuffers.clear();
     m_IndexBuffer.reset();
+    m_Lods.clear();
+    m_SubMeshes.clear();
+    std::fill( std::begin( m_BoundsMin ), std::end( m_BoundsMin ), 0.0f );
+    std::fill( std::begin( m_BoundsMax ), std::end( m_BoundsMax ), 0.0f );
 }
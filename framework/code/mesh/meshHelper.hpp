@@ -9,6 +9,7 @@
 
 #include "mesh.hpp"
 #include "meshIntermediate.hpp"
+#include "vertexFormatConverter.hpp"
 #include "material/vertexFormat.hpp"
 #include "memory/memory.hpp"
 #include "system/os_common.h"
@@ -93,6 +94,19 @@ bool MeshHelper::CreateMesh(MemoryManager<T_GFXAPI>& memoryManager, const MeshOb
     meshObjectOut->Destroy();
 
     const size_t numVertices = meshObject.m_VertexBuffer.size();
+    if (numVertices > 0)
+    {
+        for (int i = 0; i < 3; ++i)
+            meshObjectOut->m_BoundsMin[i] = meshObjectOut->m_BoundsMax[i] = meshObject.m_VertexBuffer[0].position[i];
+        for (const auto& vertex : meshObject.m_VertexBuffer)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                meshObjectOut->m_BoundsMin[i] = std::min( meshObjectOut->m_BoundsMin[i], vertex.position[i] );
+                meshObjectOut->m_BoundsMax[i] = std::max( meshObjectOut->m_BoundsMax[i], vertex.position[i] );
+            }
+        }
+    }
     // It is valid to have no vertex buffers (empty pVertexFormat) but still render vertices... vertex shader could generate verts procedurally.
     meshObjectOut->m_NumVertices = (uint32_t)numVertices;
 
@@ -107,14 +121,20 @@ bool MeshHelper::CreateMesh(MemoryManager<T_GFXAPI>& memoryManager, const MeshOb
         const auto& vertexFormat = pVertexFormat[vertexBufferIdx];
         if (vertexFormat.inputRate == VertexFormat::eInputRate::Vertex)
         {
-            const std::vector<uint32_t> formattedVertexData = MeshObjectIntermediate::CopyFatVertexToFormattedBuffer(meshObject.m_VertexBuffer, meshObject.m_WeightBuffer, pVertexFormat[vertexBufferIdx]);
-
-            if (!meshObjectOut->m_VertexBuffers.emplace_back().Initialize(&memoryManager, vertexFormat.span, numVertices, formattedVertexData.data()))
+            auto& vertexBuffer = meshObjectOut->m_VertexBuffers.emplace_back();
+            if (!vertexBuffer.Initialize(&memoryManager, vertexFormat.span, numVertices, MemoryUsage::CpuToGpu))
             {
                 LOGE("Cannot Initialize vertex buffer %d", vertexBufferIdx);
                 return false;
             }
-            meshObjectOut->m_VertexBuffers.rbegin()->AddBindingAndAtributes(bindingIndex + vertexBufferIdx, vertexFormat);
+            // Convert directly in to the (mapped) vertex buffer memory.
+            if (numVertices > 0)
+            {
+                const VertexFormatConverter converter(vertexFormat);
+                auto mapped = vertexBuffer.template Map<uint8_t>();
+                converter.Convert(meshObject.m_VertexBuffer, meshObject.m_WeightBuffer, { mapped.data(), vertexFormat.span * numVertices });
+            }
+            vertexBuffer.AddBindingAndAtributes(bindingIndex + vertexBufferIdx, vertexFormat);
         }
     }
 
@@ -124,6 +144,16 @@ bool MeshHelper::CreateMesh(MemoryManager<T_GFXAPI>& memoryManager, const MeshOb
         return false;
     }
 
+    // Levels of detail are just ranges of the index buffer.
+    meshObjectOut->m_Lods.reserve(meshObject.m_Lods.size());
+    for (const auto& lod : meshObject.m_Lods)
+        meshObjectOut->m_Lods.push_back({ lod.firstIndex, lod.numIndices, lod.error });
+
+    // Static batched meshes keep the ranges (and bounds) of the meshes they were built from (eg for culling).
+    meshObjectOut->m_SubMeshes.reserve(meshObject.m_SubMeshes.size());
+    for (const auto& subMesh : meshObject.m_SubMeshes)
+        meshObjectOut->m_SubMeshes.push_back({ subMesh.firstIndex, subMesh.numIndices, { subMesh.boundsMin.x, subMesh.boundsMin.y, subMesh.boundsMin.z }, { subMesh.boundsMax.x, subMesh.boundsMax.y, subMesh.boundsMax.z } });
+
     return true;
 }
 
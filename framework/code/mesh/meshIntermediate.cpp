@@ -14,10 +14,21 @@
 #include "system/glm_common.hpp"
 #include "system/crc32c.hpp"
 #include "mesh/meshLoader.hpp"
+#include "mesh/meshSimplifier.hpp"
+#include "mesh/objLoader.hpp"
+#include "mesh/vertexFormatConverter.hpp"
 #include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 #include <istream>
 #include <sstream>
+#include <numeric>
 #include <set>
+#include <unordered_map>
 
 using Json = nlohmann::json;
 
@@ -164,6 +175,8 @@ void MeshObjectIntermediate::Release()
     std::vector<FatVertex>().swap(m_VertexBuffer);  // use swap so we know the memory disappears (clear may leave the memory 'reserved').
     std::vector<FatWeight>().swap(m_WeightBuffer);
     std::vector<MaterialDef>().swap(m_Materials);
+    std::vector<LodRange>().swap(m_Lods);
+    std::vector<SubMeshRange>().swap(m_SubMeshes);
     m_Transform = glm::identity<glm::mat4>();
     m_NodeId = -1;
 }
@@ -215,14 +228,17 @@ MeshObjectIntermediate MeshObjectIntermediate::CopyFlattened() const
             using T = std::decay_t<decltype(m)>;
             if constexpr (std::is_same_v<T, std::vector<uint32_t>> || std::is_same_v<T, std::vector<uint16_t>> || std::is_same_v<T, std::vector<uint8_t>>)
             {
-                dst.m_VertexBuffer.resize(m.size());
-                std::transform(std::begin(m), std::end(m), std::begin(dst.m_VertexBuffer), [this](const auto index) {
+                // Only flatten the most detailed lod.
+                const auto indicesBegin = std::begin(m) + (m_Lods.empty() ? 0 : m_Lods[0].firstIndex);
+                const auto indicesEnd = m_Lods.empty() ? std::end(m) : indicesBegin + m_Lods[0].numIndices;
+                dst.m_VertexBuffer.resize(indicesEnd - indicesBegin);
+                std::transform(indicesBegin, indicesEnd, std::begin(dst.m_VertexBuffer), [this](const auto index) {
                     return this->m_VertexBuffer[index];
                 });
                 if (!this->m_WeightBuffer.empty())
                 {
-                    dst.m_WeightBuffer.resize(m.size());
-                    std::transform(std::begin(m), std::end(m), std::begin(dst.m_WeightBuffer), [this](const auto index) {
+                    dst.m_WeightBuffer.resize(indicesEnd - indicesBegin);
+                    std::transform(indicesBegin, indicesEnd, std::begin(dst.m_WeightBuffer), [this](const auto index) {
                         return this->m_WeightBuffer[index];
                     });
                 }
@@ -242,7 +258,40 @@ MeshObjectIntermediate MeshObjectIntermediate::CopyFlattened() const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void MeshObjectIntermediate::CalculateFlatTangents(std::span<FatVertex> triangleVertices)
+{
+    assert(triangleVertices.size() % 3 == 0);
+    for (size_t i = 0; i + 2 < triangleVertices.size(); i += 3)
+    {
+        FatVertex* pFaceVerts = &triangleVertices[i];
+        glm::vec3 face_tangent, face_bitangent;
+        CalculateFaceTangentAndBitangent(pFaceVerts[0].position, pFaceVerts[1].position, pFaceVerts[2].position, pFaceVerts[0].uv0, pFaceVerts[1].uv0, pFaceVerts[2].uv0,
+            face_tangent, face_bitangent);
+        for (size_t WhichVert = 0; WhichVert < 3; WhichVert++)
+        {
+            glm::vec3 outTangent;
+            glm::vec3 outBitangent;
+            CalculateTangentAndBitangent(pFaceVerts[WhichVert].normal, face_tangent, face_bitangent, outTangent, outBitangent);
+            pFaceVerts[WhichVert].tangent[0] = outTangent.x;
+            pFaceVerts[WhichVert].tangent[1] = outTangent.y;
+            pFaceVerts[WhichVert].tangent[2] = outTangent.z;
+            pFaceVerts[WhichVert].bitangent[0] = outBitangent.x;
+            pFaceVerts[WhichVert].bitangent[1] = outBitangent.y;
+            pFaceVerts[WhichVert].bitangent[2] = outBitangent.z;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 std::vector<MeshObjectIntermediate> MeshObjectIntermediate::LoadObj(AssetManager& assetManager, const std::string& filename)
+{
+    return ObjLoader::Load(assetManager, filename);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<MeshObjectIntermediate> MeshObjectIntermediate::LoadObjTinyObj(AssetManager& assetManager, const std::string& filename)
 {
     std::vector<MeshObjectIntermediate> meshObjects;
 
@@ -504,144 +553,14 @@ MeshObjectIntermediate MeshObjectIntermediate::CreateScreenSpaceTriMesh()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-// String literal lower case hash (constexpr)
-constexpr FnvHashLower operator "" _h(const char* str, size_t) { return FnvHashLower(str); }
-
 std::vector<uint32_t> MeshObjectIntermediate::CopyFatVertexToFormattedBuffer(const std::span<const MeshObjectIntermediate::FatVertex>& fatVertexBuffer, const std::span<const MeshObjectIntermediate::FatWeight>& fatWeightBuffer, const VertexFormat& vertexFormat)
 {
-    //
-    // Determine the arrangement of the output data (based on the vertexFormat)
-    // Uses case insensitive slot/semantic name comparision.
-    //
-    int positionIndex = -1;
-    int uv0Index = -1;
-    int normalIndex = -1;
-    int colorIndex = -1;
-    int tangentIndex = -1;
-    int bitangentIndex = -1;
-    int jointIndex = -1;
-    int weightIndex = -1;
-
-    for (int i = 0; i < vertexFormat.elementIds.size(); ++i)
-    {
-        const std::string& elementId = vertexFormat.elementIds[i];
-        const FnvHashLower elementHash(elementId);   // use hashes to compare, all the hashing in the switch statement is compile time!
-
-        switch (elementHash) {
-        case "Position"_h:
-            positionIndex = i;
-            break;
-        case "UV"_h:
-        case "TEXCOORD"_h:
-            uv0Index = i;
-            break;
-        case "Color"_h:
-            colorIndex = i;
-            break;
-        case "Normal"_h:
-            normalIndex = i;
-            break;
-        case "Tangent"_h:
-            tangentIndex = i;
-            break;
-        case "Bitangent"_h:
-            bitangentIndex = i;
-            break;
-        case "Joint"_h:
-            jointIndex = i;
-            break;
-        case "Weight"_h:
-            weightIndex = i;
-            break;
-        default:
-            LOGE("Cannot map vertex elementId %s to the mesh data", elementId.c_str());
-            break;
-        }
-    }
-
-    const size_t numVertices = fatVertexBuffer.size();
-
-    // Determine the mapping between the FatVertex / FatWeight (input) data and the output VertexFormat items
-    struct SrcToDstMapping {
-        size_t srcOffset;
-        int destIndex;
-        int* srcOffsetArray;
-    };
-    std::array<int, sizeof(MeshObjectIntermediate::FatVertex) / sizeof(uint32_t)> copyOffsets;
-    std::array<int, sizeof(MeshObjectIntermediate::FatWeight) / sizeof(uint32_t)> copyWeightOffsets;
-    copyOffsets.fill(-1);
-    copyWeightOffsets.fill(-1);
-    for (const auto& srcOffset_DestIndex : {
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatVertex, position) / 4, positionIndex, copyOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatVertex, normal) / 4, normalIndex, copyOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatVertex, color) / 4, colorIndex, copyOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatVertex, uv0) / 4, uv0Index, copyOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatVertex, tangent) / 4, tangentIndex, copyOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatVertex, bitangent) / 4, bitangentIndex, copyOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatWeight, joint) / 4, jointIndex, copyWeightOffsets.data()},
-        SrcToDstMapping{offsetof(MeshObjectIntermediate::FatWeight, weight) / 4, weightIndex, copyWeightOffsets.data()},
-         })
-    {
-        const int destIndex = srcOffset_DestIndex.destIndex;
-        if (destIndex != -1)
-        {
-            uint32_t srcOffset32 = srcOffset_DestIndex.srcOffset;
-            int* srcOffsetArray = srcOffset_DestIndex.srcOffsetArray;
-            uint32_t destOffset = vertexFormat.elements[destIndex].offset;
-            assert((destOffset & 3) == 0);      // cannot handle non 4 byte aligned data
-            destOffset /= 4;
-            const uint32_t destSize = vertexFormat.elements[destIndex].type.size();
-            switch (destSize)
-            {
-            case 16:
-                srcOffsetArray[srcOffset32++] = destOffset++;
-            case 12:
-                srcOffsetArray[srcOffset32++] = destOffset++;
-            case 8:
-                srcOffsetArray[srcOffset32++] = destOffset++;
-            case 4:
-                srcOffsetArray[srcOffset32++] = destOffset++;
-                break;
-            default:
-                assert(0);
-                break;
-            }
-        }
-    }
-
-    const uint32_t destSpan32 = (uint32_t)vertexFormat.span / 4;  // span of output data (in 32bit words)
     assert((vertexFormat.span & 3) == 0);   // does not support spans that are not a multiple of 4
+    const VertexFormatConverter converter(vertexFormat);
 
     std::vector<uint32_t> outputData;
-    outputData.resize(destSpan32 * numVertices, 0/*zero buffer*/);
-
-    const uint32_t* pSrc = (const uint32_t*)fatVertexBuffer.data();
-    const uint32_t* pSrcWeight = fatWeightBuffer.empty() ? nullptr : (const uint32_t*)fatWeightBuffer.data();
-    uint32_t* pDst = outputData.data();
-
-    for (size_t i = 0; i < numVertices; ++i)
-    {
-        // Copy vertex data from tinyObjVertex to our buffer vertex format (compiler may decide to unroll this since copyOffsets.size() is known at compile time
-        for (uint32_t srcOffset = 0; srcOffset < copyOffsets.size(); ++srcOffset)
-        {
-            if (copyOffsets[srcOffset] >= 0)
-            {
-                pDst[copyOffsets[srcOffset]] = *pSrc;
-            }
-            ++pSrc;
-        }
-        // Copy vertex weights and joint idxs from tinyObjVertex to our buffer vertex format (compiler may decide to unroll this since copyWeightOffsets.size() is known at compile time
-        for (uint32_t srcOffset = 0; srcOffset < copyWeightOffsets.size(); ++srcOffset)
-        {
-            if (copyWeightOffsets[srcOffset] >= 0)
-            {
-                pDst[copyWeightOffsets[srcOffset]] = *pSrcWeight;
-            }
-            ++pSrcWeight;
-        }
-        pDst += destSpan32;
-    }   // WhichVert
-
+    outputData.resize(vertexFormat.span / 4 * fatVertexBuffer.size());
+    converter.Convert(fatVertexBuffer, fatWeightBuffer, { (uint8_t*)outputData.data(), outputData.size() * sizeof(uint32_t) });
     return outputData;
 }
 
@@ -759,7 +678,7 @@ size_t MeshObjectIntermediate::CalcNumTriangles() const
             using T = std::decay_t<decltype(m)>;
             if constexpr (std::is_same_v<T, std::vector<uint32_t>> || std::is_same_v<T, std::vector<uint16_t>> || std::is_same_v<T, std::vector<uint8_t>>)
             {
-                return m.size() / 3;
+                return (m_Lods.empty() ? m.size() : m_Lods[0].numIndices) / 3;
             }
             else
             {
@@ -770,6 +689,523 @@ size_t MeshObjectIntermediate::CalcNumTriangles() const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+uint32_t MeshObjectIntermediate::GenerateLods(uint32_t numLods, float targetError)
+{
+    // Get the (lod 0) indices as 32bit (simplifier works on 32bit indices), create them if the mesh is not indexed.
+    std::vector<uint32_t> indices = std::visit([&](const auto& m) -> std::vector<uint32_t>
+        {
+            using T = std::decay_t<decltype(m)>;
+            if constexpr (std::is_same_v<T, std::vector<uint32_t>> || std::is_same_v<T, std::vector<uint16_t>> || std::is_same_v<T, std::vector<uint8_t>>)
+            {
+                const auto indicesBegin = std::begin(m) + (m_Lods.empty() ? 0 : m_Lods[0].firstIndex);
+                const auto indicesEnd = m_Lods.empty() ? std::end(m) : indicesBegin + m_Lods[0].numIndices;
+                return { indicesBegin, indicesEnd };
+            }
+            else
+            {
+                std::vector<uint32_t> sequentialIndices(m_VertexBuffer.size());
+                std::iota(sequentialIndices.begin(), sequentialIndices.end(), 0);
+                return sequentialIndices;
+            }
+        }, m_IndexBuffer);
+
+    std::vector<LodRange> lods{ {0, (uint32_t)indices.size(), 0.0f} };
+    std::vector<uint32_t> lodIndices = indices;
+    for (uint32_t lod = 1; lod <= numLods; ++lod)
+    {
+        const size_t targetIndexCount = (lodIndices.size() / 6) * 3;   // half the triangles of the previous level
+        float lodError = 0.0f;
+        std::vector<uint32_t> simplifiedIndices = MeshSimplifier::Simplify(m_VertexBuffer, m_WeightBuffer, lodIndices, targetIndexCount, targetError, &lodError);
+
+        // Stop if we are not making significant gains (simplifier is limited by targetError or the mesh topology).
+        if (simplifiedIndices.empty() || simplifiedIndices.size() > (lodIndices.size() * 9) / 10)
+            break;
+
+        lods.push_back({ (uint32_t)indices.size(), (uint32_t)simplifiedIndices.size(), lods.rbegin()->error + lodError });  // errors accumulate (conservatively) as each level is simplified from the previous one
+        indices.insert(indices.end(), simplifiedIndices.begin(), simplifiedIndices.end());
+        lodIndices = std::move(simplifiedIndices);
+    }
+
+    if (lods.size() == 1)
+    {
+        // Nothing generated, leave the mesh untouched.
+        return (uint32_t) std::max(m_Lods.size(), size_t(1));
+    }
+
+    // Write back the index buffer (keeping the original index size if it was indexed, otherwise pick the smallest that fits).
+    const bool use32bit = std::holds_alternative<std::vector<uint32_t>>(m_IndexBuffer) || (std::holds_alternative<std::monostate>(m_IndexBuffer) && m_VertexBuffer.size() > 0xffff);
+    if (use32bit)
+        m_IndexBuffer.emplace<std::vector<uint32_t>>(std::move(indices));
+    else if (std::holds_alternative<std::vector<uint8_t>>(m_IndexBuffer))
+        m_IndexBuffer.emplace<std::vector<uint8_t>>(indices.begin(), indices.end());
+    else
+        m_IndexBuffer.emplace<std::vector<uint16_t>>(indices.begin(), indices.end());
+    m_Lods = std::move(lods);
+    return (uint32_t)m_Lods.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Store the given indices in the narrowest index buffer type usable by IndexBuffer (16 or 32bit)
+static void SetIndicesNarrowest(MeshObjectIntermediate::tIndexBuffer& indexBuffer, std::vector<uint32_t>&& indices)
+{
+    const uint32_t maxIndex = indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+    if (maxIndex <= 0xffff)
+        indexBuffer.emplace<std::vector<uint16_t>>(indices.begin(), indices.end());
+    else
+        indexBuffer.emplace<std::vector<uint32_t>>(std::move(indices));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<uint32_t> MeshObjectIntermediate::CopyIndices32() const
+{
+    return std::visit([&](const auto& m) -> std::vector<uint32_t>
+        {
+            using T = std::decay_t<decltype(m)>;
+            if constexpr (std::is_same_v<T, std::vector<uint32_t>> || std::is_same_v<T, std::vector<uint16_t>> || std::is_same_v<T, std::vector<uint8_t>>)
+            {
+                return { std::begin(m), std::end(m) };
+            }
+            else
+            {
+                std::vector<uint32_t> sequentialIndices(m_VertexBuffer.size());
+                std::iota(sequentialIndices.begin(), sequentialIndices.end(), 0);
+                return sequentialIndices;
+            }
+        }, m_IndexBuffer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t MeshObjectIntermediate::CalcMemorySize() const
+{
+    const size_t indexBufferSize = std::visit([](const auto& m) -> size_t
+        {
+            using T = std::decay_t<decltype(m)>;
+            if constexpr (std::is_same_v<T, std::monostate>)
+                return 0;
+            else
+                return m.size() * sizeof(typename T::value_type);
+        }, m_IndexBuffer);
+    return m_VertexBuffer.size() * sizeof(FatVertex) + m_WeightBuffer.size() * sizeof(FatWeight) + indexBufferSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshObjectIntermediate::MinimizeIndexWidth()
+{
+    if (std::holds_alternative<std::monostate>(m_IndexBuffer))
+        return;
+    SetIndicesNarrowest(m_IndexBuffer, CopyIndices32());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t MeshObjectIntermediate::WeldVertices(float epsilon)
+{
+    const size_t numVertices = m_VertexBuffer.size();
+    if (numVertices == 0)
+        return 0;
+    const bool hasWeights = !m_WeightBuffer.empty();
+    assert(!hasWeights || m_WeightBuffer.size() == numVertices);
+
+    // Build an integer 'key' for each vertex, float attributes are snapped to an epsilon sized grid (or used bitwise if epsilon is 0), integer attributes (material, joints) are used as-is.
+    static_assert(sizeof(FatVertex) % sizeof(uint32_t) == 0 && sizeof(FatWeight) % sizeof(uint32_t) == 0);
+    constexpr size_t cVertexFloats = offsetof(FatVertex, material) / sizeof(float);
+    constexpr size_t cVertexKeySize = sizeof(FatVertex) / sizeof(uint32_t);
+    constexpr size_t cWeightFloatsOffset = offsetof(FatWeight, weight) / sizeof(float);
+    constexpr size_t cWeightKeySize = sizeof(FatWeight) / sizeof(uint32_t);
+    const size_t keySize = cVertexKeySize + (hasWeights ? cWeightKeySize : 0);
+
+    // Keys are 64bit so any finite attribute can be snapped without overflowing (positions far from the origin would not fit in 32bits at small epsilons).
+    // Non-finite floats (and everything when epsilon is 0) use their bit pattern, offset to a range no snapped value can reach.
+    const double invEpsilon = epsilon > 0.0f ? 1.0 / double(epsilon) : 0.0;
+    constexpr double cMaxSnapped = double(1ll << 62);
+    const auto quantize = [invEpsilon, cMaxSnapped](float f) -> int64_t
+    {
+        if (invEpsilon > 0.0 && std::isfinite(f))
+            return (int64_t)std::clamp(std::floor(double(f) * invEpsilon + 0.5), -cMaxSnapped, cMaxSnapped);
+        f = (f == 0.0f) ? 0.0f : f;     // -0 == 0
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return std::numeric_limits<int64_t>::min() + int64_t(bits);
+    };
+
+    std::vector<int64_t> keys(numVertices * keySize);
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        int64_t* pKey = &keys[v * keySize];
+        int32_t vertexWords[cVertexKeySize];
+        memcpy(vertexWords, &m_VertexBuffer[v], sizeof(FatVertex));
+        for (size_t i = 0; i < cVertexKeySize; ++i)
+        {
+            float f;
+            memcpy(&f, &vertexWords[i], sizeof(f));
+            pKey[i] = i < cVertexFloats ? quantize(f) : int64_t(vertexWords[i]);
+        }
+        if (hasWeights)
+        {
+            pKey += cVertexKeySize;
+            int32_t weightWords[cWeightKeySize];
+            memcpy(weightWords, &m_WeightBuffer[v], sizeof(FatWeight));
+            for (size_t i = 0; i < cWeightKeySize; ++i)
+            {
+                float f;
+                memcpy(&f, &weightWords[i], sizeof(f));
+                pKey[i] = i >= cWeightFloatsOffset ? quantize(f) : int64_t(weightWords[i]);
+            }
+        }
+    }
+
+    // Find the unique keys (first vertex with a given key is the one that is kept).
+    std::vector<uint32_t> remap(numVertices);
+    std::vector<uint32_t> uniqueVertices;
+    uniqueVertices.reserve(numVertices);
+    std::unordered_multimap<uint32_t, uint32_t> keyHashes;   // hash -> index of unique vertex (in the original vertex buffer)
+    keyHashes.reserve(numVertices);
+    for (uint32_t v = 0; v < (uint32_t)numVertices; ++v)
+    {
+        const int64_t* pKey = &keys[v * keySize];
+        const uint32_t hash = crc32c(0, { (const uint8_t*)pKey, keySize * sizeof(int64_t) });
+        const auto [rangeBegin, rangeEnd] = keyHashes.equal_range(hash);
+        const auto match = std::find_if(rangeBegin, rangeEnd, [&](const auto& it) { return memcmp(&keys[it.second * keySize], pKey, keySize * sizeof(int64_t)) == 0; });
+        if (match != rangeEnd)
+        {
+            remap[v] = remap[match->second];
+        }
+        else
+        {
+            remap[v] = (uint32_t)uniqueVertices.size();
+            uniqueVertices.push_back(v);
+            keyHashes.emplace(hash, v);
+        }
+    }
+
+    std::vector<uint32_t> indices = CopyIndices32();
+    const size_t numRemoved = numVertices - uniqueVertices.size();
+    if (numRemoved > 0)
+    {
+        tVertexBuffer weldedVertices;
+        weldedVertices.reserve(uniqueVertices.size());
+        for (const uint32_t v : uniqueVertices)
+            weldedVertices.push_back(m_VertexBuffer[v]);
+        m_VertexBuffer = std::move(weldedVertices);
+        if (hasWeights)
+        {
+            tWeightBuffer weldedWeights;
+            weldedWeights.reserve(uniqueVertices.size());
+            for (const uint32_t v : uniqueVertices)
+                weldedWeights.push_back(m_WeightBuffer[v]);
+            m_WeightBuffer = std::move(weldedWeights);
+        }
+        for (auto& index : indices)
+            index = remap[index];
+    }
+    SetIndicesNarrowest(m_IndexBuffer, std::move(indices));
+    return numRemoved;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<MeshObjectIntermediate> MeshObjectIntermediate::SplitForIndex16(bool onlyIfBeneficial) const
+{
+    constexpr size_t cMaxChunkVertices = 0x10000;
+    if (m_VertexBuffer.size() <= cMaxChunkVertices || !m_Lods.empty() || !m_SubMeshes.empty())
+        return {};
+
+    // Greedily add triangles to the current chunk until it cannot address any more vertices.
+    const std::vector<uint32_t> indices = CopyIndices32();
+    constexpr uint32_t cNotInChunk = ~0u;
+    std::vector<uint32_t> vertexToChunkVertex(m_VertexBuffer.size(), cNotInChunk);
+    std::vector<std::vector<uint32_t>> chunkVertices(1);    // original vertex index for each vertex in each chunk
+    std::vector<std::vector<uint16_t>> chunkIndices(1);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const size_t numNewVertices = std::count_if(&indices[i], &indices[i + 3], [&](uint32_t index) { return vertexToChunkVertex[index] == cNotInChunk; });
+        if (chunkVertices.rbegin()->size() + numNewVertices > cMaxChunkVertices)
+        {
+            for (const uint32_t v : *chunkVertices.rbegin())
+                vertexToChunkVertex[v] = cNotInChunk;
+            chunkVertices.emplace_back();
+            chunkIndices.emplace_back();
+        }
+        for (size_t t = i; t < i + 3; ++t)
+        {
+            uint32_t& chunkVertex = vertexToChunkVertex[indices[t]];
+            if (chunkVertex == cNotInChunk)
+            {
+                chunkVertex = (uint32_t)chunkVertices.rbegin()->size();
+                chunkVertices.rbegin()->push_back(indices[t]);
+            }
+            chunkIndices.rbegin()->push_back((uint16_t)chunkVertex);
+        }
+    }
+
+    if (onlyIfBeneficial)
+    {
+        // Vertices shared by triangles in different chunks are duplicated, make sure that costs less than we save by using 16bit indices.
+        size_t totalChunkVertices = 0;
+        for (const auto& vertices : chunkVertices)
+            totalChunkVertices += vertices.size();
+        const size_t vertexSize = sizeof(FatVertex) + (m_WeightBuffer.empty() ? 0 : sizeof(FatWeight));
+        const size_t duplicatedVertexBytes = totalChunkVertices > m_VertexBuffer.size() ? (totalChunkVertices - m_VertexBuffer.size()) * vertexSize : 0;
+        const size_t savedIndexBytes = std::holds_alternative<std::vector<uint16_t>>(m_IndexBuffer) ? 0 : indices.size() * (sizeof(uint32_t) - sizeof(uint16_t));
+        if (duplicatedVertexBytes >= savedIndexBytes)
+            return {};
+    }
+
+    std::vector<MeshObjectIntermediate> chunks;
+    chunks.reserve(chunkVertices.size());
+    for (size_t c = 0; c < chunkVertices.size(); ++c)
+    {
+        MeshObjectIntermediate& chunk = chunks.emplace_back();
+        chunk.m_MeshName = m_MeshName + "_" + std::to_string(c);
+        chunk.m_NodeName = m_NodeName;
+        chunk.m_VertexBuffer.reserve(chunkVertices[c].size());
+        for (const uint32_t v : chunkVertices[c])
+            chunk.m_VertexBuffer.push_back(m_VertexBuffer[v]);
+        if (!m_WeightBuffer.empty())
+        {
+            chunk.m_WeightBuffer.reserve(chunkVertices[c].size());
+            for (const uint32_t v : chunkVertices[c])
+                chunk.m_WeightBuffer.push_back(m_WeightBuffer[v]);
+        }
+        chunk.m_IndexBuffer.emplace<std::vector<uint16_t>>(std::move(chunkIndices[c]));
+        chunk.m_Materials = m_Materials;
+        chunk.m_Transform = m_Transform;
+        chunk.m_NodeId = m_NodeId;
+        chunk.m_WeightsPerVertex = m_WeightsPerVertex;
+    }
+    return chunks;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<MeshObjectIntermediate> MeshObjectIntermediate::SplitByMaterial() const
+{
+    if (m_Materials.size() <= 1 || !m_Lods.empty())
+        return {};
+
+    // Sort the triangles by material.
+    const std::vector<uint32_t> indices = CopyIndices32();
+    std::vector<std::vector<uint32_t>> materialIndices(m_Materials.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const int material = m_VertexBuffer[indices[i]].material;
+        auto& dstIndices = materialIndices[(material >= 0 && material < (int)m_Materials.size()) ? material : 0];
+        dstIndices.insert(dstIndices.end(), &indices[i], &indices[i + 3]);
+    }
+    // Nothing to do if only the first material is used (a single mesh is still output if it only uses one of the other materials).
+    if (std::count_if(materialIndices.begin() + 1, materialIndices.end(), [](const auto& m) { return !m.empty(); }) == 0)
+        return {};
+
+    const bool indexed = !std::holds_alternative<std::monostate>(m_IndexBuffer);
+    constexpr uint32_t cNotInSplit = ~0u;
+    std::vector<uint32_t> vertexToSplitVertex(m_VertexBuffer.size(), cNotInSplit);
+    std::vector<MeshObjectIntermediate> splitMeshObjects;
+    for (size_t m = 0; m < materialIndices.size(); ++m)
+    {
+        if (materialIndices[m].empty())
+            continue;
+        MeshObjectIntermediate& split = splitMeshObjects.emplace_back();
+        split.m_MeshName = m_MeshName + "_" + m_Materials[m].materialName;
+        split.m_NodeName = m_NodeName;
+        split.m_Materials.push_back(m_Materials[m]);
+        split.m_Transform = m_Transform;
+        split.m_NodeId = m_NodeId;
+        split.m_WeightsPerVertex = m_WeightsPerVertex;
+
+        // Only copy the vertices used by this material (keep non indexed meshes non indexed).
+        std::vector<uint32_t> splitIndices;
+        splitIndices.reserve(materialIndices[m].size());
+        for (const uint32_t index : materialIndices[m])
+        {
+            uint32_t& splitVertex = vertexToSplitVertex[index];
+            if (splitVertex == cNotInSplit || !indexed)
+            {
+                splitVertex = (uint32_t)split.m_VertexBuffer.size();
+                split.m_VertexBuffer.push_back(m_VertexBuffer[index]);
+                split.m_VertexBuffer.back().material = 0;
+                if (!m_WeightBuffer.empty())
+                    split.m_WeightBuffer.push_back(m_WeightBuffer[index]);
+            }
+            splitIndices.push_back(splitVertex);
+        }
+        for (const uint32_t index : materialIndices[m])
+            vertexToSplitVertex[index] = cNotInSplit;
+        if (indexed)
+            SetIndicesNarrowest(split.m_IndexBuffer, std::move(splitIndices));
+    }
+    return splitMeshObjects;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*static*/ std::vector<MeshObjectIntermediate> MeshObjectIntermediate::OptimizeMeshes(std::vector<MeshObjectIntermediate>&& meshObjects, float weldEpsilon)
+{
+    std::vector<MeshObjectIntermediate> optimizedMeshObjects;
+    optimizedMeshObjects.reserve(meshObjects.size());
+
+    size_t totalOriginalSize = 0;
+    size_t totalOptimizedSize = 0;
+    for (auto& meshObject : meshObjects)
+    {
+        const size_t originalNumVertices = meshObject.m_VertexBuffer.size();
+        const size_t originalSize = meshObject.CalcMemorySize();
+        const std::string meshName = meshObject.m_MeshName;
+
+        meshObject.WeldVertices(weldEpsilon);
+
+        size_t optimizedNumVertices = 0;
+        size_t optimizedSize = 0;
+        auto splitMeshObjects = meshObject.SplitForIndex16();
+        const size_t numSplit = splitMeshObjects.size();
+        if (splitMeshObjects.empty())
+        {
+            optimizedNumVertices = meshObject.m_VertexBuffer.size();
+            optimizedSize = meshObject.CalcMemorySize();
+            optimizedMeshObjects.push_back(std::move(meshObject));
+        }
+        else
+        {
+            for (auto& splitMeshObject : splitMeshObjects)
+            {
+                optimizedNumVertices += splitMeshObject.m_VertexBuffer.size();
+                optimizedSize += splitMeshObject.CalcMemorySize();
+                optimizedMeshObjects.push_back(std::move(splitMeshObject));
+            }
+        }
+        totalOriginalSize += originalSize;
+        totalOptimizedSize += optimizedSize;
+
+        if (numSplit > 0)
+            LOGI("  Mesh \"%s\": %zu -> %zu vertices, %zu -> %zu bytes (split in to %zu meshes with 16bit indices)", meshName.c_str(), originalNumVertices, optimizedNumVertices, originalSize, optimizedSize, numSplit);
+        else
+            LOGI("  Mesh \"%s\": %zu -> %zu vertices, %zu -> %zu bytes", meshName.c_str(), originalNumVertices, optimizedNumVertices, originalSize, optimizedSize);
+    }
+    meshObjects.clear();
+    LOGI("Optimized %zu meshes: %zu -> %zu bytes", optimizedMeshObjects.size(), totalOriginalSize, totalOptimizedSize);
+    return optimizedMeshObjects;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*static*/ std::vector<MeshObjectIntermediate> MeshObjectIntermediate::SplitMeshesByMaterial(std::vector<MeshObjectIntermediate>&& meshObjects)
+{
+    std::vector<MeshObjectIntermediate> splitMeshObjects;
+    splitMeshObjects.reserve(meshObjects.size());
+    for (auto& meshObject : meshObjects)
+    {
+        auto split = meshObject.SplitByMaterial();
+        if (split.empty())
+            splitMeshObjects.push_back(std::move(meshObject));
+        else
+            std::move(split.begin(), split.end(), std::back_inserter(splitMeshObjects));
+    }
+    meshObjects.clear();
+    return splitMeshObjects;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*static*/ std::vector<MeshObjectIntermediate> MeshObjectIntermediate::BatchStatic(std::vector<MeshObjectIntermediate>&& meshObjects, uint32_t maxVerticesPerBatch)
+{
+    std::vector<MeshObjectIntermediate> splitMeshObjects = SplitMeshesByMaterial(std::move(meshObjects));
+    const size_t numInputMeshes = splitMeshObjects.size();
+
+    // Group the meshes by material (in order of first use).  Meshes with no material are grouped together.
+    // Skinned meshes and meshes with levels of detail each get a group to themselves (are not batched).
+    std::vector<std::vector<size_t>> groups;
+    std::vector<const MaterialDef*> groupMaterials;     // nullptr for groups that cannot be batched
+    const MaterialDef noMaterial{};
+    for (size_t meshIdx = 0; meshIdx < splitMeshObjects.size(); ++meshIdx)
+    {
+        const auto& meshObject = splitMeshObjects[meshIdx];
+        const MaterialDef* pMaterial = nullptr;
+        if (meshObject.m_WeightBuffer.empty() && meshObject.m_Lods.empty() && meshObject.m_SubMeshes.empty())
+            pMaterial = meshObject.m_Materials.empty() ? &noMaterial : &meshObject.m_Materials[0];
+        const auto groupIt = pMaterial ? std::find_if(groupMaterials.begin(), groupMaterials.end(), [pMaterial](const MaterialDef* p) { return p && *p == *pMaterial; }) : groupMaterials.end();
+        if (groupIt == groupMaterials.end())
+        {
+            groups.push_back({ meshIdx });
+            groupMaterials.push_back(pMaterial);
+        }
+        else
+            groups[groupIt - groupMaterials.begin()].push_back(meshIdx);
+    }
+
+    std::vector<MeshObjectIntermediate> batchedMeshObjects;
+    batchedMeshObjects.reserve(groups.size());
+    size_t numBatches = 0;
+    for (size_t groupIdx = 0; groupIdx < groups.size(); ++groupIdx)
+    {
+        const auto& group = groups[groupIdx];
+        if (group.size() == 1 || !groupMaterials[groupIdx])
+        {
+            for (const size_t meshIdx : group)
+                batchedMeshObjects.push_back(std::move(splitMeshObjects[meshIdx]));
+            continue;
+        }
+
+        const MaterialDef groupMaterial = *groupMaterials[groupIdx];  // copy, the meshes (and their materials) are released as they are batched
+        MeshObjectIntermediate* pBatch = nullptr;   // points in to batchedMeshObjects, which must not grow while a batch is being built
+        std::vector<uint32_t> batchIndices;
+        const auto finishBatch = [&]() {
+            if (pBatch)
+                SetIndicesNarrowest(pBatch->m_IndexBuffer, std::move(batchIndices));
+            batchIndices = {};
+            pBatch = nullptr;
+        };
+        for (const size_t meshIdx : group)
+        {
+            auto& meshObject = splitMeshObjects[meshIdx];
+            if (pBatch && maxVerticesPerBatch > 0 && pBatch->m_VertexBuffer.size() + meshObject.m_VertexBuffer.size() > maxVerticesPerBatch)
+                finishBatch();
+            if (!pBatch)
+            {
+                if (batchedMeshObjects.size() == batchedMeshObjects.capacity())
+                    batchedMeshObjects.reserve(batchedMeshObjects.size() * 2);
+                pBatch = &batchedMeshObjects.emplace_back();
+                pBatch->m_MeshName = "Batch" + std::to_string(numBatches++) + "_" + groupMaterial.materialName;
+                if (!meshObject.m_Materials.empty())
+                    pBatch->m_Materials.push_back(groupMaterial);
+            }
+
+            const int nodeId = meshObject.m_NodeId;
+            meshObject.BakeTransform();
+
+            const uint32_t firstVertex = (uint32_t)pBatch->m_VertexBuffer.size();
+            SubMeshRange& subMesh = pBatch->m_SubMeshes.emplace_back();
+            subMesh.firstIndex = (uint32_t)batchIndices.size();
+            subMesh.nodeId = nodeId;
+            if (!meshObject.m_VertexBuffer.empty())
+            {
+                subMesh.boundsMin = subMesh.boundsMax = glm::vec3(meshObject.m_VertexBuffer[0].position[0], meshObject.m_VertexBuffer[0].position[1], meshObject.m_VertexBuffer[0].position[2]);
+                for (const auto& vertex : meshObject.m_VertexBuffer)
+                {
+                    const glm::vec3 position(vertex.position[0], vertex.position[1], vertex.position[2]);
+                    subMesh.boundsMin = glm::min(subMesh.boundsMin, position);
+                    subMesh.boundsMax = glm::max(subMesh.boundsMax, position);
+                }
+            }
+            for (const uint32_t index : meshObject.CopyIndices32())
+                batchIndices.push_back(firstVertex + index);
+            subMesh.numIndices = (uint32_t)batchIndices.size() - subMesh.firstIndex;
+
+            pBatch->m_VertexBuffer.insert(pBatch->m_VertexBuffer.end(), meshObject.m_VertexBuffer.begin(), meshObject.m_VertexBuffer.end());
+            for (auto it = pBatch->m_VertexBuffer.begin() + firstVertex; it != pBatch->m_VertexBuffer.end(); ++it)
+                it->material = 0;
+            meshObject.Release();
+        }
+        finishBatch();
+    }
+    LOGI("Static batching: %zu meshes -> %zu meshes (%zu batches)", numInputMeshes, batchedMeshObjects.size(), numBatches);
+    return batchedMeshObjects;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 /*static*/ std::vector<std::string> MeshObjectIntermediate::ExtractTextureNames(const std::vector<MeshObjectIntermediate>& meshObjects)
 {
     std::set<std::string> textureNames;
@@ -791,6 +1227,28 @@ size_t MeshObjectIntermediate::CalcNumTriangles() const
     return textureNamesVector;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshObjectIntermediate::UvsInUnitRange(int material) const
+{
+    return std::all_of(m_VertexBuffer.begin(), m_VertexBuffer.end(), [material](const FatVertex& vertex) {
+        return vertex.material != material || (vertex.uv0[0] >= 0.0f && vertex.uv0[0] <= 1.0f && vertex.uv0[1] >= 0.0f && vertex.uv0[1] <= 1.0f);
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshObjectIntermediate::RemapUvs(int material, const glm::vec4& uvScaleOffset)
+{
+    for (auto& vertex : m_VertexBuffer)
+    {
+        if (vertex.material != material)
+            continue;
+        vertex.uv0[0] = vertex.uv0[0] * uvScaleOffset.x + uvScaleOffset.z;
+        vertex.uv0[1] = vertex.uv0[1] * uvScaleOffset.y + uvScaleOffset.w;
+    }
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 
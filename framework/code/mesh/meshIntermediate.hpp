@@ -39,12 +39,66 @@ public:
     void BakeTransform();
 
     /// Create a new mesh with index data 'flattened' into the vertex data (so 3 vertices per triangle and duplication where appropriate)
+    /// Only the most detailed level of detail is copied.
     MeshObjectIntermediate CopyFlattened() const;
 
+    /// Generate (up to) numLods additional levels of detail, each having (approximately) half the triangles of the previous level.
+    /// The levels of detail are appended to m_IndexBuffer (sharing m_VertexBuffer) and described by m_Lods.  Creates an index buffer if the mesh does not already have one.
+    /// Stops generating levels early if the next level would exceed the targetError or does not reduce the triangle count significantly.
+    /// @param numLods number of levels of detail to generate (in addition to the original mesh, which becomes lod 0)
+    /// @param targetError maximum simplification error (relative to the mesh extents, eg 0.01 is 1% of the largest mesh dimension)
+    /// @returns number of levels of detail the mesh now has (including lod 0)
+    uint32_t GenerateLods(uint32_t numLods, float targetError);
+
+    /// Merge vertices (and their weights) whose attributes are all within epsilon of each other, building/remapping m_IndexBuffer to reference the remaining vertices.
+    /// Attributes are quantized to a grid of size epsilon and hashed, so vertices that straddle a grid cell boundary may not be merged; an epsilon of 0 only merges bitwise identical vertices.
+    /// Index buffer is left at the narrowest index width (see MinimizeIndexWidth).
+    /// @returns number of vertices removed
+    size_t WeldVertices(float epsilon = 0.0f);
+
+    /// Convert m_IndexBuffer to the narrowest index type that can be used for an IndexBuffer (16bit if all the indices fit, otherwise 32bit).  8bit indices are promoted to 16bit.
+    /// Does nothing if the mesh has no index buffer.
+    void MinimizeIndexWidth();
+
+    /// Split the mesh in to chunks that can each be drawn with 16bit indices (each chunk referencing no more than 65536 vertices).
+    /// Meshes already addressable with 16bit indices (and meshes with levels of detail) are not split (returned vector is empty).
+    /// @param onlyIfBeneficial only split if the index buffer memory saved is larger than the memory used by vertices duplicated between chunks
+    /// @returns the split meshes (empty if the mesh was not split, in which case this mesh should continue to be used)
+    std::vector<MeshObjectIntermediate> SplitForIndex16(bool onlyIfBeneficial = true) const;
+
+    /// Split a mesh whose faces use more than one of its m_Materials (FatVertex::material, taken from the first vertex of each triangle) in to one mesh per material.
+    /// Meshes with levels of detail are not split.
+    /// @returns the split meshes, each with a single material (empty if the mesh only uses its first material, in which case this mesh should continue to be used)
+    std::vector<MeshObjectIntermediate> SplitByMaterial() const;
+
+    /// Copy of the (entire) index buffer as 32bit indices.  Generates sequential indices if the mesh has no index buffer.
+    std::vector<uint32_t> CopyIndices32() const;
+
+    /// @brief Calculate the memory (bytes) used by the vertex, weight and index buffers.
+    size_t CalcMemorySize() const;
+
+    /// Weld vertices, minimize the index width and (where beneficial) split meshes that are too large for 16bit indices.  Logs the vertex count and memory reduction for each mesh.
+    /// @returns the optimized meshes (may contain more meshes than the input if meshes were split)
+    static std::vector<MeshObjectIntermediate> OptimizeMeshes(std::vector<MeshObjectIntermediate>&& meshObjects, float weldEpsilon = 0.0f);
+
+    /// Split any meshes that use more than one material (see SplitByMaterial).
+    static std::vector<MeshObjectIntermediate> SplitMeshesByMaterial(std::vector<MeshObjectIntermediate>&& meshObjects);
+
+    /// Static batching.  Merge meshes that use the same material in to combined meshes (fewer draw calls and pipeline/descriptor binds).
+    /// Multi material meshes are split first (SplitMeshesByMaterial).  Transforms are baked in to the vertex data and each batched mesh is indexed, with m_SubMeshes describing the
+    /// index range and bounds of each mesh it was built from.  Meshes with vertex weights or levels of detail, and materials used by a single mesh, are returned unchanged.
+    /// @param maxVerticesPerBatch start a new batch (for the same material) rather than exceed this many vertices (0 for no limit)
+    /// @returns the batched (and unchanged) meshes
+    static std::vector<MeshObjectIntermediate> BatchStatic(std::vector<MeshObjectIntermediate>&& meshObjects, uint32_t maxVerticesPerBatch = 0);
+
     /// Loads a .obj and .mtl file and builds a single vector array containing an object
-    /// for each shape that contains all vertex positions, normals, materials and colors.
+    /// for each shape (and material) that contains all vertex positions, normals, materials and colors.
+    /// Uses ObjLoader (memory mapped and parsed on multiple threads).
     static std::vector<MeshObjectIntermediate> LoadObj(AssetManager& assetManager, const std::string& filename);
 
+    /// Same as LoadObj but loaded (single threaded) with tinyobjloader.  Slower, kept as a reference for ObjLoader.
+    static std::vector<MeshObjectIntermediate> LoadObjTinyObj(AssetManager& assetManager, const std::string& filename);
+
     /// Loads a .gltf file and builds a single vector array containing an object
     /// for each shape in the gltf that contains all vertex positions, normals and colors along with an array of the materials in the gltf file.
     /// @param ignoreTransforms Dont use the gltf node transforms (generate MeshObjectIntermediate with the indentity position/rotation/scale).  Still applies globalScale!
@@ -92,8 +146,12 @@ public:
         int                 nodeId;
     };
 
+    /// Calculate (per face) tangents and bitangents for a non indexed triangle list (3 vertices per triangle) from the vertex positions, normals and uv0.
+    static void CalculateFlatTangents(std::span<FatVertex> triangleVertices);
+
     /// Creates a 'raw' array of data from a 'fat' MeshObjectIntermediate object, with the returned data being formatted in the way described by vertexFormat
     /// fatWeightBuffer may be empty if not required/supported, if not empty must have the same number of vertices as fatVertexBuffer.
+    /// Use VertexFormatConverter directly to avoid the intermediate vector (eg to write directly in to a mapped vertex buffer).
     /// @returns data in the requested vertexFormat
     static std::vector<uint32_t> CopyFatVertexToFormattedBuffer(const std::span<const MeshObjectIntermediate::FatVertex>& fatVertexBuffer, const std::span<const MeshObjectIntermediate::FatWeight>& fatWeightBuffer, const VertexFormat& vertexFormat);
 
@@ -102,13 +160,20 @@ public:
     /// @returns data in the requested vertexFormat
     static std::vector<uint32_t> CopyFatInstanceToFormattedBuffer(const std::span<const MeshObjectIntermediate::FatInstance>& fatVertexBuffer, const VertexFormat& vertexFormat);
 
-    /// @brief Calculate the number of triangles in the object.  Will use the index buffer if we have one.
+    /// @brief Calculate the number of triangles in the object (in the most detailed lod).  Will use the index buffer if we have one.
     size_t CalcNumTriangles() const;
 
     /// @brief Return a vactor of the unique texture names referenced in the given MeshObjectIntermediate s.
     /// Can then be fed into TextureManager::BatchLoad (or whatever)
     static std::vector<std::string> ExtractTextureNames(const std::vector<MeshObjectIntermediate>&);
 
+    /// @return true if uv0 of every vertex using the given material (FatVertex::material) is within 0-1, ie the material's textures can be atlased (TexturePackerSet::allowAtlas).
+    bool UvsInUnitRange(int material) const;
+
+    /// Remap uv0 of every vertex using the given material (FatVertex::material) in to its atlas region, uv = uv * uvScaleOffset.xy + uvScaleOffset.zw
+    /// (eg with TexturePackLayout::setUvScaleOffsets after packing the material's textures).
+    void RemapUvs(int material, const glm::vec4& uvScaleOffset);
+
     /// High level description of a material attached to the vertexbuffer (and indexed by FatVertex::material)
     struct MaterialDef
     {
@@ -128,10 +193,29 @@ public:
 
         bool            alphaCutout = false;
         bool            transparent = false;
+        bool operator==(const MaterialDef&) const = default;
         friend void to_json( nlohmann::json& j, const MeshObjectIntermediate::MaterialDef& material );
         friend void from_json( const nlohmann::json& j, MeshObjectIntermediate::MaterialDef& material );
     };
 
+    /// Range of m_IndexBuffer making up one level of detail.
+    struct LodRange
+    {
+        uint32_t        firstIndex = 0;
+        uint32_t        numIndices = 0;
+        float           error = 0.0f;       ///< simplification error (in object space units) compared to lod 0
+    };
+
+    /// Range of m_IndexBuffer that was a separate mesh before static batching (see BatchStatic).
+    struct SubMeshRange
+    {
+        uint32_t        firstIndex = 0;
+        uint32_t        numIndices = 0;
+        glm::vec3       boundsMin = glm::vec3(0.0f);    ///< bounding box of the sub mesh (in the batched mesh's space)
+        glm::vec3       boundsMax = glm::vec3(0.0f);
+        int             nodeId = -1;                    ///< m_NodeId of the mesh before it was batched
+    };
+
 public:
     using tVertexBuffer = std::vector<FatVertex>;
     using tWeightBuffer = std::vector<FatWeight>;
@@ -145,6 +229,10 @@ public:
     tWeightBuffer               m_WeightBuffer;  //< vertex weights (or empty)
     /// Index buffer can be 16bit or 32bit (or not exist; in which case every 3 vertices in m_VertexBuffer are the verts of a triangle).
     tIndexBuffer                m_IndexBuffer;
+    /// Levels of detail (ranges within m_IndexBuffer), most detailed first.  Empty if the mesh only has a single level of detail (the entire m_IndexBuffer).
+    std::vector<LodRange>       m_Lods;
+    /// Meshes this mesh was batched from (ranges within m_IndexBuffer).  Empty if the mesh was not built by BatchStatic.
+    std::vector<SubMeshRange>   m_SubMeshes;
     std::vector<MaterialDef>    m_Materials;
 
     /// World position transform for this mesh object
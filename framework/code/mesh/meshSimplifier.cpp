@@ -0,0 +1,386 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "meshSimplifier.hpp"
+#include "system/crc32c.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+    /// Symmetric 4x4 quadric (stored as the 10 unique values).
+    struct Quadric
+    {
+        double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+        double           b2 = 0.0, bc = 0.0, bd = 0.0;
+        double                      c2 = 0.0, cd = 0.0;
+        double                                 d2 = 0.0;
+        double weight = 0.0;
+
+        static Quadric FromPlane( double a, double b, double c, double d, double weight )
+        {
+            Quadric q;
+            q.a2 = weight * a * a; q.ab = weight * a * b; q.ac = weight * a * c; q.ad = weight * a * d;
+            q.b2 = weight * b * b; q.bc = weight * b * c; q.bd = weight * b * d;
+            q.c2 = weight * c * c; q.cd = weight * c * d;
+            q.d2 = weight * d * d;
+            q.weight = weight;
+            return q;
+        }
+
+        Quadric& operator+=( const Quadric& o )
+        {
+            a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+            b2 += o.b2; bc += o.bc; bd += o.bd;
+            c2 += o.c2; cd += o.cd;
+            d2 += o.d2;
+            weight += o.weight;
+            return *this;
+        }
+
+        /// Squared distance error of position p (v^T Q v), normalized by the accumulated plane weights
+        double Error( const double* p ) const
+        {
+            const double x = p[0], y = p[1], z = p[2];
+            const double e = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+                                        + b2 * y * y       + 2.0 * bc * y * z + 2.0 * bd * y
+                                                           + c2 * z * z       + 2.0 * cd * z
+                                                                              + d2;
+            return weight > 0.0 ? std::max( e, 0.0 ) / weight : 0.0;
+        }
+    };
+
+    struct Vec3d
+    {
+        double x, y, z;
+    };
+    inline Vec3d Sub( const double* a, const double* b ) { return {a[0] - b[0], a[1] - b[1], a[2] - b[2]}; }
+    inline Vec3d Cross( const Vec3d& a, const Vec3d& b ) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+    inline double Dot( const Vec3d& a, const Vec3d& b ) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    /// Candidate half edge collapse (src vertex is moved on to dst).
+    struct Collapse
+    {
+        uint32_t srcWedge;
+        uint32_t dstWedge;
+        double   error;
+    };
+
+    // Weight applied to the (perpendicular) planes added along open borders, stops borders from shrinking or wandering.
+    constexpr double cBorderWeight = 10.0;
+
+    inline uint64_t EdgeKey( uint32_t a, uint32_t b )
+    {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+}
+
+
+std::vector<uint32_t> MeshSimplifier::Simplify( std::span<const MeshObjectIntermediate::FatVertex> vertices, std::span<const MeshObjectIntermediate::FatWeight> weights, std::span<const uint32_t> indices, size_t targetIndexCount, float targetError, float* pResultError )
+{
+    if (pResultError)
+        *pResultError = 0.0f;
+
+    const uint32_t numVertices = (uint32_t) vertices.size();
+    assert( weights.empty() || weights.size() == vertices.size() );
+    assert( (indices.size() % 3) == 0 );
+    if (indices.empty())
+        return {};
+
+    //
+    // Determine the 'wedges' (vertices with identical attributes, eg flattened input may have many copies of the same vertex) and
+    // the unique positions (a position may be referenced by multiple wedges along an attribute seam).
+    //
+    std::vector<uint32_t> wedgeRemap( numVertices );
+    std::vector<uint32_t> positionRemap( numVertices );
+    {
+        std::unordered_multimap<uint32_t, uint32_t> wedgeHash;
+        std::unordered_multimap<uint32_t, uint32_t> positionHash;
+        wedgeHash.reserve( numVertices );
+        positionHash.reserve( numVertices );
+        for (uint32_t i = 0; i < numVertices; ++i)
+        {
+            const auto& vertex = vertices[i];
+
+            uint32_t hash = crc32c( 0, {(const uint8_t*) &vertex, sizeof( vertex )} );
+            if (!weights.empty())
+                hash = crc32c( hash, {(const uint8_t*) &weights[i], sizeof( weights[i] )} );
+            wedgeRemap[i] = i;
+            for (auto [it, itEnd] = wedgeHash.equal_range( hash ); it != itEnd; ++it)
+            {
+                const uint32_t other = it->second;
+                if (memcmp( &vertices[other], &vertex, sizeof( vertex ) ) == 0 && (weights.empty() || memcmp( &weights[other], &weights[i], sizeof( weights[i] ) ) == 0))
+                {
+                    wedgeRemap[i] = other;
+                    break;
+                }
+            }
+            if (wedgeRemap[i] != i)
+            {
+                positionRemap[i] = positionRemap[wedgeRemap[i]];
+                continue;
+            }
+            wedgeHash.emplace( hash, i );
+
+            const uint32_t positionCrc = crc32c( 0, {(const uint8_t*) vertex.position, sizeof( vertex.position )} );
+            positionRemap[i] = i;
+            for (auto [it, itEnd] = positionHash.equal_range( positionCrc ); it != itEnd; ++it)
+            {
+                if (memcmp( vertices[it->second].position, vertex.position, sizeof( vertex.position ) ) == 0)
+                {
+                    positionRemap[i] = it->second;
+                    break;
+                }
+            }
+            if (positionRemap[i] == i)
+                positionHash.emplace( positionCrc, i );
+        }
+    }
+
+    // Positions with more than one wedge are on a seam, they are locked.
+    std::vector<uint8_t> seam( numVertices, 0 );
+    {
+        std::vector<uint32_t> firstWedge( numVertices, ~0u );
+        for (uint32_t i = 0; i < numVertices; ++i)
+        {
+            if (wedgeRemap[i] != i)
+                continue;
+            uint32_t& first = firstWedge[positionRemap[i]];
+            if (first == ~0u)
+                first = i;
+            else if (first != i)
+                seam[positionRemap[i]] = 1;
+        }
+    }
+
+    //
+    // Normalize positions in to a unit box (makes the error metric relative to the mesh size).
+    //
+    double boundsMin[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    double boundsMax[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (uint32_t index : indices)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            boundsMin[c] = std::min( boundsMin[c], (double) vertices[index].position[c] );
+            boundsMax[c] = std::max( boundsMax[c], (double) vertices[index].position[c] );
+        }
+    }
+    const double extent = std::max( {boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2], std::numeric_limits<double>::min()} );
+    std::vector<double> positions( numVertices * 3 );
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+            positions[i * 3 + c] = (vertices[i].position[c] - boundsMin[c]) / extent;
+    }
+    auto Position = [&positions]( uint32_t v ) -> const double* { return &positions[v * 3]; };
+
+    //
+    // Output starts as the input with the wedges remapped (and degenerate triangles removed).
+    //
+    std::vector<uint32_t> result;
+    result.reserve( indices.size() );
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const uint32_t a = wedgeRemap[indices[i]], b = wedgeRemap[indices[i + 1]], c = wedgeRemap[indices[i + 2]];
+        if (positionRemap[a] != positionRemap[b] && positionRemap[b] != positionRemap[c] && positionRemap[c] != positionRemap[a])
+        {
+            result.push_back( a );
+            result.push_back( b );
+            result.push_back( c );
+        }
+    }
+
+    //
+    // Accumulate the (area weighted) triangle plane quadrics in to each (unique position) vertex.
+    //
+    std::vector<Quadric> quadrics( numVertices );
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        edgeCounts.reserve( result.size() );
+        for (size_t t = 0; t < result.size(); t += 3)
+            for (int e = 0; e < 3; ++e)
+                ++edgeCounts[EdgeKey( positionRemap[result[t + e]], positionRemap[result[t + (e + 1) % 3]] )];
+
+        for (size_t t = 0; t < result.size(); t += 3)
+        {
+            const uint32_t p[3] = {positionRemap[result[t]], positionRemap[result[t + 1]], positionRemap[result[t + 2]]};
+            Vec3d normal = Cross( Sub( Position( p[1] ), Position( p[0] ) ), Sub( Position( p[2] ), Position( p[0] ) ) );
+            const double length = std::sqrt( Dot( normal, normal ) );
+            if (length <= 0.0)
+                continue;
+            normal = {normal.x / length, normal.y / length, normal.z / length};
+            const double area = length * 0.5;
+            const double* p0 = Position( p[0] );
+            const Quadric q = Quadric::FromPlane( normal.x, normal.y, normal.z, -(normal.x * p0[0] + normal.y * p0[1] + normal.z * p0[2]), area );
+            for (uint32_t v : p)
+                quadrics[v] += q;
+
+            // Border edges get an additional plane (perpendicular to the triangle) so they resist moving away from the border.
+            for (int e = 0; e < 3; ++e)
+            {
+                const uint32_t e0 = p[e], e1 = p[(e + 1) % 3];
+                if (edgeCounts[EdgeKey( e0, e1 )] != 1)
+                    continue;
+                const Vec3d edge = Sub( Position( e1 ), Position( e0 ) );
+                Vec3d borderNormal = Cross( edge, normal );
+                const double borderLength = std::sqrt( Dot( borderNormal, borderNormal ) );
+                if (borderLength <= 0.0)
+                    continue;
+                borderNormal = {borderNormal.x / borderLength, borderNormal.y / borderLength, borderNormal.z / borderLength};
+                const double* pe = Position( e0 );
+                const Quadric borderQ = Quadric::FromPlane( borderNormal.x, borderNormal.y, borderNormal.z, -(borderNormal.x * pe[0] + borderNormal.y * pe[1] + borderNormal.z * pe[2]), cBorderWeight * Dot( edge, edge ) );
+                quadrics[e0] += borderQ;
+                quadrics[e1] += borderQ;
+            }
+        }
+    }
+
+    const double maxError = (double) targetError * (double) targetError;
+    double resultError = 0.0;
+
+    std::vector<Collapse>   collapses;
+    std::vector<uint32_t>   adjacencyOffsets( numVertices + 1 );
+    std::vector<uint32_t>   adjacency;
+    std::vector<uint8_t>    touched( numVertices );
+    std::vector<uint8_t>    border( numVertices );
+    std::vector<uint32_t>   collapseTarget( numVertices );
+    std::unordered_map<uint64_t, uint32_t> edgeCounts;
+
+    //
+    // Do passes of (non overlapping) collapses, cheapest first, until we hit the target index count (or no more collapses are within the error limit).
+    //
+    while (result.size() > targetIndexCount)
+    {
+        // Find the open border edges (edges only used by one triangle) for the current mesh.
+        edgeCounts.clear();
+        for (size_t t = 0; t < result.size(); t += 3)
+            for (int e = 0; e < 3; ++e)
+                ++edgeCounts[EdgeKey( positionRemap[result[t + e]], positionRemap[result[t + (e + 1) % 3]] )];
+        std::fill( border.begin(), border.end(), 0 );
+        for (const auto& [key, count] : edgeCounts)
+        {
+            if (count == 1)
+            {
+                border[(uint32_t) (key >> 32)] = 1;
+                border[(uint32_t) key] = 1;
+            }
+        }
+
+        // Build the (position) vertex to triangle adjacency.
+        std::fill( adjacencyOffsets.begin(), adjacencyOffsets.end(), 0 );
+        for (uint32_t index : result)
+            ++adjacencyOffsets[positionRemap[index] + 1];
+        for (uint32_t i = 0; i < numVertices; ++i)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        adjacency.resize( result.size() );
+        {
+            std::vector<uint32_t> fill( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+            for (uint32_t i = 0; i < (uint32_t) result.size(); ++i)
+                adjacency[fill[positionRemap[result[i]]]++] = i / 3;
+        }
+
+        // Gather all the valid collapses (and their cost).
+        collapses.clear();
+        for (size_t t = 0; t < result.size(); t += 3)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                for (int direction = 0; direction < 2; ++direction)
+                {
+                    const uint32_t srcWedge = result[t + (direction ? (e + 1) % 3 : e)];
+                    const uint32_t dstWedge = result[t + (direction ? e : (e + 1) % 3)];
+                    const uint32_t src = positionRemap[srcWedge];
+                    const uint32_t dst = positionRemap[dstWedge];
+                    if (seam[src])
+                        continue;
+                    // Border vertices are only allowed to slide along their border.
+                    if (border[src] && edgeCounts[EdgeKey( src, dst )] != 1)
+                        continue;
+                    Quadric q = quadrics[src];
+                    q += quadrics[dst];
+                    collapses.push_back( {srcWedge, dstWedge, q.Error( Position( dst ) )} );
+                }
+            }
+        }
+        std::sort( collapses.begin(), collapses.end(), []( const Collapse& a, const Collapse& b ) { return a.error < b.error; } );
+
+        // Each collapse removes (approximately) 2 triangles, dont overshoot the target by much.
+        const size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+        const size_t maxCollapses = std::max( trianglesToRemove / 2, size_t( 1 ) );
+
+        std::fill( touched.begin(), touched.end(), 0 );
+        std::iota( collapseTarget.begin(), collapseTarget.end(), 0 );
+        size_t numCollapses = 0;
+        for (const Collapse& collapse : collapses)
+        {
+            if (collapse.error > maxError || numCollapses >= maxCollapses)
+                break;
+            const uint32_t src = positionRemap[collapse.srcWedge];
+            const uint32_t dst = positionRemap[collapse.dstWedge];
+            if (touched[src] || touched[dst])
+                continue;
+
+            // Check none of the triangles around src flip (or become excessively thin) when src moves to dst.
+            bool flipped = false;
+            for (uint32_t a = adjacencyOffsets[src]; a < adjacencyOffsets[src + 1] && !flipped; ++a)
+            {
+                const uint32_t tri = adjacency[a] * 3;
+                const uint32_t p[3] = {positionRemap[result[tri]], positionRemap[result[tri + 1]], positionRemap[result[tri + 2]]};
+                if (p[0] == dst || p[1] == dst || p[2] == dst)
+                    continue;   // triangle will become degenerate (and be removed)
+                const uint32_t n[3] = {p[0] == src ? dst : p[0], p[1] == src ? dst : p[1], p[2] == src ? dst : p[2]};
+                const Vec3d oldNormal = Cross( Sub( Position( p[1] ), Position( p[0] ) ), Sub( Position( p[2] ), Position( p[0] ) ) );
+                const Vec3d newNormal = Cross( Sub( Position( n[1] ), Position( n[0] ) ), Sub( Position( n[2] ), Position( n[0] ) ) );
+                const double newLengthSq = Dot( newNormal, newNormal );
+                flipped = Dot( oldNormal, newNormal ) <= 0.25 * std::sqrt( Dot( oldNormal, oldNormal ) * newLengthSq ) || newLengthSq <= 0.0;
+            }
+            if (flipped)
+                continue;
+
+            // Accept the collapse.  Lock the neighbourhood for the remainder of this pass (the flip checks for the neighbours are now out of date).
+            for (uint32_t a = adjacencyOffsets[src]; a < adjacencyOffsets[src + 1]; ++a)
+            {
+                const uint32_t tri = adjacency[a] * 3;
+                touched[positionRemap[result[tri]]] = 1;
+                touched[positionRemap[result[tri + 1]]] = 1;
+                touched[positionRemap[result[tri + 2]]] = 1;
+            }
+            touched[dst] = 1;
+            collapseTarget[collapse.srcWedge] = collapse.dstWedge;
+            quadrics[dst] += quadrics[src];
+            resultError = std::max( resultError, collapse.error );
+            ++numCollapses;
+        }
+        if (numCollapses == 0)
+            break;
+
+        // Apply the collapses and remove the (now) degenerate triangles.
+        size_t writeIdx = 0;
+        for (size_t t = 0; t < result.size(); t += 3)
+        {
+            const uint32_t a = collapseTarget[result[t]], b = collapseTarget[result[t + 1]], c = collapseTarget[result[t + 2]];
+            if (positionRemap[a] != positionRemap[b] && positionRemap[b] != positionRemap[c] && positionRemap[c] != positionRemap[a])
+            {
+                result[writeIdx++] = a;
+                result[writeIdx++] = b;
+                result[writeIdx++] = c;
+            }
+        }
+        result.resize( writeIdx );
+    }
+
+    if (pResultError)
+        *pResultError = (float) (std::sqrt( resultError ) * extent);
+    return result;
+}
@@ -0,0 +1,42 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "mesh/meshIntermediate.hpp"
+
+
+/// Mesh Simplifier helper class
+/// Generates reduced triangle count versions of a mesh using quadric error metrics (Garland & Heckbert, "Surface Simplification Using Quadric Error Metrics", 1997).
+///
+/// Only does half-edge collapses (a vertex is moved on to one of its neighbours) so the simplified index data always references the ORIGINAL vertex buffer,
+/// this allows multiple levels of detail to share a single vertex buffer and just be stored as additional index ranges (see @MeshObjectIntermediate::GenerateLods).
+/// Vertices on attribute seams (identical position but different uv/normal/material etc) are locked in place, as are vertices on open borders (unless collapsing along the border).
+/// Not intended for runtime use, simplifying a mesh can take a non trivial amount of time (scales with triangle count).
+///
+/// @ingroup Mesh
+class MeshSimplifier
+{
+public:
+    /// Simplify a triangle list.
+    /// @param vertices vertex data referenced by indices (not modified)
+    /// @param weights vertex weight data (optional, empty or same size as vertices), vertices with different weights are never merged
+    /// @param indices triangle list to simplify (3 indices per triangle)
+    /// @param targetIndexCount simplification stops when the output has this many (or fewer) indices
+    /// @param targetError maximum error allowed for any single collapse, relative to the mesh extents (eg 0.01 is 1% of the largest dimension of the mesh's bounding box)
+    /// @param pResultError (optional) output of the largest error introduced by the simplification, in mesh (object space) units
+    /// @return simplified triangle list (references the same vertices as the input indices)
+    static std::vector<uint32_t> Simplify( std::span<const MeshObjectIntermediate::FatVertex> vertices,
+                                           std::span<const MeshObjectIntermediate::FatWeight> weights,
+                                           std::span<const uint32_t> indices,
+                                           size_t targetIndexCount,
+                                           float targetError,
+                                           float* pResultError = nullptr );
+};
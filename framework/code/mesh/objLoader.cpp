@@ -0,0 +1,722 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "objLoader.hpp"
+#include "system/assetManager.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+    // Smallest chunk of the obj file given to a thread (smaller files use fewer chunks).
+    constexpr size_t cMinChunkSize = 256 * 1024;
+    constexpr uint32_t cInvalidIndex = ~0u;
+
+    struct ObjMaterial
+    {
+        std::string name;
+        std::string diffuseTexname;
+        std::string bumpTexname;
+        std::string emissiveTexname;
+        std::string specularTexname;
+        std::string alphaTexname;
+        int         illum = 0;
+    };
+
+    /// Face corner, 0 based indices in to the (global) attribute arrays.
+    struct ObjCorner
+    {
+        uint32_t position;
+        uint32_t texcoord;  ///< cInvalidIndex if not specified
+        uint32_t normal;    ///< cInvalidIndex if not specified
+    };
+
+    /// Run of consecutive triangles (in a chunk) using the same object and material.
+    struct ObjRun
+    {
+        uint32_t shape;
+        int      material;          ///< index in to materials, -1 if no (or unknown) material
+        size_t   firstCorner;
+        size_t   numCorners;
+        size_t   meshIndex = 0;     ///< output mesh (assigned after parsing)
+        size_t   meshOffset = 0;    ///< first vertex in the output mesh's vertex buffer
+    };
+
+    struct ObjChunk
+    {
+        const char* pBegin = nullptr;
+        const char* pEnd = nullptr;
+
+        // Counted in the first pass
+        size_t numPositions = 0;
+        size_t numColoredPositions = 0;
+        size_t numTexcoords = 0;
+        size_t numNormals = 0;
+        size_t numFaces = 0;
+        uint32_t numShapes = 0;     ///< number of 'o' and 'g' statements
+        std::string_view lastUseMtl;
+        bool hasUseMtl = false;
+        std::vector<std::string_view> mtlLibs;
+
+        // Global state at the start of the chunk (from the preceeding chunks)
+        size_t firstPosition = 0;
+        size_t firstTexcoord = 0;
+        size_t firstNormal = 0;
+        uint32_t firstShape = 0;
+        int startMaterial = -1;
+
+        // Parsed in the second pass
+        std::vector<ObjCorner> corners;
+        std::vector<ObjRun> runs;
+        size_t numBadFaces = 0;
+    };
+
+    // Start enough worker threads to parse with numThreads threads (including the calling thread), 0 for one per core.
+    void StartWorker( ThreadWorker& worker, uint32_t numThreads )
+    {
+        if (numThreads == 0)
+            numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+        if (numThreads > 1)
+            worker.Initialize( "ObjLoader", numThreads - 1 );
+    }
+
+    inline bool IsSpace( char c ) { return c == ' ' || c == '\t'; }
+    inline bool IsDigit( char c ) { return c >= '0' && c <= '9'; }
+
+    // Keyword ends at p (line ends or is followed by arguments).
+    inline bool IsKeywordEnd( const char* p, const char* pLineEnd ) { return p == pLineEnd || IsSpace( *p ); }
+
+    inline const char* SkipSpace( const char* p, const char* pEnd )
+    {
+        while (p < pEnd && IsSpace( *p ))
+            ++p;
+        return p;
+    }
+
+    // Next line (after the newline), returns the end of this line (excluding any carriage return) in pLineEnd.
+    inline const char* NextLine( const char* p, const char* pEnd, const char*& pLineEnd )
+    {
+        const char* pNewline = (const char*) memchr( p, '\n', pEnd - p );
+        pLineEnd = pNewline ? pNewline : pEnd;
+        const char* pNext = pNewline ? pNewline + 1 : pEnd;
+        if (pLineEnd > p && pLineEnd[-1] == '\r')
+            --pLineEnd;
+        return pNext;
+    }
+
+    // Statement keyword (first token on the line), p is moved to the start of the arguments.
+    inline std::string_view ReadKeyword( const char*& p, const char* pLineEnd )
+    {
+        p = SkipSpace( p, pLineEnd );
+        const char* pKeyword = p;
+        while (p < pLineEnd && !IsSpace( *p ))
+            ++p;
+        std::string_view keyword( pKeyword, p - pKeyword );
+        p = SkipSpace( p, pLineEnd );
+        return keyword;
+    }
+
+    // Rest of the line (with trailing whitespace removed).
+    inline std::string_view ReadRestOfLine( const char* p, const char* pLineEnd )
+    {
+        while (pLineEnd > p && IsSpace( pLineEnd[-1] ))
+            --pLineEnd;
+        return { p, size_t( pLineEnd - p ) };
+    }
+
+    // Fast float parser (no locale, no allocation, bounded by pEnd).  Accumulates up to 19 significant digits in an integer and applies the
+    // decimal exponent with a single multiply/divide (exact powers of ten), which is within 1ulp (float) of strtof for obj data.
+    // Returns nullptr if there is no number at p.
+    const char* ParseFloat( const char* p, const char* pEnd, float& out )
+    {
+        static constexpr double cPow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        bool negative = false;
+        if (p < pEnd && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+        uint64_t mantissa = 0;
+        int numDigits = 0;
+        int exponent = 0;
+        bool anyDigits = false;
+        for (; p < pEnd && IsDigit( *p ); ++p)
+        {
+            anyDigits = true;
+            if (numDigits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                numDigits += mantissa != 0 ? 1 : 0;
+            }
+            else
+                ++exponent;
+        }
+        if (p < pEnd && *p == '.')
+        {
+            for (++p; p < pEnd && IsDigit( *p ); ++p)
+            {
+                anyDigits = true;
+                if (numDigits < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    numDigits += mantissa != 0 ? 1 : 0;
+                    --exponent;
+                }
+            }
+        }
+        if (!anyDigits)
+            return nullptr;
+        if (p < pEnd && (*p == 'e' || *p == 'E'))
+        {
+            const char* pExponent = p + 1;
+            bool negativeExponent = false;
+            if (pExponent < pEnd && (*pExponent == '-' || *pExponent == '+'))
+            {
+                negativeExponent = *pExponent == '-';
+                ++pExponent;
+            }
+            if (pExponent < pEnd && IsDigit( *pExponent ))
+            {
+                int e = 0;
+                for (; pExponent < pEnd && IsDigit( *pExponent ); ++pExponent)
+                    e = std::min( e * 10 + (*pExponent - '0'), 9999 );
+                exponent += negativeExponent ? -e : e;
+                p = pExponent;
+            }
+        }
+
+        double value = (double) mantissa;
+        if (mantissa != 0 && exponent != 0)
+        {
+            if (exponent > 0 && exponent <= 22)
+                value *= cPow10[exponent];
+            else if (exponent < 0 && exponent >= -22)
+                value /= cPow10[-exponent];
+            else
+                value *= std::pow( 10.0, (double) exponent );
+        }
+        out = (float) (negative ? -value : value);
+        return p;
+    }
+
+    // Parse up to maxValues whitespace separated floats, returns the number parsed.
+    inline uint32_t ParseFloats( const char* p, const char* pLineEnd, float* pOut, uint32_t maxValues )
+    {
+        uint32_t numValues = 0;
+        while (numValues < maxValues)
+        {
+            p = SkipSpace( p, pLineEnd );
+            p = ParseFloat( p, pLineEnd, pOut[numValues] );
+            if (!p)
+                break;
+            ++numValues;
+        }
+        return numValues;
+    }
+
+    inline const char* ParseInt( const char* p, const char* pEnd, int64_t& out )
+    {
+        bool negative = false;
+        if (p < pEnd && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+        if (p >= pEnd || !IsDigit( *p ))
+            return nullptr;
+        int64_t value = 0;
+        for (; p < pEnd && IsDigit( *p ); ++p)
+            value = std::min( value * 10 + (*p - '0'), (int64_t) UINT32_MAX + 1 );
+        out = negative ? -value : value;
+        return p;
+    }
+
+    // Convert a 1 based (or negative/relative) obj index to a 0 based index.  numSoFar is the number of elements defined before this face.
+    inline uint32_t ResolveIndex( int64_t objIndex, size_t numSoFar )
+    {
+        if (objIndex > 0 && (size_t) objIndex <= numSoFar)
+            return uint32_t( objIndex - 1 );
+        if (objIndex < 0 && (size_t) -objIndex <= numSoFar)
+            return uint32_t( (int64_t) numSoFar + objIndex );
+        return cInvalidIndex;
+    }
+
+    // Texture filename from a map_ statement (skipping any options, eg "map_bump -bm 0.5 normal.png").
+    std::string ReadTexname( const char* p, const char* pLineEnd )
+    {
+        std::string_view args = ReadRestOfLine( p, pLineEnd );
+        const auto lastSpace = args.find_last_of( " \t" );
+        if (lastSpace != std::string_view::npos && args[0] == '-')
+            args = args.substr( lastSpace + 1 );
+        return std::string( args );
+    }
+
+    // Parse a .mtl material library, appending to materials.
+    void ParseMtl( std::string_view mtlData, std::vector<ObjMaterial>& materials )
+    {
+        const char* p = mtlData.data();
+        const char* const pEnd = p + mtlData.size();
+        ObjMaterial* pMaterial = nullptr;
+        while (p < pEnd)
+        {
+            const char* pLineEnd;
+            const char* pNext = NextLine( p, pEnd, pLineEnd );
+            const auto keyword = ReadKeyword( p, pLineEnd );
+            if (keyword == "newmtl")
+            {
+                pMaterial = &materials.emplace_back();
+                pMaterial->name = ReadRestOfLine( p, pLineEnd );
+            }
+            else if (pMaterial)
+            {
+                if (keyword == "map_Kd")
+                    pMaterial->diffuseTexname = ReadTexname( p, pLineEnd );
+                else if (keyword == "map_bump" || keyword == "map_Bump" || keyword == "bump")
+                    pMaterial->bumpTexname = ReadTexname( p, pLineEnd );
+                else if (keyword == "map_Ke")
+                    pMaterial->emissiveTexname = ReadTexname( p, pLineEnd );
+                else if (keyword == "map_Ks")
+                    pMaterial->specularTexname = ReadTexname( p, pLineEnd );
+                else if (keyword == "map_d")
+                    pMaterial->alphaTexname = ReadTexname( p, pLineEnd );
+                else if (keyword == "illum")
+                {
+                    int64_t illum = 0;
+                    if (ParseInt( p, pLineEnd, illum ))
+                        pMaterial->illum = (int) illum;
+                }
+            }
+            p = pNext;
+        }
+    }
+
+    // First pass, count the attributes/objects and find the material state (without parsing any numbers).
+    void CountChunk( ObjChunk& chunk )
+    {
+        const char* p = chunk.pBegin;
+        while (p < chunk.pEnd)
+        {
+            const char* pLineEnd;
+            const char* pNext = NextLine( p, chunk.pEnd, pLineEnd );
+            p = SkipSpace( p, pLineEnd );
+            if (p < pLineEnd)
+            {
+                if (p[0] == 'v')
+                {
+                    if (IsKeywordEnd( p + 1, pLineEnd ))
+                    {
+                        ++chunk.numPositions;
+                        // Count the values, 6 or more means the vertex has a color.
+                        uint32_t numValues = 0;
+                        for (const char* c = p + 1; c < pLineEnd; )
+                        {
+                            c = SkipSpace( c, pLineEnd );
+                            if (c == pLineEnd)
+                                break;
+                            ++numValues;
+                            while (c < pLineEnd && !IsSpace( *c ))
+                                ++c;
+                        }
+                        chunk.numColoredPositions += numValues >= 6 ? 1 : 0;
+                    }
+                    else if (p[1] == 't' && IsKeywordEnd( p + 2, pLineEnd ))
+                        ++chunk.numTexcoords;
+                    else if (p[1] == 'n' && IsKeywordEnd( p + 2, pLineEnd ))
+                        ++chunk.numNormals;
+                }
+                else if (p[0] == 'f' && IsKeywordEnd( p + 1, pLineEnd ))
+                {
+                    ++chunk.numFaces;
+                }
+                else if ((p[0] == 'o' || p[0] == 'g') && IsKeywordEnd( p + 1, pLineEnd ))
+                {
+                    ++chunk.numShapes;
+                }
+                else if (p[0] == 'u' || p[0] == 'm')
+                {
+                    const auto keyword = ReadKeyword( p, pLineEnd );
+                    if (keyword == "usemtl")
+                    {
+                        chunk.lastUseMtl = ReadRestOfLine( p, pLineEnd );
+                        chunk.hasUseMtl = true;
+                    }
+                    else if (keyword == "mtllib")
+                    {
+                        // Can be more than one (space separated) library
+                        while (p < pLineEnd)
+                        {
+                            const char* pName = p;
+                            while (p < pLineEnd && !IsSpace( *p ))
+                                ++p;
+                            chunk.mtlLibs.push_back( { pName, size_t( p - pName ) } );
+                            p = SkipSpace( p, pLineEnd );
+                        }
+                    }
+                }
+            }
+            p = pNext;
+        }
+    }
+
+    // Second pass, parse the attributes (in to the global arrays) and faces.
+    void ParseChunk( ObjChunk& chunk, const std::unordered_map<std::string_view, int>& materialLookup, float* pPositions, float* pColors, float* pTexcoords, float* pNormals )
+    {
+        size_t numPositions = chunk.firstPosition;
+        size_t numTexcoords = chunk.firstTexcoord;
+        size_t numNormals = chunk.firstNormal;
+        uint32_t shape = chunk.firstShape;
+        int material = chunk.startMaterial;
+
+        std::vector<ObjCorner> faceCorners;
+        faceCorners.reserve( 8 );
+        chunk.corners.reserve( chunk.numFaces * 3 );    // exact for triangles, polygons will grow the vector
+
+        const char* p = chunk.pBegin;
+        while (p < chunk.pEnd)
+        {
+            const char* pLineEnd;
+            const char* pNext = NextLine( p, chunk.pEnd, pLineEnd );
+            p = SkipSpace( p, pLineEnd );
+            if (p < pLineEnd)
+            {
+                if (p[0] == 'v')
+                {
+                    if (IsKeywordEnd( p + 1, pLineEnd ))
+                    {
+                        float values[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+                        ParseFloats( p + 1, pLineEnd, values, 6 );
+                        memcpy( pPositions + numPositions * 3, values, sizeof( float ) * 3 );
+                        if (pColors)
+                            memcpy( pColors + numPositions * 3, values + 3, sizeof( float ) * 3 );
+                        ++numPositions;
+                    }
+                    else if (p[1] == 't' && IsKeywordEnd( p + 2, pLineEnd ))
+                    {
+                        float values[2] = {};
+                        ParseFloats( p + 2, pLineEnd, values, 2 );
+                        memcpy( pTexcoords + numTexcoords * 2, values, sizeof( values ) );
+                        ++numTexcoords;
+                    }
+                    else if (p[1] == 'n' && IsKeywordEnd( p + 2, pLineEnd ))
+                    {
+                        float values[3] = {};
+                        ParseFloats( p + 2, pLineEnd, values, 3 );
+                        memcpy( pNormals + numNormals * 3, values, sizeof( values ) );
+                        ++numNormals;
+                    }
+                }
+                else if (p[0] == 'f' && IsKeywordEnd( p + 1, pLineEnd ))
+                {
+                    // Corners are "v", "v/vt", "v//vn" or "v/vt/vn"
+                    faceCorners.clear();
+                    bool valid = true;
+                    const char* c = SkipSpace( p + 1, pLineEnd );
+                    while (c < pLineEnd && *c != '#' && valid)
+                    {
+                        ObjCorner corner{ cInvalidIndex, cInvalidIndex, cInvalidIndex };
+                        int64_t index;
+                        c = ParseInt( c, pLineEnd, index );
+                        if (!c)
+                        {
+                            valid = false;
+                            break;
+                        }
+                        corner.position = ResolveIndex( index, numPositions );
+                        valid = corner.position != cInvalidIndex;
+                        if (c < pLineEnd && *c == '/')
+                        {
+                            ++c;
+                            if (c < pLineEnd && *c != '/')
+                            {
+                                c = ParseInt( c, pLineEnd, index );
+                                valid = valid && c && (corner.texcoord = ResolveIndex( index, numTexcoords )) != cInvalidIndex;
+                            }
+                            if (c && c < pLineEnd && *c == '/')
+                            {
+                                c = ParseInt( c + 1, pLineEnd, index );
+                                valid = valid && c && (corner.normal = ResolveIndex( index, numNormals )) != cInvalidIndex;
+                            }
+                            if (!c)
+                            {
+                                valid = false;
+                                break;
+                            }
+                        }
+                        faceCorners.push_back( corner );
+                        c = SkipSpace( c, pLineEnd );
+                    }
+                    if (!valid || faceCorners.size() < 3)
+                    {
+                        ++chunk.numBadFaces;
+                    }
+                    else
+                    {
+                        if (chunk.runs.empty() || chunk.runs.back().shape != shape || chunk.runs.back().material != material)
+                            chunk.runs.push_back( { shape, material, chunk.corners.size(), 0 } );
+                        // Triangulate (fan)
+                        for (size_t i = 2; i < faceCorners.size(); ++i)
+                        {
+                            chunk.corners.push_back( faceCorners[0] );
+                            chunk.corners.push_back( faceCorners[i - 1] );
+                            chunk.corners.push_back( faceCorners[i] );
+                        }
+                        chunk.runs.back().numCorners = chunk.corners.size() - chunk.runs.back().firstCorner;
+                    }
+                }
+                else if ((p[0] == 'o' || p[0] == 'g') && IsKeywordEnd( p + 1, pLineEnd ))
+                {
+                    ++shape;
+                }
+                else if (p[0] == 'u')
+                {
+                    const auto keyword = ReadKeyword( p, pLineEnd );
+                    if (keyword == "usemtl")
+                    {
+                        const auto it = materialLookup.find( ReadRestOfLine( p, pLineEnd ) );
+                        material = it != materialLookup.end() ? it->second : -1;
+                    }
+                }
+            }
+            p = pNext;
+        }
+    }
+
+    // Third pass, write the chunk's triangles in to the output meshes.
+    void WriteChunk( const ObjChunk& chunk, std::vector<MeshObjectIntermediate>& meshObjects, const float* pPositions, const float* pColors, const float* pTexcoords, const float* pNormals )
+    {
+        for (const auto& run : chunk.runs)
+        {
+            // Vertex buffer is zero initialized (by resize), only need to fill in the attributes we have.
+            auto* pVertex = meshObjects[run.meshIndex].m_VertexBuffer.data() + run.meshOffset;
+            const auto* pCorner = chunk.corners.data() + run.firstCorner;
+            for (size_t i = 0; i < run.numCorners; ++i, ++pCorner)
+            {
+                auto& vertex = pVertex[i];
+                memcpy( vertex.position, pPositions + pCorner->position * 3, sizeof( vertex.position ) );
+                if (pCorner->normal != cInvalidIndex)
+                    memcpy( vertex.normal, pNormals + pCorner->normal * 3, sizeof( vertex.normal ) );
+                if (pCorner->texcoord != cInvalidIndex)
+                    memcpy( vertex.uv0, pTexcoords + pCorner->texcoord * 2, sizeof( vertex.uv0 ) );
+                if (pColors)
+                    memcpy( vertex.color, pColors + pCorner->position * 3, sizeof( float ) * 3 );
+                else
+                    vertex.color[0] = vertex.color[1] = vertex.color[2] = 1.0f;
+                vertex.material = std::max( run.material, 0 );
+            }
+            MeshObjectIntermediate::CalculateFlatTangents( { pVertex, run.numCorners } );
+        }
+    }
+} // namespace
+
+
+//-----------------------------------------------------------------------------
+std::vector<MeshObjectIntermediate> ObjLoader::Load( AssetManager& assetManager, const std::string& filename, uint32_t numThreads )
+//-----------------------------------------------------------------------------
+{
+    ThreadWorker worker;
+    StartWorker( worker, numThreads );
+    auto meshObjects = Load( assetManager, filename, worker );
+    worker.Terminate();
+    return meshObjects;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<MeshObjectIntermediate> ObjLoader::Load( AssetManager& assetManager, const std::string& filename, ThreadWorker& worker )
+//-----------------------------------------------------------------------------
+{
+    AssetMappedFile objFile;
+    if (!assetManager.MapFile( filename, objFile ))
+    {
+        LOGE( "ObjLoader failed to open: %s", filename.c_str() );
+        return {};
+    }
+
+    const std::string directory = assetManager.ExtractDirectory( filename );
+    auto meshObjects = Parse( { objFile.data(), objFile.size() },
+        [&assetManager, &directory]( const std::string& mtlFilename, std::string& mtlDataOut ) -> bool {
+            return assetManager.LoadFileIntoMemory( assetManager.JoinPath( directory, mtlFilename ), mtlDataOut );
+        },
+        worker );
+    if (meshObjects.empty())
+        LOGE( "ObjLoader failed to load any meshes from: %s", filename.c_str() );
+    return meshObjects;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<MeshObjectIntermediate> ObjLoader::Parse( std::span<const char> objData, const tMtlFileLoader& mtlFileLoader, uint32_t numThreads )
+//-----------------------------------------------------------------------------
+{
+    ThreadWorker worker;
+    StartWorker( worker, numThreads );
+    auto meshObjects = Parse( objData, mtlFileLoader, worker );
+    worker.Terminate();
+    return meshObjects;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<MeshObjectIntermediate> ObjLoader::Parse( std::span<const char> objData, const tMtlFileLoader& mtlFileLoader, ThreadWorker& worker )
+//-----------------------------------------------------------------------------
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint32_t numThreads = worker.NumThreads() + 1;    // workers and this thread
+
+    // Split in to chunks at line boundaries (a few chunks per thread to even out the load).
+    const size_t numChunksWanted = std::clamp( objData.size() / cMinChunkSize, (size_t) 1, (size_t) numThreads * 4 );
+    std::vector<ObjChunk> chunks;
+    chunks.reserve( numChunksWanted );
+    {
+        const char* const pDataEnd = objData.data() + objData.size();
+        const char* pChunkBegin = objData.data();
+        for (size_t i = 1; i <= numChunksWanted && pChunkBegin < pDataEnd; ++i)
+        {
+            const char* pChunkEnd = objData.data() + objData.size() * i / numChunksWanted;
+            if (pChunkEnd < pChunkBegin)
+                pChunkEnd = pChunkBegin;
+            const char* pNewline = (const char*) memchr( pChunkEnd, '\n', pDataEnd - pChunkEnd );
+            pChunkEnd = pNewline ? pNewline + 1 : pDataEnd;
+            auto& chunk = chunks.emplace_back();
+            chunk.pBegin = pChunkBegin;
+            chunk.pEnd = pChunkEnd;
+            pChunkBegin = pChunkEnd;
+        }
+    }
+
+    worker.ParallelFor( chunks.size(), [&chunks]( size_t chunkIdx ) {
+        CountChunk( chunks[chunkIdx] );
+    } );
+
+    // Load the material libraries.
+    std::vector<ObjMaterial> materials;
+    std::unordered_map<std::string_view, int> materialLookup;
+    for (const auto& chunk : chunks)
+    {
+        for (const auto mtlLib : chunk.mtlLibs)
+        {
+            std::string mtlData;
+            if (mtlFileLoader && mtlFileLoader( std::string( mtlLib ), mtlData ))
+                ParseMtl( mtlData, materials );
+            else
+                LOGE( "ObjLoader unable to load material library: %.*s", (int) mtlLib.size(), mtlLib.data() );
+        }
+    }
+    for (int materialIdx = 0; materialIdx < (int) materials.size(); ++materialIdx)
+        materialLookup.try_emplace( materials[materialIdx].name, materialIdx );
+
+    // Global offsets (and starting state) of each chunk.
+    size_t numPositions = 0, numColoredPositions = 0, numTexcoords = 0, numNormals = 0;
+    uint32_t numShapes = 0;
+    std::string_view currentUseMtl;
+    bool hasUseMtl = false;
+    for (auto& chunk : chunks)
+    {
+        chunk.firstPosition = numPositions;
+        chunk.firstTexcoord = numTexcoords;
+        chunk.firstNormal = numNormals;
+        chunk.firstShape = numShapes;
+        if (hasUseMtl)
+        {
+            const auto it = materialLookup.find( currentUseMtl );
+            chunk.startMaterial = it != materialLookup.end() ? it->second : -1;
+        }
+        numPositions += chunk.numPositions;
+        numColoredPositions += chunk.numColoredPositions;
+        numTexcoords += chunk.numTexcoords;
+        numNormals += chunk.numNormals;
+        numShapes += chunk.numShapes;
+        if (chunk.hasUseMtl)
+        {
+            currentUseMtl = chunk.lastUseMtl;
+            hasUseMtl = true;
+        }
+    }
+    if (numPositions >= cInvalidIndex || numTexcoords >= cInvalidIndex || numNormals >= cInvalidIndex)
+    {
+        LOGE( "ObjLoader obj file has too many vertices" );
+        return {};
+    }
+
+    // Vertices without a color are white (same as tinyobj), only need to store per position colors if any position has one.
+    const bool meshHasColor = numColoredPositions > 0;
+    std::vector<float> positions( numPositions * 3 );
+    std::vector<float> colors( meshHasColor ? numPositions * 3 : 0 );
+    std::vector<float> texcoords( numTexcoords * 2 );
+    std::vector<float> normals( numNormals * 3 );
+
+    worker.ParallelFor( chunks.size(), [&]( size_t chunkIdx ) {
+        ParseChunk( chunks[chunkIdx], materialLookup, positions.data(), meshHasColor ? colors.data() : nullptr, texcoords.data(), normals.data() );
+    } );
+
+    // Assign each run of triangles to an output mesh (one per shape per material, in the order they appear) and to a range of that mesh's vertices.
+    std::vector<MeshObjectIntermediate> meshObjects;
+    std::vector<size_t> meshNumVertices;
+    std::unordered_map<uint64_t, size_t> meshLookup;
+    size_t numBadFaces = 0;
+    for (auto& chunk : chunks)
+    {
+        numBadFaces += chunk.numBadFaces;
+        for (auto& run : chunk.runs)
+        {
+            const uint64_t key = (uint64_t( run.shape ) << 32) | uint32_t( run.material + 1 );
+            const auto [it, inserted] = meshLookup.try_emplace( key, meshObjects.size() );
+            if (inserted)
+            {
+                auto& meshObject = meshObjects.emplace_back();
+                meshNumVertices.push_back( 0 );
+                if (run.material >= 0)
+                {
+                    const auto& material = materials[run.material];
+                    meshObject.m_Materials.emplace_back( MeshObjectIntermediate::MaterialDef{
+                        material.name,
+                        0,  // materialId
+                        material.diffuseTexname,
+                        glm::vec4( 1.0f, 1.0f, 1.0f, 1.0f ),    // baseColorFactor
+                        material.bumpTexname,
+                        material.emissiveTexname,
+                        material.specularTexname,
+                        0.5f,                                   // metallicFactor
+                        0.5f,                                   // roughnessFactor
+                        glm::vec3( 0.0f ),                      // emissiveFactor
+                        !material.alphaTexname.empty(),
+                        material.illum == 7
+                    } );
+                }
+                else
+                {
+                    meshObject.m_Materials.emplace_back( MeshObjectIntermediate::MaterialDef{ .baseColorFactor = glm::vec4( 1.0f ), .metallicFactor = 0.5f, .roughnessFactor = 0.5f } );
+                }
+            }
+            run.meshIndex = it->second;
+            run.meshOffset = meshNumVertices[run.meshIndex];
+            meshNumVertices[run.meshIndex] += run.numCorners;
+        }
+    }
+    for (size_t meshIdx = 0; meshIdx < meshObjects.size(); ++meshIdx)
+        meshObjects[meshIdx].m_VertexBuffer.resize( meshNumVertices[meshIdx] );
+
+    worker.ParallelFor( chunks.size(), [&]( size_t chunkIdx ) {
+        WriteChunk( chunks[chunkIdx], meshObjects, positions.data(), meshHasColor ? colors.data() : nullptr, texcoords.data(), normals.data() );
+    } );
+
+    size_t numTriangles = 0;
+    for (const auto numVertices : meshNumVertices)
+        numTriangles += numVertices / 3;
+    if (numBadFaces > 0)
+        LOGE( "ObjLoader skipped %zu faces with invalid indices", numBadFaces );
+    LOGI( "ObjLoader parsed %zu positions, %zu triangles in to %zu meshes (%zu chunks, %u threads) in %.1fms", numPositions, numTriangles, meshObjects.size(), chunks.size(), numThreads,
+        std::chrono::duration<float, std::milli>( std::chrono::steady_clock::now() - startTime ).count() );
+
+    return meshObjects;
+}
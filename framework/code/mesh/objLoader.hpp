@@ -0,0 +1,48 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+#include "mesh/meshIntermediate.hpp"
+
+// Forward declarations
+class AssetManager;
+class ThreadWorker;
+
+
+/// Native Wavefront .obj (and .mtl) loader, for large (multi hundred MB) obj files.
+///
+/// The obj file is memory mapped (AssetManager::MapFile) and split at line boundaries in to chunks that are parsed in parallel:
+///   1) each chunk counts its positions/normals/uvs/objects and notes the materials libraries and last 'usemtl', so every chunk knows its global attribute offsets and starting state
+///   2) each chunk parses its attributes (with a locale independent float parser) directly in to shared arrays and resolves its faces (including negative/relative indices) to triangles
+///   3) triangles are written (again one chunk per thread) directly in to the FatVertex buffer of the output mesh for their object/material
+/// Output matches MeshObjectIntermediate::LoadObj; one (non indexed, triangulated) mesh per object per material, with per face tangents.  Missing normals/uvs are zero.
+/// Supports v (with optional vertex color), vt, vn, f, o, g, usemtl and mtllib.  Other statements are ignored.
+/// @ingroup Mesh
+class ObjLoader
+{
+public:
+    /// Callback to load a material library (.mtl) in to memory.  Returns false if the library could not be loaded.
+    typedef std::function<bool( const std::string& mtlFilename, std::string& mtlDataOut )> tMtlFileLoader;
+
+    /// Load (and parse) an obj file, and any material libraries it references (relative to the obj file).
+    /// @param numThreads number of threads to parse with (0 to use one per core)
+    static std::vector<MeshObjectIntermediate> Load( AssetManager& assetManager, const std::string& filename, uint32_t numThreads = 0 );
+    /// Load (and parse) an obj file, parsing on the calling thread and the (already initialized) worker's threads.
+    static std::vector<MeshObjectIntermediate> Load( AssetManager& assetManager, const std::string& filename, ThreadWorker& worker );
+
+    /// Parse obj data that is already in memory.
+    /// @param mtlFileLoader called to load each material library referenced by the obj data (may be empty)
+    static std::vector<MeshObjectIntermediate> Parse( std::span<const char> objData, const tMtlFileLoader& mtlFileLoader, uint32_t numThreads = 0 );
+    /// Parse obj data that is already in memory, on the calling thread and the (already initialized) worker's threads.
+    static std::vector<MeshObjectIntermediate> Parse( std::span<const char> objData, const tMtlFileLoader& mtlFileLoader, ThreadWorker& worker );
+};
@@ -0,0 +1,490 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "occlusionCuller.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OCCLUSION_SIMD_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_SIMD_SSE 1
+#endif
+
+namespace
+{
+    constexpr float cHuge = 1.0e30f;
+
+    /// Convert a (rounded) pixel coordinate to an integer clamped to [lo, hi].
+    /// Clamps before the cast, vertices close to the camera plane project far outside the int32 range (and NaN fails every comparison so maps to lo).
+    inline int32_t ClampToInt( float value, int32_t lo, int32_t hi )
+    {
+        if (!(value >= float( lo )))
+            return lo;
+        if (value > float( hi ))
+            return hi;
+        return int32_t( value );
+    }
+
+    /// Compute the covered pixel spans for 4 consecutive rows (pixel centers at y + 0.5).
+    /// Pixel x is covered if left <= x + 0.5 <= right, output is [xStart, xEnd) clamped to [0, width].
+    void CalcSpans4( const float* leftK, const float* leftM, const float* rightK, const float* rightM, float y, float width, int32_t* xStart, int32_t* xEnd )
+    {
+#if defined(OCCLUSION_SIMD_NEON)
+        const float32x4_t rowY = vaddq_f32( vdupq_n_f32( y + 0.5f ), float32x4_t{ 0.0f, 1.0f, 2.0f, 3.0f } );
+        float32x4_t left = vdupq_n_f32( -cHuge );
+        float32x4_t right = vdupq_n_f32( cHuge );
+        for (int e = 0; e < 3; ++e)
+        {
+            left = vmaxq_f32( left, vmlaq_n_f32( vdupq_n_f32( leftM[e] ), rowY, leftK[e] ) );
+            right = vminq_f32( right, vmlaq_n_f32( vdupq_n_f32( rightM[e] ), rowY, rightK[e] ) );
+        }
+        const float32x4_t zero = vdupq_n_f32( 0.0f );
+        const float32x4_t w = vdupq_n_f32( width );
+        // xStart = ceil( left - 0.5 ), values are clamped positive so truncate and round up any remainder.
+        const float32x4_t startF = vminq_f32( vmaxq_f32( vsubq_f32( left, vdupq_n_f32( 0.5f ) ), zero ), w );
+        int32x4_t start = vcvtq_s32_f32( startF );
+        start = vsubq_s32( start, vreinterpretq_s32_u32( vcltq_f32( vcvtq_f32_s32( start ), startF ) ) );
+        // xEnd = floor( right - 0.5 ) + 1
+        const int32x4_t end = vcvtq_s32_f32( vminq_f32( vmaxq_f32( vaddq_f32( right, vdupq_n_f32( 0.5f ) ), zero ), w ) );
+        vst1q_s32( xStart, start );
+        vst1q_s32( xEnd, end );
+#elif defined(OCCLUSION_SIMD_SSE)
+        const __m128 rowY = _mm_add_ps( _mm_set1_ps( y + 0.5f ), _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f ) );
+        __m128 left = _mm_set1_ps( -cHuge );
+        __m128 right = _mm_set1_ps( cHuge );
+        for (int e = 0; e < 3; ++e)
+        {
+            left = _mm_max_ps( left, _mm_add_ps( _mm_mul_ps( rowY, _mm_set1_ps( leftK[e] ) ), _mm_set1_ps( leftM[e] ) ) );
+            right = _mm_min_ps( right, _mm_add_ps( _mm_mul_ps( rowY, _mm_set1_ps( rightK[e] ) ), _mm_set1_ps( rightM[e] ) ) );
+        }
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 w = _mm_set1_ps( width );
+        // xStart = ceil( left - 0.5 ), values are clamped positive so truncate and round up any remainder.
+        const __m128 startF = _mm_min_ps( _mm_max_ps( _mm_sub_ps( left, _mm_set1_ps( 0.5f ) ), zero ), w );
+        __m128i start = _mm_cvttps_epi32( startF );
+        start = _mm_sub_epi32( start, _mm_castps_si128( _mm_cmplt_ps( _mm_cvtepi32_ps( start ), startF ) ) );
+        // xEnd = floor( right - 0.5 ) + 1
+        const __m128i end = _mm_cvttps_epi32( _mm_min_ps( _mm_max_ps( _mm_add_ps( right, _mm_set1_ps( 0.5f ) ), zero ), w ) );
+        _mm_storeu_si128( (__m128i*) xStart, start );
+        _mm_storeu_si128( (__m128i*) xEnd, end );
+#else
+        for (int r = 0; r < 4; ++r)
+        {
+            const float rowY = y + 0.5f + float( r );
+            float left = -cHuge;
+            float right = cHuge;
+            for (int e = 0; e < 3; ++e)
+            {
+                left = std::max( left, leftK[e] * rowY + leftM[e] );
+                right = std::min( right, rightK[e] * rowY + rightM[e] );
+            }
+            xStart[r] = ClampToInt( std::ceil( left - 0.5f ), 0, int32_t( width ) );
+            xEnd[r] = ClampToInt( right + 0.5f, 0, int32_t( width ) );
+        }
+#endif
+    }
+
+    /// Bits [start, end) of a 32 bit row mask.
+    inline uint32_t SpanMask( int32_t start, int32_t end )
+    {
+        if (start >= end)
+            return 0;
+        const uint32_t endMask = end >= 32 ? ~0u : ((1u << end) - 1u);
+        return endMask & ~((1u << start) - 1u);
+    }
+}
+
+OcclusionCuller::OcclusionCuller()
+{}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    Release();
+}
+
+bool OcclusionCuller::Init( uint32_t width, uint32_t height, uint32_t numThreads )
+{
+    Release();
+    if (width == 0 || height == 0)
+    {
+        LOGE( "OcclusionCuller::Init invalid size (%u x %u)", width, height );
+        return false;
+    }
+    m_Width = width;
+    m_Height = height;
+    m_NumTilesX = (width + cTileWidth - 1) / cTileWidth;
+    m_NumTilesY = (height + cTileHeight - 1) / cTileHeight;
+    const uint32_t lastColumnPixels = width - (m_NumTilesX - 1) * cTileWidth;
+    m_LastColumnPadMask = lastColumnPixels == cTileWidth ? 0 : ~((1u << lastColumnPixels) - 1u);
+    m_Tiles.resize( size_t( m_NumTilesX ) * m_NumTilesY );
+
+    if (numThreads != 1)
+    {
+        m_Worker = std::make_unique<ThreadWorker>();
+        numThreads = m_Worker->Initialize( "OcclusionCuller", numThreads );
+    }
+    // A few bands per thread so uneven occluder density still load balances.
+    m_NumBands = m_Worker ? std::min( m_NumTilesY, std::max( 1u, numThreads * 4 ) ) : 1;
+
+    BeginFrame( glm::mat4( 1.0f ) );
+    return true;
+}
+
+void OcclusionCuller::Release()
+{
+    m_Worker.reset();
+    m_Tiles.clear();
+    m_Occluders.clear();
+    m_Triangles.clear();
+    m_Width = m_Height = 0;
+    m_NumTilesX = m_NumTilesY = 0;
+}
+
+void OcclusionCuller::BeginFrame( const glm::mat4& viewProjection )
+{
+    m_ViewProjection = viewProjection;
+    m_Occluders.clear();
+    m_Triangles.clear();
+    for (auto& tile : m_Tiles)
+    {
+        memset( tile.mask, 0, sizeof( tile.mask ) );
+        tile.zMax0 = 1.0f;
+        tile.zMax1 = 0.0f;
+    }
+}
+
+void OcclusionCuller::AddOccluder( const float* pPositions, uint32_t positionStride, uint32_t numVertices, std::span<const uint32_t> indices, const glm::mat4& modelMatrix )
+{
+    assert( indices.size() % 3 == 0 );
+    m_Occluders.push_back( { pPositions, positionStride, numVertices, indices, modelMatrix } );
+}
+
+void OcclusionCuller::RasterizeOccluders()
+{
+    for (const auto& occluder : m_Occluders)
+        SetupOccluder( occluder );
+    m_Occluders.clear();
+
+    if (m_Triangles.empty())
+        return;
+
+    if (m_Worker && m_NumBands > 1)
+    {
+        for (uint32_t band = 0; band < m_NumBands; ++band)
+        {
+            m_Worker->DoWork2( []( OcclusionCuller* pThis, uint32_t band ) {
+                pThis->RasterizeBand( band );
+            }, this, band );
+        }
+        m_Worker->FinishAllWork();
+    }
+    else
+    {
+        for (uint32_t band = 0; band < m_NumBands; ++band)
+            RasterizeBand( band );
+    }
+}
+
+void OcclusionCuller::SetupOccluder( const Occluder& occluder )
+{
+    const glm::mat4 modelViewProjection = m_ViewProjection * occluder.modelMatrix;
+
+    m_ClipPositions.resize( occluder.numVertices );
+    const uint8_t* pPosition = (const uint8_t*) occluder.pPositions;
+    for (uint32_t i = 0; i < occluder.numVertices; ++i, pPosition += occluder.positionStride)
+    {
+        const float* p = (const float*) pPosition;
+        m_ClipPositions[i] = modelViewProjection * glm::vec4( p[0], p[1], p[2], 1.0f );
+    }
+
+    for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+    {
+        const glm::vec4 v[3] = { m_ClipPositions[occluder.indices[i]], m_ClipPositions[occluder.indices[i + 1]], m_ClipPositions[occluder.indices[i + 2]] };
+
+        // Trivial reject against the side planes.
+        if ((v[0].x > v[0].w && v[1].x > v[1].w && v[2].x > v[2].w) || (v[0].x < -v[0].w && v[1].x < -v[1].w && v[2].x < -v[2].w) ||
+            (v[0].y > v[0].w && v[1].y > v[1].w && v[2].y > v[2].w) || (v[0].y < -v[0].w && v[1].y < -v[1].w && v[2].y < -v[2].w))
+            continue;
+
+        // Clip against the near plane (z >= 0), other planes are handled by the rasterizer's clamping to the screen.
+        const int numInside = int( v[0].z >= 0.0f ) + int( v[1].z >= 0.0f ) + int( v[2].z >= 0.0f );
+        if (numInside == 0)
+            continue;
+        if (numInside == 3)
+        {
+            SetupTriangle( v[0], v[1], v[2] );
+            continue;
+        }
+        glm::vec4 polygon[4];
+        int numPolygon = 0;
+        for (int e = 0; e < 3; ++e)
+        {
+            const glm::vec4& a = v[e];
+            const glm::vec4& b = v[e == 2 ? 0 : e + 1];
+            if (a.z >= 0.0f)
+                polygon[numPolygon++] = a;
+            if ((a.z >= 0.0f) != (b.z >= 0.0f))
+            {
+                const float t = a.z / (a.z - b.z);
+                polygon[numPolygon++] = a + (b - a) * t;
+            }
+        }
+        for (int p = 2; p < numPolygon; ++p)
+            SetupTriangle( polygon[0], polygon[p - 1], polygon[p] );
+    }
+}
+
+void OcclusionCuller::SetupTriangle( const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2 )
+{
+    // Project to screen (pixel) space.
+    const float width = float( m_Width );
+    const float height = float( m_Height );
+    float x[3], y[3], z[3];
+    const glm::vec4* v[3] = { &v0, &v1, &v2 };
+    for (int i = 0; i < 3; ++i)
+    {
+        const float invW = 1.0f / v[i]->w;
+        x[i] = (v[i]->x * invW * 0.5f + 0.5f) * width;
+        y[i] = (v[i]->y * invW * 0.5f + 0.5f) * height;
+        z[i] = v[i]->z * invW;
+    }
+
+    // Pixels (centers) touched by the triangle bounds (off screen bounds clamp to an empty range).
+    const int32_t minX = ClampToInt( std::ceil( std::min( { x[0], x[1], x[2] } ) - 0.5f ), 0, int32_t( m_Width ) );
+    const int32_t maxX = ClampToInt( std::floor( std::max( { x[0], x[1], x[2] } ) - 0.5f ), -1, int32_t( m_Width ) - 1 );
+    const int32_t minY = ClampToInt( std::ceil( std::min( { y[0], y[1], y[2] } ) - 0.5f ), 0, int32_t( m_Height ) );
+    const int32_t maxY = ClampToInt( std::floor( std::max( { y[0], y[1], y[2] } ) - 0.5f ), -1, int32_t( m_Height ) - 1 );
+    if (minX > maxX || minY > maxY)
+        return;
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (std::abs( area ) < 1.0e-6f)
+        return;
+    if (area < 0.0f)
+    {
+        // Occluders are rasterized double sided, make the winding consistent.
+        std::swap( x[1], x[2] );
+        std::swap( y[1], y[2] );
+        std::swap( z[1], z[2] );
+        area = -area;
+    }
+
+    Triangle& triangle = m_Triangles.emplace_back();
+    triangle.minX = minX;
+    triangle.maxX = maxX;
+    triangle.minY = minY;
+    triangle.maxY = maxY;
+
+    // Edge functions E(x,y) = a*x + b*y + c, inside is E >= 0.  Each edge bounds the span on the left (a > 0) or right (a < 0) as x = k*y + m.
+    for (int e = 0; e < 3; ++e)
+    {
+        const int e1 = e == 2 ? 0 : e + 1;
+        const float a = y[e] - y[e1];
+        const float b = x[e1] - x[e];
+        const float c = -(a * x[e] + b * y[e]);
+        triangle.leftK[e] = 0.0f;
+        triangle.leftM[e] = -cHuge;
+        triangle.rightK[e] = 0.0f;
+        triangle.rightM[e] = cHuge;
+        if (a > 0.0f)
+        {
+            triangle.leftK[e] = -b / a;
+            triangle.leftM[e] = -c / a;
+        }
+        else if (a < 0.0f)
+        {
+            triangle.rightK[e] = -b / a;
+            triangle.rightM[e] = -c / a;
+        }
+        // horizontal edges are handled by the minY/maxY row range
+    }
+
+    // Depth plane.
+    const float invArea = 1.0f / area;
+    const float dx1 = x[1] - x[0], dy1 = y[1] - y[0], dz1 = z[1] - z[0];
+    const float dx2 = x[2] - x[0], dy2 = y[2] - y[0], dz2 = z[2] - z[0];
+    triangle.zA = (dz1 * dy2 - dz2 * dy1) * invArea;
+    triangle.zB = (dx1 * dz2 - dx2 * dz1) * invArea;
+    triangle.zC = z[0] - triangle.zA * x[0] - triangle.zB * y[0];
+    triangle.zMax = std::max( { z[0], z[1], z[2] } );
+}
+
+void OcclusionCuller::RasterizeBand( uint32_t band )
+{
+    const uint32_t firstTileY = band * m_NumTilesY / m_NumBands;
+    const uint32_t lastTileY = (band + 1) * m_NumTilesY / m_NumBands;
+    const int32_t bandMinY = int32_t( firstTileY * cTileHeight );
+    const int32_t bandMaxY = int32_t( lastTileY * cTileHeight ) - 1;
+
+    for (const auto& triangle : m_Triangles)
+    {
+        if (triangle.maxY < bandMinY || triangle.minY > bandMaxY)
+            continue;
+        const uint32_t tileY0 = std::max( firstTileY, uint32_t( triangle.minY ) / cTileHeight );
+        const uint32_t tileY1 = std::min( lastTileY - 1, uint32_t( triangle.maxY ) / cTileHeight );
+        for (uint32_t tileY = tileY0; tileY <= tileY1; ++tileY)
+            RasterizeTriangleRow( triangle, tileY );
+    }
+}
+
+void OcclusionCuller::RasterizeTriangleRow( const Triangle& triangle, uint32_t tileY )
+{
+    const int32_t rowY0 = int32_t( tileY * cTileHeight );
+    int32_t xStart[cTileHeight];
+    int32_t xEnd[cTileHeight];
+    const float width = float( m_Width );
+    for (uint32_t r = 0; r < cTileHeight; r += 4)
+        CalcSpans4( triangle.leftK, triangle.leftM, triangle.rightK, triangle.rightM, float( rowY0 + r ), width, &xStart[r], &xEnd[r] );
+    for (uint32_t r = 0; r < cTileHeight; ++r)
+    {
+        const int32_t row = rowY0 + int32_t( r );
+        if (row < triangle.minY || row > triangle.maxY)
+        {
+            xStart[r] = 0;
+            xEnd[r] = 0;
+        }
+    }
+
+    const float rectY0 = float( std::max( rowY0, triangle.minY ) );
+    const float rectY1 = float( std::min( rowY0 + int32_t( cTileHeight ) - 1, triangle.maxY ) + 1 );
+    const uint32_t tileX0 = uint32_t( triangle.minX ) / cTileWidth;
+    const uint32_t tileX1 = uint32_t( triangle.maxX ) / cTileWidth;
+    for (uint32_t tileX = tileX0; tileX <= tileX1; ++tileX)
+    {
+        const int32_t tilePixelX = int32_t( tileX * cTileWidth );
+        uint32_t coverage[cTileHeight];
+        uint32_t anyCoverage = 0;
+        for (uint32_t r = 0; r < cTileHeight; ++r)
+        {
+            coverage[r] = SpanMask( std::clamp( xStart[r] - tilePixelX, 0, 32 ), std::clamp( xEnd[r] - tilePixelX, 0, 32 ) );
+            anyCoverage |= coverage[r];
+        }
+        if (!anyCoverage)
+            continue;
+
+        // Farthest depth of the triangle within the (tile and triangle bounds) rectangle, planes are linear so the max is at a corner.
+        const float rectX0 = float( std::max( tilePixelX, triangle.minX ) );
+        const float rectX1 = float( std::min( tilePixelX + int32_t( cTileWidth ) - 1, triangle.maxX ) + 1 );
+        const float zPlaneMax = triangle.zC + std::max( triangle.zA * rectX0, triangle.zA * rectX1 ) + std::max( triangle.zB * rectY0, triangle.zB * rectY1 );
+        const float zTriangle = std::min( zPlaneMax, triangle.zMax );
+
+        MergeTile( m_Tiles[tileY * m_NumTilesX + tileX], tileX, tileY, coverage, zTriangle );
+    }
+}
+
+void OcclusionCuller::MergeTile( Tile& tile, uint32_t tileX, uint32_t tileY, const uint32_t* coverage, float zTriangle ) const
+{
+    if (zTriangle >= tile.zMax0)
+        return;     // behind everything already in the tile, cannot improve it
+
+    bool workingEmpty = true;
+    for (uint32_t r = 0; r < cTileHeight; ++r)
+        workingEmpty &= tile.mask[r] == 0;
+
+    // Heuristic (from MOC): if the triangle is closer to the reference layer than to the working layer then merging would push the working layer
+    // back towards the reference, so discard the working layer and restart it with this triangle.
+    if (workingEmpty || (zTriangle - tile.zMax1) > (tile.zMax0 - zTriangle))
+    {
+        memcpy( tile.mask, coverage, sizeof( tile.mask ) );
+        tile.zMax1 = zTriangle;
+    }
+    else
+    {
+        for (uint32_t r = 0; r < cTileHeight; ++r)
+            tile.mask[r] |= coverage[r];
+        tile.zMax1 = std::max( tile.zMax1, zTriangle );
+    }
+
+    if (IsTileFull( tile.mask, tileX, tileY ))
+    {
+        // Working layer covers the tile, it becomes the reference.
+        tile.zMax0 = std::min( tile.zMax0, tile.zMax1 );
+        tile.zMax1 = 0.0f;
+        memset( tile.mask, 0, sizeof( tile.mask ) );
+    }
+}
+
+bool OcclusionCuller::IsTileFull( const uint32_t* mask, uint32_t tileX, uint32_t tileY ) const
+{
+    const uint32_t padMask = tileX == m_NumTilesX - 1 ? m_LastColumnPadMask : 0;
+    const uint32_t numRows = std::min( cTileHeight, m_Height - tileY * cTileHeight );
+    for (uint32_t r = 0; r < numRows; ++r)
+    {
+        if ((mask[r] | padMask) != ~0u)
+            return false;
+    }
+    return true;
+}
+
+float OcclusionCuller::GetTileDepth( uint32_t tileX, uint32_t tileY ) const
+{
+    assert( tileX < m_NumTilesX && tileY < m_NumTilesY );
+    return m_Tiles[tileY * m_NumTilesX + tileX].zMax0;
+}
+
+bool OcclusionCuller::IsVisible( const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& modelMatrix ) const
+{
+    const glm::mat4 modelViewProjection = m_ViewProjection * modelMatrix;
+
+    // Screen rectangle and nearest depth of the box corners.
+    float minX = cHuge, maxX = -cHuge, minY = cHuge, maxY = -cHuge, minZ = cHuge;
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec4 clip = modelViewProjection * glm::vec4( (corner & 1) ? boundsMax.x : boundsMin.x, (corner & 2) ? boundsMax.y : boundsMin.y, (corner & 4) ? boundsMax.z : boundsMin.z, 1.0f );
+        if (clip.z < 0.0f)
+            return true;    // crosses the near plane
+        const float invW = 1.0f / clip.w;
+        const float x = clip.x * invW;
+        const float y = clip.y * invW;
+        minX = std::min( minX, x );
+        maxX = std::max( maxX, x );
+        minY = std::min( minY, y );
+        maxY = std::max( maxY, y );
+        minZ = std::min( minZ, clip.z * invW );
+    }
+    if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || minZ > 1.0f)
+        return false;   // outside the frustum
+
+    const int32_t pixelX0 = ClampToInt( std::floor( (minX * 0.5f + 0.5f) * float( m_Width ) ), 0, int32_t( m_Width ) - 1 );
+    const int32_t pixelX1 = ClampToInt( std::floor( (maxX * 0.5f + 0.5f) * float( m_Width ) ), 0, int32_t( m_Width ) - 1 );
+    const int32_t pixelY0 = ClampToInt( std::floor( (minY * 0.5f + 0.5f) * float( m_Height ) ), 0, int32_t( m_Height ) - 1 );
+    const int32_t pixelY1 = ClampToInt( std::floor( (maxY * 0.5f + 0.5f) * float( m_Height ) ), 0, int32_t( m_Height ) - 1 );
+    if (pixelX0 > pixelX1 || pixelY0 > pixelY1)
+        return false;
+
+    for (uint32_t tileY = uint32_t( pixelY0 ) / cTileHeight; tileY <= uint32_t( pixelY1 ) / cTileHeight; ++tileY)
+    {
+        const uint32_t tileRow0 = tileY * cTileHeight;
+        for (uint32_t tileX = uint32_t( pixelX0 ) / cTileWidth; tileX <= uint32_t( pixelX1 ) / cTileWidth; ++tileX)
+        {
+            const Tile& tile = m_Tiles[tileY * m_NumTilesX + tileX];
+            if (minZ <= std::min( tile.zMax0, tile.zMax1 ))
+                return true;    // nearer than anything in the tile
+            if (minZ > tile.zMax0)
+                continue;       // behind the whole tile
+
+            // Between the layers, visible unless every pixel of the box (in this tile) is covered by the working layer.
+            const uint32_t tilePixelX = tileX * cTileWidth;
+            const uint32_t rectMask = SpanMask( std::max( pixelX0 - int32_t( tilePixelX ), 0 ), std::min( pixelX1 + 1 - int32_t( tilePixelX ), 32 ) );
+            for (uint32_t r = 0; r < cTileHeight; ++r)
+            {
+                const int32_t row = int32_t( tileRow0 + r );
+                if (row >= pixelY0 && row <= pixelY1 && (rectMask & ~tile.mask[r]) != 0)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,134 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Forward declarations
+class ThreadWorker;
+template<typename T_GFXAPI> class Drawable;
+
+
+/// CPU occlusion culler.
+/// Rasterizes a (small) set of occluder meshes in to a low resolution 'masked' depth buffer and tests bounding boxes against it, for use where gpu driven culling is not an option.
+///
+/// Depth is stored in the style of Masked Software Occlusion Culling (Andersson et al, 2015): the screen is split in to 32x8 pixel tiles, each with a
+/// coverage bitmask and two conservative (farthest) depth layers.  Triangles are merged in to the tile's 'working' layer until its mask is full at which point
+/// it becomes the tile's reference depth, so no per pixel depth is stored or interpolated.
+/// Scanline spans are computed 4 rows at a time using SIMD (NEON or SSE, scalar fallback) and the screen is split in to bands of tile rows which are
+/// rasterized in parallel on worker threads.
+///
+/// Depth is expected to be 0 (near) to 1 (far) after projection (ie Vulkan clip space, not reversed).
+/// Occluders should be conservative (inside the visible geometry), occludee bounds may be loose.
+///
+/// Typical use, each frame:
+///   BeginFrame( viewProjection ); AddOccluder( ... ) for each occluder; RasterizeOccluders();
+///   if (IsVisible( drawable, modelMatrix )) AddDrawableToCmdBuffers( drawable, ... );
+///
+/// @ingroup Mesh
+class OcclusionCuller
+{
+    OcclusionCuller( const OcclusionCuller& ) = delete;
+    OcclusionCuller& operator=( const OcclusionCuller& ) = delete;
+public:
+    static constexpr uint32_t cTileWidth = 32;     ///< pixels per tile (one bit per pixel in each row's mask)
+    static constexpr uint32_t cTileHeight = 8;     ///< rows per tile
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    /// Initialize the depth buffer resolution (does not need to match the render resolution, 320x180 or so is typical).
+    /// @param numThreads number of worker threads to rasterize with (0 to use one per core, 1 to rasterize on the calling thread)
+    bool Init( uint32_t width, uint32_t height, uint32_t numThreads = 0 );
+    void Release();
+
+    /// Clear the depth buffer and occluder list ready for a new frame.
+    void BeginFrame( const glm::mat4& viewProjection );
+
+    /// Add an occluder triangle list.  Data is referenced (not copied) until RasterizeOccluders returns.
+    /// @param pPositions first vertex position (3 floats)
+    /// @param positionStride bytes between each vertex position (eg sizeof(MeshObjectIntermediate::FatVertex))
+    void AddOccluder( const float* pPositions, uint32_t positionStride, uint32_t numVertices, std::span<const uint32_t> indices, const glm::mat4& modelMatrix );
+    void AddOccluder( std::span<const glm::vec3> positions, std::span<const uint32_t> indices, const glm::mat4& modelMatrix ) { AddOccluder( &positions.data()->x, sizeof( glm::vec3 ), (uint32_t) positions.size(), indices, modelMatrix ); }
+
+    /// Transform, clip and rasterize all the occluders added since BeginFrame.
+    void RasterizeOccluders();
+
+    /// Test an object space bounding box against the rasterized occluders (and the view frustum).
+    /// @return true if any part of the box may be visible
+    bool IsVisible( const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& modelMatrix ) const;
+
+    /// Test a Drawable's mesh bounds (Mesh::m_BoundsMin/Max) against the rasterized occluders.  For instanced drawables the bounds only cover a single instance.
+    template<typename T_GFXAPI>
+    bool IsVisible( const Drawable<T_GFXAPI>& drawable, const glm::mat4& modelMatrix ) const
+    {
+        const auto& mesh = drawable.GetMeshObject();
+        return IsVisible( { mesh.m_BoundsMin[0], mesh.m_BoundsMin[1], mesh.m_BoundsMin[2] }, { mesh.m_BoundsMax[0], mesh.m_BoundsMax[1], mesh.m_BoundsMax[2] }, modelMatrix );
+    }
+
+    uint32_t GetWidth() const { return m_Width; }
+    uint32_t GetHeight() const { return m_Height; }
+    uint32_t GetNumTilesX() const { return m_NumTilesX; }
+    uint32_t GetNumTilesY() const { return m_NumTilesY; }
+    size_t GetNumTriangles() const { return m_Triangles.size(); }   ///< number of (clipped) occluder triangles rasterized this frame
+    /// Conservative (farthest) depth of everything within a tile, ie anything behind this is occluded.  1.0 if the tile is not fully covered.
+    float GetTileDepth( uint32_t tileX, uint32_t tileY ) const;
+
+protected:
+    struct Occluder
+    {
+        const float*        pPositions;
+        uint32_t            positionStride;
+        uint32_t            numVertices;
+        std::span<const uint32_t> indices;
+        glm::mat4           modelMatrix;
+    };
+
+    /// Depth tile (MOC style 1 bit per pixel coverage and two depth layers).
+    struct Tile
+    {
+        uint32_t            mask[cTileHeight];  ///< coverage of the working layer (one uint per row, bit per pixel)
+        float               zMax0;              ///< reference layer, farthest depth of the whole tile
+        float               zMax1;              ///< working layer, farthest depth of the pixels in mask
+    };
+
+    /// Screen space triangle, ready for rasterization.
+    struct Triangle
+    {
+        float               leftK[3], leftM[3];     ///< per edge, left span bound x = k*y + m (neutral values for edges that are not left bounds)
+        float               rightK[3], rightM[3];   ///< per edge, right span bound
+        float               zA, zB, zC;             ///< depth plane z = zA*x + zB*y + zC
+        float               zMax;                   ///< farthest vertex depth
+        int32_t             minX, maxX;             ///< pixel columns touched (inclusive)
+        int32_t             minY, maxY;             ///< pixel rows touched (inclusive)
+    };
+
+    void SetupTriangle( const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2 );
+    void SetupOccluder( const Occluder& occluder );
+    void RasterizeBand( uint32_t band );
+    void RasterizeTriangleRow( const Triangle& triangle, uint32_t tileY );
+    void MergeTile( Tile& tile, uint32_t tileX, uint32_t tileY, const uint32_t* coverage, float zTriangle ) const;
+    bool IsTileFull( const uint32_t* mask, uint32_t tileX, uint32_t tileY ) const;
+
+    uint32_t                        m_Width = 0;
+    uint32_t                        m_Height = 0;
+    uint32_t                        m_NumTilesX = 0;
+    uint32_t                        m_NumTilesY = 0;
+    uint32_t                        m_NumBands = 1;
+    uint32_t                        m_LastColumnPadMask = 0;    ///< bits (pixels) of the rightmost tile column beyond m_Width, treated as always covered
+    glm::mat4                       m_ViewProjection{ 1.0f };
+    std::vector<Tile>               m_Tiles;
+    std::vector<Occluder>           m_Occluders;
+    std::vector<Triangle>           m_Triangles;
+    std::vector<glm::vec4>          m_ClipPositions;            ///< scratch, occluder vertices in clip space
+    std::unique_ptr<ThreadWorker>   m_Worker;
+};
@@ -7,6 +7,35 @@
 //============================================================================================================
 
 #include "octree.hpp"
+#include <algorithm>
 
 #include "system/os_common.h"
 
+
+void OctreeBase::RadixSort( std::vector<std::pair<tCellKey, uint32_t>>& keys, uint32_t numKeyBits )
+{
+    std::vector<std::pair<tCellKey, uint32_t>> sortedKeys( keys.size() );
+
+    // 8 bits per pass, least significant first.
+    for( uint32_t shift = 0; shift < numKeyBits; shift += 8 )
+    {
+        std::array<size_t, 256> offsets{};
+        for( const auto& key : keys )
+            ++offsets[(key.first >> shift) & 0xff];
+
+        // Skip the pass if every key has the same value for these bits (common for the upper bits of shallow octrees).
+        if( std::find( offsets.begin(), offsets.end(), keys.size() ) != offsets.end() )
+            continue;
+
+        size_t offset = 0;
+        for( auto& bucketOffset : offsets )
+        {
+            const size_t count = bucketOffset;
+            bucketOffset = offset;
+            offset += count;
+        }
+        for( const auto& key : keys )
+            sortedKeys[offsets[(key.first >> shift) & 0xff]++] = key;
+        keys.swap( sortedKeys );
+    }
+}
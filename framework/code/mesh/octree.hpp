@@ -7,16 +7,67 @@
 //============================================================================================================
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <array>
+#include <span>
+#include <utility>
 #include <vector>
 #include <glm/glm.hpp>
 
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OCTREE_SIMD_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCTREE_SIMD_SSE 1
+#endif
+
 const static glm::vec4 sCellOffsets[8] = {
     {-1.f,-1.f, -1.f, 0.f}, {1.f,-1.f,-1.f, 0.f}, {-1.f,1.f,-1.f, 0.f}, {1.f,1.f,-1.f, 0.f},
     {-1.f,-1.f,  1.f, 0.f}, {1.f,-1.f, 1.f, 0.f}, {-1.f,1.f, 1.f, 0.f}, {1.f,1.f, 1.f, 0.f}
 };
 
+class ViewFrustum;
+
+/// Minimal 4 wide float vector helpers used by the frustum tests (NEON, SSE or scalar fallback).
+namespace OctreeSimd
+{
+#if defined(OCTREE_SIMD_NEON)
+    typedef float32x4_t tFloat4;
+    inline tFloat4 Load( const float* p ) { return vld1q_f32( p ); }
+    inline tFloat4 Splat( float f ) { return vdupq_n_f32( f ); }
+    inline tFloat4 Add( tFloat4 a, tFloat4 b ) { return vaddq_f32( a, b ); }
+    inline tFloat4 Sub( tFloat4 a, tFloat4 b ) { return vsubq_f32( a, b ); }
+    inline tFloat4 Mul( tFloat4 a, tFloat4 b ) { return vmulq_f32( a, b ); }
+    inline tFloat4 Min( tFloat4 a, tFloat4 b ) { return vminq_f32( a, b ); }
+    inline tFloat4 Abs( tFloat4 a ) { return vabsq_f32( a ); }
+    inline bool AnyNegative( tFloat4 a ) { return vmaxvq_u32( vcltq_f32( a, vdupq_n_f32( 0.0f ) ) ) != 0; }
+#elif defined(OCTREE_SIMD_SSE)
+    typedef __m128 tFloat4;
+    inline tFloat4 Load( const float* p ) { return _mm_load_ps( p ); }
+    inline tFloat4 Splat( float f ) { return _mm_set1_ps( f ); }
+    inline tFloat4 Add( tFloat4 a, tFloat4 b ) { return _mm_add_ps( a, b ); }
+    inline tFloat4 Sub( tFloat4 a, tFloat4 b ) { return _mm_sub_ps( a, b ); }
+    inline tFloat4 Mul( tFloat4 a, tFloat4 b ) { return _mm_mul_ps( a, b ); }
+    inline tFloat4 Min( tFloat4 a, tFloat4 b ) { return _mm_min_ps( a, b ); }
+    inline tFloat4 Abs( tFloat4 a ) { return _mm_andnot_ps( _mm_set1_ps( -0.0f ), a ); }
+    inline bool AnyNegative( tFloat4 a ) { return _mm_movemask_ps( _mm_cmplt_ps( a, _mm_setzero_ps() ) ) != 0; }
+#else
+    struct tFloat4 { float v[4]; };
+    inline tFloat4 Load( const float* p ) { return { p[0], p[1], p[2], p[3] }; }
+    inline tFloat4 Splat( float f ) { return { f, f, f, f }; }
+    inline tFloat4 Add( tFloat4 a, tFloat4 b ) { return { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] }; }
+    inline tFloat4 Sub( tFloat4 a, tFloat4 b ) { return { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] }; }
+    inline tFloat4 Mul( tFloat4 a, tFloat4 b ) { return { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] }; }
+    inline tFloat4 Min( tFloat4 a, tFloat4 b ) { return { std::min( a.v[0], b.v[0] ), std::min( a.v[1], b.v[1] ), std::min( a.v[2], b.v[2] ), std::min( a.v[3], b.v[3] ) }; }
+    inline tFloat4 Abs( tFloat4 a ) { return { std::abs( a.v[0] ), std::abs( a.v[1] ), std::abs( a.v[2] ), std::abs( a.v[3] ) }; }
+    inline bool AnyNegative( tFloat4 a ) { return a.v[0] < 0.0f || a.v[1] < 0.0f || a.v[2] < 0.0f || a.v[3] < 0.0f; }
+#endif
+}
+
 class OctreeBase
 {
 public:
@@ -24,6 +75,15 @@ public:
     {
         Inside, Outside, Partial
     };
+
+protected:
+    /// Key describing the path of cells (3 bits each, stored in 4 bit digits with the first cell in the most significant digit) from the root node down to where an object lives.
+    /// Sorting objects by this key gives the same order as the objects are stored in the Octree.
+    typedef uint64_t tCellKey;
+
+    /// Stable (LSD) radix sort of keys and their associated object index.
+    /// @param numKeyBits number of (low) bits of the key that are used
+    static void RadixSort( std::vector<std::pair<tCellKey, uint32_t>>& keys, uint32_t numKeyBits );
 };
 
 
@@ -32,8 +92,8 @@ public:
 /// 
 /// Should give very good query and traversal performance (nodes are stored linearly in memory and ordered such that every node under a single octree node can be traversed linearly).
 /// 
-/// Has APALLING add/insert performance, potentially an add will cause all data in the octree to be moved.
-/// Could be improved 
+/// Has APALLING add/insert performance (for single objects), potentially an add will cause all data in the octree to be moved.
+/// When adding more than a handful of objects use Build (or AddObjects) which sort the objects by their cell path (an octree 'morton' order) and emit the node and object arrays in one linear pass.
 ///
 /// @tparam T_OBJECT object contained in the octree.  Keep small as these will be copied (a lot) on insertion.
 /// @tparam T_MAXDEPTH maximum depth (levels of nodes).  If 5 or less the octree will use less memory (16bit node indices)
@@ -72,14 +132,38 @@ public:
     /// @note SLOW
     void AddObject( const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/, T_OBJECT&& object );
 
+    /// Build the octree from a batch of objects, replacing any existing contents.
+    /// Gives the same octree as calling AddObject for each object (in order) on an empty octree, in O(n) time (for a given T_MAXDEPTH).
+    /// @param objectPositions position of each object
+    /// @param objectSizes size of each object (NOT a half size)
+    /// @param objects objects to add (same number as objectPositions and objectSizes)
+    void Build( std::span<const glm::vec4> objectPositions, std::span<const glm::vec4> objectSizes, std::vector<T_OBJECT>&& objects );
+
+    /// Add a batch of objects to the octree.
+    /// Gives the same octree as calling AddObject for each object (in order) but the existing nodes and objects are only moved once, O(n + m) rather than O(n * m).
+    void AddObjects( std::span<const glm::vec4> objectPositions, std::span<const glm::vec4> objectSizes, std::vector<T_OBJECT>&& objects );
+
+    size_t GetNumObjects() const { return m_Objects.size(); }
+    size_t GetNumNodes() const { return m_Nodes.size(); }
+
     /// Query against this octree and output all contained objects. 
     template<typename T_TEST, typename T_OUTPUT>
     void Query( const T_TEST& testFn, T_OUTPUT&& outputFn ) const;
 
+    /// Query against a view frustum and output all the (potentially) visible objects.
+    /// Faster than Query with a FrustumTest, the 8 cells of each node are tested against the frustum planes together (SIMD).
+    /// Cells are tested using their 'loose' bounds (objects can overhang their cell by up to half the cell size).
+    template<typename T_OUTPUT>
+    void QueryFrustum( const ViewFrustum& frustum, T_OUTPUT&& outputFn ) const;
+
+    /// Query against a view frustum and copy the (potentially) visible objects in to the output span.
+    /// @return number of visible objects.  If larger than output.size() the output was truncated (only the first output.size() objects written).
+    size_t QueryFrustum( const ViewFrustum& frustum, std::span<T_OBJECT> output ) const;
+
 private:
 
     // Gives the cell 'index' (octant) based upon the sign of the 3 axis.  Returns 0-7 (inclusive).
-    uint8_t CalcCellIndex( const glm::vec4& pos )
+    static uint8_t CalcCellIndex( const glm::vec4& pos )
     {
         uint8_t cellIndex = 0;
         if( pos.x >= 0.0f )
@@ -103,6 +187,37 @@ private:
     template<typename T_TEST, typename T_OUTPUT>
     void Query( const T_TEST& testFn, T_OUTPUT&& outputFn, uint32_t nodeIdx, uint32_t objectIdx, uint32_t objectEndIdx/*index of end of m_Object span for this node and all the nodes below*/, glm::vec4 center, glm::vec4 halfSize ) const;
 
+    // Internal (recursive) frustum query.  Visible objects are accumulated in to a run of contiguous objects (visibleRun), which is output when a non visible object breaks the run.
+    template<typename T_OUTPUTSPAN>
+    void QueryFrustum( const ViewFrustum& frustum, T_OUTPUTSPAN& outputSpanFn, std::pair<uint32_t, uint32_t>& visibleRun, uint32_t nodeIdx, uint32_t objectIdx, uint32_t objectEndIdx, const glm::vec3& center, const glm::vec3& halfSize ) const;
+    template<typename T_OUTPUTSPAN>
+    void QueryFrustumOutput( T_OUTPUTSPAN& outputSpanFn, std::pair<uint32_t, uint32_t>& visibleRun, uint32_t objectIdx, uint32_t objectEndIdx ) const
+    {
+        if( objectIdx != visibleRun.second )
+        {
+            if( visibleRun.first != visibleRun.second )
+                outputSpanFn( &m_Objects[visibleRun.first], visibleRun.second - visibleRun.first );
+            visibleRun.first = objectIdx;
+        }
+        visibleRun.second = objectEndIdx;
+    }
+
+    // Cell key helpers (Build and AddObjects).
+    // Each node depth has one digit (the cell index), followed by a cCellKeyEnd digit after the cell the object is stored in.
+    // cCellKeyEnd sorts after all the cells, matching objects stored 'in' a node being after the objects in the node's child cells.
+    static constexpr uint32_t cCellKeyDigits = T_MAXDEPTH + 2;
+    static constexpr tCellKey cCellKeyEnd = 8;
+    static_assert( cCellKeyDigits * 4 <= sizeof( tCellKey ) * 8, "T_MAXDEPTH too large for tCellKey" );
+    static constexpr uint32_t CellKeyShift( uint32_t depth ) { return (cCellKeyDigits - 1 - depth) * 4; }
+    static uint32_t CellKeyDigit( tCellKey key, uint32_t depth ) { return (uint32_t) (key >> CellKeyShift( depth )) & 0xf; }
+
+    // Calculate the cell key for an object (the same cell path AddObject would take).
+    tCellKey CalcCellKey( const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/ ) const;
+    // Recover the cell keys of the objects already in the octree (written to cellKeysOut[objectIdx]).
+    void CalcCellKeys( uint32_t nodeIdx, uint32_t objectIdx, uint32_t objectEndIdx, uint32_t depth, tCellKey cellKeyPrefix, std::vector<tCellKey>& cellKeysOut ) const;
+    // Add a node (and recursively its children) for a span of sorted cell keys that all share the same prefix (up to depth).
+    void BuildNodes( uint32_t depth, std::span<const tCellKey> sortedCellKeys );
+
 private:
     std::vector<Node>       m_Nodes;
     std::vector<T_OBJECT>   m_Objects;
@@ -196,6 +311,146 @@ uint32_t Octree<T_OBJECT, T_MAXDEPTH>::AddObject(uint32_t nodeIdx, uint32_t obje
     return numNewNodes;
 }
 
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+typename Octree<T_OBJECT, T_MAXDEPTH>::tCellKey Octree<T_OBJECT, T_MAXDEPTH>::CalcCellKey( const glm::vec4& objectPosition, const glm::vec4& objectSize/*NOT a half size*/ ) const
+{
+    // Mirrors the AddObject recursion (including the floating point math, so both give the exact same result).
+    if( !(objectSize.x < m_HalfSize.x && objectSize.y < m_HalfSize.y && objectSize.z < m_HalfSize.z) )
+    {
+        // Object too big to go in to any cells, lives in the top node.
+        return cCellKeyEnd << CellKeyShift( 0 );
+    }
+
+    tCellKey cellKey = 0;
+    glm::vec4 relativePosition = objectPosition - m_Center;
+    glm::vec4 scaledObjectSize = objectSize * 2.0f;
+    uint32_t depth = 0;
+    for( ;; )
+    {
+        const uint8_t cellIndex = CalcCellIndex( relativePosition );
+        cellKey |= tCellKey( cellIndex ) << CellKeyShift( depth );
+        if( depth < T_MAXDEPTH && (scaledObjectSize.x < m_HalfSize.x && scaledObjectSize.y < m_HalfSize.y && scaledObjectSize.z < m_HalfSize.z) )
+        {
+            relativePosition = 2.0f * relativePosition - m_HalfSize * sCellOffsets[cellIndex];
+            scaledObjectSize = scaledObjectSize * 2.0f;
+            ++depth;
+        }
+        else
+            break;
+    }
+    return cellKey | (cCellKeyEnd << CellKeyShift( depth + 1 ));
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void Octree<T_OBJECT, T_MAXDEPTH>::CalcCellKeys( uint32_t nodeIdx, uint32_t objectIdx, uint32_t objectEndIdx, uint32_t depth, tCellKey cellKeyPrefix, std::vector<tCellKey>& cellKeysOut ) const
+{
+    const Node& node = m_Nodes[nodeIdx];
+
+    for( uint32_t cell = 0; cell < 8; ++cell )
+    {
+        const uint32_t childObjectIdx = objectIdx + ((cell > 0) ? node.ChildObjectCountTotal[cell - 1] : 0);
+        const uint32_t childObjectEndIdx = objectIdx + node.ChildObjectCountTotal[cell];
+        if( childObjectIdx == childObjectEndIdx )
+            continue;
+
+        const tCellKey cellKey = cellKeyPrefix | (tCellKey( cell ) << CellKeyShift( depth ));
+        const uint32_t childNodeOffset = (cell > 0) ? node.ChildNodeCountTotal[cell - 1] : 0;
+        const uint32_t childNodeCount = node.ChildNodeCountTotal[cell] - childNodeOffset;
+        if( childNodeCount != 0 )
+        {
+            CalcCellKeys( nodeIdx + 1 + childNodeOffset, childObjectIdx, childObjectEndIdx, depth + 1, cellKey, cellKeysOut );
+        }
+        else
+        {
+            for( uint32_t i = childObjectIdx; i < childObjectEndIdx; ++i )
+                cellKeysOut[i] = cellKey | (cCellKeyEnd << CellKeyShift( depth + 1 ));
+        }
+    }
+
+    // Objects at the current node level.
+    for( uint32_t i = objectIdx + node.ChildObjectCountTotal[7]; i < objectEndIdx; ++i )
+        cellKeysOut[i] = cellKeyPrefix | (cCellKeyEnd << CellKeyShift( depth ));
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void Octree<T_OBJECT, T_MAXDEPTH>::BuildNodes( uint32_t depth, std::span<const tCellKey> sortedCellKeys )
+{
+    const size_t nodeIdx = m_Nodes.size();
+    m_Nodes.push_back( Node{} );
+
+    size_t cellBegin = 0;
+    for( uint32_t cell = 0; cell < 8; ++cell )
+    {
+        size_t cellEnd = cellBegin;
+        while( cellEnd < sortedCellKeys.size() && CellKeyDigit( sortedCellKeys[cellEnd], depth ) == cell )
+            ++cellEnd;
+
+        // Objects that go deeper than this cell sort before those stored in the cell, so only need to check the first object to see if we need a child node.
+        if( cellEnd != cellBegin && CellKeyDigit( sortedCellKeys[cellBegin], depth + 1 ) != cCellKeyEnd )
+            BuildNodes( depth + 1, sortedCellKeys.subspan( cellBegin, cellEnd - cellBegin ) );
+
+        Node& node = m_Nodes[nodeIdx];  // m_Nodes may have moved
+        node.ChildObjectCountTotal[cell] = (tObjectIdx) cellEnd;
+        node.ChildNodeCountTotal[cell] = (tNodeCount) (m_Nodes.size() - nodeIdx - 1);
+        cellBegin = cellEnd;
+    }
+    // Remaining objects (cCellKeyEnd at this depth) are stored at this node level.
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void Octree<T_OBJECT, T_MAXDEPTH>::Build( std::span<const glm::vec4> objectPositions, std::span<const glm::vec4> objectSizes, std::vector<T_OBJECT>&& objects )
+{
+    m_Nodes.clear();
+    m_Objects.clear();
+    AddObjects( objectPositions, objectSizes, std::move( objects ) );
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+void Octree<T_OBJECT, T_MAXDEPTH>::AddObjects( std::span<const glm::vec4> objectPositions, std::span<const glm::vec4> objectSizes, std::vector<T_OBJECT>&& objects )
+{
+    assert( objectPositions.size() == objects.size() && objectSizes.size() == objects.size() );
+
+    // Sort the new objects in to octree order (stable, so objects in the same cell stay in the order they were given).
+    std::vector<std::pair<tCellKey, uint32_t>> newCellKeys;
+    newCellKeys.reserve( objects.size() );
+    for( uint32_t i = 0; i < (uint32_t) objects.size(); ++i )
+        newCellKeys.emplace_back( CalcCellKey( objectPositions[i], objectSizes[i] ), i );
+    RadixSort( newCellKeys, cCellKeyDigits * 4 );
+
+    // Existing objects are already in octree order.
+    std::vector<tCellKey> existingCellKeys( m_Objects.size() );
+    if( !m_Objects.empty() )
+        CalcCellKeys( 0, 0, (uint32_t) m_Objects.size(), 0, 0, existingCellKeys );
+
+    // Merge.  Existing objects go before new objects in the same cell (as AddObject would do).
+    std::vector<T_OBJECT> mergedObjects;
+    std::vector<tCellKey> mergedCellKeys;
+    mergedObjects.reserve( std::max( m_Objects.capacity(), m_Objects.size() + objects.size() ) );
+    mergedCellKeys.reserve( m_Objects.size() + objects.size() );
+    size_t existingIdx = 0;
+    size_t newIdx = 0;
+    while( existingIdx < existingCellKeys.size() || newIdx < newCellKeys.size() )
+    {
+        if( newIdx == newCellKeys.size() || (existingIdx < existingCellKeys.size() && existingCellKeys[existingIdx] <= newCellKeys[newIdx].first) )
+        {
+            mergedCellKeys.push_back( existingCellKeys[existingIdx] );
+            mergedObjects.push_back( std::move( m_Objects[existingIdx] ) );
+            ++existingIdx;
+        }
+        else
+        {
+            mergedCellKeys.push_back( newCellKeys[newIdx].first );
+            mergedObjects.push_back( std::move( objects[newCellKeys[newIdx].second] ) );
+            ++newIdx;
+        }
+    }
+    m_Objects = std::move( mergedObjects );
+
+    // Emit the (linear) node array.
+    m_Nodes.clear();
+    BuildNodes( 0, mergedCellKeys );
+}
+
 template<typename T_OBJECT, uint32_t T_MAXDEPTH>
 template<typename T_TEST, typename T_OUTPUT>
 void Octree<T_OBJECT, T_MAXDEPTH>::Query(const T_TEST& testFn, T_OUTPUT&& outputFn) const
@@ -410,6 +665,15 @@ public:
             plane.z = plane.z / l;
             plane.w = plane.w / l;
         }
+
+        // Structure of arrays copy of the planes (for testing 4 planes at a time).  Padded with planes that everything is inside.
+        for (int i = 0; i < 8; i++)
+        {
+            m_PlanesX[i] = (i < 6) ? m_Planes[i].x : 0.0f;
+            m_PlanesY[i] = (i < 6) ? m_Planes[i].y : 0.0f;
+            m_PlanesZ[i] = (i < 6) ? m_Planes[i].z : 0.0f;
+            m_PlanesW[i] = (i < 6) ? m_Planes[i].w : 1.0f;
+        }
     };
 
     inline const auto& GetPlanes() const { return m_Planes; }
@@ -457,25 +721,18 @@ public:
     /// @note can get some false positives (boxes counted as inside or partial when they are actually outside), additional bounding plane checks would hit performance for these edge cases so currently not implemented.
     inline OctreeBase::eQueryResult BoxTest( const glm::vec3& boxCenter, const glm::vec3& boxHalfSize ) const
     {
-        const glm::vec3 boxMin = boxCenter - boxHalfSize;
-        const glm::vec3 boxMax = boxCenter + boxHalfSize;
-
-        // check box outside/inside of frustum
+        // check box outside/inside of frustum.
+        // Only need to test the box corner furthest along the plane normal (p-vertex) for outside and the nearest (n-vertex) for partially outside.
         bool partiallyOutside = false;
         for( int i=0; i<6; i++ )
         {
-            uint32_t outCount = (glm::dot( m_Planes[i], glm::vec4( boxMin.x, boxMin.y, boxMin.z, 1.0f ) ) < 0.0) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMax.x, boxMin.y, boxMin.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMin.x, boxMax.y, boxMin.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMax.x, boxMax.y, boxMin.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMin.x, boxMin.y, boxMax.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMax.x, boxMin.y, boxMax.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMin.x, boxMax.y, boxMax.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            outCount += (glm::dot( m_Planes[i], glm::vec4(boxMax.x, boxMax.y, boxMax.z, 1.0f) ) < 0.0 ) ? 1 : 0;
-            if( outCount == 8 )
-                // If all 8 points of box are outside plane we are outside this plane, and by extension outside the view frustum.
+            const glm::vec3 normal( m_Planes[i] );
+            const float distance = glm::dot( normal, boxCenter ) + m_Planes[i].w;
+            const float radius = glm::dot( glm::abs( normal ), boxHalfSize );
+            if( distance + radius < 0.0f )
+                // If the p-vertex is outside this plane the entire box is, and by extension outside the view frustum.
                 return OctreeBase::eQueryResult::Outside;
-            if( outCount != 0 )
+            if( distance - radius < 0.0f )
                 partiallyOutside = true;
         }
 
@@ -486,9 +743,63 @@ public:
         The downside is the extra CPU time spent double checking all the positive positives! */
         return partiallyOutside ? OctreeBase::eQueryResult::Partial : OctreeBase::eQueryResult::Inside;
     }
+
+    /// Result of CellTest, bit n is set for cell n (cells ordered as sCellOffsets)
+    struct CellMasks
+    {
+        uint8_t outside;    ///< cells entirely outside the frustum
+        uint8_t partial;    ///< cells partially inside the frustum (cells in neither mask are entirely inside)
+    };
+
+    /// Test the 8 cells (2x2x2 grid) of an octree node against the view frustum together.
+    /// Same result as BoxTest on each of the cells, the 6 planes are tested 4 at a time (SIMD).
+    /// @param center center of the octree node (cell centers are offset from this by +-cellHalfSize)
+    /// @param cellHalfSize half size of each cell
+    /// @param boxHalfSize half size of the box tested around each cell center (larger than cellHalfSize for 'loose' cells)
+    inline CellMasks CellTest( const glm::vec3& center, const glm::vec3& cellHalfSize, const glm::vec3& boxHalfSize ) const
+    {
+        using namespace OctreeSimd;
+        tFloat4 distance[2], radius[2], offsetX[2], offsetY[2], offsetZ[2];
+        for( int i = 0; i < 2; i++ )
+        {
+            const tFloat4 planeX = Load( &m_PlanesX[i * 4] );
+            const tFloat4 planeY = Load( &m_PlanesY[i * 4] );
+            const tFloat4 planeZ = Load( &m_PlanesZ[i * 4] );
+            // Distance of node center from each plane.
+            distance[i] = Add( Add( Mul( planeX, Splat( center.x ) ), Mul( planeY, Splat( center.y ) ) ), Add( Mul( planeZ, Splat( center.z ) ), Load( &m_PlanesW[i * 4] ) ) );
+            // Projected box 'radius' for each plane (same for every cell).
+            radius[i] = Add( Add( Mul( Abs( planeX ), Splat( boxHalfSize.x ) ), Mul( Abs( planeY ), Splat( boxHalfSize.y ) ) ), Mul( Abs( planeZ ), Splat( boxHalfSize.z ) ) );
+            // Distance offset of each cell center from the node center (sign depends on the cell).
+            offsetX[i] = Mul( planeX, Splat( cellHalfSize.x ) );
+            offsetY[i] = Mul( planeY, Splat( cellHalfSize.y ) );
+            offsetZ[i] = Mul( planeZ, Splat( cellHalfSize.z ) );
+        }
+
+        CellMasks masks{ 0, 0 };
+        for( uint32_t cell = 0; cell < 8; ++cell )
+        {
+            tFloat4 cellDistance[2];
+            for( int i = 0; i < 2; i++ )
+            {
+                cellDistance[i] = (cell & 1) ? Add( distance[i], offsetX[i] ) : Sub( distance[i], offsetX[i] );
+                cellDistance[i] = (cell & 2) ? Add( cellDistance[i], offsetY[i] ) : Sub( cellDistance[i], offsetY[i] );
+                cellDistance[i] = (cell & 4) ? Add( cellDistance[i], offsetZ[i] ) : Sub( cellDistance[i], offsetZ[i] );
+            }
+            // Outside if the p-vertex is outside any plane, partial if the n-vertex is outside any plane.
+            masks.outside |= (uint8_t) (AnyNegative( Min( Add( cellDistance[0], radius[0] ), Add( cellDistance[1], radius[1] ) ) ) << cell);
+            masks.partial |= (uint8_t) (AnyNegative( Min( Sub( cellDistance[0], radius[0] ), Sub( cellDistance[1], radius[1] ) ) ) << cell);
+        }
+        masks.partial &= ~masks.outside;
+        return masks;
+    }
 private:
     /// Planes defining the frustum sides (for culling)
     glm::vec4 m_Planes[6];
+    /// Planes in structure of arrays layout (padded to 8)
+    alignas(16) float m_PlanesX[8];
+    alignas(16) float m_PlanesY[8];
+    alignas(16) float m_PlanesZ[8];
+    alignas(16) float m_PlanesW[8];
     //// Frustum vertex positions, converted to x,y,z array (for potential vectorization)
     //float m_VerticesX[8];
     //float m_VerticesZ[8];
@@ -518,3 +829,78 @@ struct FrustumTest
 
     const ViewFrustum& m_Frustum;
 };
+
+
+//
+// Octree frustum query implementation (needs the complete ViewFrustum)
+//
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+template<typename T_OUTPUT>
+void Octree<T_OBJECT, T_MAXDEPTH>::QueryFrustum( const ViewFrustum& frustum, T_OUTPUT&& outputFn ) const
+{
+    auto outputSpanFn = [&outputFn]( const T_OBJECT* pObjects, uint32_t numObjects ) {
+        for( uint32_t i = 0; i < numObjects; ++i )
+            outputFn( pObjects[i] );
+    };
+    std::pair<uint32_t, uint32_t> visibleRun{ 0, 0 };
+    QueryFrustum( frustum, outputSpanFn, visibleRun, 0, 0, (uint32_t) m_Objects.size(), glm::vec3( m_Center ), glm::vec3( m_HalfSize ) );
+    QueryFrustumOutput( outputSpanFn, visibleRun, ~0u, ~0u );  // flush
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+size_t Octree<T_OBJECT, T_MAXDEPTH>::QueryFrustum( const ViewFrustum& frustum, std::span<T_OBJECT> output ) const
+{
+    size_t numVisible = 0;
+    auto outputSpanFn = [&numVisible, &output]( const T_OBJECT* pObjects, uint32_t numObjects ) {
+        if( numVisible < output.size() )
+        {
+            const size_t numToCopy = std::min( (size_t) numObjects, output.size() - numVisible );
+            std::copy( pObjects, pObjects + numToCopy, output.begin() + numVisible );
+        }
+        numVisible += numObjects;
+    };
+    std::pair<uint32_t, uint32_t> visibleRun{ 0, 0 };
+    QueryFrustum( frustum, outputSpanFn, visibleRun, 0, 0, (uint32_t) m_Objects.size(), glm::vec3( m_Center ), glm::vec3( m_HalfSize ) );
+    QueryFrustumOutput( outputSpanFn, visibleRun, ~0u, ~0u );  // flush
+    return numVisible;
+}
+
+template<typename T_OBJECT, uint32_t T_MAXDEPTH>
+template<typename T_OUTPUTSPAN>
+void Octree<T_OBJECT, T_MAXDEPTH>::QueryFrustum( const ViewFrustum& frustum, T_OUTPUTSPAN& outputSpanFn, std::pair<uint32_t, uint32_t>& visibleRun, uint32_t nodeIdx, uint32_t objectIdx, uint32_t objectEndIdx, const glm::vec3& center, const glm::vec3& halfSize ) const
+{
+    const glm::vec3 cellHalfSize = halfSize * 0.5f;
+    const Node& node = m_Nodes[nodeIdx];
+
+    // Test all 8 cells in one go.  Expand out the test because we allow objects up to half the cell size in each cell.
+    const ViewFrustum::CellMasks masks = frustum.CellTest( center, cellHalfSize, cellHalfSize * 1.5f );
+
+    for( uint32_t cell = 0; cell < 8; ++cell )
+    {
+        const uint32_t childObjectIdx = objectIdx + ((cell > 0) ? node.ChildObjectCountTotal[cell - 1] : 0);
+        const uint32_t childObjectEndIdx = objectIdx + node.ChildObjectCountTotal[cell];
+        if( childObjectIdx == childObjectEndIdx || (masks.outside & (1 << cell)) != 0 )
+            continue;
+
+        if( (masks.partial & (1 << cell)) != 0 )
+        {
+            const uint32_t childNodeOffset = (cell > 0) ? node.ChildNodeCountTotal[cell - 1] : 0;
+            const uint32_t childNodeCount = node.ChildNodeCountTotal[cell] - childNodeOffset;
+            if( childNodeCount != 0 )
+            {
+                // Recurse in to this cell's child node.
+                const glm::vec3 cellCenter = center + glm::vec3( sCellOffsets[cell] ) * cellHalfSize;
+                QueryFrustum( frustum, outputSpanFn, visibleRun, nodeIdx + 1 + childNodeOffset, childObjectIdx, childObjectEndIdx, cellCenter, cellHalfSize );
+                continue;
+            }
+        }
+        // Cell inside (or partially inside with no nodes below), output everything under this cell.
+        QueryFrustumOutput( outputSpanFn, visibleRun, childObjectIdx, childObjectEndIdx );
+    }
+
+    // output everything that is at the current node level (ie not at a lower level).
+    const uint32_t nodeObjectIdx = objectIdx + node.ChildObjectCountTotal[7];
+    if( nodeObjectIdx < objectEndIdx )
+        QueryFrustumOutput( outputSpanFn, visibleRun, nodeObjectIdx, objectEndIdx );
+}
@@ -0,0 +1,318 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "vertexFormatConverter.hpp"
+#include "material/vertexFormat.hpp"
+#include "system/crc32c.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define VERTEX_CONVERTER_NEON 1
+#elif defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define VERTEX_CONVERTER_F16C 1
+#endif
+
+namespace
+{
+    // String literal lower case hash (constexpr)
+    constexpr FnvHashLower operator "" _h(const char* str, size_t) { return FnvHashLower(str); }
+
+    /// Number of vertices converted in each block (output block is written to the destination in one sequential copy).
+    constexpr size_t cBlockVertices = 256;
+
+    /// Float to half conversion, round to nearest even, handles denormals/inf/nan.
+    /// Based on the public domain float_to_half_fast3_rtne by Fabian Giesen.
+    inline uint16_t FloatToHalf(float f)
+    {
+        uint32_t x;
+        memcpy(&x, &f, sizeof(x));
+        const uint32_t sign = x & 0x80000000u;
+        x ^= sign;
+
+        uint16_t o;
+        if (x >= 0x47800000u)           // result is Inf or NaN (all exponent bits set)
+        {
+            o = (x > 0x7f800000u) ? 0x7e00 : 0x7c00;   // NaN->qNaN and Inf->Inf
+        }
+        else if (x < 0x38800000u)       // resulting FP16 is subnormal or zero
+        {
+            // Use a magic value to align our 10 mantissa bits at the bottom of the float (float addition does the rounding).
+            float fx;
+            memcpy(&fx, &x, sizeof(fx));
+            fx += 0.5f;
+            memcpy(&x, &fx, sizeof(x));
+            o = (uint16_t)(x - 0x3f000000u);
+        }
+        else
+        {
+            const uint32_t mantissaOdd = (x >> 13) & 1;
+            x += ((uint32_t)(15 - 127) << 23) + 0xfff;  // update exponent, rounding bias part 1
+            x += mantissaOdd;                           // rounding bias part 2
+            o = (uint16_t)(x >> 13);
+        }
+        return o | (uint16_t)(sign >> 16);
+    }
+
+    /// Batch float to half conversion (vectorized where the cpu supports it).
+    void FloatToHalf(const float* pSrc, uint16_t* pDst, size_t count)
+    {
+        size_t i = 0;
+#if defined(VERTEX_CONVERTER_NEON)
+        for (; i + 4 <= count; i += 4)
+            vst1_u16(pDst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(pSrc + i))));
+#elif defined(VERTEX_CONVERTER_F16C)
+        for (; i + 8 <= count; i += 8)
+            _mm_storeu_si128((__m128i*)(pDst + i), _mm256_cvtps_ph(_mm256_loadu_ps(pSrc + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+        for (; i < count; ++i)
+            pDst[i] = FloatToHalf(pSrc[i]);
+    }
+
+    // Kernels.  Each is specialized on the number of components so the inner loops fully unroll.
+
+    template<size_t T_COMPONENTS>
+    void GatherCopy32(const uint8_t* pSrc, size_t srcStride, uint8_t* pDst, size_t dstStride, size_t count)
+    {
+        for (size_t v = 0; v < count; ++v, pSrc += srcStride, pDst += dstStride)
+            memcpy(pDst, pSrc, T_COMPONENTS * sizeof(uint32_t));
+    }
+
+    template<size_t T_COMPONENTS>
+    void GatherToFloat16(const uint8_t* pSrc, size_t srcStride, bool srcIsFloat, uint8_t* pDst, size_t dstStride, size_t count)
+    {
+        // Gather in to a contiguous array, batch convert, scatter.
+        std::array<float, cBlockVertices * T_COMPONENTS> gathered;
+        std::array<uint16_t, cBlockVertices * T_COMPONENTS> halfs;
+        assert(count <= cBlockVertices);
+        if (srcIsFloat)
+        {
+            for (size_t v = 0; v < count; ++v, pSrc += srcStride)
+                memcpy(&gathered[v * T_COMPONENTS], pSrc, T_COMPONENTS * sizeof(float));
+        }
+        else
+        {
+            for (size_t v = 0; v < count; ++v, pSrc += srcStride)
+            {
+                int32_t ints[T_COMPONENTS];
+                memcpy(ints, pSrc, sizeof(ints));
+                for (size_t c = 0; c < T_COMPONENTS; ++c)
+                    gathered[v * T_COMPONENTS + c] = (float)ints[c];
+            }
+        }
+        FloatToHalf(gathered.data(), halfs.data(), count * T_COMPONENTS);
+        for (size_t v = 0; v < count; ++v, pDst += dstStride)
+            memcpy(pDst, &halfs[v * T_COMPONENTS], T_COMPONENTS * sizeof(uint16_t));
+    }
+
+    template<size_t T_COMPONENTS>
+    void GatherToInt16(const uint8_t* pSrc, size_t srcStride, bool srcIsFloat, uint8_t* pDst, size_t dstStride, size_t count)
+    {
+        for (size_t v = 0; v < count; ++v, pSrc += srcStride, pDst += dstStride)
+        {
+            uint16_t out[T_COMPONENTS];
+            if (srcIsFloat)
+            {
+                float in[T_COMPONENTS];
+                memcpy(in, pSrc, sizeof(in));
+                for (size_t c = 0; c < T_COMPONENTS; ++c)
+                    out[c] = (uint16_t)(int32_t)in[c];
+            }
+            else
+            {
+                int32_t in[T_COMPONENTS];
+                memcpy(in, pSrc, sizeof(in));
+                for (size_t c = 0; c < T_COMPONENTS; ++c)
+                    out[c] = (uint16_t)in[c];
+            }
+            memcpy(pDst, out, sizeof(out));
+        }
+    }
+
+    /// Dispatch a runtime component count (1-8, more than 4 when 32bit copies are merged) to the compile time specialized kernel
+    template<template<size_t> class T_KERNEL, typename... T_ARGS>
+    void DispatchComponents(uint32_t numComponents, T_ARGS&&... args)
+    {
+        switch (numComponents) {
+        case 1: T_KERNEL<1>{}(std::forward<T_ARGS>(args)...); break;
+        case 2: T_KERNEL<2>{}(std::forward<T_ARGS>(args)...); break;
+        case 3: T_KERNEL<3>{}(std::forward<T_ARGS>(args)...); break;
+        case 4: T_KERNEL<4>{}(std::forward<T_ARGS>(args)...); break;
+        case 5: T_KERNEL<5>{}(std::forward<T_ARGS>(args)...); break;
+        case 6: T_KERNEL<6>{}(std::forward<T_ARGS>(args)...); break;
+        case 7: T_KERNEL<7>{}(std::forward<T_ARGS>(args)...); break;
+        case 8: T_KERNEL<8>{}(std::forward<T_ARGS>(args)...); break;
+        default: assert(0); break;
+        }
+    }
+    template<size_t T_COMPONENTS> struct Copy32Kernel { template<typename... T_ARGS> void operator()(T_ARGS... args) const { GatherCopy32<T_COMPONENTS>(args...); } };
+    template<size_t T_COMPONENTS> struct ToFloat16Kernel { template<typename... T_ARGS> void operator()(T_ARGS... args) const { GatherToFloat16<T_COMPONENTS>(args...); } };
+    template<size_t T_COMPONENTS> struct ToInt16Kernel { template<typename... T_ARGS> void operator()(T_ARGS... args) const { GatherToInt16<T_COMPONENTS>(args...); } };
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+VertexFormatConverter::VertexFormatConverter(const VertexFormat& vertexFormat) : m_Span(vertexFormat.span)
+{
+    using FatVertex = MeshObjectIntermediate::FatVertex;
+    using FatWeight = MeshObjectIntermediate::FatWeight;
+    using ElementType = VertexFormat::Element::ElementType;
+
+    //
+    // Determine the source of each element in the vertexFormat.
+    // Uses case insensitive slot/semantic name comparision.
+    //
+    std::vector<bool> written(m_Span, false);
+    for (size_t i = 0; i < vertexFormat.elementIds.size(); ++i)
+    {
+        const std::string& elementId = vertexFormat.elementIds[i];
+        const FnvHashLower elementHash(elementId);   // use hashes to compare, all the hashing in the switch statement is compile time!
+
+        Op op{};
+        op.srcIsFloat = true;
+        switch (elementHash) {
+        case "Position"_h:
+            op.srcOffset = offsetof(FatVertex, position);
+            break;
+        case "UV"_h:
+        case "TEXCOORD"_h:
+            op.srcOffset = offsetof(FatVertex, uv0);
+            break;
+        case "Color"_h:
+            op.srcOffset = offsetof(FatVertex, color);
+            break;
+        case "Normal"_h:
+            op.srcOffset = offsetof(FatVertex, normal);
+            break;
+        case "Tangent"_h:
+            op.srcOffset = offsetof(FatVertex, tangent);
+            break;
+        case "Bitangent"_h:
+            op.srcOffset = offsetof(FatVertex, bitangent);
+            break;
+        case "Joint"_h:
+            op.srcOffset = offsetof(FatWeight, joint);
+            op.srcIsWeight = true;
+            op.srcIsFloat = false;
+            break;
+        case "Weight"_h:
+            op.srcOffset = offsetof(FatWeight, weight);
+            op.srcIsWeight = true;
+            break;
+        default:
+            LOGE("Cannot map vertex elementId %s to the mesh data", elementId.c_str());
+            continue;
+        }
+
+        const auto& element = vertexFormat.elements[i];
+        op.dstOffset = element.offset;
+        op.numComponents = (uint8_t)element.type.elements();
+        switch (ElementType::t(element.type)) {
+        case ElementType::t::Float16:
+        case ElementType::t::F16Vec2:
+        case ElementType::t::F16Vec3:
+        case ElementType::t::F16Vec4:
+            op.type = OpType::ToFloat16;
+            break;
+        case ElementType::t::Int16:
+        case ElementType::t::UInt16:
+        case ElementType::t::I16Vec2:
+        case ElementType::t::I16Vec3:
+        case ElementType::t::I16Vec4:
+        case ElementType::t::U16Vec2:
+        case ElementType::t::U16Vec3:
+        case ElementType::t::U16Vec4:
+            op.type = OpType::ToInt16;
+            break;
+        default:
+            op.type = OpType::Copy32;
+            assert((op.dstOffset & 3) == 0);      // cannot handle non 4 byte aligned 32bit data
+            break;
+        }
+        const uint32_t dstSize = element.type.size();
+        if (op.numComponents == 0 || op.dstOffset + dstSize > m_Span || op.srcOffset + op.numComponents * 4 > (op.srcIsWeight ? sizeof(FatWeight) : sizeof(FatVertex)))
+        {
+            LOGE("Cannot map vertex elementId %s (bad size or offset)", elementId.c_str());
+            continue;
+        }
+        std::fill(written.begin() + op.dstOffset, written.begin() + op.dstOffset + dstSize, true);
+
+        // Merge with the previous op if both the source and destination are contiguous (eg Position followed by Normal).
+        if (!m_Ops.empty())
+        {
+            Op& prevOp = *m_Ops.rbegin();
+            if (prevOp.type == OpType::Copy32 && op.type == OpType::Copy32 && prevOp.srcIsWeight == op.srcIsWeight &&
+                prevOp.srcOffset + prevOp.numComponents * 4 == op.srcOffset && prevOp.dstOffset + prevOp.numComponents * 4 == op.dstOffset && prevOp.numComponents + op.numComponents <= 8)
+            {
+                prevOp.numComponents += op.numComponents;
+                continue;
+            }
+        }
+        m_Ops.push_back(op);
+    }
+    m_NeedsZeroFill = std::find(written.begin(), written.end(), false) != written.end();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void VertexFormatConverter::Convert(std::span<const MeshObjectIntermediate::FatVertex> fatVertexBuffer, std::span<const MeshObjectIntermediate::FatWeight> fatWeightBuffer, std::span<uint8_t> output) const
+{
+    const size_t numVertices = fatVertexBuffer.size();
+    assert(fatWeightBuffer.empty() || fatWeightBuffer.size() == numVertices);
+    assert(output.size() >= numVertices * m_Span);
+    if (numVertices == 0 || m_Span == 0)
+        return;
+
+    // Convert a block at a time in to (cached) local memory, output may be uncached/write-combined.
+    std::vector<uint8_t> block(cBlockVertices * m_Span, 0);
+    for (size_t firstVertex = 0; firstVertex < numVertices; firstVertex += cBlockVertices)
+    {
+        const size_t count = std::min(cBlockVertices, numVertices - firstVertex);
+        if (m_NeedsZeroFill)
+            std::fill(block.begin(), block.end(), uint8_t(0));
+
+        for (const Op& op : m_Ops)
+        {
+            const uint8_t* pSrc;
+            size_t srcStride;
+            if (op.srcIsWeight)
+            {
+                if (fatWeightBuffer.empty())
+                    continue;   // leave zeroed
+                pSrc = (const uint8_t*)&fatWeightBuffer[firstVertex] + op.srcOffset;
+                srcStride = sizeof(MeshObjectIntermediate::FatWeight);
+            }
+            else
+            {
+                pSrc = (const uint8_t*)&fatVertexBuffer[firstVertex] + op.srcOffset;
+                srcStride = sizeof(MeshObjectIntermediate::FatVertex);
+            }
+            uint8_t* pDst = block.data() + op.dstOffset;
+
+            switch (op.type) {
+            case OpType::Copy32:
+                DispatchComponents<Copy32Kernel>(op.numComponents, pSrc, srcStride, pDst, (size_t)m_Span, count);
+                break;
+            case OpType::ToFloat16:
+                DispatchComponents<ToFloat16Kernel>(op.numComponents, pSrc, srcStride, op.srcIsFloat, pDst, (size_t)m_Span, count);
+                break;
+            case OpType::ToInt16:
+                DispatchComponents<ToInt16Kernel>(op.numComponents, pSrc, srcStride, op.srcIsFloat, pDst, (size_t)m_Span, count);
+                break;
+            }
+        }
+        memcpy(output.data() + firstVertex * m_Span, block.data(), count * m_Span);
+    }
+}
@@ -0,0 +1,59 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "mesh/meshIntermediate.hpp"
+
+// Forward declarations
+class VertexFormat;
+
+
+/// Converts MeshObjectIntermediate 'fat' vertex (and weight) data in to the layout described by a VertexFormat.
+///
+/// The VertexFormat is parsed once (on construction) in to a list of conversion operations, one per output element.
+/// Each operation is run over a block of vertices at a time using a kernel specialized (at compile time) for the operation type and number of components,
+/// so the per-vertex work is a tight strided gather (and batched float to half conversion) with no per-element branching.
+/// Output is written sequentially, so it is safe (and efficient) to convert directly in to mapped (write-combined) buffer memory.
+/// @ingroup Mesh
+class VertexFormatConverter
+{
+public:
+    explicit VertexFormatConverter(const VertexFormat& vertexFormat);
+
+    /// Output span (bytes per vertex)
+    uint32_t GetSpan() const { return m_Span; }
+
+    /// Convert the vertex (and optional weight) data.
+    /// @param fatVertexBuffer vertex data to convert
+    /// @param fatWeightBuffer vertex weights (may be empty, if not empty must have the same number of vertices as fatVertexBuffer)
+    /// @param output destination, must be at least fatVertexBuffer.size() * GetSpan() bytes.  Every byte of every output vertex is written (elements not in the VertexFormat are zeroed).
+    void Convert(std::span<const MeshObjectIntermediate::FatVertex> fatVertexBuffer, std::span<const MeshObjectIntermediate::FatWeight> fatWeightBuffer, std::span<uint8_t> output) const;
+
+protected:
+    enum class OpType : uint8_t {
+        Copy32,     ///< copy 32bit components as-is
+        ToFloat16,  ///< convert to 16bit float
+        ToInt16,    ///< convert to 16bit (signed or unsigned) integer
+    };
+    struct Op
+    {
+        OpType      type;
+        bool        srcIsWeight;    ///< source is FatWeight (otherwise FatVertex)
+        bool        srcIsFloat;     ///< source components are floats (otherwise int)
+        uint8_t     numComponents;
+        uint32_t    srcOffset;      ///< byte offset in FatVertex/FatWeight
+        uint32_t    dstOffset;      ///< byte offset in the output vertex
+    };
+
+    std::vector<Op> m_Ops;
+    uint32_t        m_Span = 0;
+    bool            m_NeedsZeroFill = false;    ///< ops do not write every byte of the output vertex
+};
@@ -8,7 +8,10 @@
 
 #include "Worker.h"
 #include "os_common.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <memory>
 
 
 // **********************************************
@@ -233,3 +236,48 @@ void ThreadWorker::DoWork(ThreadWork&& work, uint32_t WaitTimeMS)
     // LOGI("(%s) DoWork posting WorkAvailable", m_Name.c_str());
     m_WorkAvailable.Post();
 }
+
+namespace
+{
+    /// Shared by the ParallelFor caller and the worker threads helping it (helpers may start after ParallelFor has returned, so shared_ptr owned).
+    struct ParallelForJob
+    {
+        const std::function<void( size_t )>* pFn;     ///< only dereferenced while ParallelFor is waiting
+        size_t                  count;
+        std::atomic<size_t>     nextIndex = 0;
+        std::atomic<size_t>     numDone = 0;
+        std::mutex              doneMutex;
+        std::condition_variable doneCondition;
+
+        ParallelForJob( const std::function<void( size_t )>& fn, size_t _count ) noexcept : pFn( &fn ), count( _count ) {}
+
+        void Run()
+        {
+            for (size_t index = nextIndex++; index < count; index = nextIndex++)
+            {
+                (*pFn)( index );
+                if (++numDone == count)
+                {
+                    std::lock_guard<std::mutex> lock( doneMutex );
+                    doneCondition.notify_all();
+                }
+            }
+        }
+    };
+}
+
+//-----------------------------------------------------------------------------
+void ThreadWorker::ParallelFor( size_t count, const std::function<void( size_t )>& fn )
+//-----------------------------------------------------------------------------
+{
+    if (count == 0)
+        return;
+    auto job = std::make_shared<ParallelForJob>( fn, count );
+    const size_t numHelpers = std::min( m_Workers.size(), count - 1 );
+    for (size_t i = 0; i < numHelpers; ++i)
+        DoWork2( []( std::shared_ptr<ParallelForJob> job ) { job->Run(); }, job );
+    job->Run();
+
+    std::unique_lock<std::mutex> lock( job->doneMutex );
+    job->doneCondition.wait( lock, [&job]() { return job->numDone == job->count; } );
+}
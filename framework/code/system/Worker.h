@@ -216,6 +216,11 @@ public:
         DoWork( +lambdaWrap, pWork, 1000 );
     }
 
+    /// Run fn(index) for every index in [0,count), spread across the worker threads and the calling thread.  Returns when all are complete.
+    /// The calling thread takes indices too, so this completes even if the worker threads are busy (or the worker has no threads).
+    /// @note Thread safe.
+    void        ParallelFor( size_t count, const std::function<void( size_t )>& fn );
+
     void        Terminate();
 
 protected:
@@ -14,6 +14,10 @@
 #include "system/os_common.h"
 #include <android/asset_manager.h>
 #include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 //-----------------------------------------------------------------------------
 // Define a class to hold the file handle pointers.
@@ -201,6 +205,44 @@ void AssetManager::CloseFile(AssetHandle* pHandle)
     delete pHandle;
 }
 
+//-----------------------------------------------------------------------------
+void* AssetManager::MapFileData(const std::string& pPortableFileName, size_t& fileSizeOut)
+//-----------------------------------------------------------------------------
+{
+    if (pPortableFileName.empty())
+        return nullptr;
+
+    const auto deviceFilename = PortableFilenameToDevicePath(pPortableFileName);
+    int fd = open(deviceFilename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    void* pMapping = nullptr;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        pMapping = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMapping == MAP_FAILED)
+        {
+            pMapping = nullptr;
+        }
+        else
+        {
+            fileSizeOut = (size_t)fileStat.st_size;
+        }
+    }
+    // Mapping stays valid after the file is closed.
+    close(fd);
+    return pMapping;
+}
+
+//-----------------------------------------------------------------------------
+void AssetManager::UnmapFileData(void* pMapping, size_t fileSize)
+//-----------------------------------------------------------------------------
+{
+    munmap(pMapping, fileSize);
+}
+
 //-----------------------------------------------------------------------------
 std::string AssetManager::PortableFilenameToDevicePath(const std::string& portableFilename)
 //-----------------------------------------------------------------------------
@@ -114,6 +114,35 @@ private:
 };
 
 
+/// Read only view of an entire file, filled by AssetManager::MapFile.
+/// Memory mapped where the platform supports it (so large files are paged in on demand rather than read and copied), otherwise the file contents are loaded in to memory.
+/// @ingroup System
+class AssetMappedFile
+{
+    AssetMappedFile(const AssetMappedFile&) = delete;
+    AssetMappedFile& operator=(const AssetMappedFile&) = delete;
+public:
+    friend class AssetManager;
+    AssetMappedFile() {}
+    ~AssetMappedFile() { Release(); }
+
+    /// Unmap (or free) the file contents.
+    void Release();
+
+    const char* data() const noexcept { return m_pData; }
+    size_t size() const noexcept { return m_Size; }
+    bool empty() const noexcept { return m_Size == 0; }
+    /// @return true if the data is memory mapped (false if it was loaded in to memory)
+    bool IsMapped() const { return m_pMapping != nullptr; }
+
+private:
+    const char*         m_pData = nullptr;
+    size_t              m_Size = 0;
+    void*               m_pMapping = nullptr;   ///< platform mapping (nullptr if the file was loaded in to m_Memory)
+    std::vector<char>   m_Memory;
+};
+
+
 /// Handles file loading from device storage.
 /// Implementations are expected to be device specific (eg in android/androidAssetManager.cpp)
 /// @ingroup System
@@ -174,6 +203,29 @@ public:
         return true;
     }
 
+    /// Map the contents of the given file in to memory (read only).
+    /// Falls back to loading the file in to memory if it cannot be mapped (eg files inside the Android apk).
+    /// @return true if successful
+    bool MapFile(const std::string& portableFileName, AssetMappedFile& mappedFile)
+    {
+        mappedFile.Release();
+        size_t fileSize = 0;
+        if (void* pMapping = MapFileData(portableFileName, fileSize))
+        {
+            mappedFile.m_pMapping = pMapping;
+            mappedFile.m_pData = (const char*)pMapping;
+            mappedFile.m_Size = fileSize;
+            return true;
+        }
+        if (!LoadFileIntoMemory(portableFileName, mappedFile.m_Memory))
+        {
+            return false;
+        }
+        mappedFile.m_pData = mappedFile.m_Memory.data();
+        mappedFile.m_Size = mappedFile.m_Memory.size();
+        return true;
+    }
+
     AssetHandleGuard OpenFile( const std::string& portableFilename )
     {
         auto* fileHandle = OpenFile( portableFilename, Mode::Read );
@@ -249,6 +301,20 @@ public:
         return true;
     }
 
+    /// Get the size of the given file (without reading it).
+    /// @return true if the file exists
+    bool GetFileSize(const std::string& portableFileName, size_t& fileSizeOut)
+    {
+        AssetHandle* handle = OpenFile(portableFileName, Mode::Read);
+        if (!handle)
+        {
+            return false;
+        }
+        fileSizeOut = FileSize(handle);
+        CloseFile(handle);
+        return true;
+    }
+
     /// Join together two file paths
     inline std::string JoinPath(const std::string& a, const std::string& b) const
     {
@@ -258,6 +324,9 @@ public:
             return a + std::string("/") + b;
     }
 
+    /// Get the device (platform specific) path for a portable file name, eg for use with std::filesystem.
+    std::string GetDevicePath(const std::string& portableFileName) { return PortableFilenameToDevicePath(portableFileName); }
+
     /// Extract the directory name from a file path
     inline std::string ExtractDirectory(const std::string& filename) const
     {
@@ -279,6 +348,10 @@ protected:
     size_t ReadFile(void* pDest, size_t bytes, AssetHandle* pHandle);
     size_t WriteFile(const void* psrc, size_t bytes, AssetHandle* pHandle);
     void CloseFile(AssetHandle*);
+    /// Memory map (read only) the given file, returns nullptr if the file cannot be mapped (or is empty).
+    void* MapFileData(const std::string& pPortableFileName, size_t& fileSizeOut);
+    static void UnmapFileData(void* pMapping, size_t fileSize);
+    friend class AssetMappedFile;
 
     std::string PortableFilenameToDevicePath(const std::string& pPortableFileName);
 
@@ -300,3 +373,15 @@ inline void AssetHandleGuard::Release()
     }
     assert( m_AssetHandle == nullptr );
 }
+
+inline void AssetMappedFile::Release()
+{
+    if (m_pMapping)
+    {
+        AssetManager::UnmapFileData( m_pMapping, m_Size );
+        m_pMapping = nullptr;
+    }
+    m_Memory = std::vector<char>();
+    m_pData = nullptr;
+    m_Size = 0;
+}
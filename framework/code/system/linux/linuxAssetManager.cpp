@@ -15,6 +15,10 @@
 #include <cstdio>
 #include <cassert>
 #include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 
 //-----------------------------------------------------------------------------
@@ -98,6 +102,45 @@ void AssetManager::CloseFile(AssetHandle* pHandle)
 }
 
 
+//-----------------------------------------------------------------------------
+void* AssetManager::MapFileData(const std::string& pPortableFileName, size_t& fileSizeOut)
+//-----------------------------------------------------------------------------
+{
+    if (pPortableFileName.empty())
+        return nullptr;
+
+    const auto deviceFilename = PortableFilenameToDevicePath(pPortableFileName);
+    int fd = open(deviceFilename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    void* pMapping = nullptr;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        pMapping = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMapping == MAP_FAILED)
+        {
+            pMapping = nullptr;
+        }
+        else
+        {
+            fileSizeOut = (size_t)fileStat.st_size;
+        }
+    }
+    // Mapping stays valid after the file is closed.
+    close(fd);
+    return pMapping;
+}
+
+//-----------------------------------------------------------------------------
+void AssetManager::UnmapFileData(void* pMapping, size_t fileSize)
+//-----------------------------------------------------------------------------
+{
+    munmap(pMapping, fileSize);
+}
+
+
 //-----------------------------------------------------------------------------
 std::string AssetManager::PortableFilenameToDevicePath(const std::string& portableFileName)
 //-----------------------------------------------------------------------------
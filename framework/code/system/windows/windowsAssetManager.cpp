@@ -15,6 +15,8 @@
 #include <cstdio>
 #include <cassert>
 #include <algorithm>
+#define NOMINMAX
+#include <windows.h>
 
 
 //-----------------------------------------------------------------------------
@@ -98,6 +100,43 @@ void AssetManager::CloseFile(AssetHandle* pHandle)
 }
 
 
+//-----------------------------------------------------------------------------
+void* AssetManager::MapFileData(const std::string& pPortableFileName, size_t& fileSizeOut)
+//-----------------------------------------------------------------------------
+{
+    if (pPortableFileName.empty())
+        return nullptr;
+
+    const auto deviceFilename = PortableFilenameToDevicePath(pPortableFileName);
+    HANDLE hFile = CreateFileA(deviceFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    void* pMapping = nullptr;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0)
+    {
+        HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (hMapping != nullptr)
+        {
+            pMapping = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+            if (pMapping)
+                fileSizeOut = (size_t)fileSize.QuadPart;
+            // View stays valid after the mapping and file handles are closed.
+            CloseHandle(hMapping);
+        }
+    }
+    CloseHandle(hFile);
+    return pMapping;
+}
+
+//-----------------------------------------------------------------------------
+void AssetManager::UnmapFileData(void* pMapping, size_t)
+//-----------------------------------------------------------------------------
+{
+    UnmapViewOfFile(pMapping);
+}
+
 //-----------------------------------------------------------------------------
 std::string AssetManager::PortableFilenameToDevicePath(const std::string& portableFileName)
 //-----------------------------------------------------------------------------
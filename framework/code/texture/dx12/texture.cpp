@@ -136,7 +136,7 @@ Texture<Dx12> CreateTextureObject<Dx12>( Dx12& dx12, const CreateTexObjectInfo&
 //-----------------------------------------------------------------------------
 // Implementation of template function specialization
 template<>
-Texture<Dx12> CreateTextureFromBuffer<Dx12>( Dx12& dx12, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName )
+Texture<Dx12> CreateTextureFromBuffer<Dx12>( Dx12& dx12, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName, bool GenerateMips )
 //-----------------------------------------------------------------------------
 {
     assert( 0 && "unimplemented!" );    ///TODO: implement!
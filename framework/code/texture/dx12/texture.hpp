@@ -63,7 +63,7 @@ Texture<Dx12> CreateTextureObject<Dx12>(Dx12&, const CreateTexObjectInfo&, Memor
 
 /// Template specialization for Dx12 CreateTextureFromBuffer
 template<>
-Texture<Dx12> CreateTextureFromBuffer<Dx12>(Dx12&, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName);
+Texture<Dx12> CreateTextureFromBuffer<Dx12>(Dx12&, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName, bool GenerateMips);
 
 /// Create a texture that views (aliases) another texture but using a different texture format (must be 'related' formats, which formats are related is dependant on graphics api)
 /// Template specialization for Dx12 CreateTextureFromBuffer
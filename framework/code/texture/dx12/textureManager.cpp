@@ -168,9 +168,9 @@ const TextureBase* TextureManager<Dx12>::CreateTextureObject( const CreateTexObj
         return &it.first->second;
 }
 
-const TextureBase* TextureManager<Dx12>::CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name ) /*override*/
+const TextureBase* TextureManager<Dx12>::CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name, bool generateMips ) /*override*/
 {
-    auto texture = ::CreateTextureFromBuffer( m_GfxApi, pData, DataSize, Width, Height, Depth, Format, SamplerMode, Filter, name.c_str() );
+    auto texture = ::CreateTextureFromBuffer( m_GfxApi, pData, DataSize, Width, Height, Depth, Format, SamplerMode, Filter, name.c_str(), generateMips );
 
     assert( name.empty() ); // must have a valid name
     auto it = m_LoadedTextures.try_emplace( name, std::move( texture ) );
@@ -0,0 +1,327 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "ktxTranscodeCache.hpp"
+#include "system/os_common.h"
+#include <ktx.h>  // KTX-Software
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+// Cache file header, followed by dataSize bytes of texture data (ktxTexture2::pData)
+struct KtxTranscodeCacheFileHeader
+{
+    char        magic[4];
+    uint32_t    version;
+    uint64_t    sourceHash;
+    uint64_t    sourceSize;
+    uint32_t    transcodeFormat;
+    uint32_t    vkFormat;
+    uint32_t    baseWidth;
+    uint32_t    baseHeight;
+    uint32_t    baseDepth;
+    uint32_t    numDimensions;
+    uint32_t    numLevels;
+    uint32_t    numLayers;
+    uint32_t    numFaces;
+    uint32_t    isArray;
+    uint32_t    generateMipmaps;
+    uint32_t    padding;
+    uint64_t    dataSize;
+    uint64_t    dataHash;
+};
+static constexpr char cCacheFileMagic[4] = { 'K', 'T', 'C', 'F' };
+static constexpr uint32_t cCacheFileVersion = 1;    // increment if the file layout (or the transcoder output) changes, invalidates existing cache files
+static constexpr const char* cCacheFileExtension = ".ktc";
+
+
+/// 64bit hash of a (potentially large) block of data, processes 8 bytes at a time (in the style of MurmurHash3).
+static uint64_t Hash64(std::span<const uint8_t> data)
+{
+    constexpr uint64_t c1 = 0x87c37b91114253d5ull;
+    constexpr uint64_t c2 = 0x4cf5ad432745937full;
+    const auto mixWord = [](uint64_t h, uint64_t word) -> uint64_t {
+        word *= c1;
+        word = (word << 31) | (word >> 33);
+        word *= c2;
+        h ^= word;
+        h = (h << 27) | (h >> 37);
+        return h * 5 + 0x52dce729;
+    };
+
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ data.size();
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, &data[i], sizeof(word));
+        h = mixWord(h, word);
+    }
+    if (i < data.size())
+    {
+        uint64_t word = 0;
+        memcpy(&word, &data[i], data.size() - i);
+        h = mixWord(h, word);
+    }
+
+    // Final avalanche
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+//-----------------------------------------------------------------------------
+bool KtxTranscodeCache::Initialize(const std::filesystem::path& cacheDirectory, uint64_t maxCacheBytes)
+//-----------------------------------------------------------------------------
+{
+    Release();
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+    if (ec || !std::filesystem::is_directory(cacheDirectory, ec))
+    {
+        LOGE("Unable to create texture transcode cache directory: %s", cacheDirectory.string().c_str());
+        return false;
+    }
+
+    // Index the existing cache files (the file modification time is the time the entry was last used).
+    for (const auto& dirEntry : std::filesystem::directory_iterator(cacheDirectory, ec))
+    {
+        if (!dirEntry.is_regular_file(ec))
+            continue;
+        const auto& path = dirEntry.path();
+        if (path.extension() == cCacheFileExtension)
+        {
+            std::error_code sizeEc, timeEc;
+            Entry entry{ dirEntry.file_size(sizeEc), dirEntry.last_write_time(timeEc) };
+            if (!sizeEc && !timeEc)
+            {
+                m_CacheBytes += entry.size;
+                m_Entries.emplace(path.filename().string(), entry);
+            }
+        }
+        else if (path.extension() == ".tmp")
+        {
+            // Left over from an interrupted Store.
+            std::filesystem::remove(path, ec);
+        }
+    }
+
+    m_CacheDirectory = cacheDirectory;
+    m_MaxCacheBytes = maxCacheBytes;
+    Trim(m_MaxCacheBytes);
+    LOGI("Texture transcode cache: %s (%zu files, %llu bytes)", m_CacheDirectory.string().c_str(), m_Entries.size(), (unsigned long long)m_CacheBytes);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void KtxTranscodeCache::Release()
+//-----------------------------------------------------------------------------
+{
+    if (IsInitialized())
+        LOGI("Texture transcode cache: %u hits, %u misses (%llu bytes)", m_NumHits.load(), m_NumMisses.load(), (unsigned long long)m_CacheBytes);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_CacheDirectory.clear();
+    m_Entries.clear();
+    m_CacheBytes = 0;
+    m_NumHits = 0;
+    m_NumMisses = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*static*/ KtxTranscodeCache::Key KtxTranscodeCache::MakeKey(std::span<const uint8_t> sourceData, uint32_t transcodeFormat)
+//-----------------------------------------------------------------------------
+{
+    return { Hash64(sourceData), sourceData.size(), transcodeFormat };
+}
+
+//-----------------------------------------------------------------------------
+std::filesystem::path KtxTranscodeCache::MakeFilename(const Key& key) const
+//-----------------------------------------------------------------------------
+{
+    char filename[64];
+    snprintf(filename, sizeof(filename), "%016llx_%llx_%u%s", (unsigned long long)key.sourceHash, (unsigned long long)key.sourceSize, key.transcodeFormat, cCacheFileExtension);
+    return m_CacheDirectory / filename;
+}
+
+//-----------------------------------------------------------------------------
+ktxTexture2* KtxTranscodeCache::Load(const Key& key)
+//-----------------------------------------------------------------------------
+{
+    if (!IsInitialized())
+        return nullptr;
+
+    const auto path = MakeFilename(key);
+    const auto filename = path.filename().string();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Entries.find(filename) == m_Entries.end())
+        {
+            ++m_NumMisses;
+            return nullptr;
+        }
+    }
+
+    ktxTexture2* pTexture = nullptr;
+    bool valid = false;
+    if (FILE* fp = fopen(path.string().c_str(), "rb"))
+    {
+        KtxTranscodeCacheFileHeader header;
+        if (fread(&header, sizeof(header), 1, fp) == 1 &&
+            memcmp(header.magic, cCacheFileMagic, sizeof(cCacheFileMagic)) == 0 &&
+            header.version == cCacheFileVersion &&
+            header.sourceHash == key.sourceHash &&
+            header.sourceSize == key.sourceSize &&
+            header.transcodeFormat == key.transcodeFormat)
+        {
+            ktxTextureCreateInfo createInfo{};
+            createInfo.vkFormat = header.vkFormat;
+            createInfo.baseWidth = header.baseWidth;
+            createInfo.baseHeight = header.baseHeight;
+            createInfo.baseDepth = header.baseDepth;
+            createInfo.numDimensions = header.numDimensions;
+            createInfo.numLevels = header.numLevels;
+            createInfo.numLayers = header.numLayers;
+            createInfo.numFaces = header.numFaces;
+            createInfo.isArray = header.isArray ? KTX_TRUE : KTX_FALSE;
+            createInfo.generateMipmaps = header.generateMipmaps ? KTX_TRUE : KTX_FALSE;
+
+            // Read the data directly in to the texture (created with the same layout as the transcoder output).
+            if (KTX_SUCCESS == ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &pTexture) &&
+                pTexture->dataSize == header.dataSize &&
+                fread(pTexture->pData, 1, header.dataSize, fp) == header.dataSize &&
+                fgetc(fp) == EOF &&
+                Hash64({ pTexture->pData, (size_t)header.dataSize }) == header.dataHash)
+            {
+                valid = true;
+            }
+        }
+        fclose(fp);
+    }
+
+    if (!valid)
+    {
+        LOGE("Texture transcode cache file %s is not valid, removing", filename.c_str());
+        if (pTexture)
+            ktxTexture_Destroy(ktxTexture(pTexture));
+        RemoveEntry(filename);
+        ++m_NumMisses;
+        return nullptr;
+    }
+
+    // Mark as recently used (in memory and on disk, for the next run).
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Entries.find(filename);
+        if (it != m_Entries.end())
+        {
+            std::error_code ec;
+            it->second.lastUsed = std::filesystem::file_time_type::clock::now();
+            std::filesystem::last_write_time(path, it->second.lastUsed, ec);
+        }
+    }
+    ++m_NumHits;
+    return pTexture;
+}
+
+//-----------------------------------------------------------------------------
+bool KtxTranscodeCache::Store(const Key& key, const ktxTexture2& transcodedTexture)
+//-----------------------------------------------------------------------------
+{
+    if (!IsInitialized())
+        return false;
+    if (transcodedTexture.pData == nullptr || transcodedTexture.supercompressionScheme != KTX_SS_NONE || transcodedTexture.vkFormat == 0/*VK_FORMAT_UNDEFINED, not transcoded*/)
+        return false;
+
+    KtxTranscodeCacheFileHeader header{};
+    memcpy(header.magic, cCacheFileMagic, sizeof(cCacheFileMagic));
+    header.version = cCacheFileVersion;
+    header.sourceHash = key.sourceHash;
+    header.sourceSize = key.sourceSize;
+    header.transcodeFormat = key.transcodeFormat;
+    header.vkFormat = transcodedTexture.vkFormat;
+    header.baseWidth = transcodedTexture.baseWidth;
+    header.baseHeight = transcodedTexture.baseHeight;
+    header.baseDepth = transcodedTexture.baseDepth;
+    header.numDimensions = transcodedTexture.numDimensions;
+    header.numLevels = transcodedTexture.numLevels;
+    header.numLayers = transcodedTexture.numLayers;
+    header.numFaces = transcodedTexture.numFaces;
+    header.isArray = transcodedTexture.isArray ? 1 : 0;
+    header.generateMipmaps = transcodedTexture.generateMipmaps ? 1 : 0;
+    header.dataSize = transcodedTexture.dataSize;
+    header.dataHash = Hash64({ transcodedTexture.pData, (size_t)transcodedTexture.dataSize });
+
+    // Write to a temporary file and rename, so other threads (or processes) never see a partially written cache file.
+    const auto path = MakeFilename(key);
+    auto tempPath = path;
+    tempPath += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    bool written = false;
+    if (FILE* fp = fopen(tempPath.string().c_str(), "wb"))
+    {
+        written = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                  fwrite(transcodedTexture.pData, 1, transcodedTexture.dataSize, fp) == transcodedTexture.dataSize;
+        written = (fclose(fp) == 0) && written;
+    }
+    std::error_code ec;
+    if (written)
+        std::filesystem::rename(tempPath, path, ec);
+    if (!written || ec)
+    {
+        LOGE("Unable to write texture transcode cache file %s", path.string().c_str());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Entry& entry = m_Entries[path.filename().string()];
+        m_CacheBytes -= entry.size;     // replacing an existing entry
+        entry.size = sizeof(header) + header.dataSize;
+        entry.lastUsed = std::filesystem::file_time_type::clock::now();
+        m_CacheBytes += entry.size;
+    }
+    Trim(m_MaxCacheBytes);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void KtxTranscodeCache::Trim(uint64_t maxCacheBytes)
+//-----------------------------------------------------------------------------
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    while (m_CacheBytes > maxCacheBytes && !m_Entries.empty())
+    {
+        const auto oldestIt = std::min_element(m_Entries.begin(), m_Entries.end(), [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+        std::error_code ec;
+        std::filesystem::remove(m_CacheDirectory / oldestIt->first, ec);
+        m_CacheBytes -= oldestIt->second.size;
+        m_Entries.erase(oldestIt);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void KtxTranscodeCache::RemoveEntry(const std::string& filename)
+//-----------------------------------------------------------------------------
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::error_code ec;
+    std::filesystem::remove(m_CacheDirectory / filename, ec);
+    auto it = m_Entries.find(filename);
+    if (it != m_Entries.end())
+    {
+        m_CacheBytes -= it->second.size;
+        m_Entries.erase(it);
+    }
+}
@@ -0,0 +1,89 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+// Forward declarations
+struct ktxTexture2;
+
+
+/// Persistent (on disk) cache of transcoded ktx2 (Basis Universal) textures.
+///
+/// Transcoding Basis textures to a gpu format (ASTC, ETC, BC7) is cpu expensive and is otherwise done for every texture on every run.
+/// Entries are keyed by a hash of the (untranscoded) ktx2 file contents and the transcode target format, so changing the source
+/// texture or running on a gpu that wants a different format just results in a cache miss.
+///
+/// Each cache file is a small header (key, texture dimensions/format and a hash of the payload) followed by the transcoded texture data, ready for upload.
+/// Files that fail validation are deleted.  The cache is trimmed (least recently used files first) to stay under the maximum size.
+/// Load and Store are thread safe (textures are typically transcoded on worker threads).
+class KtxTranscodeCache
+{
+    KtxTranscodeCache(const KtxTranscodeCache&) = delete;
+    KtxTranscodeCache& operator=(const KtxTranscodeCache&) = delete;
+public:
+    static constexpr uint64_t cDefaultMaxCacheBytes = 512ull * 1024 * 1024;
+
+    /// Identifies a cache entry (see MakeKey)
+    struct Key
+    {
+        uint64_t    sourceHash = 0;
+        uint64_t    sourceSize = 0;
+        uint32_t    transcodeFormat = 0;    ///< ktx_transcode_fmt_e
+    };
+
+    KtxTranscodeCache() = default;
+    ~KtxTranscodeCache() { Release(); }
+
+    /// Initialize the cache in the given (device path) directory, creating it if needed, and trim it to maxCacheBytes.
+    /// @return true on success (if false the cache is not usable, Load will always miss and Store does nothing)
+    bool Initialize(const std::filesystem::path& cacheDirectory, uint64_t maxCacheBytes = cDefaultMaxCacheBytes);
+    void Release();
+    bool IsInitialized() const { return !m_CacheDirectory.empty(); }
+
+    /// Make the cache key for the given (untranscoded) ktx file contents and transcode target format.
+    static Key MakeKey(std::span<const uint8_t> sourceData, uint32_t transcodeFormat);
+
+    /// Load a transcoded texture from the cache.
+    /// @return newly created texture (owned by the caller) or nullptr if not in the cache (or the cache file was not valid)
+    ktxTexture2* Load(const Key& key);
+
+    /// Store a transcoded texture in the cache, evicting the least recently used entries if the cache grows larger than the maximum size.
+    bool Store(const Key& key, const ktxTexture2& transcodedTexture);
+
+    /// Remove least recently used cache files until the cache fits in maxCacheBytes.
+    void Trim(uint64_t maxCacheBytes);
+
+    uint64_t GetCacheBytes() const { return m_CacheBytes; }
+    uint32_t GetNumHits() const { return m_NumHits; }
+    uint32_t GetNumMisses() const { return m_NumMisses; }
+
+protected:
+    std::filesystem::path MakeFilename(const Key& key) const;
+    void RemoveEntry(const std::string& filename);
+
+    struct Entry
+    {
+        uint64_t                            size = 0;
+        std::filesystem::file_time_type     lastUsed;
+    };
+
+    std::mutex                              m_Mutex;        ///< protects m_Entries and m_CacheBytes
+    std::filesystem::path                   m_CacheDirectory;
+    std::unordered_map<std::string, Entry>  m_Entries;      ///< cache files, by filename
+    uint64_t                                m_CacheBytes = 0;
+    uint64_t                                m_MaxCacheBytes = cDefaultMaxCacheBytes;
+    std::atomic<uint32_t>                   m_NumHits = 0;
+    std::atomic<uint32_t>                   m_NumMisses = 0;
+};
@@ -6,10 +6,12 @@
 //============================================================================================================
 
 #include <ktx.h>  // KTX-Software
+#include <algorithm>
 #include <memory>
 #include <cassert>
 #include <cstring>
 #include "system/assetManager.hpp"
+#include "system/crc32c.hpp"
 #include "loaderKtx.hpp"
 #include "../lib/gl_format.h"
 
@@ -40,6 +42,11 @@ void TextureKtxFileWrapper::Release()
     m_ktxTexture = nullptr;
 }
 
+size_t TextureKtxFileWrapper::GetDataSize() const
+{
+    return m_ktxTexture ? m_ktxTexture->dataSize : 0;
+}
+
 TextureKtxBase::~TextureKtxBase() noexcept
 {
     Release();
@@ -50,6 +57,157 @@ bool TextureKtxBase::Initialize()
     return true;
 }
 
+void TextureKtxBase::Release()
+{
+    m_TranscodeCache.reset();
+}
+
+bool TextureKtxBase::InitializeTranscodeCache(const std::string& cacheDirectory, uint64_t maxCacheBytes)
+{
+    auto transcodeCache = std::make_unique<KtxTranscodeCache>();
+    if (!transcodeCache->Initialize(cacheDirectory, maxCacheBytes))
+        return false;
+    m_TranscodeCache = std::move(transcodeCache);
+    return true;
+}
+
+std::optional<KtxTranscodeCache::Key> TextureKtxBase::GetTranscodeCacheKey(const TextureKtxFileWrapper& fileData, uint32_t transcodeFormat) const
+{
+    if (!m_TranscodeCache || fileData.GetFileData().empty())
+        return std::nullopt;
+    return KtxTranscodeCache::MakeKey(fileData.GetFileData(), transcodeFormat);
+}
+
+std::optional<TextureContentHash> TextureKtxBase::HashFileData(const TextureKtxFileWrapper& textureFile) const
+{
+    const auto fileData = textureFile.GetFileData();
+    if (fileData.empty())
+        return std::nullopt;
+    return TextureContentHash{ KtxTranscodeCache::MakeKey(fileData, 0).sourceHash, fileData.size(), crc32c(0, fileData) };
+}
+
+TextureKtxFileWrapper TextureKtxBase::LoadTranscodedFromCache(const KtxTranscodeCache::Key& key) const
+{
+    TextureKtxFileWrapper textureData;
+    if (m_TranscodeCache)
+        textureData.m_ktxTexture = ktxTexture(m_TranscodeCache->Load(key));    // texture data is owned by the ktxTexture, no m_fileData
+    return textureData;
+}
+
+TextureKtxFileWrapper TextureKtxBase::WrapKtxTexture(ktxTexture* pKtxTexture) const
+{
+    TextureKtxFileWrapper textureData;
+    textureData.m_ktxTexture = pKtxTexture;
+    return textureData;
+}
+
+void TextureKtxBase::StoreTranscodedInCache(const KtxTranscodeCache::Key& key, const TextureKtxFileWrapper& transcodedData) const
+{
+    const auto* pKtxTexture = transcodedData.GetKtxTexture();
+    if (m_TranscodeCache && pKtxTexture && pKtxTexture->classId == class_id::ktxTexture2_c)
+        m_TranscodeCache->Store(key, *(const ktxTexture2*)pKtxTexture);
+}
+
+static std::vector<TextureKtxMipLevel> MakeMipLevels(ktxTexture* pKtxTexture, bool withSizes)
+{
+    std::vector<TextureKtxMipLevel> mipLevels;
+    mipLevels.reserve(pKtxTexture->numLevels);
+    for (uint32_t level = 0; level < pKtxTexture->numLevels; ++level)
+    {
+        TextureKtxMipLevel& mipLevel = mipLevels.emplace_back();
+        mipLevel.width = std::max(1u, pKtxTexture->baseWidth >> level);
+        mipLevel.height = std::max(1u, pKtxTexture->baseHeight >> level);
+        if (withSizes)
+            mipLevel.sizeBytes = uint64_t(ktxTexture_GetImageSize(pKtxTexture, level)) * pKtxTexture->numLayers * pKtxTexture->numFaces;
+    }
+    return mipLevels;
+}
+
+std::vector<TextureKtxMipLevel> TextureKtxBase::GetMipLevels(const TextureKtxFileWrapper& fileData) const
+{
+    auto* const pKtxTexture = fileData.GetKtxTexture();
+    if (!pKtxTexture || pKtxTexture->classId != class_id::ktxTexture2_c || pKtxTexture->baseDepth > 1)
+        return {};
+    // Size of the image data is not known until it is transcoded.
+    return MakeMipLevels(pKtxTexture, !ktxTexture_NeedsTranscoding(pKtxTexture));
+}
+
+std::vector<TextureKtxMipLevel> TextureKtxBase::GetMipLevels(const TextureKtxFileWrapper& fileData, const TextureKtxFileWrapper& transcodedLevels) const
+{
+    auto* const pKtxTexture = fileData.GetKtxTexture();
+    auto* const pTranscodedTexture = transcodedLevels.GetKtxTexture();
+    if (!pKtxTexture || !pTranscodedTexture || pKtxTexture->classId != class_id::ktxTexture2_c || pTranscodedTexture->classId != class_id::ktxTexture2_c || pKtxTexture->baseDepth > 1)
+        return {};
+    if (!ktxTexture_NeedsTranscoding(pKtxTexture))
+        return MakeMipLevels(pKtxTexture, true);
+
+    // Texture with the full texture's dimensions in the transcoded format, only used to size the levels (no image data).
+    ktxTextureCreateInfo createInfo{};
+    createInfo.vkFormat = ((const ktxTexture2*)pTranscodedTexture)->vkFormat;
+    createInfo.baseWidth = pKtxTexture->baseWidth;
+    createInfo.baseHeight = pKtxTexture->baseHeight;
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = pKtxTexture->numDimensions;
+    createInfo.numLevels = pKtxTexture->numLevels;
+    createInfo.numLayers = pKtxTexture->numLayers;
+    createInfo.numFaces = pKtxTexture->numFaces;
+    createInfo.isArray = pKtxTexture->isArray;
+    createInfo.generateMipmaps = KTX_FALSE;
+    ktxTexture2* pSizingTexture = nullptr;
+    if (KTX_SUCCESS != ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_NO_STORAGE, &pSizingTexture))
+        return {};
+    auto mipLevels = MakeMipLevels(ktxTexture(pSizingTexture), true);
+    ktxTexture_Destroy(ktxTexture(pSizingTexture));
+    return mipLevels;
+}
+
+TextureKtxFileWrapper TextureKtxBase::ExtractMipLevels(const TextureKtxFileWrapper& fileData, uint32_t firstMip) const
+{
+    auto* const pKtxTexture = fileData.GetKtxTexture();
+    if (!pKtxTexture || pKtxTexture->classId != class_id::ktxTexture2_c || pKtxTexture->baseDepth > 1 || ktxTexture_NeedsTranscoding(pKtxTexture) || firstMip >= pKtxTexture->numLevels)
+        return {};
+
+    // Textures loaded from file do not load (or inflate) their image data until it is needed.
+    if (pKtxTexture->pData == nullptr && KTX_SUCCESS != ktxTexture_LoadImageData(pKtxTexture, nullptr, 0))
+        return {};
+
+    const auto* const pKtx2Texture = (const ktxTexture2*)pKtxTexture;
+    ktxTextureCreateInfo createInfo{};
+    createInfo.vkFormat = pKtx2Texture->vkFormat;
+    createInfo.baseWidth = std::max(1u, pKtxTexture->baseWidth >> firstMip);
+    createInfo.baseHeight = std::max(1u, pKtxTexture->baseHeight >> firstMip);
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = pKtxTexture->numDimensions;
+    createInfo.numLevels = pKtxTexture->numLevels - firstMip;
+    createInfo.numLayers = pKtxTexture->numLayers;
+    createInfo.numFaces = pKtxTexture->numFaces;
+    createInfo.isArray = pKtxTexture->isArray;
+    createInfo.generateMipmaps = KTX_FALSE;
+
+    TextureKtxFileWrapper mipData;
+    ktxTexture2* pMipTexture = nullptr;
+    if (KTX_SUCCESS != ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &pMipTexture))
+        return {};
+    mipData.m_ktxTexture = ktxTexture(pMipTexture);    // texture data is owned by the ktxTexture, no m_fileData
+
+    // Each level is tightly packed (layers and faces) so can be copied in one go.
+    for (uint32_t level = 0; level < createInfo.numLevels; ++level)
+    {
+        ktx_size_t srcOffset = 0, dstOffset = 0;
+        const ktx_size_t levelSize = ktx_size_t(ktxTexture_GetImageSize(pKtxTexture, firstMip + level)) * pKtxTexture->numLayers * pKtxTexture->numFaces;
+        if (KTX_SUCCESS != ktxTexture_GetImageOffset(pKtxTexture, firstMip + level, 0, 0, &srcOffset) ||
+            KTX_SUCCESS != ktxTexture_GetImageOffset(mipData.m_ktxTexture, level, 0, 0, &dstOffset) ||
+            srcOffset + levelSize > pKtxTexture->dataSize ||
+            dstOffset + levelSize > mipData.m_ktxTexture->dataSize)
+        {
+            LOGE("Unable to extract mip level %u of ktx texture", firstMip + level);
+            return {};
+        }
+        memcpy(mipData.m_ktxTexture->pData + dstOffset, pKtxTexture->pData + srcOffset, levelSize);
+    }
+    return mipData;
+}
+
 TextureKtxFileWrapper TextureKtxBase::LoadFile(AssetManager& assetManager, const char* const pFileName) const
 {
     std::vector<uint8_t> fileData;
@@ -6,7 +6,12 @@
 //============================================================================================================
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <vector>
+#include "ktxTranscodeCache.hpp"
 
 ///
 /// KTX image file loading
@@ -18,6 +23,18 @@ class AssetManager;
 template<typename T_GFXAPI> class Texture;
 template<typename T_GFXAPI> class TextureKtx;
 template<typename T_GFXAPI> class Sampler;
+class ThreadWorker;
+
+/// @brief Identifies the contents of a (not yet transcoded) ktx file, see TextureKtxBase::HashFileData.
+/// Files are only treated as identical when the size and both (independent) hashes match, a 64bit hash collision alone is not enough.
+struct TextureContentHash
+{
+    uint64_t    hash = 0;           ///< 64bit hash of the file data
+    uint64_t    fileBytes = 0;      ///< size of the file data
+    uint32_t    crc = 0;            ///< crc32c of the file data
+    bool operator==( const TextureContentHash& ) const = default;
+    struct Hasher { size_t operator()( const TextureContentHash& contentHash ) const { return size_t( contentHash.hash ); } };
+};
 
 /// @brief opaque class holding texture data (in some texture format internal format, not a vulkan texture)
 class TextureKtxFileWrapper final
@@ -32,14 +49,25 @@ public:
     TextureKtxFileWrapper& operator=(TextureKtxFileWrapper&&) noexcept;
     operator bool() const { return m_ktxTexture != nullptr; }
     void Release();
+    /// @return size of the texture image data (bytes, as it will be uploaded)
+    size_t GetDataSize() const;
 protected:
     friend class TextureKtxBase;
     auto GetKtxTexture() const { return m_ktxTexture; }
+    std::span<const uint8_t> GetFileData() const { return m_fileData; }
 private:
     ktxTexture* m_ktxTexture = nullptr;
     std::vector<uint8_t> m_fileData;            ///< contents of .ktx file (ktxTexture_CreateFromMemory does not take a copy of all the data in here, so we need to retain it)
 };
 
+/// @brief Size of a single mip level of a ktx texture (see TextureKtxBase::GetMipLevels)
+struct TextureKtxMipLevel
+{
+    uint32_t    width = 0;
+    uint32_t    height = 0;
+    uint64_t    sizeBytes = 0;      ///< size of the level data (all array layers and faces)
+};
+
 /// @brief Class to handle loading KTX textures
 /// Generally applications will want a singleton of this class (or a derived version eg @TextureKtxVulkan).
 class TextureKtxBase
@@ -59,7 +87,42 @@ public:
     virtual bool Initialize() = 0;
 
     /// @brief Release (de-initialize) back to a clean (initializable) state
-    virtual void Release() {}
+    virtual void Release();
+
+    /// @brief Enable the persistent (on disk) cache of transcoded ktx2 textures (used by derived class Transcode implementations)
+    /// @param cacheDirectory writable (device) path to store the cache files in
+    /// @param maxCacheBytes size the cache is trimmed to (least recently used files are removed first)
+    /// @return true on success
+    bool InitializeTranscodeCache(const std::string& cacheDirectory, uint64_t maxCacheBytes = KtxTranscodeCache::cDefaultMaxCacheBytes);
+
+    /// @return the transcode cache (nullptr if not enabled)
+    KtxTranscodeCache* GetTranscodeCache() const { return m_TranscodeCache.get(); }
+
+    /// @brief Set the worker whose threads help transcode large basis textures (each texture is split across the threads, see TranscodeKtx2Parallel)
+    /// @param pWorker worker (not owned, must outlive its use here), nullptr to transcode each texture on a single thread
+    void SetTranscodeWorker(ThreadWorker* pWorker) { m_TranscodeWorker = pWorker; }
+
+    /// @brief Hash the contents of the (not yet transcoded) ktx file, for detecting textures with identical contents (see TextureManager content deduplication)
+    /// @return hashes (and size) of the file data, nullopt if the wrapper has no file data (eg already transcoded)
+    std::optional<TextureContentHash> HashFileData(const TextureKtxFileWrapper& textureFile) const;
+
+    /// @brief Get the dimensions and size of each mip level (most detailed first)
+    /// @param textureFile ktx texture data (sizeBytes is 0 for textures that are not transcoded yet, their size depends on the transcode format)
+    /// @return mip levels, empty if the texture levels cannot be extracted individually (see ExtractMipLevels)
+    std::vector<TextureKtxMipLevel> GetMipLevels(const TextureKtxFileWrapper& textureFile) const;
+
+    /// @brief Get the dimensions and (transcoded) size of each mip level of a texture that has only had some of its levels transcoded (see TextureKtx::TranscodeMipLevels)
+    /// @param textureFile ktx texture data (not transcoded)
+    /// @param transcodedLevels mip levels of textureFile that were transcoded (sizes are those of this texture's format)
+    /// @return mip levels of the whole texture, empty if the texture levels cannot be extracted individually
+    std::vector<TextureKtxMipLevel> GetMipLevels(const TextureKtxFileWrapper& textureFile, const TextureKtxFileWrapper& transcodedLevels) const;
+
+    /// @brief Make a new texture containing a copy of the mip levels from firstMip down to the smallest mip level of the given texture.
+    /// Only supports (transcoded) 2d ktx2 textures.  Loads the image data of textureFile if it was not already loaded.
+    /// @param textureFile ktx texture data (already transcoded, if needed)
+    /// @param firstMip most detailed mip level to copy (becomes mip level 0 of the returned texture)
+    /// @return new texture, empty on failure
+    TextureKtxFileWrapper ExtractMipLevels(const TextureKtxFileWrapper& textureFile, uint32_t firstMip) const;
 
     /// @brief Do the necessary upload etc to go from a cpu texture representation to Vulkan format
     /// WE EXPECT THERE TO BE A SPECIALIZED IMPLEMENTATION OF THIS TEMPLATE for each supported T_GFXAPI.
@@ -86,6 +149,24 @@ public:
 protected:
     /// Helper to get the ktx texture pointer (for derived classes)
     auto GetKtxTexture(const TextureKtxFileWrapper& tex) const { return tex.GetKtxTexture(); }
+
+    /// Helpers for derived class Transcode implementations.
+    /// @return the transcode cache key for the given (not yet transcoded) texture, empty if the transcode cache is not enabled
+    std::optional<KtxTranscodeCache::Key> GetTranscodeCacheKey(const TextureKtxFileWrapper& fileData, uint32_t transcodeFormat) const;
+    /// @return the cached transcoded texture, empty if not in the cache
+    TextureKtxFileWrapper LoadTranscodedFromCache(const KtxTranscodeCache::Key& key) const;
+    /// Add a transcoded texture to the cache.
+    void StoreTranscodedInCache(const KtxTranscodeCache::Key& key, const TextureKtxFileWrapper& transcodedData) const;
+    /// @return worker to split transcoding over (nullptr if not set)
+    ThreadWorker* GetTranscodeWorker() const { return m_TranscodeWorker; }
+    /// @return contents of the ktx file the texture was loaded from (empty if not from a file, eg already transcoded)
+    std::span<const uint8_t> GetFileData(const TextureKtxFileWrapper& tex) const { return tex.GetFileData(); }
+    /// @return wrapper taking ownership of the given ktx texture (texture data is owned by the ktxTexture, no file data)
+    TextureKtxFileWrapper WrapKtxTexture(ktxTexture* pKtxTexture) const;
+
+private:
+    std::unique_ptr<KtxTranscodeCache> m_TranscodeCache;
+    ThreadWorker* m_TranscodeWorker = nullptr;
 };
 
 /// @brief Templated (by graphics api) ktx loader class, expected to be specialized.
@@ -5,11 +5,13 @@
 //
 //============================================================================================================
 
+#include <algorithm>
 #include <memory>
 #include <cassert>
 #include "system/assetManager.hpp"
 #include "loaderPpm.hpp"
 #include "texture.hpp"
+#include "textureFormatConvert.hpp"
 
 TexturePpmFileWrapper::TexturePpmFileWrapper(TexturePpmFileWrapper&& other) noexcept : m_Data(std::move(other.m_Data))
 {
@@ -85,39 +87,27 @@ TexturePpmFileWrapper TexturePpmBase::LoadFile( AssetManager& assetManager, cons
 
     TextureFormat format = TextureFormat::R8G8_UNORM;
     size_t bytesPerPixel = 2;
+    const size_t numPixels = size_t( width ) * height * depth;
+    if (bytesPerPPMPixel != 1 || numPixels == 0)
+        return {};  // 16bit ppm not supported
+    const std::span<const uint8_t> srcData{ fileData.data() + dataOffset, numPixels * 3 };
     std::vector<uint8_t> targetData;
-    targetData.resize( width * height * depth * bytesPerPixel );
-    if (bytesPerPixel == 1)
+    targetData.resize( numPixels * bytesPerPixel );
+    switch (bytesPerPixel)
     {
-        for (auto& target : targetData)
-        {
-            target = *fileDataIt;
-            fileDataIt += 3;
-        }
-    }
-    else
-    {
-        auto targetIt = targetData.begin();
-        for (size_t i = 0; i < width * height * depth; ++i)
-        {
-            *targetIt = *fileDataIt;
-            ++targetIt;
-            ++fileDataIt;
-            *targetIt = *fileDataIt;
-            ++targetIt;
-            ++fileDataIt;
-            if (bytesPerPixel > 2)
-            {
-                *targetIt = *fileDataIt;
-                ++targetIt;
-            }
-            if (bytesPerPixel > 3)
-            {
-                *targetIt = 255;   // no alpha in ppm
-                ++targetIt;
-            }
-            ++fileDataIt;
-        }
+    case 1:
+        for (size_t i = 0; i < numPixels; ++i)
+            targetData[i] = srcData[i * 3];
+        break;
+    case 2:
+        ConvertRgb8ToRg8( srcData, targetData );
+        break;
+    case 3:
+        std::copy( srcData.begin(), srcData.end(), targetData.begin() );
+        break;
+    default:
+        ConvertRgb8ToRgba8( srcData, targetData, 255 );   // no alpha in ppm
+        break;
     }
 
     TexturePpmFileWrapper ppmData{ width, height, depth, format, std::move(targetData) };
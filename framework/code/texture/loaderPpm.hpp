@@ -80,7 +80,7 @@ Texture<T_GFXAPI> TexturePpmBase::LoadPpm( T_GFXAPI& gfxApi, AssetManager& asset
 template<typename T_GFXAPI>
 Texture<T_GFXAPI> TexturePpmBase::LoadPpm( T_GFXAPI& gfxApi, const TexturePpmFileWrapper& ppmData, const Sampler<T_GFXAPI>& sampler )
 {
-    return ::CreateTextureFromBuffer( gfxApi, ppmData.m_Data.data(), ppmData.m_Data.size(), ppmData.m_Width, ppmData.m_Height, ppmData.m_Depth, ppmData.m_Format, SamplerAddressMode::Repeat, SamplerFilter::Linear );
+    return ::CreateTextureFromBuffer( gfxApi, ppmData.m_Data.data(), ppmData.m_Data.size(), ppmData.m_Width, ppmData.m_Height, ppmData.m_Depth, ppmData.m_Format, SamplerAddressMode::Repeat, SamplerFilter::Linear, nullptr, true/*GenerateMips*/ );
 }
 
 
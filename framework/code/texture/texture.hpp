@@ -211,8 +211,9 @@ std::unique_ptr<TextureBase> CreateTextureObject(GraphicsApiBase& gfxApi, const
 }
 
 /// Create texture from a memory buffer.
+/// @param GenerateMips generate a full mip chain (on the gpu) from the buffer's data, where the graphics api and format support it.  Otherwise the texture has a single mip level.
 template<typename T_GFXAPI>
-Texture<T_GFXAPI> CreateTextureFromBuffer( T_GFXAPI& gfxApi, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName = nullptr )
+Texture<T_GFXAPI> CreateTextureFromBuffer( T_GFXAPI& gfxApi, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName = nullptr, bool GenerateMips = false )
 {
     static_assert(sizeof( T_GFXAPI ) != sizeof( T_GFXAPI ), "Must use the specialized version of this function.  Your are likely missing #include \"texture/<GFXAPI>/texture.hpp\"");
     assert( 0 && "Expecting CreateTextureFromBuffer (per graphics api) to be used" );
@@ -221,10 +222,10 @@ Texture<T_GFXAPI> CreateTextureFromBuffer( T_GFXAPI& gfxApi, const void* pData,
 
 /// Create texture (unique_ptr) (generally for render target usage).  Uses CreateTexObjectInfo structure to define texture creation parameters.
 template<typename T_GFXAPI>
-std::unique_ptr<TextureBase> CreateTextureFromBuffer( GraphicsApiBase& gfxApi, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName = nullptr )
+std::unique_ptr<TextureBase> CreateTextureFromBuffer( GraphicsApiBase& gfxApi, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName = nullptr, bool GenerateMips = false )
 {
     auto pTexture = std::make_unique<Texture<T_GFXAPI>>();
-    *pTexture = std::move( CreateTextureFromBuffer( static_cast<T_GFXAPI&>( gfxApi ), pData, DataSize, Width, Height, Depth, Format, SamplerMode, Filter, pName ) );
+    *pTexture = std::move( CreateTextureFromBuffer( static_cast<T_GFXAPI&>( gfxApi ), pData, DataSize, Width, Height, Depth, Format, SamplerMode, Filter, pName, GenerateMips ) );
     return pTexture;
 }
 
@@ -0,0 +1,546 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "textureFormatConvert.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TEXTURE_CONVERT_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_CONVERT_SSE2 1
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <tmmintrin.h>
+#define TEXTURE_CONVERT_SSSE3 1
+#endif
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define TEXTURE_CONVERT_F16C 1
+#endif
+#endif
+
+namespace
+{
+    inline uint32_t FloatBits( float f )
+    {
+        uint32_t u;
+        memcpy( &u, &f, sizeof( u ) );
+        return u;
+    }
+
+    inline float BitsFloat( uint32_t u )
+    {
+        float f;
+        memcpy( &f, &u, sizeof( f ) );
+        return f;
+    }
+
+    double LinearToSrgbReference( double linear )
+    {
+        return linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow( linear, 1.0 / 2.4 ) - 0.055;
+    }
+
+    double SrgbToLinearReference( double srgb )
+    {
+        return srgb <= 0.04045 ? srgb / 12.92 : std::pow( (srgb + 0.055) / 1.055, 2.4 );
+    }
+
+    /// Lookup tables for the sRGB conversions (built once, on first use).
+    struct SrgbTables
+    {
+        SrgbTables()
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+                srgbToLinear[i] = float( SrgbToLinearReference( i / 255.0 ) );
+
+            // thresholds[k] is the smallest (positive) float that the reference conversion maps to sRGB value k (binary search on the float bit pattern, the reference is monotonic).
+            thresholds[0] = 0.0f;
+            for (uint32_t k = 1; k < 256; ++k)
+            {
+                uint32_t lo = FloatBits( thresholds[k - 1] ), hi = FloatBits( 1.0f );
+                while (lo < hi)
+                {
+                    const uint32_t mid = lo + (hi - lo) / 2;
+                    if (TextureFormatConvertScalar::LinearToSrgb8( BitsFloat( mid ) ) >= k)
+                        hi = mid;
+                    else
+                        lo = mid + 1;
+                }
+                thresholds[k] = BitsFloat( lo );
+            }
+        }
+        std::array<float, 256> srgbToLinear;
+        std::array<float, 256> thresholds;
+    };
+
+    const SrgbTables& GetSrgbTables()
+    {
+        static const SrgbTables sTables;
+        return sTables;
+    }
+
+    /// Branchless search of the threshold table, gives the same result as TextureFormatConvertScalar::LinearToSrgb8 without the pow.
+    inline uint8_t LinearToSrgb8Table( const std::array<float, 256>& thresholds, float linear )
+    {
+        const float x = std::min( linear > 0.0f ? linear : 0.0f, 1.0f );   // also maps nan to 0
+        uint32_t idx = 0;
+        for (uint32_t step = 128; step > 0; step >>= 1)
+            idx += (x >= thresholds[idx + step]) ? step : 0;
+        return (uint8_t) idx;
+    }
+
+    inline uint8_t UnormToUint8( float value )
+    {
+        const float x = std::min( value > 0.0f ? value : 0.0f, 1.0f );
+        return (uint8_t) (x * 255.0f + 0.5f);
+    }
+
+    /// Convert one 11bit (5 bit exponent, 6 bit mantissa) or 10bit (5 bit exponent, 5 bit mantissa) unsigned float to float.
+    template<uint32_t T_MANTISSA_BITS>
+    inline float SmallFloatToFloat( uint32_t bits )
+    {
+        const uint32_t exponent = (bits >> T_MANTISSA_BITS) & 31;
+        const uint32_t mantissa = bits & ((1u << T_MANTISSA_BITS) - 1);
+        if (exponent == 31)
+            return BitsFloat( 0x7f800000u | (mantissa << (23 - T_MANTISSA_BITS)) );     // inf or nan
+        if (exponent == 0)
+            return float( mantissa ) * BitsFloat( (127 - 14 - T_MANTISSA_BITS) << 23 );  // denormal (exact), mantissa * 2^(-14-mantissaBits)
+        return BitsFloat( ((exponent + 127 - 15) << 23) | (mantissa << (23 - T_MANTISSA_BITS)) );
+    }
+}
+
+
+namespace TextureFormatConvertScalar
+{
+    //-----------------------------------------------------------------------------
+    uint16_t FloatToHalf( float f )
+    //-----------------------------------------------------------------------------
+    {
+        // Based on the public domain float_to_half_fast3_rtne by Fabian Giesen.
+        uint32_t x = FloatBits( f );
+        const uint32_t sign = x & 0x80000000u;
+        x ^= sign;
+
+        uint16_t o;
+        if (x >= 0x47800000u)           // result is Inf or NaN (all exponent bits set)
+        {
+            o = (x > 0x7f800000u) ? uint16_t( 0x7e00 | ((x >> 13) & 0x3ff) ) : 0x7c00;
+        }
+        else if (x < 0x38800000u)       // resulting FP16 is subnormal or zero
+        {
+            // Use a magic value to align our 10 mantissa bits at the bottom of the float (float addition does the rounding).
+            o = (uint16_t) (FloatBits( BitsFloat( x ) + 0.5f ) - 0x3f000000u);
+        }
+        else
+        {
+            const uint32_t mantissaOdd = (x >> 13) & 1;
+            x += ((uint32_t) (15 - 127) << 23) + 0xfff;  // update exponent, rounding bias part 1
+            x += mantissaOdd;                           // rounding bias part 2
+            o = (uint16_t) (x >> 13);
+        }
+        return o | (uint16_t) (sign >> 16);
+    }
+
+    //-----------------------------------------------------------------------------
+    float HalfToFloat( uint16_t h )
+    //-----------------------------------------------------------------------------
+    {
+        const uint32_t exponentMantissa = h & 0x7fffu;
+        uint32_t o = (exponentMantissa << 13) + ((127 - 15) << 23);     // exponent/mantissa bits, rebias exponent
+        if (exponentMantissa >= 0x7c00u)
+            o = 0x7f800000u | ((exponentMantissa & 0x3ffu) << 13) | (exponentMantissa > 0x7c00u ? 0x400000u : 0);     // inf or (quiet) nan
+        else if (exponentMantissa < 0x0400u)
+            o = FloatBits( BitsFloat( o + (1 << 23) ) - BitsFloat( 113 << 23 ) );  // zero or denormal, renormalize with float maths (no denormal floats involved)
+        return BitsFloat( o | (uint32_t( h & 0x8000u ) << 16) );
+    }
+
+    //-----------------------------------------------------------------------------
+    float Srgb8ToLinear( uint8_t srgb )
+    //-----------------------------------------------------------------------------
+    {
+        return float( SrgbToLinearReference( srgb / 255.0 ) );
+    }
+
+    //-----------------------------------------------------------------------------
+    uint8_t LinearToSrgb8( float linear )
+    //-----------------------------------------------------------------------------
+    {
+        const double x = std::min( linear > 0.0f ? double( linear ) : 0.0, 1.0 );
+        return (uint8_t) (LinearToSrgbReference( x ) * 255.0 + 0.5);
+    }
+
+    //-----------------------------------------------------------------------------
+    void UnpackB10G11R11Ufloat( uint32_t packed, float* rgb )
+    //-----------------------------------------------------------------------------
+    {
+        rgb[0] = SmallFloatToFloat<6>( packed & 0x7ffu );
+        rgb[1] = SmallFloatToFloat<6>( (packed >> 11) & 0x7ffu );
+        rgb[2] = SmallFloatToFloat<5>( packed >> 22 );
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+void ConvertRgb8ToRgba8( std::span<const uint8_t> src, std::span<uint8_t> dst, uint8_t alpha )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size() / 3;
+    assert( dst.size() >= count * 4 );
+    const uint8_t* pSrc = src.data();
+    uint8_t* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16x3_t rgb = vld3q_u8( pSrc + i * 3 );
+        const uint8x16x4_t rgba{ { rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8( alpha ) } };
+        vst4q_u8( pDst + i * 4, rgba );
+    }
+#elif defined(TEXTURE_CONVERT_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+    const __m128i alphaMask = _mm_set1_epi32( int( uint32_t( alpha ) << 24 ) );
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i in0 = _mm_loadu_si128( (const __m128i*) (pSrc + i * 3) );
+        const __m128i in1 = _mm_loadu_si128( (const __m128i*) (pSrc + i * 3 + 16) );
+        const __m128i in2 = _mm_loadu_si128( (const __m128i*) (pSrc + i * 3 + 32) );
+        // 4 pixels (12 bytes) at a time, starting at bytes 0, 12, 24 and 36
+        _mm_storeu_si128( (__m128i*) (pDst + i * 4), _mm_or_si128( _mm_shuffle_epi8( in0, shuffle ), alphaMask ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 4 + 16), _mm_or_si128( _mm_shuffle_epi8( _mm_alignr_epi8( in1, in0, 12 ), shuffle ), alphaMask ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 4 + 32), _mm_or_si128( _mm_shuffle_epi8( _mm_alignr_epi8( in2, in1, 8 ), shuffle ), alphaMask ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 4 + 48), _mm_or_si128( _mm_shuffle_epi8( _mm_srli_si128( in2, 4 ), shuffle ), alphaMask ) );
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        pDst[i * 4 + 0] = pSrc[i * 3 + 0];
+        pDst[i * 4 + 1] = pSrc[i * 3 + 1];
+        pDst[i * 4 + 2] = pSrc[i * 3 + 2];
+        pDst[i * 4 + 3] = alpha;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ConvertRgb8ToRg8( std::span<const uint8_t> src, std::span<uint8_t> dst )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size() / 3;
+    assert( dst.size() >= count * 2 );
+    const uint8_t* pSrc = src.data();
+    uint8_t* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16x3_t rgb = vld3q_u8( pSrc + i * 3 );
+        const uint8x16x2_t rg{ { rgb.val[0], rgb.val[1] } };
+        vst2q_u8( pDst + i * 2, rg );
+    }
+#elif defined(TEXTURE_CONVERT_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8( 0, 1, 3, 4, 6, 7, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1 );
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i in0 = _mm_loadu_si128( (const __m128i*) (pSrc + i * 3) );
+        const __m128i in1 = _mm_loadu_si128( (const __m128i*) (pSrc + i * 3 + 16) );
+        const __m128i in2 = _mm_loadu_si128( (const __m128i*) (pSrc + i * 3 + 32) );
+        const __m128i rg0 = _mm_shuffle_epi8( in0, shuffle );
+        const __m128i rg1 = _mm_shuffle_epi8( _mm_alignr_epi8( in1, in0, 12 ), shuffle );
+        const __m128i rg2 = _mm_shuffle_epi8( _mm_alignr_epi8( in2, in1, 8 ), shuffle );
+        const __m128i rg3 = _mm_shuffle_epi8( _mm_srli_si128( in2, 4 ), shuffle );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 2), _mm_unpacklo_epi64( rg0, rg1 ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 2 + 16), _mm_unpacklo_epi64( rg2, rg3 ) );
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        pDst[i * 2 + 0] = pSrc[i * 3 + 0];
+        pDst[i * 2 + 1] = pSrc[i * 3 + 1];
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ConvertRgba8ToRgb8( std::span<const uint8_t> src, std::span<uint8_t> dst )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size() / 4;
+    assert( dst.size() >= count * 3 );
+    const uint8_t* pSrc = src.data();
+    uint8_t* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16x4_t rgba = vld4q_u8( pSrc + i * 4 );
+        const uint8x16x3_t rgb{ { rgba.val[0], rgba.val[1], rgba.val[2] } };
+        vst3q_u8( pDst + i * 3, rgb );
+    }
+#elif defined(TEXTURE_CONVERT_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8( 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 );
+    for (; i + 16 <= count; i += 16)
+    {
+        // Pack each 4 pixels in to 12 bytes, then stitch the 4 groups together in to 48 bytes.
+        const __m128i rgb0 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*) (pSrc + i * 4) ), shuffle );
+        const __m128i rgb1 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*) (pSrc + i * 4 + 16) ), shuffle );
+        const __m128i rgb2 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*) (pSrc + i * 4 + 32) ), shuffle );
+        const __m128i rgb3 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*) (pSrc + i * 4 + 48) ), shuffle );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 3), _mm_or_si128( rgb0, _mm_slli_si128( rgb1, 12 ) ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 3 + 16), _mm_or_si128( _mm_srli_si128( rgb1, 4 ), _mm_slli_si128( rgb2, 8 ) ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 3 + 32), _mm_or_si128( _mm_srli_si128( rgb2, 8 ), _mm_slli_si128( rgb3, 4 ) ) );
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        pDst[i * 3 + 0] = pSrc[i * 4 + 0];
+        pDst[i * 3 + 1] = pSrc[i * 4 + 1];
+        pDst[i * 3 + 2] = pSrc[i * 4 + 2];
+    }
+}
+
+//-----------------------------------------------------------------------------
+void SwizzleRgba8Bgra8( std::span<const uint8_t> src, std::span<uint8_t> dst )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size() / 4;
+    assert( dst.size() >= count * 4 );
+    const uint8_t* pSrc = src.data();
+    uint8_t* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8( pSrc + i * 4 );
+        std::swap( pixels.val[0], pixels.val[2] );
+        vst4q_u8( pDst + i * 4, pixels );
+    }
+#elif defined(TEXTURE_CONVERT_SSE2)
+    const __m128i greenAlphaMask = _mm_set1_epi32( int( 0xff00ff00u ) );
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128( (const __m128i*) (pSrc + i * 4) );
+        const __m128i redBlue = _mm_andnot_si128( greenAlphaMask, pixels );
+        const __m128i swapped = _mm_or_si128( _mm_slli_epi32( redBlue, 16 ), _mm_srli_epi32( redBlue, 16 ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 4), _mm_or_si128( _mm_and_si128( pixels, greenAlphaMask ), swapped ) );
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const uint8_t r = pSrc[i * 4 + 0];
+        const uint8_t b = pSrc[i * 4 + 2];
+        pDst[i * 4 + 0] = b;
+        pDst[i * 4 + 1] = pSrc[i * 4 + 1];
+        pDst[i * 4 + 2] = r;
+        pDst[i * 4 + 3] = pSrc[i * 4 + 3];
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ConvertFloat32ToFloat16( std::span<const float> src, std::span<uint16_t> dst )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size();
+    assert( dst.size() >= count );
+    const float* pSrc = src.data();
+    uint16_t* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    for (; i + 4 <= count; i += 4)
+        vst1_u16( pDst + i, vreinterpret_u16_f16( vcvt_f16_f32( vld1q_f32( pSrc + i ) ) ) );
+#elif defined(TEXTURE_CONVERT_F16C)
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128( (__m128i*) (pDst + i), _mm256_cvtps_ph( _mm256_loadu_ps( pSrc + i ), _MM_FROUND_TO_NEAREST_INT ) );
+#elif defined(TEXTURE_CONVERT_SSE2)
+    // Same algorithm as TextureFormatConvertScalar::FloatToHalf, 8 at a time.
+    const __m128i absMask = _mm_set1_epi32( 0x7fffffff );
+    const __m128i infNanThreshold = _mm_set1_epi32( 0x47800000 - 1 );
+    const __m128i infBits = _mm_set1_epi32( 0x7f800000 );
+    const __m128i subnormalThreshold = _mm_set1_epi32( 0x38800000 );
+    const __m128 subnormalMagic = _mm_castsi128_ps( _mm_set1_epi32( 0x3f000000 ) );
+    const __m128i rebias = _mm_set1_epi32( int( ((uint32_t) (15 - 127) << 23) + 0xfff ) );
+    const __m128i one = _mm_set1_epi32( 1 );
+    const auto convert4 = [&]( const float* pIn ) -> __m128i
+    {
+        const __m128i bits = _mm_castps_si128( _mm_loadu_ps( pIn ) );
+        const __m128i x = _mm_and_si128( bits, absMask );
+        const __m128i sign = _mm_srli_epi32( _mm_andnot_si128( absMask, bits ), 16 );
+
+        const __m128i subnormal = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( _mm_castsi128_ps( x ), subnormalMagic ) ), _mm_castps_si128( subnormalMagic ) );
+        const __m128i mantissaOdd = _mm_and_si128( _mm_srli_epi32( x, 13 ), one );
+        const __m128i normal = _mm_srli_epi32( _mm_add_epi32( _mm_add_epi32( x, rebias ), mantissaOdd ), 13 );
+        const __m128i nan = _mm_or_si128( _mm_set1_epi32( 0x7e00 ), _mm_and_si128( _mm_srli_epi32( x, 13 ), _mm_set1_epi32( 0x3ff ) ) );
+        const __m128i infNan = _mm_or_si128( _mm_and_si128( _mm_cmpgt_epi32( x, infBits ), nan ), _mm_andnot_si128( _mm_cmpgt_epi32( x, infBits ), _mm_set1_epi32( 0x7c00 ) ) );
+
+        const __m128i isSubnormal = _mm_cmplt_epi32( x, subnormalThreshold );
+        const __m128i isInfNan = _mm_cmpgt_epi32( x, infNanThreshold );
+        __m128i o = _mm_or_si128( _mm_and_si128( isSubnormal, subnormal ), _mm_andnot_si128( isSubnormal, normal ) );
+        o = _mm_or_si128( _mm_and_si128( isInfNan, infNan ), _mm_andnot_si128( isInfNan, o ) );
+        o = _mm_or_si128( o, sign );
+        return _mm_srai_epi32( _mm_slli_epi32( o, 16 ), 16 );  // sign extend so the (signed saturating) pack is exact
+    };
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128( (__m128i*) (pDst + i), _mm_packs_epi32( convert4( pSrc + i ), convert4( pSrc + i + 4 ) ) );
+#endif
+    for (; i < count; ++i)
+        pDst[i] = TextureFormatConvertScalar::FloatToHalf( pSrc[i] );
+}
+
+//-----------------------------------------------------------------------------
+void ConvertFloat16ToFloat32( std::span<const uint16_t> src, std::span<float> dst )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size();
+    assert( dst.size() >= count );
+    const uint16_t* pSrc = src.data();
+    float* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32( pDst + i, vcvt_f32_f16( vreinterpret_f16_u16( vld1_u16( pSrc + i ) ) ) );
+#elif defined(TEXTURE_CONVERT_F16C)
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps( pDst + i, _mm256_cvtph_ps( _mm_loadu_si128( (const __m128i*) (pSrc + i) ) ) );
+#elif defined(TEXTURE_CONVERT_SSE2)
+    // Same algorithm as TextureFormatConvertScalar::HalfToFloat, 8 at a time.
+    const __m128i exponentMantissaMask = _mm_set1_epi32( 0x7fff );
+    const __m128i rebias = _mm_set1_epi32( (127 - 15) << 23 );
+    const __m128i infThreshold = _mm_set1_epi32( 0x7c00 - 1 );
+    const __m128i nanThreshold = _mm_set1_epi32( 0x7c00 );
+    const __m128i denormalThreshold = _mm_set1_epi32( 0x0400 );
+    const __m128 denormalMagic = _mm_castsi128_ps( _mm_set1_epi32( 113 << 23 ) );
+    const auto convert4 = [&]( __m128i h ) -> __m128
+    {
+        const __m128i exponentMantissa = _mm_and_si128( h, exponentMantissaMask );
+        const __m128i o = _mm_add_epi32( _mm_slli_epi32( exponentMantissa, 13 ), rebias );
+        const __m128i denormal = _mm_castps_si128( _mm_sub_ps( _mm_castsi128_ps( _mm_add_epi32( o, _mm_set1_epi32( 1 << 23 ) ) ), denormalMagic ) );
+        const __m128i infNan = _mm_or_si128( _mm_or_si128( _mm_set1_epi32( 0x7f800000 ), _mm_slli_epi32( _mm_and_si128( exponentMantissa, _mm_set1_epi32( 0x3ff ) ), 13 ) ),
+                                             _mm_and_si128( _mm_cmpgt_epi32( exponentMantissa, nanThreshold ), _mm_set1_epi32( 0x400000 ) ) );
+        const __m128i isDenormal = _mm_cmplt_epi32( exponentMantissa, denormalThreshold );
+        const __m128i isInfNan = _mm_cmpgt_epi32( exponentMantissa, infThreshold );
+        __m128i result = _mm_or_si128( _mm_and_si128( isDenormal, denormal ), _mm_andnot_si128( isDenormal, o ) );
+        result = _mm_or_si128( _mm_and_si128( isInfNan, infNan ), _mm_andnot_si128( isInfNan, result ) );
+        return _mm_castsi128_ps( _mm_or_si128( result, _mm_slli_epi32( _mm_andnot_si128( exponentMantissaMask, h ), 16 ) ) );
+    };
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i halfs = _mm_loadu_si128( (const __m128i*) (pSrc + i) );
+        _mm_storeu_ps( pDst + i, convert4( _mm_unpacklo_epi16( halfs, zero ) ) );
+        _mm_storeu_ps( pDst + i + 4, convert4( _mm_unpackhi_epi16( halfs, zero ) ) );
+    }
+#endif
+    for (; i < count; ++i)
+        pDst[i] = TextureFormatConvertScalar::HalfToFloat( pSrc[i] );
+}
+
+//-----------------------------------------------------------------------------
+void ConvertSrgb8ToLinearFloat( std::span<const uint8_t> src, std::span<float> dst, uint32_t numChannels )
+//-----------------------------------------------------------------------------
+{
+    assert( numChannels >= 1 && numChannels <= 4 );
+    assert( dst.size() >= src.size() );
+    // Table lookup is faster than any vector evaluation of the sRGB curve (and exact).
+    const auto& srgbToLinear = GetSrgbTables().srgbToLinear;
+    const bool hasAlpha = (numChannels == 2 || numChannels == 4);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        const bool isAlpha = hasAlpha && (i % numChannels) == numChannels - 1;
+        dst[i] = isAlpha ? float( src[i] ) * (1.0f / 255.0f) : srgbToLinear[src[i]];
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ConvertLinearFloatToSrgb8( std::span<const float> src, std::span<uint8_t> dst, uint32_t numChannels )
+//-----------------------------------------------------------------------------
+{
+    assert( numChannels >= 1 && numChannels <= 4 );
+    assert( dst.size() >= src.size() );
+    // Threshold table search (8 compares, no pow) gives the same rounding as the reference conversion.
+    const auto& thresholds = GetSrgbTables().thresholds;
+    const bool hasAlpha = (numChannels == 2 || numChannels == 4);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        const bool isAlpha = hasAlpha && (i % numChannels) == numChannels - 1;
+        dst[i] = isAlpha ? UnormToUint8( src[i] ) : LinearToSrgb8Table( thresholds, src[i] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void UnpackB10G11R11UfloatToRgba32f( std::span<const uint32_t> src, std::span<float> dst )
+//-----------------------------------------------------------------------------
+{
+    const size_t count = src.size();
+    assert( dst.size() >= count * 4 );
+    const uint32_t* pSrc = src.data();
+    float* pDst = dst.data();
+    size_t i = 0;
+#if defined(TEXTURE_CONVERT_NEON)
+    // Same algorithm as TextureFormatConvertScalar::UnpackB10G11R11Ufloat, 4 at a time.
+    const auto unpack4 = []( uint32x4_t bits, uint32_t mantissaBits ) -> float32x4_t
+    {
+        const int32x4_t mantissaShift = vdupq_n_s32( int32_t( 23 - mantissaBits ) );
+        const uint32x4_t exponent = vandq_u32( vshlq_u32( bits, vdupq_n_s32( -int32_t( mantissaBits ) ) ), vdupq_n_u32( 31 ) );
+        const uint32x4_t mantissa = vandq_u32( bits, vdupq_n_u32( (1u << mantissaBits) - 1 ) );
+        const uint32x4_t shiftedMantissa = vshlq_u32( mantissa, mantissaShift );
+        const uint32x4_t normal = vorrq_u32( vshlq_n_u32( vaddq_u32( exponent, vdupq_n_u32( 127 - 15 ) ), 23 ), shiftedMantissa );
+        const uint32x4_t denormal = vreinterpretq_u32_f32( vmulq_f32( vcvtq_f32_u32( mantissa ), vreinterpretq_f32_u32( vdupq_n_u32( (127 - 14 - mantissaBits) << 23 ) ) ) );
+        const uint32x4_t infNan = vorrq_u32( vdupq_n_u32( 0x7f800000u ), shiftedMantissa );
+        uint32x4_t result = vbslq_u32( vceqq_u32( exponent, vdupq_n_u32( 0 ) ), denormal, normal );
+        result = vbslq_u32( vceqq_u32( exponent, vdupq_n_u32( 31 ) ), infNan, result );
+        return vreinterpretq_f32_u32( result );
+    };
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32x4_t packed = vld1q_u32( pSrc + i );
+        float32x4x4_t rgba;
+        rgba.val[0] = unpack4( vandq_u32( packed, vdupq_n_u32( 0x7ffu ) ), 6 );
+        rgba.val[1] = unpack4( vandq_u32( vshrq_n_u32( packed, 11 ), vdupq_n_u32( 0x7ffu ) ), 6 );
+        rgba.val[2] = unpack4( vshrq_n_u32( packed, 22 ), 5 );
+        rgba.val[3] = vdupq_n_f32( 1.0f );
+        vst4q_f32( pDst + i * 4, rgba );
+    }
+#elif defined(TEXTURE_CONVERT_SSE2)
+    // Same algorithm as TextureFormatConvertScalar::UnpackB10G11R11Ufloat, 4 at a time.
+    const auto unpack4 = []( __m128i bits, int mantissaBits ) -> __m128
+    {
+        const __m128i exponent = _mm_and_si128( _mm_srl_epi32( bits, _mm_cvtsi32_si128( mantissaBits ) ), _mm_set1_epi32( 31 ) );
+        const __m128i mantissa = _mm_and_si128( bits, _mm_set1_epi32( (1 << mantissaBits) - 1 ) );
+        const __m128i shiftedMantissa = _mm_sll_epi32( mantissa, _mm_cvtsi32_si128( 23 - mantissaBits ) );
+        const __m128i normal = _mm_or_si128( _mm_slli_epi32( _mm_add_epi32( exponent, _mm_set1_epi32( 127 - 15 ) ), 23 ), shiftedMantissa );
+        const __m128i denormal = _mm_castps_si128( _mm_mul_ps( _mm_cvtepi32_ps( mantissa ), _mm_castsi128_ps( _mm_set1_epi32( (127 - 14 - mantissaBits) << 23 ) ) ) );
+        const __m128i infNan = _mm_or_si128( _mm_set1_epi32( 0x7f800000 ), shiftedMantissa );
+        const __m128i isDenormal = _mm_cmpeq_epi32( exponent, _mm_setzero_si128() );
+        const __m128i isInfNan = _mm_cmpeq_epi32( exponent, _mm_set1_epi32( 31 ) );
+        __m128i result = _mm_or_si128( _mm_and_si128( isDenormal, denormal ), _mm_andnot_si128( isDenormal, normal ) );
+        result = _mm_or_si128( _mm_and_si128( isInfNan, infNan ), _mm_andnot_si128( isInfNan, result ) );
+        return _mm_castsi128_ps( result );
+    };
+    const __m128i mask11 = _mm_set1_epi32( 0x7ff );
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i packed = _mm_loadu_si128( (const __m128i*) (pSrc + i) );
+        __m128 r = unpack4( _mm_and_si128( packed, mask11 ), 6 );
+        __m128 g = unpack4( _mm_and_si128( _mm_srli_epi32( packed, 11 ), mask11 ), 6 );
+        __m128 b = unpack4( _mm_srli_epi32( packed, 22 ), 5 );
+        __m128 a = _mm_set1_ps( 1.0f );
+        _MM_TRANSPOSE4_PS( r, g, b, a );
+        _mm_storeu_ps( pDst + i * 4, r );
+        _mm_storeu_ps( pDst + i * 4 + 4, g );
+        _mm_storeu_ps( pDst + i * 4 + 8, b );
+        _mm_storeu_ps( pDst + i * 4 + 12, a );
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        TextureFormatConvertScalar::UnpackB10G11R11Ufloat( pSrc[i], pDst + i * 4 );
+        pDst[i * 4 + 3] = 1.0f;
+    }
+}
@@ -0,0 +1,63 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+///
+/// Cpu side pixel format conversions (for texture loading, saving and readback).
+///
+/// Bulk conversions are vectorized (NEON on arm64, SSE2/SSSE3/F16C on x86 where the compiler targets them) and give bit identical results to the
+/// scalar reference conversions in TextureFormatConvertScalar (which the vector loops also use for their tail pixels).
+/// Pixel counts are taken from the source span, the destination span must be large enough to hold the converted pixels.
+/// Unless noted source and destination must not overlap.
+///
+
+/// RGB8 to RGBA8 (3 bytes per pixel to 4 bytes per pixel), alpha is set to the given value.
+void ConvertRgb8ToRgba8( std::span<const uint8_t> src, std::span<uint8_t> dst, uint8_t alpha = 255 );
+
+/// RGB8 to RG8 (blue is dropped).
+void ConvertRgb8ToRg8( std::span<const uint8_t> src, std::span<uint8_t> dst );
+
+/// RGBA8 to RGB8 (alpha is dropped).
+void ConvertRgba8ToRgb8( std::span<const uint8_t> src, std::span<uint8_t> dst );
+
+/// Swap the red and blue channels of 4 byte per pixel data (RGBA8 to BGRA8, or BGRA8 to RGBA8).  Source and destination may be the same memory.
+void SwizzleRgba8Bgra8( std::span<const uint8_t> src, std::span<uint8_t> dst );
+
+/// 32bit float to 16bit (half) float, round to nearest even.
+void ConvertFloat32ToFloat16( std::span<const float> src, std::span<uint16_t> dst );
+
+/// 16bit (half) float to 32bit float.
+void ConvertFloat16ToFloat32( std::span<const uint16_t> src, std::span<float> dst );
+
+/// sRGB encoded 8bit to linear float.
+/// @param numChannels channels per pixel, when 2 or 4 the last channel is alpha and is not sRGB encoded (converted as unorm)
+void ConvertSrgb8ToLinearFloat( std::span<const uint8_t> src, std::span<float> dst, uint32_t numChannels );
+
+/// Linear float to sRGB encoded 8bit (values are clamped to 0-1, rounded to the nearest sRGB value).
+/// @param numChannels channels per pixel, when 2 or 4 the last channel is alpha and is not sRGB encoded (converted as unorm)
+void ConvertLinearFloatToSrgb8( std::span<const float> src, std::span<uint8_t> dst, uint32_t numChannels );
+
+/// Unpack B10G11R11_UFLOAT_PACK32 (as used by TextureFormat::B10G11R11_UFLOAT_PACK32) to RGBA float (alpha is 1).
+void UnpackB10G11R11UfloatToRgba32f( std::span<const uint32_t> src, std::span<float> dst );
+
+
+/// Scalar (single value) reference conversions.
+namespace TextureFormatConvertScalar
+{
+    /// Round to nearest even, handles denormals, inf and nan (nan payload is truncated and quieted, as hardware converts).
+    uint16_t FloatToHalf( float f );
+    /// Handles denormals, inf and nan (nan is quieted, as hardware converts).
+    float HalfToFloat( uint16_t h );
+    float Srgb8ToLinear( uint8_t srgb );
+    uint8_t LinearToSrgb8( float linear );
+    /// @param rgb (output) 3 floats
+    void UnpackB10G11R11Ufloat( uint32_t packed, float* rgb );
+}
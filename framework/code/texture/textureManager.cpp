@@ -9,6 +9,7 @@
 #include "textureManager.hpp"
 #include "loaderKtx.hpp"
 #include "loaderPpm.hpp"
+#include <algorithm>
 #include <queue>
 
 TextureManagerBase::TextureManagerBase( AssetManager& rAssetManager ) noexcept
@@ -25,12 +26,38 @@ bool TextureManagerBase::Initialize(uint32_t numWorkerThreads)
 {
     if (m_LoadingThreadWorker.Initialize("TextureThreadWorker", numWorkerThreads) <= 0)
         return false;
+    m_Loader->SetTranscodeWorker(&m_LoadingThreadWorker);   // large basis textures are transcoded across the loading threads
     return m_Loader->Initialize();
 }
 
 void TextureManagerBase::Release()
 {
+    if (m_Loader)
+        m_Loader->SetTranscodeWorker(nullptr);
     m_LoadingThreadWorker.Terminate();
+    m_QueuedAsyncLoads.clear();
+}
+
+bool TextureManagerBase::LoadTextureAsync_( const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler )
+{
+    // Default (no background loading) queues the texture for UpdateAsyncLoads to load.
+    if (std::none_of( m_QueuedAsyncLoads.begin(), m_QueuedAsyncLoads.end(), [&textureSlotName]( const QueuedAsyncLoad& queued ) { return queued.slotName == textureSlotName; } ))
+        m_QueuedAsyncLoads.push_back( { textureSlotName, filename, &sampler } );
+    return true;
+}
+
+std::vector<std::string> TextureManagerBase::UpdateAsyncLoads( uint32_t maxTextures )
+{
+    std::vector<std::string> finishedSlotNames;
+    for (uint32_t loadIdx = 0; loadIdx < maxTextures && !m_QueuedAsyncLoads.empty(); ++loadIdx)
+    {
+        QueuedAsyncLoad queued = std::move( m_QueuedAsyncLoads.front() );
+        m_QueuedAsyncLoads.pop_front();
+        if (!GetTexture( queued.slotName ))
+            GetOrLoadTexture_( queued.slotName, queued.filename, *queued.pSampler );
+        finishedSlotNames.push_back( std::move( queued.slotName ) );
+    }
+    return finishedSlotNames;
 }
 
 const TextureBase* TextureManagerBase::CreateTextureObject( uint32_t Width, uint32_t Height, TextureFormat Format, TEXTURE_TYPE TexType, const char* pName, Msaa Msaa, TEXTURE_FLAGS Flags )
@@ -5,10 +5,12 @@
 //
 //==============================================================================
 #pragma once
+#include <deque>
 #include <span>
 #include <string>
 #include <functional>
 #include <filesystem>
+#include <vector>
 
 ///
 /// Texture file loading and tracking
@@ -61,6 +63,22 @@ public:
 	template<typename... T_PATHMANIPULATOR>
 	void BatchLoad(const std::span<const std::string> textureNames, const SamplerBase& defaultSampler, T_PATHMANIPULATOR && ... pathnameManipulators);
 
+	/// @brief Start loading a texture into a named 'slot' without waiting for it (unlike GetOrLoadTexture).
+	/// The file is loaded (and transcoded) on the loading worker threads and the texture is added to the manager by a later UpdateAsyncLoads.
+	/// @param textureSlotName name of texture slot (key in lookup)
+	/// @param filename texture filename to load
+	/// @param sampler sampler to load the texture with (must outlive the loading)
+	/// @param ...pathnameManipulators variadic functors to manipulate the filename (eg change extension or path)
+	/// @return true if the texture is loading (or already was), false if it is already loaded or there is nothing to load
+	template<typename... T_PATHMANIPULATOR>
+	bool LoadTextureAsync(const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler, T_PATHMANIPULATOR && ... pathnameManipulators);
+
+	/// @brief Add textures that have finished loading (see LoadTextureAsync) to the manager.  Call from the rendering thread (eg once per frame).
+	/// Graphics apis without background loading load the queued textures here instead.
+	/// @param maxTextures maximum number of textures added (uploaded) by this call
+	/// @return slot names of the loads finished by this call, including loads that failed (which GetTexture does not find)
+	virtual std::vector<std::string> UpdateAsyncLoads(uint32_t maxTextures);
+
 	/// @brief Find a texture (by slot name) that may be already loaded
 	/// @param textureSlotName name to look for
 	/// @return pointer to already loaded texture, or null
@@ -85,7 +103,8 @@ public:
     virtual const TextureBase* CreateTextureObjectView( const TextureBase& original, TextureFormat viewFormat, std::string name ) = 0;
 
     /// Create texture from a block of texture data in memory (with correct format, span etc).
-    virtual const TextureBase* CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name) = 0;
+    /// @param generateMips generate the rest of the mip chain (on the gpu) from the data, which only contains the top mip level
+    virtual const TextureBase* CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name, bool generateMips = false) = 0;
 
     /// Get a 'default' sampler for the given address mode (all other sampler settings assumed to be 'normal' ie linearly sampled etc)
     virtual const SamplerBase* const GetSampler( SamplerAddressMode ) const = 0;
@@ -98,6 +117,15 @@ protected:
 
     virtual const TextureBase* GetOrLoadTexture_( const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler ) = 0;
     virtual void BatchLoad(const std::span<std::pair<std::string, std::string>>, const SamplerBase& defaultSampler) = 0;
+    virtual bool LoadTextureAsync_(const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler);
+
+    /// Texture queued by LoadTextureAsync_ (default implementation, loaded by UpdateAsyncLoads)
+    struct QueuedAsyncLoad
+    {
+        std::string         slotName;
+        std::string         filename;
+        const SamplerBase*  pSampler = nullptr;
+    };
 
 protected:
 	AssetManager&								m_AssetManager;
@@ -105,6 +133,7 @@ protected:
     std::unique_ptr<TexturePpmBase>		        m_LoaderPpm;
     std::function<void(std::string&)>			m_DefaultFilenameManipulator = [](std::string&) {return; };
 	ThreadWorker								m_LoadingThreadWorker;
+	std::deque<QueuedAsyncLoad>					m_QueuedAsyncLoads;
 };
 
 
@@ -195,6 +224,19 @@ const TextureBase* TextureManagerBase::GetOrLoadTexture(const std::string& textu
     return GetOrLoadTexture_(textureSlotName, filename_, sampler);
 }
 
+template<typename... T_PATHMANIPULATOR>
+bool TextureManagerBase::LoadTextureAsync(const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler, T_PATHMANIPULATOR && ... pathnameManipulators)
+{
+    if (textureSlotName.empty() || filename.empty() || GetTexture(textureSlotName))
+        return false;
+    std::string filename_ = filename;
+    if constexpr (sizeof...(pathnameManipulators) == 0)
+        m_DefaultFilenameManipulator(filename_);
+    else
+        ExecutePathManipulators(filename_, pathnameManipulators...);
+    return LoadTextureAsync_(textureSlotName, filename_, sampler);
+}
+
 template<typename... T_PATHMANIPULATOR>
 void TextureManagerBase::BatchLoad(const std::span<const std::string> textureNames, const SamplerBase& defaultSampler, T_PATHMANIPULATOR && ... pathnameManipulators)
 {
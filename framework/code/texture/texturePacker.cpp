@@ -0,0 +1,200 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "texturePacker.hpp"
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <tuple>
+
+/// @return width (and height) of the format's compression block, 1 for uncompressed formats, 0 for formats that cannot be atlased.
+static uint32_t AtlasBlockDimension(TextureFormat format)
+{
+    if (format >= TextureFormat::BC1_RGB_UNORM_BLOCK && format <= TextureFormat::ASTC_4x4_SRGB_BLOCK)
+        return 4;   // BC, ETC2, EAC and ASTC 4x4 are all 4x4 blocks (and contiguous in TextureFormat)
+    if (FormatIsCompressed(format) || FormatHasDepth(format) || FormatBytesPerPixel(format) == 0)
+        return 0;
+    return 1;
+}
+
+TexturePackLayout PlanTexturePacking(std::span<const TexturePackerSet> sets, const TexturePackerSettings& settings)
+{
+    TexturePackLayout layout;
+    layout.setUvScaleOffsets.resize(sets.size(), glm::vec4(1.0f, 1.0f, 0.0f, 0.0f));
+
+    const uint32_t atlasSize = std::bit_floor(std::max(settings.atlasSize, 4u));
+    const uint32_t atlasMaxDimension = std::min(settings.atlasMaxDimension, atlasSize);
+
+    // Textures used by more than one set (or more than once) cannot be atlased, they would need a different uv remap for each use.
+    std::unordered_map<std::string, uint32_t> textureUseCount;
+    for (const auto& set : sets)
+        for (const auto& texture : set.textures)
+            ++textureUseCount[texture.slotName];
+
+    //
+    // Atlases.  Group atlasable sets by the formats of their textures (each texture in the set gets its own atlas) and by the number of atlas mips.
+    //
+    struct AtlasCandidate
+    {
+        uint32_t    setIndex;
+        uint32_t    width;
+        uint32_t    height;
+    };
+    std::map<std::pair<std::vector<TextureFormat>, uint32_t/*mips*/>, std::vector<AtlasCandidate>> atlasGroups;
+    for (uint32_t setIndex = 0; setIndex < (uint32_t)sets.size(); ++setIndex)
+    {
+        const auto& set = sets[setIndex];
+        if (!set.allowAtlas || set.textures.empty())
+            continue;
+        const uint32_t width = set.textures[0].width;
+        const uint32_t height = set.textures[0].height;
+        if (!std::has_single_bit(width) || !std::has_single_bit(height) || std::max(width, height) > atlasMaxDimension || std::min(width, height) < 4)
+            continue;
+
+        // Atlas mips stop at 4x4 (so mip rectangles stay block aligned and do not overlap their neighbours)
+        uint32_t mipLevels = std::bit_width(std::min(width, height)) - 2;
+        std::vector<TextureFormat> formats;
+        bool atlasable = true;
+        for (const auto& texture : set.textures)
+        {
+            atlasable &= texture.width == width && texture.height == height && AtlasBlockDimension(texture.format) != 0 && textureUseCount[texture.slotName] == 1;
+            mipLevels = std::min(mipLevels, std::max(texture.mipLevels, 1u));
+            formats.push_back(texture.format);
+        }
+        if (atlasable)
+            atlasGroups[{ std::move(formats), mipLevels }].push_back({ setIndex, width, height });
+    }
+
+    std::vector<bool> setAtlased(sets.size(), false);
+    for (auto& [groupKey, candidates] : atlasGroups)
+    {
+        const auto& [formats, mipLevels] = groupKey;
+        if (candidates.size() < 2)
+            continue;
+
+        // Shelf pack (tallest first).  Everything is a power of 2 so positions stay aligned to the smallest mip's block.
+        std::stable_sort(candidates.begin(), candidates.end(), [](const AtlasCandidate& a, const AtlasCandidate& b) {
+            return std::tie(a.height, a.width) > std::tie(b.height, b.width);
+        });
+
+        struct Placement
+        {
+            uint32_t    setIndex;
+            uint32_t    x, y, width, height;
+        };
+        std::vector<std::vector<Placement>> pages(1);
+        std::vector<uint32_t> pageWidths(1, 0);
+        std::vector<uint32_t> pageHeights(1, 0);
+        uint32_t shelfX = 0, shelfY = 0, shelfHeight = 0;
+        for (const auto& candidate : candidates)
+        {
+            if (shelfX + candidate.width > atlasSize)
+            {
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            if (shelfY + candidate.height > atlasSize)
+            {
+                pages.emplace_back();
+                pageWidths.push_back(0);
+                pageHeights.push_back(0);
+                shelfX = shelfY = shelfHeight = 0;
+            }
+            pages.back().push_back({ candidate.setIndex, shelfX, shelfY, candidate.width, candidate.height });
+            shelfX += candidate.width;
+            shelfHeight = std::max(shelfHeight, candidate.height);
+            pageWidths.back() = std::max(pageWidths.back(), shelfX);
+            pageHeights.back() = std::max(pageHeights.back(), shelfY + candidate.height);
+        }
+
+        for (size_t pageIdx = 0; pageIdx < pages.size(); ++pageIdx)
+        {
+            const auto& page = pages[pageIdx];
+            if (page.size() < 2)
+                continue;   // not worth an atlas, leave for the texture arrays
+            // Trim the (last) page to what was used, keeping it a power of 2 so every mip level divides evenly.
+            const uint32_t pageWidth = std::bit_ceil(pageWidths[pageIdx]);
+            const uint32_t pageHeight = std::bit_ceil(pageHeights[pageIdx]);
+
+            // One atlas per texture in the sets (same layout in each)
+            const uint32_t firstPackedTexture = (uint32_t)layout.packedTextures.size();
+            for (const TextureFormat format : formats)
+            {
+                auto& packedTexture = layout.packedTextures.emplace_back();
+                packedTexture.format = format;
+                packedTexture.width = pageWidth;
+                packedTexture.height = pageHeight;
+                packedTexture.mipLevels = mipLevels;
+                packedTexture.layers = 1;
+                packedTexture.isAtlas = true;
+            }
+            for (const auto& placement : page)
+            {
+                const glm::vec4 uvScaleOffset{ float(placement.width) / float(pageWidth), float(placement.height) / float(pageHeight), float(placement.x) / float(pageWidth), float(placement.y) / float(pageHeight) };
+                layout.setUvScaleOffsets[placement.setIndex] = uvScaleOffset;
+                setAtlased[placement.setIndex] = true;
+
+                const auto& textures = sets[placement.setIndex].textures;
+                for (uint32_t textureIdx = 0; textureIdx < (uint32_t)textures.size(); ++textureIdx)
+                {
+                    const uint32_t packedTextureIndex = firstPackedTexture + textureIdx;
+                    layout.packedTextures[packedTextureIndex].regions.push_back({ textures[textureIdx].slotName, 0, placement.x, placement.y, placement.width, placement.height });
+                    layout.locations[textures[textureIdx].slotName] = { packedTextureIndex, 0, uvScaleOffset };
+                }
+            }
+        }
+    }
+
+    //
+    // Texture arrays.  Group everything that was not atlased by format, size and mip count.
+    //
+    std::map<std::tuple<TextureFormat, uint32_t, uint32_t, uint32_t>, std::vector<std::string>> arrayGroups;
+    for (uint32_t setIndex = 0; setIndex < (uint32_t)sets.size(); ++setIndex)
+    {
+        if (setAtlased[setIndex])
+            continue;
+        for (const auto& texture : sets[setIndex].textures)
+        {
+            if (texture.width == 0 || texture.height == 0 || texture.format == TextureFormat::UNDEFINED)
+                continue;
+            auto& slotNames = arrayGroups[{ texture.format, texture.width, texture.height, std::max(texture.mipLevels, 1u) }];
+            if (std::find(slotNames.begin(), slotNames.end(), texture.slotName) == slotNames.end())
+                slotNames.push_back(texture.slotName);
+        }
+    }
+
+    const uint32_t minArrayLayers = std::max(settings.minArrayLayers, 2u);
+    const uint32_t maxArrayLayers = std::max(settings.maxArrayLayers, minArrayLayers);
+    for (const auto& [groupKey, slotNames] : arrayGroups)
+    {
+        const auto& [format, width, height, mipLevels] = groupKey;
+        for (size_t first = 0; first < slotNames.size(); first += maxArrayLayers)
+        {
+            const uint32_t numLayers = (uint32_t)std::min<size_t>(maxArrayLayers, slotNames.size() - first);
+            if (numLayers < minArrayLayers)
+                break;
+            const uint32_t packedTextureIndex = (uint32_t)layout.packedTextures.size();
+            auto& packedTexture = layout.packedTextures.emplace_back();
+            packedTexture.format = format;
+            packedTexture.width = width;
+            packedTexture.height = height;
+            packedTexture.mipLevels = mipLevels;
+            packedTexture.layers = numLayers;
+            packedTexture.isAtlas = false;
+            for (uint32_t layer = 0; layer < numLayers; ++layer)
+            {
+                const std::string& slotName = slotNames[first + layer];
+                packedTexture.regions.push_back({ slotName, layer, 0, 0, width, height });
+                layout.locations[slotName] = { packedTextureIndex, layer, glm::vec4(1.0f, 1.0f, 0.0f, 0.0f) };
+            }
+        }
+    }
+
+    return layout;
+}
@@ -0,0 +1,92 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "system/glm_common.hpp"
+#include "textureFormat.hpp"
+
+///
+/// Planning of texture packing (small textures in to atlases, same sized textures in to texture arrays)
+///
+
+/// Texture to be considered for packing (see PlanTexturePacking)
+struct TexturePackerTexture
+{
+    std::string     slotName;
+    TextureFormat   format = TextureFormat::UNDEFINED;
+    uint32_t        width = 0;
+    uint32_t        height = 0;
+    uint32_t        mipLevels = 1;
+};
+
+/// Textures sampled with the same texture coordinates (eg the textures of one material).
+/// A set is either atlased together (each texture goes in to the same rectangle of its own atlas, so one uv remap works for all of them) or not atlased at all.
+struct TexturePackerSet
+{
+    std::vector<TexturePackerTexture> textures;
+    bool            allowAtlas = true;      ///< must be false if the texture coordinates used with this set go outside 0-1 (atlased textures cannot wrap)
+};
+
+struct TexturePackerSettings
+{
+    uint32_t        atlasMaxDimension = 256;    ///< textures no larger than this are atlased (when their set allows), otherwise they are candidates for texture arrays
+    uint32_t        atlasSize = 2048;           ///< maximum width and height of an atlas (power of 2)
+    uint32_t        minArrayLayers = 2;         ///< smallest group of same format/size textures to put in to a texture array
+    uint32_t        maxArrayLayers = 256;
+};
+
+/// Where a source texture ended up after packing
+struct TexturePackLocation
+{
+    uint32_t        packedTextureIndex = 0;     ///< index in to TexturePackLayout::packedTextures
+    uint32_t        layer = 0;                  ///< array layer (always 0 for atlases)
+    glm::vec4       uvScaleOffset = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);  ///< packed uv = uv * xy + zw (identity for texture arrays)
+};
+
+/// Result of PlanTexturePacking
+struct TexturePackLayout
+{
+    /// Source texture copied in to a packed texture (all mip levels of the packed texture)
+    struct Region
+    {
+        std::string     slotName;
+        uint32_t        layer = 0;
+        uint32_t        x = 0;
+        uint32_t        y = 0;
+        uint32_t        width = 0;
+        uint32_t        height = 0;
+    };
+
+    /// Texture array (isAtlas false) or atlas
+    struct PackedTexture
+    {
+        TextureFormat       format = TextureFormat::UNDEFINED;
+        uint32_t            width = 0;
+        uint32_t            height = 0;
+        uint32_t            mipLevels = 1;      ///< atlases may have fewer mips than their source textures (mips are not shared between neighbouring regions)
+        uint32_t            layers = 1;
+        bool                isAtlas = false;
+        std::vector<Region> regions;
+    };
+
+    std::vector<PackedTexture>                              packedTextures;
+    std::unordered_map<std::string, TexturePackLocation>    locations;          ///< by source texture slot name (textures that were not packed are not in here)
+    std::vector<glm::vec4>                                  setUvScaleOffsets;  ///< uv remap for each TexturePackerSet (identity if the set was not atlased)
+};
+
+/// Plan how to pack the given textures.
+/// Sets that allow atlasing, whose textures are all the same power of 2 size (no larger than atlasMaxDimension), are in a 4x4 block compressed (or uncompressed) format
+/// and are not shared with any other set, are shelf packed in to atlases (one atlas per texture in the set, grouped by the set's texture formats).
+/// Remaining textures with the same format, size and mip count are grouped in to texture arrays.
+/// Textures that do not fit in either are left as they are (not in TexturePackLayout::locations).
+TexturePackLayout PlanTexturePacking(std::span<const TexturePackerSet> sets, const TexturePackerSettings& settings = {});
@@ -0,0 +1,360 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "ktxParallelTranscode.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <ktx.h>  // KTX-Software
+#include <KHR/khr_df.h>
+#include "vulkan/vulkan.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// Basis Universal low level transcoder (built in to the ktx_read library, these must match the definitions ktx_read is built with)
+#define BASISD_SUPPORT_KTX2 0
+#define BASISD_SUPPORT_KTX2_ZSTD 0
+#define BASISD_SUPPORT_FXT1 0
+#include "KTX-Software/lib/basisu/transcoder/basisu_transcoder.h"
+
+namespace
+{
+    /// UASTC images are split in to strips of this many block rows (128 pixel rows), ETC1S images cannot be split (variable length bitstream)
+    constexpr uint32_t cUastcStripBlockRows = 32;
+    /// Textures with fewer 4x4 blocks than this (256x256 with mips) are transcoded single threaded
+    constexpr uint64_t cMinParallelBlocks = 64 * 64;
+
+    // Ktx2 file header (KTX 2.0 specification section 3)
+    struct Ktx2Header
+    {
+        uint8_t     identifier[12];
+        uint32_t    vkFormat;
+        uint32_t    typeSize;
+        uint32_t    pixelWidth;
+        uint32_t    pixelHeight;
+        uint32_t    pixelDepth;
+        uint32_t    layerCount;
+        uint32_t    faceCount;
+        uint32_t    levelCount;
+        uint32_t    supercompressionScheme;
+        uint32_t    dfdByteOffset;
+        uint32_t    dfdByteLength;
+        uint32_t    kvdByteOffset;
+        uint32_t    kvdByteLength;
+        uint64_t    sgdByteOffset;
+        uint64_t    sgdByteLength;
+    };
+    static_assert(sizeof( Ktx2Header ) == 80);
+
+    struct Ktx2LevelIndex
+    {
+        uint64_t    byteOffset;
+        uint64_t    byteLength;
+        uint64_t    uncompressedByteLength;
+    };
+
+    // BasisLZ supercompression global data (KTX 2.0 specification section 3.10.2)
+    struct BasisLzGlobalHeader
+    {
+        uint16_t    endpointCount;
+        uint16_t    selectorCount;
+        uint32_t    endpointsByteLength;
+        uint32_t    selectorsByteLength;
+        uint32_t    tablesByteLength;
+        uint32_t    extendedByteLength;
+    };
+    static_assert(sizeof( BasisLzGlobalHeader ) == 20);
+
+    struct BasisLzImageDesc
+    {
+        uint32_t    imageFlags;
+        uint32_t    rgbSliceByteOffset;
+        uint32_t    rgbSliceByteLength;
+        uint32_t    alphaSliceByteOffset;
+        uint32_t    alphaSliceByteLength;
+    };
+
+    /// One image (ETC1S) or strip of an image (UASTC), transcoded straight in to the output texture
+    struct TranscodeTask
+    {
+        const uint8_t*  pSrc;
+        uint32_t        srcBytes;
+        uint8_t*        pDst;
+        uint32_t        dstBlocksOrPixels;
+        uint32_t        numBlocksX;
+        uint32_t        numBlocksY;
+        uint32_t        width;
+        uint32_t        height;
+        uint32_t        level;
+        uint32_t        etc1sImageIndex;    ///< index in to TranscodeJob::etc1sImageDescs
+    };
+
+    /// Tasks (and the shared read only decode data) for one texture, transcoded in parallel by ThreadWorker::ParallelFor
+    struct TranscodeJob
+    {
+        std::vector<TranscodeTask>      tasks;
+        std::vector<BasisLzImageDesc>   etc1sImageDescs;
+        basist::basisu_lowlevel_etc1s_transcoder etc1sTranscoder;   ///< palettes/tables decoded once, read only while transcoding
+        basist::transcoder_texture_format targetFormat = basist::transcoder_texture_format::cTFRGBA32;
+        bool                            isEtc1s = false;
+        bool                            hasAlpha = false;
+
+        bool Transcode( const TranscodeTask& task )
+        {
+            basist::basisu_transcoder_state state;  // decode state is only carried between images for video (which we do not transcode)
+            if (isEtc1s)
+            {
+                const auto& imageDesc = etc1sImageDescs[task.etc1sImageIndex];
+                return etc1sTranscoder.transcode_image( targetFormat, task.pDst, task.dstBlocksOrPixels, task.pSrc, task.srcBytes,
+                                                        task.numBlocksX, task.numBlocksY, task.width, task.height, task.level,
+                                                        imageDesc.rgbSliceByteOffset, imageDesc.rgbSliceByteLength, imageDesc.alphaSliceByteOffset, imageDesc.alphaSliceByteLength,
+                                                        0/*decode flags*/, hasAlpha, false/*is video*/, 0/*output row pitch*/, &state );
+            }
+            basist::basisu_lowlevel_uastc_transcoder uastcTranscoder;
+            return uastcTranscoder.transcode_image( targetFormat, task.pDst, task.dstBlocksOrPixels, task.pSrc, task.srcBytes,
+                                                    task.numBlocksX, task.numBlocksY, task.width, task.height, task.level,
+                                                    0/*slice offset*/, task.srcBytes, 0/*decode flags*/, hasAlpha, false/*is video*/, 0/*output row pitch*/, &state );
+        }
+    };
+
+    /// Vulkan format (and size) of the transcode output formats we support.
+    struct TranscodeOutputFormat
+    {
+        VkFormat    unormFormat;
+        VkFormat    srgbFormat;
+        uint32_t    bytesPerBlock;      ///< 0 for uncompressed (4 bytes per pixel) output
+    };
+
+    bool GetTranscodeOutputFormat( uint32_t transcodeFormat, TranscodeOutputFormat& outputFormat )
+    {
+        switch (transcodeFormat)
+        {
+        case KTX_TTF_ETC1_RGB:      outputFormat = { VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK, 8 }; return true;
+        case KTX_TTF_ETC2_RGBA:     outputFormat = { VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK, 16 }; return true;
+        case KTX_TTF_BC1_RGB:       outputFormat = { VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGB_SRGB_BLOCK, 8 }; return true;
+        case KTX_TTF_BC3_RGBA:      outputFormat = { VK_FORMAT_BC3_UNORM_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK, 16 }; return true;
+        case KTX_TTF_BC7_RGBA:      outputFormat = { VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK, 16 }; return true;
+        case KTX_TTF_ASTC_4x4_RGBA: outputFormat = { VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_SRGB_BLOCK, 16 }; return true;
+        case KTX_TTF_RGBA32:        outputFormat = { VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB, 0 }; return true;
+        default:
+            return false;
+        }
+    }
+
+    /// Read the ETC1S (BasisLZ) global data and level index from the ktx2 file, decode the palettes and tables and add a task per image.
+    bool PrepareEtc1s( TranscodeJob& job, const ktxTexture2& source, std::span<const uint8_t> fileData, std::vector<const uint8_t*>& levelData, std::vector<uint32_t>& levelBytes )
+    {
+        Ktx2Header header;
+        if (fileData.size() < sizeof( header ))
+            return false;
+        memcpy( &header, fileData.data(), sizeof( header ) );
+        const uint32_t numLevels = std::max( header.levelCount, 1u );
+        const uint32_t numImages = numLevels * std::max( header.layerCount, 1u ) * header.faceCount;
+        if (numLevels != source.numLevels || header.faceCount != source.numFaces || fileData.size() < sizeof( header ) + numLevels * sizeof( Ktx2LevelIndex ))
+            return false;
+
+        for (uint32_t level = 0; level < numLevels; ++level)
+        {
+            Ktx2LevelIndex levelIndex;
+            memcpy( &levelIndex, fileData.data() + sizeof( header ) + level * sizeof( Ktx2LevelIndex ), sizeof( levelIndex ) );
+            if (levelIndex.byteOffset + levelIndex.byteLength > fileData.size())
+                return false;
+            levelData.push_back( fileData.data() + levelIndex.byteOffset );
+            levelBytes.push_back( (uint32_t) levelIndex.byteLength );
+        }
+
+        BasisLzGlobalHeader globalHeader;
+        if (header.sgdByteOffset + header.sgdByteLength > fileData.size() || header.sgdByteLength < sizeof( globalHeader ))
+            return false;
+        const uint8_t* pSgd = fileData.data() + header.sgdByteOffset;
+        memcpy( &globalHeader, pSgd, sizeof( globalHeader ) );
+        const uint64_t imageDescsBytes = uint64_t( numImages ) * sizeof( BasisLzImageDesc );
+        if (sizeof( globalHeader ) + imageDescsBytes + globalHeader.endpointsByteLength + globalHeader.selectorsByteLength + globalHeader.tablesByteLength + globalHeader.extendedByteLength > header.sgdByteLength)
+            return false;
+
+        job.etc1sImageDescs.resize( numImages );
+        memcpy( job.etc1sImageDescs.data(), pSgd + sizeof( globalHeader ), imageDescsBytes );
+        const uint8_t* pEndpoints = pSgd + sizeof( globalHeader ) + imageDescsBytes;
+        const uint8_t* pSelectors = pEndpoints + globalHeader.endpointsByteLength;
+        const uint8_t* pTables = pSelectors + globalHeader.selectorsByteLength;
+        return job.etc1sTranscoder.decode_palettes( globalHeader.endpointCount, pEndpoints, globalHeader.endpointsByteLength, globalHeader.selectorCount, pSelectors, globalHeader.selectorsByteLength ) &&
+               job.etc1sTranscoder.decode_tables( pTables, globalHeader.tablesByteLength );
+    }
+}
+
+//-----------------------------------------------------------------------------
+/// Transcode mip levels firstLevel onwards of source (helped by pWorker's threads, if given).
+/// Textures with fewer than minBlocks 4x4 blocks (in the transcoded levels) are not transcoded (returns nullptr).
+static ktxTexture2* TranscodeKtx2( ktxTexture2& source, std::span<const uint8_t> sourceFileData, uint32_t transcodeFormat, uint32_t firstLevel, ThreadWorker* pWorker, uint64_t minBlocks )
+//-----------------------------------------------------------------------------
+{
+    if (source.baseDepth > 1 || source.pDfd == nullptr || firstLevel >= source.numLevels)
+        return nullptr;
+
+    // Video (with inter frame prediction) has to be transcoded in order.
+    unsigned int animDataBytes = 0;
+    void* pAnimData = nullptr;
+    if (ktxHashList_FindValue( &source.kvDataHead, KTX_ANIMDATA_KEY, &animDataBytes, &pAnimData ) == KTX_SUCCESS)
+        return nullptr;
+
+    const uint32_t* pBdb = source.pDfd + 1;    // basic data format descriptor block
+    const uint32_t colorModel = KHR_DFDVAL( pBdb, MODEL );
+    const bool isEtc1s = colorModel == KHR_DF_MODEL_ETC1S && source.supercompressionScheme == KTX_SS_BASIS_LZ;
+    const bool isUastc = colorModel == KHR_DF_MODEL_UASTC;
+    if (!isEtc1s && !isUastc)
+        return nullptr;
+    const uint32_t channel0 = KHR_DFDSVAL( pBdb, 0, CHANNELID );
+    const bool hasAlpha = isEtc1s ? KHR_DFDSAMPLECOUNT( pBdb ) == 2 : (channel0 == KHR_DF_CHANNEL_UASTC_RGBA || channel0 == KHR_DF_CHANNEL_UASTC_RRRG);
+    const bool isSrgb = KHR_DFDVAL( pBdb, TRANSFER ) == KHR_DF_TRANSFER_SRGB;
+
+    // Resolve the 'pick by alpha' formats the same way ktxTexture2_TranscodeBasis does.
+    if (transcodeFormat == KTX_TTF_ETC)
+        transcodeFormat = hasAlpha ? KTX_TTF_ETC2_RGBA : KTX_TTF_ETC1_RGB;
+    else if (transcodeFormat == KTX_TTF_BC1_OR_3)
+        transcodeFormat = hasAlpha ? KTX_TTF_BC3_RGBA : KTX_TTF_BC1_RGB;
+    TranscodeOutputFormat outputFormat;
+    if (!GetTranscodeOutputFormat( transcodeFormat, outputFormat ))
+        return nullptr;
+
+    uint64_t totalBlocks = 0;
+    for (uint32_t level = firstLevel; level < source.numLevels; ++level)
+        totalBlocks += uint64_t( (std::max( 1u, source.baseWidth >> level ) + 3) / 4 ) * ((std::max( 1u, source.baseHeight >> level ) + 3) / 4) * source.numLayers * source.numFaces;
+    if (totalBlocks < minBlocks)
+        return nullptr;
+
+    static std::once_flag sTranscoderInitialized;
+    std::call_once( sTranscoderInitialized, []() { basist::basisu_transcoder_init(); } );
+
+    TranscodeJob job;
+    job.targetFormat = (basist::transcoder_texture_format) transcodeFormat;
+    job.isEtc1s = isEtc1s;
+    job.hasAlpha = hasAlpha;
+
+    std::vector<const uint8_t*> etc1sLevelData;
+    std::vector<uint32_t> etc1sLevelBytes;
+    if (isEtc1s)
+    {
+        if (!PrepareEtc1s( job, source, sourceFileData, etc1sLevelData, etc1sLevelBytes ))
+            return nullptr;
+    }
+    else if (source.pData == nullptr && ktxTexture_LoadImageData( ktxTexture( &source ), nullptr, 0 ) != KTX_SUCCESS)
+    {
+        return nullptr;     // loads (and inflates zstd supercompressed) UASTC data
+    }
+
+    // Output texture (firstLevel is its level 0), transcoded images are written straight in to their place in its data.
+    ktxTextureCreateInfo createInfo{};
+    createInfo.vkFormat = isSrgb ? outputFormat.srgbFormat : outputFormat.unormFormat;
+    createInfo.baseWidth = std::max( 1u, source.baseWidth >> firstLevel );
+    createInfo.baseHeight = std::max( 1u, source.baseHeight >> firstLevel );
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = source.numDimensions;
+    createInfo.numLevels = source.numLevels - firstLevel;
+    createInfo.numLayers = source.numLayers;
+    createInfo.numFaces = source.numFaces;
+    createInfo.isArray = source.isArray;
+    createInfo.generateMipmaps = source.generateMipmaps;
+    ktxTexture2* pOutput = nullptr;
+    if (ktxTexture2_Create( &createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &pOutput ) != KTX_SUCCESS)
+        return nullptr;
+
+    for (uint32_t level = firstLevel; level < source.numLevels; ++level)
+    {
+        const uint32_t width = std::max( 1u, source.baseWidth >> level );
+        const uint32_t height = std::max( 1u, source.baseHeight >> level );
+        const uint32_t numBlocksX = (width + 3) / 4;
+        const uint32_t numBlocksY = (height + 3) / 4;
+        for (uint32_t layer = 0; layer < source.numLayers; ++layer)
+        {
+            for (uint32_t face = 0; face < source.numFaces; ++face)
+            {
+                ktx_size_t dstOffset = 0;
+                if (ktxTexture_GetImageOffset( ktxTexture( pOutput ), level - firstLevel, layer, face, &dstOffset ) != KTX_SUCCESS)
+                {
+                    ktxTexture_Destroy( ktxTexture( pOutput ) );
+                    return nullptr;
+                }
+                uint8_t* const pDstImage = pOutput->pData + dstOffset;
+
+                if (isEtc1s)
+                {
+                    const uint32_t imageIndex = (level * source.numLayers + layer) * source.numFaces + face;
+                    const uint32_t dstBlocksOrPixels = outputFormat.bytesPerBlock ? numBlocksX * numBlocksY : width * height;
+                    job.tasks.push_back( { etc1sLevelData[level], etc1sLevelBytes[level], pDstImage, dstBlocksOrPixels, numBlocksX, numBlocksY, width, height, level, imageIndex } );
+                    continue;
+                }
+
+                ktx_size_t srcOffset = 0;
+                if (ktxTexture_GetImageOffset( ktxTexture( &source ), level, layer, face, &srcOffset ) != KTX_SUCCESS)
+                {
+                    ktxTexture_Destroy( ktxTexture( pOutput ) );
+                    return nullptr;
+                }
+                const uint8_t* const pSrcImage = source.pData + srcOffset;
+                for (uint32_t blockRow = 0; blockRow < numBlocksY; blockRow += cUastcStripBlockRows)
+                {
+                    // Each 16 byte UASTC block transcodes independently, so a strip of block rows is just a smaller image.
+                    const uint32_t stripBlocksY = std::min( cUastcStripBlockRows, numBlocksY - blockRow );
+                    const uint32_t stripHeight = std::min( stripBlocksY * 4, height - blockRow * 4 );
+                    TranscodeTask task{ pSrcImage + size_t( blockRow ) * numBlocksX * 16, stripBlocksY * numBlocksX * 16, nullptr, 0, numBlocksX, stripBlocksY, width, stripHeight, level, 0 };
+                    if (outputFormat.bytesPerBlock)
+                    {
+                        task.pDst = pDstImage + size_t( blockRow ) * numBlocksX * outputFormat.bytesPerBlock;
+                        task.dstBlocksOrPixels = stripBlocksY * numBlocksX;
+                    }
+                    else
+                    {
+                        task.pDst = pDstImage + size_t( blockRow ) * 4 * width * 4;
+                        task.dstBlocksOrPixels = stripHeight * width;
+                    }
+                    job.tasks.push_back( task );
+                }
+            }
+        }
+    }
+
+    // Biggest images first, so the last tasks to finish are the small ones.
+    std::stable_sort( job.tasks.begin(), job.tasks.end(), []( const TranscodeTask& a, const TranscodeTask& b ) { return a.level < b.level; } );
+
+    std::atomic<bool> failed = false;
+    const auto transcodeTask = [&job, &failed]( size_t taskIdx ) {
+        if (!failed && !job.Transcode( job.tasks[taskIdx] ))
+            failed = true;
+    };
+    if (pWorker)
+        pWorker->ParallelFor( job.tasks.size(), transcodeTask );
+    else
+        for (size_t taskIdx = 0; taskIdx < job.tasks.size(); ++taskIdx)
+            transcodeTask( taskIdx );
+
+    if (failed)
+    {
+        LOGE( "Unable to transcode ktx2 texture (%ux%u, %u levels)", source.baseWidth, source.baseHeight, source.numLevels );
+        ktxTexture_Destroy( ktxTexture( pOutput ) );
+        return nullptr;
+    }
+    return pOutput;
+}
+
+//-----------------------------------------------------------------------------
+ktxTexture2* TranscodeKtx2Parallel( ktxTexture2& source, std::span<const uint8_t> sourceFileData, uint32_t transcodeFormat, ThreadWorker& worker )
+//-----------------------------------------------------------------------------
+{
+    if (worker.NumThreads() == 0)
+        return nullptr;
+    return TranscodeKtx2( source, sourceFileData, transcodeFormat, 0, &worker, cMinParallelBlocks );
+}
+
+//-----------------------------------------------------------------------------
+ktxTexture2* TranscodeKtx2Levels( ktxTexture2& source, std::span<const uint8_t> sourceFileData, uint32_t transcodeFormat, uint32_t firstLevel, ThreadWorker* pWorker )
+//-----------------------------------------------------------------------------
+{
+    return TranscodeKtx2( source, sourceFileData, transcodeFormat, firstLevel, pWorker, 0 );
+}
@@ -0,0 +1,36 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Forward declarations
+struct ktxTexture2;
+class ThreadWorker;
+
+/// @brief Transcode a Basis Universal (ETC1S or UASTC) ktx2 texture, spreading the work over the calling thread and the worker's threads.
+/// Each mip level, array layer and cubemap face is transcoded as a separate task (UASTC images are further split in to strips of block rows)
+/// directly in to its place in the returned texture's (upload ready) data.  The calling thread transcodes too, and only waits for tasks that have
+/// already started, so this is safe to call from one of the worker's own threads.
+/// @param source basis compressed ktx2 texture (image data is loaded, and UASTC zstd supercompression is inflated, if not already)
+/// @param sourceFileData contents of the ktx2 file source was created from (ETC1S global data and images are read directly from here)
+/// @param transcodeFormat ktx_transcode_fmt_e to transcode to (KTX_TTF_ETC and KTX_TTF_BC1_OR_3 are resolved by the texture's alpha)
+/// @return new transcoded texture (caller owns, destroy with ktxTexture_Destroy), nullptr if the texture is too small to be worth splitting or is not supported
+///         (video, unusual transcode format), in which case use ktxTexture2_TranscodeBasis.
+ktxTexture2* TranscodeKtx2Parallel( ktxTexture2& source, std::span<const uint8_t> sourceFileData, uint32_t transcodeFormat, ThreadWorker& worker );
+
+/// @brief Transcode just the mip levels from firstLevel down to the smallest mip level of a Basis Universal (ETC1S or UASTC) ktx2 texture, the more detailed levels are not transcoded.
+/// Used by mip streaming (the mip tail is transcoded when the texture is loaded, more detailed levels when they are streamed in).  Transcodes textures of any size.
+/// @param source basis compressed ktx2 texture (as TranscodeKtx2Parallel)
+/// @param sourceFileData contents of the ktx2 file source was created from
+/// @param transcodeFormat ktx_transcode_fmt_e to transcode to
+/// @param firstLevel most detailed mip level to transcode (becomes mip level 0 of the returned texture)
+/// @param pWorker (optional) worker whose threads help with the transcode, nullptr to transcode on the calling thread
+/// @return new transcoded texture (caller owns, destroy with ktxTexture_Destroy), nullptr if the texture is not supported (see TranscodeKtx2Parallel) or firstLevel is out of range.
+ktxTexture2* TranscodeKtx2Levels( ktxTexture2& source, std::span<const uint8_t> sourceFileData, uint32_t transcodeFormat, uint32_t firstLevel, ThreadWorker* pWorker );
@@ -9,7 +9,10 @@
 #include "vulkan/TextureFuncts.h"
 #include "texture/vulkan/texture.hpp"
 #include "loaderKtx.hpp"
+#include "ktxParallelTranscode.hpp"
 #include <ktxvulkan.h>  // KTX-Software
+#include <algorithm>
+#include <numeric>
 
 
 // Static
@@ -82,15 +85,62 @@ TextureKtxFileWrapper TextureKtx<Vulkan>::Transcode(TextureKtxFileWrapper&& file
     auto* const pKtxData = GetKtxTexture(fileData);
     if (pKtxData!=nullptr && ktxTexture_NeedsTranscoding(pKtxData) && pKtxData->classId == class_id::ktxTexture2_c)
     {
+        const uint32_t transcodeFormat = DetermineTranscodeOutputFormat();
+
+        // Use the previously transcoded texture from the transcode cache (if enabled).
+        const auto cacheKey = GetTranscodeCacheKey(fileData, transcodeFormat);
+        if (cacheKey)
+        {
+            auto cachedData = LoadTranscodedFromCache(*cacheKey);
+            if (cachedData)
+                return cachedData;
+        }
+
         auto pKtx2Data = (ktxTexture2* const)pKtxData;
-        if (KTX_SUCCESS != ktxTexture2_TranscodeBasis(pKtx2Data, (ktx_transcode_fmt_e) DetermineTranscodeOutputFormat(), (ktx_transcode_flag_bits_e)0))
+
+        // Large textures are split across the transcode worker's threads (returns nullptr for textures it does not handle).
+        ktxTexture2* pParallelTranscoded = nullptr;
+        if (GetTranscodeWorker() && !GetFileData(fileData).empty())
+            pParallelTranscoded = TranscodeKtx2Parallel(*pKtx2Data, GetFileData(fileData), transcodeFormat, *GetTranscodeWorker());
+        if (pParallelTranscoded)
+        {
+            fileData.Release();
+            fileData = WrapKtxTexture(ktxTexture(pParallelTranscoded));
+        }
+        else if (KTX_SUCCESS != ktxTexture2_TranscodeBasis(pKtx2Data, (ktx_transcode_fmt_e) transcodeFormat, (ktx_transcode_flag_bits_e)0))
         {
             return {};
         }
+        if (cacheKey)
+            StoreTranscodedInCache(*cacheKey, fileData);
     }
     return std::move(fileData);
 }
 
+TextureKtxFileWrapper TextureKtx<Vulkan>::TranscodeMipLevels(const TextureKtxFileWrapper& fileData, uint32_t firstLevel) const
+{
+    auto* const pKtxData = GetKtxTexture(fileData);
+    if (pKtxData == nullptr || !ktxTexture_NeedsTranscoding(pKtxData))
+        return ExtractMipLevels(fileData, firstLevel);
+    if (pKtxData->classId != class_id::ktxTexture2_c)
+        return {};
+
+    const uint32_t transcodeFormat = DetermineTranscodeOutputFormat();
+    ktxTexture2* pTranscoded = TranscodeKtx2Levels(*(ktxTexture2*)pKtxData, GetFileData(fileData), transcodeFormat, firstLevel, GetTranscodeWorker());
+    if (pTranscoded)
+        return WrapKtxTexture(ktxTexture(pTranscoded));
+
+    // Textures the level transcoder does not handle (eg video) are transcoded in full, from a copy so fileData stays untranscoded.
+    const auto sourceFileData = GetFileData(fileData);
+    ktxTexture2* pCopy = nullptr;
+    if (sourceFileData.empty() || KTX_SUCCESS != ktxTexture2_CreateFromMemory(sourceFileData.data(), sourceFileData.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &pCopy))
+        return {};
+    auto copyData = WrapKtxTexture(ktxTexture(pCopy));
+    if (KTX_SUCCESS != ktxTexture2_TranscodeBasis(pCopy, (ktx_transcode_fmt_e)transcodeFormat, (ktx_transcode_flag_bits_e)0))
+        return {};
+    return ExtractMipLevels(copyData, firstLevel);
+}
+
 TextureVulkan TextureKtx<Vulkan>::LoadKtx(Vulkan& vulkan, const TextureKtxFileWrapper& fileData, Sampler<Vulkan> sampler)
 {
     auto* const pKtxData = GetKtxTexture(fileData);
@@ -110,7 +160,7 @@ TextureVulkan TextureKtx<Vulkan>::LoadKtx(Vulkan& vulkan, const TextureKtxFileWr
     sUploadingTextureKtxVulkan = this;
     if (KTX_SUCCESS != ktxTexture_VkUploadEx(GetKtxTexture(fileData), m_VulkanDeviceInfo.get(), &uploadedTexture,
                                              VK_IMAGE_TILING_OPTIMAL,
-                                             VK_IMAGE_USAGE_SAMPLED_BIT,
+                                             VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,   // transfer src so textures can be packed (see TextureManager<Vulkan>::PackTextures)
                                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL))
     {
         return {};
@@ -136,12 +186,185 @@ TextureVulkan TextureKtx<Vulkan>::LoadKtx(Vulkan& vulkan, const TextureKtxFileWr
 
 TextureVulkan TextureKtx<Vulkan>::LoadKtx( Vulkan& vulkan, AssetManager& assetManager, const char* const pFileName, Sampler<Vulkan> sampler )
 {
-    auto ktxData = LoadFile( assetManager, pFileName );
+    auto ktxData = Transcode( LoadFile( assetManager, pFileName ) );
     if (!ktxData)
         return {};
     return LoadKtx( vulkan, ktxData, std::move(sampler) );
 }
 
+std::vector<TextureVulkan> TextureKtx<Vulkan>::LoadKtxBatch( Vulkan& vulkan, std::span<const TextureKtxFileWrapper* const> textureFiles, const Sampler<Vulkan>& sampler )
+{
+    std::vector<TextureVulkan> textures;
+    textures.resize( textureFiles.size() );
+
+    struct BatchedTexture
+    {
+        size_t                                  index;
+        ktxTexture2*                            pKtxData;
+        std::vector<VkBufferImageCopy>          regions;    ///< one per mip level
+        MemoryAllocatedBuffer<Vulkan, VkImage>  image;
+    };
+    std::vector<BatchedTexture> batchedTextures;
+    batchedTextures.reserve( textureFiles.size() );
+
+    // Lay out every mip level of every texture in one staging buffer.
+    VkDeviceSize stagingSize = 0;
+    for (size_t i = 0; i < textureFiles.size(); ++i)
+    {
+        auto* const pKtxData = textureFiles[i] ? GetKtxTexture( *textureFiles[i] ) : nullptr;
+        if (!pKtxData)
+            continue;
+        if (pKtxData->classId != class_id::ktxTexture2_c || ktxTexture_NeedsTranscoding( pKtxData ) || pKtxData->generateMipmaps || pKtxData->baseDepth > 1 || pKtxData->numDimensions > 2 ||
+            (pKtxData->pData == nullptr && KTX_SUCCESS != ktxTexture_LoadImageData( pKtxData, nullptr, 0 )))
+        {
+            textures[i] = LoadKtx( vulkan, *textureFiles[i], sampler.Copy() );
+            continue;
+        }
+
+        BatchedTexture& batched = batchedTextures.emplace_back( BatchedTexture{ i, (ktxTexture2*)pKtxData } );
+        // Copy offsets must be a multiple of the texel (block) size and of 4.
+        const VkDeviceSize alignment = std::lcm( VkDeviceSize( 16 ), VkDeviceSize( std::max( 1u, ktxTexture_GetElementSize( pKtxData ) ) ) );
+        for (uint32_t level = 0; level < pKtxData->numLevels; ++level)
+        {
+            stagingSize = (stagingSize + alignment - 1) / alignment * alignment;
+            VkBufferImageCopy& region = batched.regions.emplace_back();
+            region.bufferOffset = stagingSize;
+            region.bufferRowLength = 0;     // ktx2 level data is tightly packed
+            region.bufferImageHeight = 0;
+            region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, pKtxData->numLayers * pKtxData->numFaces };
+            region.imageOffset = { 0, 0, 0 };
+            region.imageExtent = { std::max( 1u, pKtxData->baseWidth >> level ), std::max( 1u, pKtxData->baseHeight >> level ), 1 };
+            stagingSize += VkDeviceSize( ktxTexture_GetImageSize( pKtxData, level ) ) * pKtxData->numLayers * pKtxData->numFaces;
+        }
+    }
+    if (batchedTextures.empty())
+        return textures;
+
+    auto& memoryManager = vulkan.GetMemoryManager();
+    auto stagingBuffer = memoryManager.CreateBuffer( (size_t) stagingSize, BufferUsageFlags::TransferSrc, MemoryUsage::CpuToGpu );
+    if (!stagingBuffer)
+    {
+        LOGE( "Unable to create staging buffer (%zu bytes) for texture batch upload", (size_t) stagingSize );
+        return textures;
+    }
+    {
+        auto stagingCpu = memoryManager.Map<uint8_t>( stagingBuffer );
+        for (const auto& batched : batchedTextures)
+        {
+            ktxTexture* const pKtxData = ktxTexture( batched.pKtxData );
+            for (const auto& region : batched.regions)
+            {
+                const uint32_t level = region.imageSubresource.mipLevel;
+                ktx_size_t srcOffset = 0;
+                ktxTexture_GetImageOffset( pKtxData, level, 0, 0, &srcOffset );
+                memcpy( stagingCpu.data() + region.bufferOffset, pKtxData->pData + srcOffset, size_t( ktxTexture_GetImageSize( pKtxData, level ) ) * pKtxData->numLayers * pKtxData->numFaces );
+            }
+        }
+        memoryManager.Unmap( stagingBuffer, std::move( stagingCpu ) );
+    }
+
+    // Create the images and record the copies (with a single barrier before and after all the copies).
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+    imageBarriers.reserve( batchedTextures.size() );
+    for (auto& batched : batchedTextures)
+    {
+        const ktxTexture* const pKtxData = ktxTexture( batched.pKtxData );
+        VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageInfo.flags = pKtxData->isCubemap ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        imageInfo.imageType = pKtxData->numDimensions == 1 ? VK_IMAGE_TYPE_1D : VK_IMAGE_TYPE_2D;
+        imageInfo.format = (VkFormat) batched.pKtxData->vkFormat;
+        imageInfo.extent = { pKtxData->baseWidth, pKtxData->baseHeight, 1 };
+        imageInfo.mipLevels = pKtxData->numLevels;
+        imageInfo.arrayLayers = pKtxData->numLayers * pKtxData->numFaces;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        batched.image = memoryManager.CreateImage( imageInfo, MemoryUsage::GpuExclusive );
+        if (!batched.image)
+        {
+            LOGE( "Unable to create image (%ux%u) for texture batch upload", pKtxData->baseWidth, pKtxData->baseHeight );
+            continue;
+        }
+
+        VkImageMemoryBarrier& barrier = imageBarriers.emplace_back( VkImageMemoryBarrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER } );
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = batched.image.GetVkBuffer();
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, imageInfo.mipLevels, 0, imageInfo.arrayLayers };
+    }
+
+    bool uploaded = false;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    if (!imageBarriers.empty() && vulkan.AllocateCommandBuffer( VK_COMMAND_BUFFER_LEVEL_PRIMARY, Vulkan::eGraphicsQueue, &cmdBuffer ))
+    {
+        VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (CheckVkError( "vkBeginCommandBuffer()", vkBeginCommandBuffer( cmdBuffer, &beginInfo ) ))
+        {
+            vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, (uint32_t) imageBarriers.size(), imageBarriers.data() );
+            for (const auto& batched : batchedTextures)
+            {
+                if (batched.image)
+                    vkCmdCopyBufferToImage( cmdBuffer, stagingBuffer.GetVkBuffer(), batched.image.GetVkBuffer(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t) batched.regions.size(), batched.regions.data() );
+            }
+            for (auto& barrier : imageBarriers)
+            {
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            }
+            vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, (uint32_t) imageBarriers.size(), imageBarriers.data() );
+
+            // Submit and wait on a fence (rather than waiting for the queue to go idle).
+            VkFenceCreateInfo fenceInfo{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+            VkFence fence = VK_NULL_HANDLE;
+            if (CheckVkError( "vkEndCommandBuffer()", vkEndCommandBuffer( cmdBuffer ) ) &&
+                CheckVkError( "vkCreateFence()", vkCreateFence( vulkan.m_VulkanDevice, &fenceInfo, nullptr, &fence ) ))
+            {
+                if (vulkan.QueueSubmit( cmdBuffer, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, Vulkan::eGraphicsQueue, fence ))
+                    uploaded = CheckVkError( "vkWaitForFences()", vkWaitForFences( vulkan.m_VulkanDevice, 1, &fence, VK_TRUE, UINT64_MAX ) );
+                vkDestroyFence( vulkan.m_VulkanDevice, fence, nullptr );
+            }
+        }
+        vulkan.FreeCommandBuffer( Vulkan::eGraphicsQueue, cmdBuffer );
+    }
+    memoryManager.Destroy( std::move( stagingBuffer ) );
+
+    for (auto& batched : batchedTextures)
+    {
+        if (!batched.image)
+            continue;
+        if (!uploaded)
+        {
+            memoryManager.Destroy( std::move( batched.image ) );
+            continue;
+        }
+        const ktxTexture* const pKtxData = ktxTexture( batched.pKtxData );
+        const uint32_t numFaces = pKtxData->numLayers * pKtxData->numFaces;
+        const ImageViewType viewType = pKtxData->numDimensions == 1 ? (pKtxData->isArray ? ImageViewType::View1DArray : ImageViewType::View1D)
+                                     : pKtxData->isCubemap ? (pKtxData->isArray ? ImageViewType::ViewCubeArray : ImageViewType::ViewCube)
+                                     : (pKtxData->isArray ? ImageViewType::View2DArray : ImageViewType::View2D);
+        const TextureFormat textureFormat = VkToTextureFormat( (VkFormat) batched.pKtxData->vkFormat );
+
+        Image<Vulkan> image{ std::move( batched.image ) };
+        auto imageView = CreateImageView( vulkan, image, textureFormat, pKtxData->numLevels, 0, numFaces, 0, viewType );
+        if (imageView.IsEmpty())
+        {
+            ReleaseImage( vulkan, &image );
+            continue;
+        }
+        textures[batched.index] = TextureVulkan{ pKtxData->baseWidth, pKtxData->baseHeight, 1, pKtxData->numLevels, 0, numFaces, 0, textureFormat, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VkClearValue{}, std::move( image ), sampler.Copy(), std::move( imageView ) };
+    }
+    return textures;
+}
+
 // Comparison functions so we can look for VkBuffer in a set of MemoryAllocatedBuffer<Vulkan, VkBuffer>
 static bool operator<(const MemoryAllocatedBuffer<Vulkan, VkBuffer>& a, const MemoryAllocatedBuffer<Vulkan, VkBuffer>& b) { return a.GetVkBuffer() < b.GetVkBuffer(); }
 static bool operator<(const VkBuffer& a, const MemoryAllocatedBuffer<Vulkan, VkBuffer>& b) { return a < b.GetVkBuffer(); }
@@ -15,7 +15,9 @@
 #include "texture.hpp"
 #include <volk/volk.h>
 #include <set>
+#include <span>
 #include <memory>
+#include <vector>
 
 // Forward declarations
 struct ktxVulkanDeviceInfo;
@@ -55,6 +57,13 @@ public:
     /// @returns a &TextureVulkan, will be empty on failure
     TextureVulkan LoadKtx(Vulkan& vulkan, AssetManager& assetManager, const char* const pFileName, Sampler<Vulkan> sampler);
 
+    /// @brief Upload a batch of (already transcoded) ktx textures using one staging buffer, one command buffer and one fence for the whole batch.
+    /// Textures that cannot be uploaded with a straight copy (ktx1, 3d or needing mip generation) are uploaded individually by LoadKtx.
+    /// @param textureFiles ktx file data to upload (null entries are skipped)
+    /// @param sampler sampler each loaded texture takes a copy of
+    /// @returns loaded textures (one per textureFiles entry), empty textures for failures
+    std::vector<TextureVulkan> LoadKtxBatch(Vulkan& vulkan, std::span<const TextureKtxFileWrapper* const> textureFiles, const Sampler<Vulkan>& sampler);
+
     /// @brief Run the Ktx2 transcoding step (if needed) 
     /// Will do nothing for textures that do not need transcoding.
     /// Performance will depend on ktx2 texture size and intermediate encoding format.
@@ -62,6 +71,13 @@ public:
     /// @return transcoded Ktx texture.
     TextureKtxFileWrapper Transcode(TextureKtxFileWrapper&& fileData);
 
+    /// @brief Transcode (if needed) only the mip levels from firstLevel down to the smallest mip level, without transcoding the more detailed levels.
+    /// Used by mip streaming, where the mip tail is all that is needed when the texture is loaded.  Does not use the transcode cache.
+    /// @param fileData ktx file data loaded by TextureKtx::LoadData or similar (left untranscoded, so can be used for other levels later)
+    /// @param firstLevel most detailed mip level wanted (becomes mip level 0 of the returned texture)
+    /// @return new texture containing the (transcoded) mip levels, empty on failure.
+    TextureKtxFileWrapper TranscodeMipLevels(const TextureKtxFileWrapper& fileData, uint32_t firstLevel) const;
+
 protected:
     // Callbacks to override the allocation/bind functions used by ktxTexture_VkUploadEx
     static VkResult VkAllocateMemory(VkDevice device, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks* pAllocator, VkDeviceMemory* pMemory);
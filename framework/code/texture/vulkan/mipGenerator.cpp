@@ -0,0 +1,342 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "mipGenerator.hpp"
+#include "texture.hpp"
+#include "vulkan/vulkan.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+/// Push constants for the compute downsample shader (see MipGenerator)
+struct MipGeneratorPushConstants
+{
+    uint32_t    srcLevel;
+    uint32_t    dstWidth;
+    uint32_t    dstHeight;
+};
+
+//-----------------------------------------------------------------------------
+uint32_t CalcNumMipLevels( uint32_t width, uint32_t height )
+//-----------------------------------------------------------------------------
+{
+    return std::max( 1u, (uint32_t) std::bit_width( std::max( width, height ) ) );
+}
+
+//-----------------------------------------------------------------------------
+bool CanGenerateMipsWithBlit( Vulkan& vulkan, TextureFormat format )
+//-----------------------------------------------------------------------------
+{
+    constexpr VkFormatFeatureFlags cRequiredFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    const VkFormatProperties& formatProperties = vulkan.GetFormatProperties( TextureFormatToVk( format ) );
+    return (formatProperties.optimalTilingFeatures & cRequiredFeatures) == cRequiredFeatures;
+}
+
+//-----------------------------------------------------------------------------
+void RecordGenerateMipsBlit( VkCommandBuffer cmdBuffer, VkImage image, uint32_t width, uint32_t height, uint32_t numLayers, uint32_t numMipLevels, VkImageLayout mip0Layout, VkImageLayout finalLayout )
+//-----------------------------------------------------------------------------
+{
+    VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, numLayers };
+
+    // Mip 0 becomes the first blit source, the other mips are blit destinations (previous contents discarded).
+    std::array<VkImageMemoryBarrier, 2> startBarriers{ barrier, barrier };
+    startBarriers[0].srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    startBarriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    startBarriers[0].oldLayout = mip0Layout;
+    startBarriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    startBarriers[1].srcAccessMask = 0;
+    startBarriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    startBarriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    startBarriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    startBarriers[1].subresourceRange.baseMipLevel = 1;
+    startBarriers[1].subresourceRange.levelCount = numMipLevels - 1;
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, numMipLevels > 1 ? 2 : 1, startBarriers.data() );
+
+    for (uint32_t level = 1; level < numMipLevels; ++level)
+    {
+        VkImageBlit blit{};
+        blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, numLayers };
+        blit.srcOffsets[1] = { int32_t( std::max( 1u, width >> (level - 1) ) ), int32_t( std::max( 1u, height >> (level - 1) ) ), 1 };
+        blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, numLayers };
+        blit.dstOffsets[1] = { int32_t( std::max( 1u, width >> level ) ), int32_t( std::max( 1u, height >> level ) ), 1 };
+        vkCmdBlitImage( cmdBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR );
+
+        // This level is the source for the next.
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.subresourceRange.baseMipLevel = level;
+        vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+    }
+
+    // Every level is now a transfer source.
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout = finalLayout;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = numMipLevels;
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+}
+
+//-----------------------------------------------------------------------------
+MipGenerator::~MipGenerator()
+//-----------------------------------------------------------------------------
+{
+    Release();
+}
+
+//-----------------------------------------------------------------------------
+bool MipGenerator::Init( Vulkan& vulkan, std::span<const uint32_t> downsampleShaderSpirv )
+//-----------------------------------------------------------------------------
+{
+    m_pVulkan = &vulkan;
+    if (downsampleShaderSpirv.empty())
+        return true;    // blit only
+
+    const VkDevice device = vulkan.m_VulkanDevice;
+
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    binding.descriptorCount = cMaxMipLevels;
+    binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    descriptorSetLayoutInfo.bindingCount = 1;
+    descriptorSetLayoutInfo.pBindings = &binding;
+    if (!CheckVkError( "vkCreateDescriptorSetLayout()", vkCreateDescriptorSetLayout( device, &descriptorSetLayoutInfo, nullptr, &m_DescriptorSetLayout ) ))
+        return false;
+
+    VkPushConstantRange pushConstantRange{ VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( MipGeneratorPushConstants ) };
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    if (!CheckVkError( "vkCreatePipelineLayout()", vkCreatePipelineLayout( device, &pipelineLayoutInfo, nullptr, &m_PipelineLayout ) ))
+        return false;
+
+    VkShaderModuleCreateInfo shaderModuleInfo{ VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    shaderModuleInfo.codeSize = downsampleShaderSpirv.size_bytes();
+    shaderModuleInfo.pCode = downsampleShaderSpirv.data();
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    if (!CheckVkError( "vkCreateShaderModule()", vkCreateShaderModule( device, &shaderModuleInfo, nullptr, &shaderModule ) ))
+        return false;
+    const bool pipelineCreated = vulkan.CreateComputePipeline( vulkan.GetPipelineCache(), m_PipelineLayout, shaderModule, nullptr, &m_ComputePipeline );
+    vkDestroyShaderModule( device, shaderModule, nullptr );
+    if (!pipelineCreated)
+        return false;
+
+    VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, cMaxPendingGenerations * cMaxMipLevels };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets = cMaxPendingGenerations;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    return CheckVkError( "vkCreateDescriptorPool()", vkCreateDescriptorPool( device, &poolInfo, nullptr, &m_DescriptorPool ) );
+}
+
+//-----------------------------------------------------------------------------
+void MipGenerator::Release()
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan)
+        return;
+    ReleaseCompleted();
+
+    const VkDevice device = m_pVulkan->m_VulkanDevice;
+    if (m_DescriptorPool != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool( device, m_DescriptorPool, nullptr );
+    if (m_ComputePipeline != VK_NULL_HANDLE)
+        vkDestroyPipeline( device, m_ComputePipeline, nullptr );
+    if (m_PipelineLayout != VK_NULL_HANDLE)
+        vkDestroyPipelineLayout( device, m_PipelineLayout, nullptr );
+    if (m_DescriptorSetLayout != VK_NULL_HANDLE)
+        vkDestroyDescriptorSetLayout( device, m_DescriptorSetLayout, nullptr );
+    m_DescriptorPool = VK_NULL_HANDLE;
+    m_ComputePipeline = VK_NULL_HANDLE;
+    m_PipelineLayout = VK_NULL_HANDLE;
+    m_DescriptorSetLayout = VK_NULL_HANDLE;
+    m_pVulkan = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool MipGenerator::CanGenerateMips( TextureFormat format ) const
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan)
+        return false;
+    if (CanGenerateMipsWithBlit( *m_pVulkan, format ))
+        return true;
+    const VkFormatProperties& formatProperties = m_pVulkan->GetFormatProperties( TextureFormatToVk( format ) );
+    return m_ComputePipeline != VK_NULL_HANDLE && (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+}
+
+//-----------------------------------------------------------------------------
+bool MipGenerator::RecordGenerateMips( VkCommandBuffer cmdBuffer, const Texture<Vulkan>& texture )
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan || texture.Depth > 1 || texture.FirstMip != 0)
+    {
+        LOGE( "MipGenerator: unable to generate mips (only supports 2d textures, from mip level 0)" );
+        return false;
+    }
+    if (texture.MipLevels <= 1)
+        return true;
+
+    if (CanGenerateMipsWithBlit( *m_pVulkan, texture.Format ))
+    {
+        RecordGenerateMipsBlit( cmdBuffer, texture.GetVkImage(), texture.Width, texture.Height, texture.Faces, texture.MipLevels, texture.ImageLayout, texture.ImageLayout );
+        return true;
+    }
+    return RecordGenerateMipsCompute( cmdBuffer, texture );
+}
+
+//-----------------------------------------------------------------------------
+bool MipGenerator::RecordGenerateMipsCompute( VkCommandBuffer cmdBuffer, const Texture<Vulkan>& texture )
+//-----------------------------------------------------------------------------
+{
+    if (!CanGenerateMips( texture.Format ) || texture.Faces != 1 || texture.MipLevels > cMaxMipLevels)
+    {
+        LOGE( "MipGenerator: unable to generate mips for texture format %d (no downsample shader, format not usable as a storage image, or texture is an array)", (int) texture.Format );
+        return false;
+    }
+    if (m_PendingGenerations.size() >= cMaxPendingGenerations)
+    {
+        LOGE( "MipGenerator: too many pending mip generations (call ReleaseCompleted)" );
+        return false;
+    }
+    const VkDevice device = m_pVulkan->m_VulkanDevice;
+
+    PendingGeneration& pending = m_PendingGenerations.emplace_back();
+    VkDescriptorSetAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocateInfo.descriptorPool = m_DescriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+    if (!CheckVkError( "vkAllocateDescriptorSets()", vkAllocateDescriptorSets( device, &allocateInfo, &pending.descriptorSet ) ))
+    {
+        m_PendingGenerations.pop_back();
+        return false;
+    }
+
+    // One view per mip level (unused descriptor array elements point at the last level)
+    std::array<VkDescriptorImageInfo, cMaxMipLevels> imageInfos{};
+    VkImageViewCreateInfo viewInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    viewInfo.image = texture.GetVkImage();
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = TextureFormatToVk( texture.Format );
+    for (uint32_t level = 0; level < cMaxMipLevels; ++level)
+    {
+        if (level < texture.MipLevels)
+        {
+            viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+            VkImageView imageView = VK_NULL_HANDLE;
+            if (!CheckVkError( "vkCreateImageView()", vkCreateImageView( device, &viewInfo, nullptr, &imageView ) ))
+            {
+                for (VkImageView createdView : pending.imageViews)
+                    vkDestroyImageView( device, createdView, nullptr );
+                vkFreeDescriptorSets( device, m_DescriptorPool, 1, &pending.descriptorSet );
+                m_PendingGenerations.pop_back();
+                return false;
+            }
+            pending.imageViews.push_back( imageView );
+        }
+        imageInfos[level] = { VK_NULL_HANDLE, pending.imageViews.back(), VK_IMAGE_LAYOUT_GENERAL };
+    }
+    VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = pending.descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = cMaxMipLevels;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    write.pImageInfo = imageInfos.data();
+    vkUpdateDescriptorSets( device, 1, &write, 0, nullptr );
+
+    VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture.GetVkImage();
+    std::array<VkImageMemoryBarrier, 2> startBarriers{ barrier, barrier };
+    startBarriers[0].srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    startBarriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    startBarriers[0].oldLayout = texture.ImageLayout;
+    startBarriers[0].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    startBarriers[0].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    startBarriers[1].srcAccessMask = 0;
+    startBarriers[1].dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    startBarriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    startBarriers[1].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    startBarriers[1].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 1, texture.MipLevels - 1, 0, 1 };
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, (uint32_t) startBarriers.size(), startBarriers.data() );
+
+    vkCmdBindPipeline( cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_ComputePipeline );
+    vkCmdBindDescriptorSets( cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, 0, 1, &pending.descriptorSet, 0, nullptr );
+    for (uint32_t level = 1; level < texture.MipLevels; ++level)
+    {
+        const MipGeneratorPushConstants pushConstants{ level - 1, std::max( 1u, texture.Width >> level ), std::max( 1u, texture.Height >> level ) };
+        vkCmdPushConstants( cmdBuffer, m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( pushConstants ), &pushConstants );
+        vkCmdDispatch( cmdBuffer, (pushConstants.dstWidth + 7) / 8, (pushConstants.dstHeight + 7) / 8, 1 );
+
+        // Next level reads what this level wrote.
+        VkMemoryBarrier memoryBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr );
+    }
+
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.newLayout = texture.ImageLayout;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, texture.MipLevels, 0, 1 };
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool MipGenerator::GenerateMips( const Texture<Vulkan>& texture )
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan)
+        return false;
+    const size_t numPending = m_PendingGenerations.size();
+    VkCommandBuffer setupCmdBuffer = m_pVulkan->StartSetupCommandBuffer();
+    const bool success = RecordGenerateMips( setupCmdBuffer, texture );
+    m_pVulkan->FinishSetupCommandBuffer( setupCmdBuffer );
+
+    // Setup command buffer has completed, release what it used (but not generations recorded in to other command buffers).
+    const VkDevice device = m_pVulkan->m_VulkanDevice;
+    for (size_t i = numPending; i < m_PendingGenerations.size(); ++i)
+    {
+        for (VkImageView imageView : m_PendingGenerations[i].imageViews)
+            vkDestroyImageView( device, imageView, nullptr );
+        vkFreeDescriptorSets( device, m_DescriptorPool, 1, &m_PendingGenerations[i].descriptorSet );
+    }
+    m_PendingGenerations.resize( numPending );
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+void MipGenerator::ReleaseCompleted()
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan)
+        return;
+    const VkDevice device = m_pVulkan->m_VulkanDevice;
+    for (auto& pending : m_PendingGenerations)
+    {
+        for (VkImageView imageView : pending.imageViews)
+            vkDestroyImageView( device, imageView, nullptr );
+        vkFreeDescriptorSets( device, m_DescriptorPool, 1, &pending.descriptorSet );
+    }
+    m_PendingGenerations.clear();
+}
@@ -0,0 +1,92 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <volk/volk.h>
+#include "../textureFormat.hpp"
+
+// Forward declarations
+class Vulkan;
+template<typename T_GFXAPI> class Texture;
+
+///
+/// Gpu generation of texture mip chains (for textures created at runtime, which only have their most detailed mip level filled in)
+///
+
+/// @return number of mip levels in a full mip chain for a texture of the given size
+uint32_t CalcNumMipLevels( uint32_t width, uint32_t height );
+
+/// @return true if mip levels of the given format can be generated with (linearly filtered) vkCmdBlitImage
+bool CanGenerateMipsWithBlit( Vulkan& vulkan, TextureFormat format );
+
+/// Record mip chain generation (each level a linearly filtered vkCmdBlitImage of the previous) in to a command buffer.
+/// Mip level 0 must already be filled in.  Image must have been created with TRANSFER_SRC and TRANSFER_DST usage.
+/// @param image 2d image (all array layers are generated)
+/// @param mip0Layout current layout of mip level 0 (other mip levels are assumed to be undefined)
+/// @param finalLayout layout all mip levels are left in
+void RecordGenerateMipsBlit( VkCommandBuffer cmdBuffer, VkImage image, uint32_t width, uint32_t height, uint32_t numLayers, uint32_t numMipLevels, VkImageLayout mip0Layout, VkImageLayout finalLayout );
+
+/// @brief Generate mip chains, with vkCmdBlitImage where the format supports linear filtered blits, otherwise with a compute shader.
+///
+/// The compute path needs an application supplied downsample shader (compiled spir-v), with the interface:
+/// @code
+///     layout(local_size_x = 8, local_size_y = 8) in;
+///     layout(set = 0, binding = 0, rgba8) uniform image2D Mips[MipGenerator::cMaxMipLevels];     // format qualifier to suit the textures (or use shaderStorageImageReadWithoutFormat)
+///     layout(push_constant) uniform Params { uint SrcLevel; uint DstWidth; uint DstHeight; };
+///     // write Mips[SrcLevel + 1] (DstWidth x DstHeight) from a 2x2 box filter of Mips[SrcLevel]
+/// @endcode
+/// The shader is dispatched once per mip level (with a barrier between levels), textures using the compute path need STORAGE usage.
+/// Descriptor sets and image views used by recorded compute generation are kept until ReleaseCompleted is called.
+class MipGenerator
+{
+    MipGenerator( const MipGenerator& ) = delete;
+    MipGenerator& operator=( const MipGenerator& ) = delete;
+public:
+    static constexpr uint32_t cMaxMipLevels = 14;   ///< largest compute generated texture is 8192x8192
+    static constexpr uint32_t cMaxPendingGenerations = 64;
+
+    MipGenerator() = default;
+    ~MipGenerator();
+
+    /// @param downsampleShaderSpirv compute shader for formats that cannot be blitted (may be empty, in which case only blittable formats are supported)
+    bool Init( Vulkan& vulkan, std::span<const uint32_t> downsampleShaderSpirv = {} );
+    void Release();
+
+    /// @return true if mip chains for textures of the given format can be generated (by blit or compute)
+    bool CanGenerateMips( TextureFormat format ) const;
+
+    /// Record generation of the texture's mip chain (all texture.MipLevels, from texture.FirstMip) in to cmdBuffer.
+    /// Mip level 0 of the texture must be in texture.ImageLayout (the whole texture is left in that layout).
+    bool RecordGenerateMips( VkCommandBuffer cmdBuffer, const Texture<Vulkan>& texture );
+
+    /// Generate the texture's mip chain now (on a setup command buffer, waits for completion).
+    bool GenerateMips( const Texture<Vulkan>& texture );
+
+    /// Release resources used by recorded (compute) mip generation.  Call once the command buffers passed to RecordGenerateMips have completed execution.
+    void ReleaseCompleted();
+
+protected:
+    bool RecordGenerateMipsCompute( VkCommandBuffer cmdBuffer, const Texture<Vulkan>& texture );
+
+    /// Resources that must outlive the command buffer a compute generation was recorded in to
+    struct PendingGeneration
+    {
+        VkDescriptorSet             descriptorSet = VK_NULL_HANDLE;
+        std::vector<VkImageView>    imageViews;
+    };
+
+    Vulkan*                         m_pVulkan = nullptr;
+    VkDescriptorSetLayout           m_DescriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout                m_PipelineLayout = VK_NULL_HANDLE;
+    VkPipeline                      m_ComputePipeline = VK_NULL_HANDLE;     ///< null if no downsample shader
+    VkDescriptorPool                m_DescriptorPool = VK_NULL_HANDLE;
+    std::vector<PendingGeneration>  m_PendingGenerations;
+};
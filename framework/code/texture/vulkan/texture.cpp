@@ -7,6 +7,7 @@
 
 #include "memory/vulkan/memoryMapped.hpp"
 #include "texture.hpp"
+#include "mipGenerator.hpp"
 #include "vulkan/vulkan.hpp"
 #include <cstring>
 
@@ -785,7 +786,7 @@ Texture<Vulkan> CreateTextureObjectView( Vulkan& vulkan, const Texture<Vulkan>&
 
 //-----------------------------------------------------------------------------
 template<>
-Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName )
+Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName, bool GenerateMips )
 //-----------------------------------------------------------------------------
 {
     if (pName == nullptr)
@@ -801,6 +802,19 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
     VkImageUsageFlags FinalUsage = ( VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT );
     VkImageLayout FinalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
+    // Buffer only contains the top mip, the rest of the chain (if requested) is generated on the gpu once it is copied in.
+    uint32_t FinalMipLevels = 1;
+    if (GenerateMips)
+    {
+        if (Depth == 1 && CanGenerateMipsWithBlit( vulkan, Format ))
+        {
+            FinalMipLevels = CalcNumMipLevels( Width, Height );
+            FinalUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
+        else
+            LOGW( "CreateTextureFromBuffer: Unable to generate mips for texture format %d (not blittable), texture will only have 1 mip level", (int) Format );
+    }
+
     // Image creation info.  Will change below based on need
     VkImageCreateInfo ImageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
     ImageInfo.flags = 0;
@@ -940,7 +954,7 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
     ImageInfo.imageType = Depth == 1 ? VK_IMAGE_TYPE_2D : VK_IMAGE_TYPE_3D;
 
     // Now that we are done creating single images, need to create all mip levels
-    ImageInfo.mipLevels = MipLevels;
+    ImageInfo.mipLevels = FinalMipLevels;
 
     // Setup texture as blit target with optimal tiling
     ImageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -967,7 +981,7 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
     VkPipelineStageFlags srcMask = 0;
     VkPipelineStageFlags dstMask = 1;
     uint32_t baseMipLevel = 0;
-    uint32_t mipLevelCount = MipLevels;
+    uint32_t mipLevelCount = FinalMipLevels;
     uint32_t baseLayer = 0;
     uint32_t layerCount = Faces;
 
@@ -1032,17 +1046,25 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
     srcMask = 0;
     dstMask = 1;
     baseMipLevel = 0;
-    mipLevelCount = MipLevels;
+    mipLevelCount = FinalMipLevels;
     baseLayer = 0;
     layerCount = Faces;
 
-    vulkan.SetImageLayout( FinalVmaImage.GetVkBuffer(), SetupCmdBuffer, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, FinalLayout,
-        srcMask,
-        dstMask,
-        baseMipLevel,
-        mipLevelCount,
-        baseLayer,
-        layerCount );
+    if (FinalMipLevels > 1)
+    {
+        // Generate the remaining mips from the (just copied) top level, leaves every mip in FinalLayout
+        RecordGenerateMipsBlit( SetupCmdBuffer, FinalVmaImage.GetVkBuffer(), Width, Height, Faces, FinalMipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, FinalLayout );
+    }
+    else
+    {
+        vulkan.SetImageLayout( FinalVmaImage.GetVkBuffer(), SetupCmdBuffer, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, FinalLayout,
+            srcMask,
+            dstMask,
+            baseMipLevel,
+            mipLevelCount,
+            baseLayer,
+            layerCount );
+    }
 
     // Submit the command buffer we have been working on
     vulkan.FinishSetupCommandBuffer( SetupCmdBuffer );
@@ -1064,7 +1086,7 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
         viewType = ImageViewType::ViewCube;
     else
         viewType = ImageViewType::View2D;
-    ImageViewVulkan imageView = CreateImageView( vulkan, Image, Format, MipLevels, baseMipLevel, layerCount, baseLayer, viewType );
+    ImageViewVulkan imageView = CreateImageView( vulkan, Image, Format, FinalMipLevels, baseMipLevel, layerCount, baseLayer, viewType );
     if (imageView.IsEmpty())
     {
         ReleaseSampler(vulkan, &sampler);
@@ -1072,7 +1094,7 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
     }
 
     // Set the return values
-    return { Width, Height, Depth, MipLevels, 0/*firstmip*/, Faces, 0/*firstface*/, Format, FinalLayout, ClearValue, std::move(Image), std::move(sampler), std::move(imageView)};
+    return { Width, Height, Depth, FinalMipLevels, 0/*firstmip*/, Faces, 0/*firstface*/, Format, FinalLayout, ClearValue, std::move(Image), std::move(sampler), std::move(imageView)};
 }
 
 //-----------------------------------------------------------------------------
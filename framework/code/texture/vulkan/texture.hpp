@@ -166,7 +166,7 @@ Texture<Vulkan> CreateTextureObject<Vulkan>( Vulkan&, const CreateTexObjectInfo&
 
 /// Template specialization for Vulkan CreateTextureFromBuffer
 template<>
-Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan&, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName );
+Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan&, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName, bool GenerateMips );
 
 /// Create a texture that views (aliases) another texture but using a different texture format (must be 'related' formats, which formats are related is dependant on graphics api)
 template<>
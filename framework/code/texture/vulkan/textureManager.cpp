@@ -10,6 +10,12 @@
 #include "../loaderPpm.hpp"
 #include "vulkan/vulkan.hpp"
 #include "memory/memory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <utility>
 
 
 //-----------------------------------------------------------------------------
@@ -50,6 +56,34 @@ bool TextureManager<Vulkan>::Initialize()
 void TextureManager<Vulkan>::Release()
 //-----------------------------------------------------------------------------
 {
+    if (!m_AsyncLoadSlots.empty())
+    {
+        // Async loads (on the worker threads) use the loader, and queue their results in m_FinishedAsyncLoads
+        m_LoadingThreadWorker.FinishAllWork();
+        m_FinishedAsyncLoads.clear();
+        m_AsyncLoadSlots.clear();
+    }
+
+    if (m_MipStreamingEnabled)
+    {
+        // Streaming loads (on the worker threads) use the loader, and queue their results in m_StreamedMipLoads
+        m_LoadingThreadWorker.FinishAllWork();
+        m_StreamedMipLoads.clear();
+        m_StreamedTextures.clear();
+        for (auto& [frame, texture] : m_StreamingReleaseQueue)
+            texture.Release(&m_GfxApi);
+        m_StreamingReleaseQueue.clear();
+        m_StreamingChangedTextures.clear();
+        m_StreamingResidentBytes = 0;
+        m_MipStreamingEnabled = false;
+    }
+
+    m_PackedTextureLocations.clear();
+    m_NumPackedTextures = 0;
+    m_TextureContentHashes.clear();
+    m_SharedImageTextures.clear();
+    m_ContentDeduplicationStats = {};
+
     for (auto& [key, texture] : m_LoadedTextures)
     {
         texture.Release(&m_GfxApi);
@@ -81,34 +115,110 @@ const TextureBase* TextureManager<Vulkan>::GetOrLoadTexture_(const std::string&
 //-----------------------------------------------------------------------------
 {
     const TextureBase* pTexture = GetTexture(textureSlotName);
-    if (!pTexture)
+    if (pTexture)
+        return pTexture;
+
+    const SamplerVulkan& samplerVulkan = static_cast<const SamplerVulkan&>(sampler);
+    auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(GetLoader());
+    auto fileData = pKtxLoader->LoadFile(m_AssetManager, filename.c_str());
+
+    // Files with the same contents as an already loaded texture share its image (no need to transcode or upload)
+    std::optional<TextureContentHash> contentHash;
+    if (fileData && IsContentDeduplicationActive())
     {
-        const SamplerVulkan& samplerVulkan = static_cast<const SamplerVulkan&>(sampler);
-        auto loadedTexture = GetLoader()->LoadKtx(m_GfxApi, m_AssetManager, filename.c_str(), std::move(samplerVulkan.Copy()));
-        if (!loadedTexture.IsEmpty())
-        {
-            auto insertedIt = m_LoadedTextures.insert({ textureSlotName, std::move(loadedTexture) });
-            pTexture = &(insertedIt.first->second);
-        }
+        contentHash = pKtxLoader->HashFileData(fileData);
+        const Texture* pOriginal = contentHash ? FindContentDuplicate(*contentHash) : nullptr;
+        if (pOriginal)
+            return AddSharedTexture(textureSlotName, *pOriginal, samplerVulkan, m_TextureContentHashes[*contentHash].dataBytes);
     }
 
+    // Streamed textures only transcode (and upload) their mip tail.
+    StreamedTexture streamedTexture;
+    const bool streamed = fileData && m_MipStreamingEnabled && PrepareMipTail(fileData, filename, streamedTexture);
+    auto ktxData = streamed ? TextureKtxFileWrapper{} : pKtxLoader->Transcode(std::move(fileData));
+    if (!streamed && !ktxData)
+        return nullptr;
+
+    auto loadedTexture = pKtxLoader->LoadKtx(m_GfxApi, streamed ? streamedTexture.mipTail : ktxData, std::move(samplerVulkan.Copy()));
+    if (!loadedTexture.IsEmpty())
+    {
+        auto insertedIt = m_LoadedTextures.insert({ textureSlotName, std::move(loadedTexture) });
+        if (streamed)
+            AddStreamedTexture(insertedIt.first->second, std::move(streamedTexture));
+        else if (contentHash)
+            m_TextureContentHashes.insert_or_assign(*contentHash, ContentHashEntry{ textureSlotName, ktxData.GetDataSize() });
+        pTexture = &(insertedIt.first->second);
+    }
     return pTexture;
 }
 
+//-----------------------------------------------------------------------------
+const TextureManager<Vulkan>::Texture* TextureManager<Vulkan>::FindContentDuplicate( const TextureContentHash& contentHash ) const
+//-----------------------------------------------------------------------------
+{
+    auto hashIt = m_TextureContentHashes.find(contentHash);
+    if (hashIt == m_TextureContentHashes.end())
+        return nullptr;
+    // Original may have been removed (eg packed)
+    auto textureIt = m_LoadedTextures.find(hashIt->second.slotName);
+    return (textureIt == m_LoadedTextures.end()) ? nullptr : &textureIt->second;
+}
+
+//-----------------------------------------------------------------------------
+const TextureBase* TextureManager<Vulkan>::AddSharedTexture( const std::string& textureSlotName, const Texture& original, const Sampler& sampler, uint64_t dataBytes )
+//-----------------------------------------------------------------------------
+{
+    auto imageView = CreateImageView(m_GfxApi, original.Image, original.Format, original.MipLevels, original.FirstMip, original.Faces, original.FirstFace, original.ImageView.GetImageViewType());
+    if (imageView.IsEmpty())
+        return nullptr;
+
+    // Image is not owned by the shared texture (same as CreateTextureObjectView)
+    auto insertedIt = m_LoadedTextures.try_emplace(textureSlotName, original.Width, original.Height, original.Depth, original.MipLevels, original.FirstMip, original.Faces, original.FirstFace, original.Format,
+                                                   original.GetVkImageLayout(), original.GetVkClearValue(), original.GetVkImage(), VK_NULL_HANDLE, sampler.Copy(), std::move(imageView));
+    if (!insertedIt.second)
+        return &insertedIt.first->second;
+    m_SharedImageTextures.insert(&original);
+    m_SharedImageTextures.insert(&insertedIt.first->second);
+    ++m_ContentDeduplicationStats.numDuplicates;
+    m_ContentDeduplicationStats.bytesSaved += dataBytes;
+    return &insertedIt.first->second;
+}
+
 typedef std::queue<std::pair<size_t, TextureKtxFileWrapper>> tLoadedFileQueue;
-struct BatchLoadThreadParams {
-    AssetManager& assetManager;
-    std::mutex& loadedFileQueueMutex;
-    tLoadedFileQueue& loadedFileQueue;
-    Semaphore& dataReadySema;
-    const std::string& filename;
-    size_t slotIndex;;
+
+/// Time spent in each phase of BatchLoad (microseconds, summed over all the threads doing that phase)
+struct BatchLoadTimings {
+    std::atomic<int64_t> fileIoUs = 0;
+    std::atomic<int64_t> transcodeUs = 0;
+    std::atomic<int64_t> uploadUs = 0;
+    std::atomic<uint32_t> uploadBatches = 0;
+};
+
+static int64_t MicrosecondsSince(std::chrono::steady_clock::time_point startTime)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/// Content deduplication state for one BatchLoad (slots indexed by position in slotAndFileNames)
+struct BatchContentDedup {
+    std::mutex mutex;
+    std::unordered_map<TextureContentHash, size_t, TextureContentHash::Hasher> firstSlotIndex;  ///< first slot in this batch loaded with each content hash (protected by mutex)
+    std::vector<std::optional<TextureContentHash>> contentHashes;
+    std::vector<uint8_t> isDuplicate;                           ///< slot duplicates an already loaded texture, or an earlier slot in this batch
+    std::vector<uint64_t> dataBytes;
 };
 
 //-----------------------------------------------------------------------------
 void TextureManager<Vulkan>::BatchLoad(const std::span<std::pair<std::string/*textureSlotName*/, std::string/*filename*/>> slotAndFileNames, const SamplerBase& defaultSampler)
 //-----------------------------------------------------------------------------
 {
+    // Loaded textures are uploaded in batches (one staging buffer and command buffer per batch), a batch is whatever has finished loading (up to these limits).
+    static constexpr size_t cMaxTexturesPerUpload = 32;
+    static constexpr size_t cMaxBytesPerUpload = 64 * 1024 * 1024;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    BatchLoadTimings timings;
+
     std::mutex loadedFileQueueMutex;
     tLoadedFileQueue loadedFileQueue;
     Semaphore dataReadySema{ 0 };
@@ -117,66 +227,150 @@ void TextureManager<Vulkan>::BatchLoad(const std::span<std::pair<std::string/*te
     // Setup the output textures
     std::vector<Texture> vulkanTextures;
     vulkanTextures.resize(slotAndFileNames.size());
+    std::vector<StreamedTexture> streamedTextures;
+    if (m_MipStreamingEnabled)
+        streamedTextures.resize(slotAndFileNames.size());
 
-    // We have one worker job just grabbing loaded textures and transfering them to vulkan (gpu memory).
+    size_t texturesToLoad = 0;
+    for (const auto& [textureSlotName, filename] : slotAndFileNames)
+    {
+        if (m_LoadedTextures.find(textureSlotName) == m_LoadedTextures.end())
+            ++texturesToLoad;
+    }
+
+    BatchContentDedup contentDedup;
+    const bool deduplicate = IsContentDeduplicationActive();
+    if (deduplicate)
+    {
+        contentDedup.contentHashes.resize(slotAndFileNames.size());
+        contentDedup.isDuplicate.resize(slotAndFileNames.size(), 0);
+        contentDedup.dataBytes.resize(slotAndFileNames.size(), 0);
+    }
+    const uint32_t numDuplicatesAtStart = m_ContentDeduplicationStats.numDuplicates;
+    const uint64_t bytesSavedAtStart = m_ContentDeduplicationStats.bytesSaved;
+
+    // We have one worker job grabbing batches of loaded textures and transfering them to vulkan (gpu memory).
     struct TransferWorkerParams {
         std::mutex& loadedFileQueueMutex;
         tLoadedFileQueue& loadedFileQueue;
         Semaphore& dataReadySema;
         Semaphore& finishedSema;
+        BatchLoadTimings& timings;
         const SamplerVulkan& defaultSampler;
         std::vector<Texture>& vulkanTextures;
-    } transferWorkerParams{ loadedFileQueueMutex, loadedFileQueue, dataReadySema, finishedSema, apiCast<Vulkan>(defaultSampler), vulkanTextures };
+        std::vector<StreamedTexture>& streamedTextures;     // empty if not streaming
+        const std::span<std::pair<std::string, std::string>> slotAndFileNames;
+        size_t texturesToLoad;
+    } transferWorkerParams{ loadedFileQueueMutex, loadedFileQueue, dataReadySema, finishedSema, timings, apiCast<Vulkan>(defaultSampler), vulkanTextures, streamedTextures, slotAndFileNames, texturesToLoad };
 
     m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, TransferWorkerParams params)
     {
-        size_t texturesRemaining = params.vulkanTextures.size();
+        auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(pThis->GetLoader());
+        std::vector<std::pair<size_t, TextureKtxFileWrapper>> batch;
+        std::vector<const TextureKtxFileWrapper*> batchUploads;
+
+        size_t texturesRemaining = params.texturesToLoad;
         while (texturesRemaining > 0)
         {
-            TextureKtxFileWrapper ktxData;
-            size_t slotIndex;
+            // Wait for at least one texture, then take everything else that has finished loading (one Post per queued texture).
             params.dataReadySema.Wait();
+            size_t batchBytes = 0;
             {
                 std::lock_guard<std::mutex> lock(params.loadedFileQueueMutex);
-                auto&& loadedData = params.loadedFileQueue.front();
-                ktxData = std::move(loadedData.second);
-                slotIndex = loadedData.first;
-                params.loadedFileQueue.pop();
+                do
+                {
+                    auto&& loadedData = params.loadedFileQueue.front();
+                    batchBytes += loadedData.second ? loadedData.second.GetDataSize() : 0;
+                    batch.emplace_back(loadedData.first, std::move(loadedData.second));
+                    params.loadedFileQueue.pop();
+                } while (!params.loadedFileQueue.empty() && batch.size() < cMaxTexturesPerUpload && batchBytes < cMaxBytesPerUpload);
             }
-            if (ktxData)
-                params.vulkanTextures[slotIndex] = pThis->GetLoader()->LoadKtx(pThis->m_GfxApi, ktxData, std::move(params.defaultSampler.Copy()) );
-            --texturesRemaining;
+            for (size_t i = 1; i < batch.size(); ++i)
+                params.dataReadySema.Wait();    // already posted (or about to be)
+            texturesRemaining -= batch.size();
+
+            const auto uploadStartTime = std::chrono::steady_clock::now();
+            for (auto& [slotIndex, ktxData] : batch)
+            {
+                // Streamed textures only upload their mip tail (prepared by the loading thread)
+                if (!params.streamedTextures.empty() && params.streamedTextures[slotIndex].mipTail)
+                    batchUploads.push_back(&params.streamedTextures[slotIndex].mipTail);
+                else
+                    batchUploads.push_back(ktxData ? &ktxData : nullptr);
+            }
+            auto uploadedTextures = pKtxLoader->LoadKtxBatch(pThis->m_GfxApi, batchUploads, params.defaultSampler);
+            for (size_t i = 0; i < batch.size(); ++i)
+                params.vulkanTextures[batch[i].first] = std::move(uploadedTextures[i]);
+            params.timings.uploadUs += MicrosecondsSince(uploadStartTime);
+            ++params.timings.uploadBatches;
+
+            batch.clear();
+            batchUploads.clear();
         }
         params.finishedSema.Post();
 
     }, this, transferWorkerParams);
 
-    size_t currentSlotIndex = 0;
-    for (const auto& [textureSlotName, filename] : slotAndFileNames)
+    // Each texture is loaded (and transcoded) by its own worker job.
+    struct BatchLoadThreadParams {
+        AssetManager& assetManager;
+        std::mutex& loadedFileQueueMutex;
+        tLoadedFileQueue& loadedFileQueue;
+        Semaphore& dataReadySema;
+        BatchLoadTimings& timings;
+        BatchContentDedup* pContentDedup;   // null if not deduplicating
+        StreamedTexture* pStreamedTexture;  // null if not streaming
+        const std::string& filename;
+        size_t slotIndex;
+    };
+
+    for (size_t slotIndex = 0; slotIndex < slotAndFileNames.size(); ++slotIndex)
     {
-        auto iter = m_LoadedTextures.find(textureSlotName);
-        if (iter == m_LoadedTextures.end())
+        const auto& [textureSlotName, filename] = slotAndFileNames[slotIndex];
+        if (m_LoadedTextures.find(textureSlotName) == m_LoadedTextures.end())
         {
-            BatchLoadThreadParams params{ m_AssetManager, loadedFileQueueMutex, loadedFileQueue, dataReadySema, filename, currentSlotIndex };
+            BatchLoadThreadParams params{ m_AssetManager, loadedFileQueueMutex, loadedFileQueue, dataReadySema, timings, deduplicate ? &contentDedup : nullptr, streamedTextures.empty() ? nullptr : &streamedTextures[slotIndex], filename, slotIndex };
 
             m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, BatchLoadThreadParams params)
             {
+                auto phaseStartTime = std::chrono::steady_clock::now();
                 auto ktxData = pThis->m_Loader->LoadFile(params.assetManager, params.filename.c_str());
+                params.timings.fileIoUs += MicrosecondsSince(phaseStartTime);
+
+                // Duplicates (of textures already loaded, or earlier in this batch) are not transcoded or uploaded, they share the original's image once the batch is loaded.
+                // m_TextureContentHashes and m_LoadedTextures are not modified until the batch is finished.
+                auto* pContentDedup = params.pContentDedup;
+                if (ktxData && pContentDedup)
+                {
+                    const auto contentHash = pThis->GetLoader()->HashFileData(ktxData);
+                    pContentDedup->contentHashes[params.slotIndex] = contentHash;
+                    if (contentHash)
+                    {
+                        std::lock_guard<std::mutex> lock(pContentDedup->mutex);
+                        if (pThis->FindContentDuplicate(*contentHash) || !pContentDedup->firstSlotIndex.try_emplace(*contentHash, params.slotIndex).second)
+                        {
+                            pContentDedup->isDuplicate[params.slotIndex] = 1;
+                            ktxData.Release();
+                        }
+                    }
+                }
+
+                phaseStartTime = std::chrono::steady_clock::now();
                 auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(pThis->GetLoader());
-                ktxData = pKtxLoader->Transcode(std::move(ktxData));
+                // Streamed textures only transcode their mip tail (uploaded from pStreamedTexture->mipTail), others are transcoded in full.
+                if (ktxData && params.pStreamedTexture && pThis->PrepareMipTail(ktxData, params.filename, *params.pStreamedTexture))
+                    ktxData.Release();
+                else if (ktxData)
+                    ktxData = pKtxLoader->Transcode(std::move(ktxData));
+                if (ktxData && pContentDedup)
+                    pContentDedup->dataBytes[params.slotIndex] = ktxData.GetDataSize();
+                params.timings.transcodeUs += MicrosecondsSince(phaseStartTime);
                 {
                     std::lock_guard<std::mutex> lock(params.loadedFileQueueMutex);
                     params.loadedFileQueue.emplace(std::pair{ params.slotIndex, std::move(ktxData) });
                 }
                 params.dataReadySema.Post();
             }, this, params);
-
-            ++currentSlotIndex;
-        }
-        else
-        {
-            // Signal the transfer thread, but dont give it any data (it finishes when it has recieved a signal for every texture being BatchLoaded)
-            dataReadySema.Post();
         }
     }
 
@@ -187,9 +381,106 @@ void TextureManager<Vulkan>::BatchLoad(const std::span<std::pair<std::string/*te
     {
         if (!vulkanTextures[i].IsEmpty())
         {
-            m_LoadedTextures.emplace(std::pair<std::string, Texture>{ slotAndFileNames[i].first/*slot*/, std::move(vulkanTextures[i])});
+            auto insertedIt = m_LoadedTextures.emplace(std::pair<std::string, Texture>{ slotAndFileNames[i].first/*slot*/, std::move(vulkanTextures[i])});
+            if (!streamedTextures.empty() && streamedTextures[i].mipTail && insertedIt.second)
+                AddStreamedTexture(insertedIt.first->second, std::move(streamedTextures[i]));
+            else if (deduplicate && contentDedup.contentHashes[i] && insertedIt.second)
+                m_TextureContentHashes.insert_or_assign(*contentDedup.contentHashes[i], ContentHashEntry{ slotAndFileNames[i].first, contentDedup.dataBytes[i] });
         }
     }
+
+    // Duplicates share the image of their (now loaded) original, with the default sampler.
+    for (size_t i = 0; deduplicate && i < slotAndFileNames.size(); ++i)
+    {
+        if (!contentDedup.isDuplicate[i])
+            continue;
+        const TextureContentHash& contentHash = *contentDedup.contentHashes[i];
+        const Texture* pOriginal = FindContentDuplicate(contentHash);
+        if (!pOriginal || !AddSharedTexture(slotAndFileNames[i].first, *pOriginal, apiCast<Vulkan>(defaultSampler), m_TextureContentHashes[contentHash].dataBytes))
+            LOGE("Unable to load texture: %s (duplicate of a texture that failed to load)", slotAndFileNames[i].second.c_str());
+    }
+
+    LOGI("BatchLoad: %zu textures in %.1fms (file io %.1fms and transcode %.1fms summed over %u loader threads, gpu upload %.1fms in %u batches)",
+         texturesToLoad, MicrosecondsSince(startTime) / 1000.0f,
+         timings.fileIoUs / 1000.0f, timings.transcodeUs / 1000.0f, m_LoadingThreadWorker.NumThreads(),
+         timings.uploadUs / 1000.0f, timings.uploadBatches.load());
+    if (deduplicate)
+        LOGI("BatchLoad: %u duplicate textures (%.1fMB not loaded)", m_ContentDeduplicationStats.numDuplicates - numDuplicatesAtStart, (m_ContentDeduplicationStats.bytesSaved - bytesSavedAtStart) / (1024.0f * 1024.0f));
+}
+
+//-----------------------------------------------------------------------------
+bool TextureManager<Vulkan>::LoadTextureAsync_( const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler ) /*override*/
+//-----------------------------------------------------------------------------
+{
+    if (!m_AsyncLoadSlots.insert(textureSlotName).second)
+        return true;    // already loading
+
+    // Streaming and deduplication are decided when the load starts (worker threads do not read the settings)
+    const bool streamed = m_MipStreamingEnabled;
+    const bool deduplicate = IsContentDeduplicationActive();
+
+    m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, std::string textureSlotName, std::string filename, const Sampler* pSampler, bool streamed, bool deduplicate)
+    {
+        auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(pThis->GetLoader());
+        auto fileData = pKtxLoader->LoadFile(pThis->m_AssetManager, filename.c_str());
+
+        // Duplicates are found when the texture is uploaded (m_LoadedTextures belongs to the rendering thread), so are still transcoded here.
+        AsyncTextureLoad asyncLoad{ std::move(textureSlotName), pSampler };
+        if (fileData && deduplicate)
+            asyncLoad.contentHash = pKtxLoader->HashFileData(fileData);
+        if (fileData && streamed && pThis->PrepareMipTail(fileData, filename, asyncLoad.streamedTexture))
+            fileData.Release();
+        else if (fileData)
+            asyncLoad.ktxData = pKtxLoader->Transcode(std::move(fileData));
+        {
+            std::lock_guard<std::mutex> lock(pThis->m_AsyncLoadsMutex);
+            pThis->m_FinishedAsyncLoads.push_back(std::move(asyncLoad));
+        }
+    }, this, textureSlotName, filename, &static_cast<const Sampler&>(sampler), streamed, deduplicate);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<std::string> TextureManager<Vulkan>::UpdateAsyncLoads( uint32_t maxTextures ) /*override*/
+//-----------------------------------------------------------------------------
+{
+    std::vector<std::string> finishedSlotNames;
+    while (finishedSlotNames.size() < maxTextures)
+    {
+        AsyncTextureLoad asyncLoad;
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncLoadsMutex);
+            if (m_FinishedAsyncLoads.empty())
+                break;
+            asyncLoad = std::move(m_FinishedAsyncLoads.front());
+            m_FinishedAsyncLoads.pop_front();
+        }
+        m_AsyncLoadSlots.erase(asyncLoad.slotName);
+        finishedSlotNames.push_back(asyncLoad.slotName);
+        if (GetTexture(asyncLoad.slotName))
+            continue;   // loaded some other way (eg GetOrLoadTexture) while this load was in flight
+
+        const Texture* pOriginal = asyncLoad.contentHash ? FindContentDuplicate(*asyncLoad.contentHash) : nullptr;
+        if (pOriginal)
+        {
+            AddSharedTexture(asyncLoad.slotName, *pOriginal, *asyncLoad.pSampler, m_TextureContentHashes[*asyncLoad.contentHash].dataBytes);
+            continue;
+        }
+
+        const bool streamed = bool(asyncLoad.streamedTexture.mipTail);
+        if (!streamed && !asyncLoad.ktxData)
+            continue;
+        auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(GetLoader());
+        auto loadedTexture = pKtxLoader->LoadKtx(m_GfxApi, streamed ? asyncLoad.streamedTexture.mipTail : asyncLoad.ktxData, std::move(asyncLoad.pSampler->Copy()));
+        if (loadedTexture.IsEmpty())
+            continue;
+        auto insertedIt = m_LoadedTextures.insert({ asyncLoad.slotName, std::move(loadedTexture) });
+        if (streamed)
+            AddStreamedTexture(insertedIt.first->second, std::move(asyncLoad.streamedTexture));
+        else if (asyncLoad.contentHash)
+            m_TextureContentHashes.insert_or_assign(*asyncLoad.contentHash, ContentHashEntry{ asyncLoad.slotName, asyncLoad.ktxData.GetDataSize() });
+    }
+    return finishedSlotNames;
 }
 
 //-----------------------------------------------------------------------------
@@ -210,10 +501,10 @@ const TextureBase* TextureManager<Vulkan>::CreateTextureObject( const CreateTexO
 }
 
 //-----------------------------------------------------------------------------
-const TextureBase* TextureManager<Vulkan>::CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name )
+const TextureBase* TextureManager<Vulkan>::CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name, bool generateMips )
 //-----------------------------------------------------------------------------
 {
-    auto texture = ::CreateTextureFromBuffer( m_GfxApi, pData, DataSize, Width, Height, Depth, Format, SamplerMode, Filter, name.c_str() );
+    auto texture = ::CreateTextureFromBuffer( m_GfxApi, pData, DataSize, Width, Height, Depth, Format, SamplerMode, Filter, name.c_str(), generateMips );
 
     assert( name.empty() ); // must have a valid name
     auto it = m_LoadedTextures.try_emplace( name, std::move(texture) );
@@ -242,3 +533,393 @@ const TextureBase* TextureManager<Vulkan>::CreateTextureObjectView( const Textur
     else
         return &it.first->second;
 }
+
+//-----------------------------------------------------------------------------
+uint64_t TextureManager<Vulkan>::StreamedTexture::GetResidentBytes(uint32_t firstLevel) const
+//-----------------------------------------------------------------------------
+{
+    firstLevel = std::min(firstLevel, (uint32_t)mipLevelBytes.size());
+    return std::accumulate(mipLevelBytes.begin() + firstLevel, mipLevelBytes.end(), uint64_t(0));
+}
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::EnableMipStreaming( const MipStreamingSettings& settings )
+//-----------------------------------------------------------------------------
+{
+    m_MipStreamingSettings = settings;
+    m_MipStreamingSettings.residentMaxDimension = std::max(1u, settings.residentMaxDimension);
+    m_MipStreamingSettings.maxUploadsPerUpdate = std::max(1u, settings.maxUploadsPerUpdate);
+    m_StreamingChangedTextures.resize(NUM_VULKAN_BUFFERS);
+    m_MipStreamingEnabled = true;
+}
+
+//-----------------------------------------------------------------------------
+bool TextureManager<Vulkan>::PrepareMipTail( const TextureKtxFileWrapper& fileData, const std::string& filename, StreamedTexture& streamedTexture ) const
+//-----------------------------------------------------------------------------
+{
+    auto* pKtxLoader = static_cast<const TextureKtx<Vulkan>*>(GetLoader());
+    const auto mipLevels = pKtxLoader->GetMipLevels(fileData);     // dimensions only (not transcoded yet)
+
+    // First mip level that is always resident.  Textures that are small (or do not have small enough mips to fall back to) are not streamed.
+    const auto mipTailIt = std::find_if(mipLevels.begin(), mipLevels.end(), [this](const TextureKtxMipLevel& mipLevel) {
+        return std::max(mipLevel.width, mipLevel.height) <= m_MipStreamingSettings.residentMaxDimension;
+    });
+    if (mipTailIt == mipLevels.begin() || mipTailIt == mipLevels.end())
+        return false;
+    const uint32_t mipTailFirstLevel = (uint32_t)std::distance(mipLevels.begin(), mipTailIt);
+
+    // Only the mip tail is transcoded, more detailed levels are transcoded when they are streamed in.
+    auto mipTail = pKtxLoader->TranscodeMipLevels(fileData, mipTailFirstLevel);
+    if (!mipTail)
+        return false;
+    const auto transcodedMipLevels = pKtxLoader->GetMipLevels(fileData, mipTail);
+    if (transcodedMipLevels.size() != mipLevels.size())
+        return false;
+
+    streamedTexture.filename = filename;
+    streamedTexture.mipTail = std::move(mipTail);
+    streamedTexture.mipLevelBytes.clear();
+    for (const auto& mipLevel : transcodedMipLevels)
+        streamedTexture.mipLevelBytes.push_back(mipLevel.sizeBytes);
+    streamedTexture.mipTailFirstLevel = mipTailFirstLevel;
+    streamedTexture.residentFirstLevel = mipTailFirstLevel;
+    streamedTexture.requestedFirstLevel = 0;
+    streamedTexture.loadInFlight = false;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::AddStreamedTexture( Texture& texture, StreamedTexture&& streamedTexture )
+//-----------------------------------------------------------------------------
+{
+    streamedTexture.pTexture = &texture;
+    streamedTexture.lastRequestedFrame = m_StreamingFrame;
+    m_StreamingResidentBytes += streamedTexture.GetResidentBytes(streamedTexture.residentFirstLevel);
+    m_StreamedTextures.emplace(&texture, std::move(streamedTexture));
+}
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::RequestMips( const TextureBase& texture, uint32_t mostDetailedMip )
+//-----------------------------------------------------------------------------
+{
+    auto it = m_StreamedTextures.find(&texture);
+    if (it == m_StreamedTextures.end())
+        return;
+    StreamedTexture& streamedTexture = it->second;
+    streamedTexture.requestedFirstLevel = std::min(mostDetailedMip, streamedTexture.mipTailFirstLevel);
+    streamedTexture.lastRequestedFrame = m_StreamingFrame;
+}
+
+//-----------------------------------------------------------------------------
+bool TextureManager<Vulkan>::ReplaceStreamedMips( StreamedTexture& streamedTexture, const TextureKtxFileWrapper& mipLevels, uint32_t firstLevel )
+//-----------------------------------------------------------------------------
+{
+    Texture& texture = *streamedTexture.pTexture;
+    auto newTexture = GetLoader()->LoadKtx(m_GfxApi, mipLevels, std::move(texture.Sampler.Copy()));
+    if (newTexture.IsEmpty())
+    {
+        LOGE("Unable to upload mip level %u of streamed texture: %s", firstLevel, streamedTexture.filename.c_str());
+        return false;
+    }
+
+    m_StreamingResidentBytes -= streamedTexture.GetResidentBytes(streamedTexture.residentFirstLevel);
+    m_StreamingResidentBytes += streamedTexture.GetResidentBytes(firstLevel);
+    streamedTexture.residentFirstLevel = firstLevel;
+
+    // Swap in the new image (texture address does not change), the old one may still be referenced by frames in flight.
+    m_StreamingReleaseQueue.emplace_back(m_StreamingFrame, std::move(texture));
+    texture = std::move(newTexture);
+
+    for (auto& changedTextures : m_StreamingChangedTextures)
+    {
+        if (std::find(changedTextures.begin(), changedTextures.end(), &texture) == changedTextures.end())
+            changedTextures.push_back(&texture);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool TextureManager<Vulkan>::MakeStreamingBudget( uint64_t additionalBytes, uint32_t lastRequestedFrame )
+//-----------------------------------------------------------------------------
+{
+    const uint64_t budgetBytes = m_MipStreamingSettings.budgetBytes;
+    if (budgetBytes == 0)
+        return true;
+
+    while (m_StreamingResidentBytes + additionalBytes > budgetBytes)
+    {
+        // Evict the streamed mips of the least recently requested texture (that has streamed mips resident)
+        StreamedTexture* pEvict = nullptr;
+        for (auto& [pTexture, streamedTexture] : m_StreamedTextures)
+        {
+            if (streamedTexture.residentFirstLevel < streamedTexture.mipTailFirstLevel && streamedTexture.lastRequestedFrame < lastRequestedFrame &&
+                (pEvict == nullptr || streamedTexture.lastRequestedFrame < pEvict->lastRequestedFrame))
+                pEvict = &streamedTexture;
+        }
+        if (pEvict == nullptr || !ReplaceStreamedMips(*pEvict, pEvict->mipTail, pEvict->mipTailFirstLevel))
+            return false;
+        // Do not stream back in until requested again.
+        pEvict->requestedFirstLevel = pEvict->mipTailFirstLevel;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<const TextureBase*> TextureManager<Vulkan>::UpdateMipStreaming( uint32_t bufferIdx )
+//-----------------------------------------------------------------------------
+{
+    if (!m_MipStreamingEnabled)
+        return {};
+    ++m_StreamingFrame;
+
+    // Release replaced textures once every frame (and descriptor set) that may have been using them is done.
+    auto releaseEndIt = std::find_if(m_StreamingReleaseQueue.begin(), m_StreamingReleaseQueue.end(), [this](const auto& release) {
+        return release.first + NUM_VULKAN_BUFFERS >= m_StreamingFrame;
+    });
+    for (auto it = m_StreamingReleaseQueue.begin(); it != releaseEndIt; ++it)
+        it->second.Release(&m_GfxApi);
+    m_StreamingReleaseQueue.erase(m_StreamingReleaseQueue.begin(), releaseEndIt);
+
+    // Upload mip levels that the worker threads have finished loading.
+    for (uint32_t numUploads = 0; numUploads < m_MipStreamingSettings.maxUploadsPerUpdate;)
+    {
+        StreamedMipLoad mipLoad;
+        {
+            std::lock_guard<std::mutex> lock(m_StreamedMipLoadsMutex);
+            if (m_StreamedMipLoads.empty())
+                break;
+            mipLoad = std::move(m_StreamedMipLoads.front());
+            m_StreamedMipLoads.pop_front();
+        }
+        auto it = m_StreamedTextures.find(mipLoad.pTexture);
+        if (it == m_StreamedTextures.end())
+            continue;
+        StreamedTexture& streamedTexture = it->second;
+        streamedTexture.loadInFlight = false;
+
+        // Skip loads that failed, or that are no longer wanted (requested mips changed while loading)
+        if (!mipLoad.mipLevels || mipLoad.firstLevel >= streamedTexture.residentFirstLevel || mipLoad.firstLevel < streamedTexture.requestedFirstLevel)
+            continue;
+
+        const uint64_t additionalBytes = streamedTexture.GetResidentBytes(mipLoad.firstLevel) - streamedTexture.GetResidentBytes(streamedTexture.residentFirstLevel);
+        if (!MakeStreamingBudget(additionalBytes, streamedTexture.lastRequestedFrame))
+        {
+            // No room, stop trying until requested again.
+            streamedTexture.requestedFirstLevel = streamedTexture.residentFirstLevel;
+            continue;
+        }
+        if (ReplaceStreamedMips(streamedTexture, mipLoad.mipLevels, mipLoad.firstLevel))
+            ++numUploads;
+    }
+
+    // Start loading requested mip levels (on the worker threads).
+    for (auto& [pTexture, streamedTexture] : m_StreamedTextures)
+    {
+        if (streamedTexture.loadInFlight || streamedTexture.requestedFirstLevel >= streamedTexture.residentFirstLevel)
+            continue;
+        streamedTexture.loadInFlight = true;
+
+        m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, const TextureBase* pTexture, std::string filename, uint32_t firstLevel)
+        {
+            // Only the requested levels (and the less detailed levels below them, which the new image also needs) are transcoded.
+            auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(pThis->GetLoader());
+            auto fileData = pKtxLoader->LoadFile(pThis->m_AssetManager, filename.c_str());
+            StreamedMipLoad mipLoad{ pTexture, firstLevel, fileData ? pKtxLoader->TranscodeMipLevels(fileData, firstLevel) : TextureKtxFileWrapper{} };
+            {
+                std::lock_guard<std::mutex> lock(pThis->m_StreamedMipLoadsMutex);
+                pThis->m_StreamedMipLoads.push_back(std::move(mipLoad));
+            }
+        }, this, pTexture, streamedTexture.filename, streamedTexture.requestedFirstLevel);
+    }
+
+    if (bufferIdx >= m_StreamingChangedTextures.size())
+        return {};
+    return std::exchange(m_StreamingChangedTextures[bufferIdx], {});
+}
+
+//-----------------------------------------------------------------------------
+bool TextureManager<Vulkan>::PackTextures( const TexturePackLayout& layout, bool releaseSources )
+//-----------------------------------------------------------------------------
+{
+    auto& memoryManager = m_GfxApi.GetMemoryManager();
+
+    struct Packing
+    {
+        const TexturePackLayout::PackedTexture* pPackedTexture = nullptr;
+        uint32_t                                packedTextureIndex = 0;
+        std::vector<Texture*>                   sources;        ///< one per region
+        MemoryAllocatedBuffer<Vulkan, VkImage>  image;
+    };
+    std::vector<Packing> packings;
+    packings.reserve( layout.packedTextures.size() );
+
+    bool success = true;
+    for (uint32_t packedTextureIndex = 0; packedTextureIndex < (uint32_t) layout.packedTextures.size(); ++packedTextureIndex)
+    {
+        const auto& packedTexture = layout.packedTextures[packedTextureIndex];
+        Packing packing{ &packedTexture, packedTextureIndex };
+
+        // Check the sources can be copied as planned.
+        for (const auto& region : packedTexture.regions)
+        {
+            auto it = m_LoadedTextures.find( region.slotName );
+            Texture* pSource = (it == m_LoadedTextures.end()) ? nullptr : &it->second;
+            if (pSource == nullptr || pSource->Format != packedTexture.format || pSource->Width != region.width || pSource->Height != region.height || pSource->Depth != 1 ||
+                pSource->Faces != 1 || pSource->MipLevels < packedTexture.mipLevels || pSource->ImageLayout != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL || m_StreamedTextures.contains( pSource ) || m_SharedImageTextures.contains( pSource ))
+            {
+                LOGE( "Unable to pack texture: %s (missing, streamed, sharing its image or does not match the packing layout)", region.slotName.c_str() );
+                packing.sources.clear();
+                break;
+            }
+            packing.sources.push_back( pSource );
+        }
+        if (packing.sources.empty())
+        {
+            success = false;
+            continue;
+        }
+
+        VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = TextureFormatToVk( packedTexture.format );
+        imageInfo.extent = { packedTexture.width, packedTexture.height, 1 };
+        imageInfo.mipLevels = packedTexture.mipLevels;
+        imageInfo.arrayLayers = packedTexture.layers;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        packing.image = memoryManager.CreateImage( imageInfo, MemoryUsage::GpuExclusive );
+        if (!packing.image)
+        {
+            LOGE( "Unable to create packed texture image (%ux%u, %u layers)", packedTexture.width, packedTexture.height, packedTexture.layers );
+            success = false;
+            continue;
+        }
+        packings.push_back( std::move( packing ) );
+    }
+    if (packings.empty())
+        return success;
+
+    // Barriers to get the packed images in to transfer dst and the sources in to transfer src (and back again after the copies)
+    std::vector<VkImageMemoryBarrier> dstBarriers;
+    std::vector<VkImageMemoryBarrier> srcBarriers;
+    for (const auto& packing : packings)
+    {
+        VkImageMemoryBarrier& dstBarrier = dstBarriers.emplace_back( VkImageMemoryBarrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER } );
+        dstBarrier.srcAccessMask = 0;
+        dstBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        dstBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        dstBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        dstBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        dstBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        dstBarrier.image = packing.image.GetVkBuffer();
+        dstBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, packing.pPackedTexture->mipLevels, 0, packing.pPackedTexture->layers };
+
+        for (const Texture* pSource : packing.sources)
+        {
+            VkImageMemoryBarrier& srcBarrier = srcBarriers.emplace_back( VkImageMemoryBarrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER } );
+            srcBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            srcBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            srcBarrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            srcBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            srcBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            srcBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            srcBarrier.image = pSource->GetVkImage();
+            srcBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, pSource->MipLevels, 0, 1 };
+        }
+    }
+
+    VkCommandBuffer cmdBuffer = m_GfxApi.StartSetupCommandBuffer();
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, (uint32_t) srcBarriers.size(), srcBarriers.data() );
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, (uint32_t) dstBarriers.size(), dstBarriers.data() );
+
+    std::vector<VkImageCopy> copyRegions;
+    for (const auto& packing : packings)
+    {
+        const auto& packedTexture = *packing.pPackedTexture;
+        for (size_t regionIdx = 0; regionIdx < packedTexture.regions.size(); ++regionIdx)
+        {
+            const auto& region = packedTexture.regions[regionIdx];
+            // Atlas regions are power of 2 sized and aligned, so each mip level maps to the same region at half the size.
+            copyRegions.clear();
+            for (uint32_t level = 0; level < packedTexture.mipLevels; ++level)
+            {
+                VkImageCopy& copyRegion = copyRegions.emplace_back();
+                copyRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+                copyRegion.srcOffset = { 0, 0, 0 };
+                copyRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, region.layer, 1 };
+                copyRegion.dstOffset = { int32_t( region.x >> level ), int32_t( region.y >> level ), 0 };
+                copyRegion.extent = { std::max( region.width >> level, 1u ), std::max( region.height >> level, 1u ), 1 };
+            }
+            vkCmdCopyImage( cmdBuffer, packing.sources[regionIdx]->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, packing.image.GetVkBuffer(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t) copyRegions.size(), copyRegions.data() );
+        }
+    }
+
+    for (auto& barrier : dstBarriers)
+    {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+    for (auto& barrier : srcBarriers)
+    {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+    dstBarriers.insert( dstBarriers.end(), srcBarriers.begin(), srcBarriers.end() );
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, (uint32_t) dstBarriers.size(), dstBarriers.data() );
+    m_GfxApi.FinishSetupCommandBuffer( cmdBuffer );
+
+    // Create the packed textures (views) and record where each source went.
+    for (auto& packing : packings)
+    {
+        const auto& packedTexture = *packing.pPackedTexture;
+        Image<Vulkan> image{ std::move( packing.image ) };
+        auto imageView = CreateImageView( m_GfxApi, image, packedTexture.format, packedTexture.mipLevels, 0, packedTexture.layers, 0, packedTexture.isAtlas ? ImageViewType::View2D : ImageViewType::View2DArray );
+        if (imageView.IsEmpty())
+        {
+            LOGE( "Unable to create packed texture image view" );
+            ReleaseImage( m_GfxApi, &image );
+            success = false;
+            continue;
+        }
+
+        const std::string packedName = "_packed" + std::to_string( m_NumPackedTextures++ );
+        auto [packedIt, inserted] = m_LoadedTextures.try_emplace( packedName, packedTexture.width, packedTexture.height, 1, packedTexture.mipLevels, 0, packedTexture.layers, 0, packedTexture.format,
+                                                                   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VkClearValue{}, std::move( image ), packing.sources[0]->Sampler.Copy(), std::move( imageView ) );
+        assert( inserted );
+        const TextureBase* pPackedTexture = &packedIt->second;
+
+        for (const auto& region : packedTexture.regions)
+        {
+            auto locationIt = layout.locations.find( region.slotName );
+            const TexturePackLocation location = (locationIt != layout.locations.end()) ? locationIt->second : TexturePackLocation{ packing.packedTextureIndex, region.layer };
+            m_PackedTextureLocations.insert_or_assign( region.slotName, std::pair{ pPackedTexture, location } );
+
+            if (releaseSources)
+            {
+                auto sourceIt = m_LoadedTextures.find( region.slotName );
+                sourceIt->second.Release( &m_GfxApi );
+                m_LoadedTextures.erase( sourceIt );
+            }
+        }
+    }
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+const TextureBase* TextureManager<Vulkan>::GetPackedTexture( const std::string& textureSlotName, TexturePackLocation* pLocation ) const
+//-----------------------------------------------------------------------------
+{
+    auto it = m_PackedTextureLocations.find( textureSlotName );
+    if (it == m_PackedTextureLocations.end())
+        return nullptr;
+    if (pLocation)
+        *pLocation = it->second.second;
+    return it->second.first;
+}
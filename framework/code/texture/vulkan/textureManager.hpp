@@ -7,7 +7,15 @@
 #pragma once
 
 #include "../textureManager.hpp"
+#include "../loaderKtx.hpp"
+#include "../texturePacker.hpp"
+#include <deque>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // Forward declarations
 class Vulkan;
@@ -50,7 +58,7 @@ public:
 
     /// Create texture from a block of texture data in memory (with correct format, span etc).
     /// Implements the base class virtual function.
-    const TextureBase* CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name ) override;
+    const TextureBase* CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name, bool generateMips = false ) override;
 
     /// Create a texture that views (aliases) another texture but using a different texture format (must be 'related' formats, which formats are related is dependant on graphics api)
     /// Implements the base class virtual function.
@@ -59,13 +67,165 @@ public:
     /// Get a 'default' sampler for the given address mode (all other sampler settings assumed to be 'normal' ie linearly sampled etc)
     const SamplerBase* const GetSampler( SamplerAddressMode ) const override;
 
+    /// Settings for mip streaming (see EnableMipStreaming)
+    struct MipStreamingSettings
+    {
+        uint32_t    residentMaxDimension = 128;     ///< mip levels no larger than this (the 'mip tail') are uploaded when the texture is loaded, larger mip levels are streamed in afterwards
+        uint64_t    budgetBytes = 0;                ///< gpu memory budget for streamed textures (0 = unlimited).  When over budget the least recently requested textures drop back to their mip tail.
+        uint32_t    maxUploadsPerUpdate = 2;        ///< maximum number of streamed textures uploaded to the gpu by each call to UpdateMipStreaming
+    };
+
+    /// Enable mip streaming for textures loaded after this call.
+    /// Only the mip tail of a streamed (ktx2) texture is uploaded when it is loaded, the more detailed mip levels are loaded (and transcoded) on
+    /// the loading worker threads and uploaded by UpdateMipStreaming.  Until then the texture's image (and view) start at the most detailed resident
+    /// mip level (and Width/Height are the dimensions of that level).
+    /// Streamed textures request all their mip levels when loaded, use RequestMips to change this.
+    /// Textures that are not ktx2, are 3d or are already no larger than residentMaxDimension are loaded as normal.
+    void EnableMipStreaming( const MipStreamingSettings& settings );
+
+    /// Request the mip levels of a streamed texture that should be resident (does nothing for textures that are not streamed).
+    /// Also marks the texture as recently used (least recently requested textures are evicted first when over the streaming budget).
+    /// @param texture texture returned by GetOrLoadTexture (or BatchLoad)
+    /// @param mostDetailedMip most detailed mip level wanted (0 is the full resolution texture)
+    void RequestMips( const TextureBase& texture, uint32_t mostDetailedMip = 0 );
+
+    /// Upload streamed mip levels that have finished loading, evict mip levels when over budget, and start loading newly requested mip levels.
+    /// Call once per frame (from the rendering thread) before updating descriptor sets for this frame's bufferIdx.
+    /// Streamed textures are updated in place (the TextureBase pointer does not change) but they get a new image, so descriptor sets referencing
+    /// them must be rewritten (eg Material::UpdateDescriptorSets).  The replaced image is released once no frame can be using it.
+    /// @param bufferIdx buffer index of the descriptor sets about to be used (swapchain image index)
+    /// @return textures that changed since the last UpdateMipStreaming for this bufferIdx (descriptor sets for this bufferIdx using them need updating)
+    std::vector<const TextureBase*> UpdateMipStreaming( uint32_t bufferIdx );
+
+    /// @return gpu memory (bytes) used by the currently resident mip levels of streamed textures
+    uint64_t GetMipStreamingResidentBytes() const { return m_StreamingResidentBytes; }
+
+    /// Enable (or disable) content deduplication for textures loaded after this call.
+    /// Texture files are hashed (before transcoding) and a file with the same contents as an already loaded texture is not transcoded or uploaded,
+    /// its slot gets a texture sharing the original's image (with its own image view and sampler, so per slot samplers still work).
+    /// Textures loaded while mip streaming is enabled are not deduplicated (streaming replaces their images).
+    void EnableContentDeduplication( bool enable = true ) { m_ContentDeduplicationEnabled = enable; }
+
+    /// Content deduplication statistics (see EnableContentDeduplication)
+    struct ContentDeduplicationStats
+    {
+        uint32_t    numDuplicates = 0;      ///< texture slots sharing another slot's image
+        uint64_t    bytesSaved = 0;         ///< texture data (gpu upload size) not loaded because it was a duplicate
+    };
+    const ContentDeduplicationStats& GetContentDeduplicationStats() const { return m_ContentDeduplicationStats; }
+
+    /// Pack already loaded textures in to texture arrays and atlases (gpu copies), as planned by PlanTexturePacking.
+    /// Packed textures are added to the manager (named "_packed<n>") and are found with GetPackedTexture.
+    /// Source textures must be 2d (not streamed or sharing their image, see EnableContentDeduplication) with the size, format and at least as many mips as their packed texture;
+    /// packed textures with any unsuitable source are skipped (and their sources left as they are).
+    /// @param layout packing plan (typically made from the textures of each material, see PlanTexturePacking)
+    /// @param releaseSources release (and remove from the manager) source textures that were packed.  Pointers to them become invalid!
+    /// @return true if every packed texture in the layout was created
+    bool PackTextures( const TexturePackLayout& layout, bool releaseSources );
+
+    /// Find where a (source) texture was packed by PackTextures.
+    /// @param textureSlotName slot name of the source texture
+    /// @param pLocation (optional) output, layer and uv remapping of the source texture within the packed texture
+    /// @return packed texture, or null if textureSlotName was not packed
+    const TextureBase* GetPackedTexture( const std::string& textureSlotName, TexturePackLocation* pLocation = nullptr ) const;
+
+    /// Upload (up to maxTextures) textures loaded by LoadTextureAsync and add them to the manager.
+    /// Implements the base class virtual function.
+    std::vector<std::string> UpdateAsyncLoads( uint32_t maxTextures ) override;
+
 protected:
     const TextureBase* GetOrLoadTexture_(const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler) override;
     void BatchLoad(const std::span<std::pair<std::string, std::string>>, const SamplerBase& defaultSampler) override;
+    /// Load (and transcode) the texture on a loading worker thread, for UpdateAsyncLoads to upload
+    bool LoadTextureAsync_(const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler) override;
+
+    /// Streaming state of a texture loaded with mip streaming enabled
+    struct StreamedTexture
+    {
+        std::string                 filename;
+        TextureKtxFileWrapper       mipTail;                    ///< cpu copy of the mip tail (evicting does not need to reload the file)
+        std::vector<uint64_t>       mipLevelBytes;              ///< gpu size of each mip level (of the full resolution texture)
+        uint32_t                    mipTailFirstLevel = 0;
+        uint32_t                    residentFirstLevel = 0;     ///< most detailed mip level currently uploaded
+        uint32_t                    requestedFirstLevel = 0;    ///< most detailed mip level wanted
+        uint32_t                    lastRequestedFrame = 0;
+        bool                        loadInFlight = false;
+        Texture*                    pTexture = nullptr;
+
+        uint64_t GetResidentBytes(uint32_t firstLevel) const;
+    };
+
+    /// Mip levels loaded (and transcoded) by a streaming worker thread, waiting for upload
+    struct StreamedMipLoad
+    {
+        const TextureBase*          pTexture = nullptr;
+        uint32_t                    firstLevel = 0;
+        TextureKtxFileWrapper       mipLevels;                  ///< empty if loading failed
+    };
+
+    /// Texture loaded (and transcoded) by a LoadTextureAsync_ worker job, waiting for UpdateAsyncLoads to upload it
+    struct AsyncTextureLoad
+    {
+        std::string                 slotName;
+        const Sampler*              pSampler = nullptr;
+        TextureKtxFileWrapper       ktxData;                    ///< empty if loading failed (or the texture is streamed)
+        StreamedTexture             streamedTexture;            ///< mipTail set if the texture is streamed
+        std::optional<TextureContentHash> contentHash;          ///< set if content deduplication was active when the load started
+    };
+
+    /// Transcode just the mip tail of the (not yet transcoded) texture file and fill in the streaming state (streamedTexture.mipTail is the texture data to upload).
+    /// Safe to call from the loading worker threads.
+    /// @return false if the texture is not suitable for streaming (should be transcoded and loaded as normal)
+    bool PrepareMipTail( const TextureKtxFileWrapper& fileData, const std::string& filename, StreamedTexture& streamedTexture ) const;
+    void AddStreamedTexture( Texture& texture, StreamedTexture&& streamedTexture );
+    /// Upload the given mip levels and swap them in to the streamed texture (old image is queued for release)
+    bool ReplaceStreamedMips( StreamedTexture& streamedTexture, const TextureKtxFileWrapper& mipLevels, uint32_t firstLevel );
+    /// Evict mip levels from textures requested less recently than lastRequestedFrame until there is room for additionalBytes
+    bool MakeStreamingBudget( uint64_t additionalBytes, uint32_t lastRequestedFrame );
+
+    /// Texture (slot) that was loaded from the file with the given content hash
+    struct ContentHashEntry
+    {
+        std::string                 slotName;
+        uint64_t                    dataBytes = 0;              ///< size of the texture data (as uploaded)
+    };
+
+    /// @return true if content deduplication applies to textures being loaded now
+    bool IsContentDeduplicationActive() const { return m_ContentDeduplicationEnabled && !m_MipStreamingEnabled; }
+    /// @return loaded texture with the given content hash (same file size and hashes), or null
+    const Texture* FindContentDuplicate( const TextureContentHash& contentHash ) const;
+    /// Add a texture (slot) that shares the image of an already loaded texture, using its own sampler.
+    const TextureBase* AddSharedTexture( const std::string& textureSlotName, const Texture& original, const Sampler& sampler, uint64_t dataBytes );
 
 private:
     std::map<std::string, Texture>          m_LoadedTextures;
     std::vector<Sampler>                    m_DefaultSamplers;
     const bool                              m_MirrorClampToEdgeSupported = false;  // currently this is never set, if we add VK_KHR_sampler_mirror_clamp_to_edge extension support or samplerMirrorClampToEdge feature flag then we can change this to non const and set/reset
     tGfxApi&                                m_GfxApi;
+
+    // Mip streaming
+    bool                                    m_MipStreamingEnabled = false;
+    MipStreamingSettings                    m_MipStreamingSettings;
+    std::unordered_map<const TextureBase*, StreamedTexture> m_StreamedTextures;
+    std::mutex                              m_StreamedMipLoadsMutex;
+    std::deque<StreamedMipLoad>             m_StreamedMipLoads;             ///< loaded by worker threads (protected by m_StreamedMipLoadsMutex)
+    std::vector<std::pair<uint32_t, Texture>> m_StreamingReleaseQueue;      ///< replaced textures (and frame they were replaced on) waiting for the gpu to be done with them
+    std::vector<std::vector<const TextureBase*>> m_StreamingChangedTextures;///< textures changed since the last UpdateMipStreaming (per bufferIdx)
+    uint64_t                                m_StreamingResidentBytes = 0;
+    uint32_t                                m_StreamingFrame = 0;
+
+    // Async loads
+    std::unordered_set<std::string>         m_AsyncLoadSlots;               ///< slots being loaded by the worker threads (or waiting for upload)
+    std::mutex                              m_AsyncLoadsMutex;
+    std::deque<AsyncTextureLoad>            m_FinishedAsyncLoads;           ///< loaded by worker threads (protected by m_AsyncLoadsMutex)
+
+    // Content deduplication
+    bool                                    m_ContentDeduplicationEnabled = false;
+    std::unordered_map<TextureContentHash, ContentHashEntry, TextureContentHash::Hasher> m_TextureContentHashes;  ///< by hash (and size) of the texture file contents
+    std::unordered_set<const TextureBase*>  m_SharedImageTextures;          ///< textures sharing their image with another texture (originals and duplicates)
+    ContentDeduplicationStats               m_ContentDeduplicationStats;
+
+    // Texture packing
+    std::unordered_map<std::string, std::pair<const TextureBase*, TexturePackLocation>> m_PackedTextureLocations;  ///< by source texture slot name
+    uint32_t                                m_NumPackedTextures = 0;
 };
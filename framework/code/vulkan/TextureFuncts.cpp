@@ -10,9 +10,11 @@
 //      Vulkan texture handling support
 
 #include "texture/textureFormat.hpp"
+#include "texture/textureFormatConvert.hpp"
 #include "texture/vulkan/texture.hpp"
 #include "vulkan/vulkan.hpp"
 #include <cinttypes>
+#include <vector>
 #define STB_IMAGE_IMPLEMENTATION
 #include "tinygltf/stb_image.h"
 #include "tinygltf/stb_image_write.h"
@@ -23,11 +25,20 @@ bool SaveTextureData( const char* pFileName, TextureFormat format, int width, in
 {
     int bytesPerTexel = 1;
     int components = 0;
+    const size_t numPixels = size_t( width ) * size_t( height );
+    std::vector<uint8_t> convertedData;     // for formats that need converting to 8bit RGB(A)
     switch (format)
     {
     case TextureFormat::R8G8B8A8_SRGB:
+    case TextureFormat::R8G8B8A8_UNORM:
         components = 4;
         break;
+    case TextureFormat::B8G8R8A8_SRGB:
+    case TextureFormat::B8G8R8A8_UNORM:
+        components = 4;
+        convertedData.resize( numPixels * 4 );
+        SwizzleRgba8Bgra8( { static_cast<const uint8_t*>( data ), numPixels * 4 }, convertedData );
+        break;
     case TextureFormat::R8G8B8_SRGB:
         components = 3;
         break;
@@ -39,13 +50,38 @@ bool SaveTextureData( const char* pFileName, TextureFormat format, int width, in
     case TextureFormat::R8_UNORM:
         components = 1;
         break;
+    case TextureFormat::R16G16B16A16_SFLOAT:
+    {
+        // Linear (hdr) data, written as (clamped) sRGB
+        components = 4;
+        std::vector<float> floatData( numPixels * 4 );
+        ConvertFloat16ToFloat32( { static_cast<const uint16_t*>( data ), numPixels * 4 }, floatData );
+        convertedData.resize( numPixels * 4 );
+        ConvertLinearFloatToSrgb8( floatData, convertedData, 4 );
+        break;
+    }
+    case TextureFormat::R32G32B32A32_SFLOAT:
+        components = 4;
+        convertedData.resize( numPixels * 4 );
+        ConvertLinearFloatToSrgb8( { static_cast<const float*>( data ), numPixels * 4 }, convertedData, 4 );
+        break;
+    case TextureFormat::B10G11R11_UFLOAT_PACK32:
+    {
+        components = 4;
+        std::vector<float> floatData( numPixels * 4 );
+        UnpackB10G11R11UfloatToRgba32f( { static_cast<const uint32_t*>( data ), numPixels }, floatData );
+        convertedData.resize( numPixels * 4 );
+        ConvertLinearFloatToSrgb8( floatData, convertedData, 4 );
+        break;
+    }
     default:
         LOGE( "SaveTextureData: format %s not supported for output", Vulkan::VulkanFormatString( TextureFormatToVk(format) ) );
         return false;
     }
 
     {
-        int error = stbi_write_png( pFileName, width, height, components, data, width * components * bytesPerTexel );
+        const void* pOutputData = convertedData.empty() ? data : convertedData.data();
+        int error = stbi_write_png( pFileName, width, height, components, pOutputData, width * components * bytesPerTexel );
         return (error != 0);
     }
 }
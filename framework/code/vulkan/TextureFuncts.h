@@ -13,5 +13,6 @@
 #include "texture/texture.hpp"
 
 /// Save texture data to 'filename'
+/// Data is tightly packed (width * height pixels).  BGRA formats are swizzled, float formats are converted from linear to sRGB (clamped) before saving.
 /// @returns true on success
 bool SaveTextureData(const char* pFileName, TextureFormat format, int width, int height, const void* data);
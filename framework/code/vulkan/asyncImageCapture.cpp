@@ -0,0 +1,252 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "asyncImageCapture.hpp"
+#include "TextureFuncts.h"
+#include "texture/textureFormat.hpp"
+#include <array>
+
+
+AsyncImageCapture::AsyncImageCapture( Vulkan& vulkan ) noexcept : m_Vulkan( vulkan )
+{
+}
+
+
+AsyncImageCapture::~AsyncImageCapture()
+{
+    Destroy();
+}
+
+
+bool AsyncImageCapture::Initialize( size_t maxImageBytes, uint32_t numSlots )
+{
+    assert( m_NumSlots == 0 );
+    if (numSlots == 0 || maxImageBytes == 0)
+        return false;
+
+    if (m_EncodeThreadWorker.Initialize( "ImageCaptureWorker", 1 ) == 0)
+        return false;
+
+    // One buffer for all the slots, kept mapped.
+    m_SlotBytes = (maxImageBytes + 255) & ~size_t( 255 );
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    m_RingBuffer = memoryManager.CreateBuffer( m_SlotBytes * numSlots, BufferUsageFlags::TransferDst, MemoryUsage::GpuToCpu );
+    if (!m_RingBuffer)
+    {
+        LOGE( "AsyncImageCapture: unable to create %zu byte readback buffer", m_SlotBytes * numSlots );
+        return false;
+    }
+    m_RingBufferMapped.emplace( memoryManager.Map<uint8_t>( m_RingBuffer ) );
+
+    m_Slots = std::make_unique<Slot[]>( numSlots );
+    m_NumSlots = numSlots;
+    m_NextSlot = 0;
+
+    VkCommandBufferAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    allocateInfo.commandPool = m_Vulkan.m_VulkanQueues[Vulkan::eGraphicsQueue].CommandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+    const VkFenceCreateInfo fenceInfo{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+    const VkSemaphoreCreateInfo semaphoreInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    for (uint32_t slotIdx = 0; slotIdx < numSlots; ++slotIdx)
+    {
+        auto& slot = m_Slots[slotIdx];
+        slot.offset = m_SlotBytes * slotIdx;
+        if (!CheckVkError( "vkAllocateCommandBuffers()", vkAllocateCommandBuffers( m_Vulkan.m_VulkanDevice, &allocateInfo, &slot.commandBuffer ) ) ||
+            !CheckVkError( "vkCreateFence()", vkCreateFence( m_Vulkan.m_VulkanDevice, &fenceInfo, nullptr, &slot.fence ) ) ||
+            !CheckVkError( "vkCreateSemaphore()", vkCreateSemaphore( m_Vulkan.m_VulkanDevice, &semaphoreInfo, nullptr, &slot.semaphore ) ))
+        {
+            Destroy();
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void AsyncImageCapture::Destroy()
+{
+    if (m_NumSlots > 0)
+    {
+        Flush();
+        for (uint32_t slotIdx = 0; slotIdx < m_NumSlots; ++slotIdx)
+        {
+            auto& slot = m_Slots[slotIdx];
+            if (slot.commandBuffer != VK_NULL_HANDLE)
+                vkFreeCommandBuffers( m_Vulkan.m_VulkanDevice, m_Vulkan.m_VulkanQueues[Vulkan::eGraphicsQueue].CommandPool, 1, &slot.commandBuffer );
+            if (slot.fence != VK_NULL_HANDLE)
+                vkDestroyFence( m_Vulkan.m_VulkanDevice, slot.fence, nullptr );
+            if (slot.semaphore != VK_NULL_HANDLE)
+                vkDestroySemaphore( m_Vulkan.m_VulkanDevice, slot.semaphore, nullptr );
+        }
+        m_Slots.reset();
+        m_NumSlots = 0;
+    }
+    m_EncodeThreadWorker.Terminate();
+
+    if (m_RingBufferMapped)
+    {
+        m_Vulkan.GetMemoryManager().Unmap( m_RingBuffer, std::move( *m_RingBufferMapped ) );
+        m_RingBufferMapped.reset();
+    }
+    if (m_RingBuffer)
+        m_Vulkan.GetMemoryManager().Destroy( std::move( m_RingBuffer ) );
+}
+
+
+AsyncImageCapture::Slot* AsyncImageCapture::AcquireSlot( TextureFormat format, uint32_t width, uint32_t height, const char* pFileName )
+{
+    if (m_NumSlots == 0)
+        return nullptr;
+    const size_t imageBytes = size_t( width ) * height * FormatBytesPerPixel( format );
+    if (imageBytes == 0 || imageBytes > m_SlotBytes)
+    {
+        LOGE( "AsyncImageCapture: %ux%u image does not fit in a capture slot (%zu bytes)", width, height, m_SlotBytes );
+        return nullptr;
+    }
+
+    // Never wait for a slot, drop the capture instead.
+    auto& slot = m_Slots[m_NextSlot];
+    if (slot.state.load( std::memory_order_acquire ) != SlotState::Free)
+    {
+        ++m_NumDroppedCaptures;
+        return nullptr;
+    }
+    m_NextSlot = (m_NextSlot + 1) % m_NumSlots;
+
+    slot.format = format;
+    slot.width = width;
+    slot.height = height;
+    slot.fileName = pFileName;
+    return &slot;
+}
+
+
+void AsyncImageCapture::RecordCopy( VkCommandBuffer commandBuffer, const Slot& slot, VkImage image, VkImageLayout imageLayout ) const
+{
+    const VkImageSubresourceRange subresourceRange{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    // Transition to transfer source (waiting for anything that may have written the image).
+    VkImageMemoryBarrier imageBarrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    imageBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = imageLayout;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = image;
+    imageBarrier.subresourceRange = subresourceRange;
+    vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier );
+
+    // Tightly packed copy in to the slot.
+    VkBufferImageCopy copyRegion{};
+    copyRegion.bufferOffset = slot.offset;
+    copyRegion.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    copyRegion.imageExtent = { slot.width, slot.height, 1 };
+    vkCmdCopyImageToBuffer( commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_RingBuffer.GetVkBuffer(), 1, &copyRegion );
+
+    // Back to the original layout, and make the copied data visible to the host (once the fence has signalled).
+    imageBarrier.srcAccessMask = 0;
+    imageBarrier.dstAccessMask = 0;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = imageLayout;
+    VkBufferMemoryBarrier bufferBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = m_RingBuffer.GetVkBuffer();
+    bufferBarrier.offset = slot.offset;
+    bufferBarrier.size = m_SlotBytes;
+    vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &bufferBarrier, 1, &imageBarrier );
+}
+
+
+bool AsyncImageCapture::Capture( VkImage image, VkImageLayout imageLayout, TextureFormat format, uint32_t width, uint32_t height, const char* pFileName, std::span<const VkSemaphore> waitSemaphores, VkSemaphore& signalSemaphore )
+{
+    signalSemaphore = VK_NULL_HANDLE;
+    Slot* pSlot = AcquireSlot( format, width, height, pFileName );
+    if (!pSlot)
+        return false;
+
+    // Slot was Free, so its command buffer and fence are no longer in use by the gpu.
+    VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (!CheckVkError( "vkBeginCommandBuffer()", vkBeginCommandBuffer( pSlot->commandBuffer, &beginInfo ) ))
+        return false;
+    RecordCopy( pSlot->commandBuffer, *pSlot, image, imageLayout );
+    if (!CheckVkError( "vkEndCommandBuffer()", vkEndCommandBuffer( pSlot->commandBuffer ) ))
+        return false;
+
+    constexpr uint32_t cMaxWaitSemaphores = 8;
+    std::array<VkPipelineStageFlags, cMaxWaitSemaphores> waitDstStageMasks;
+    assert( waitSemaphores.size() <= cMaxWaitSemaphores );
+    waitDstStageMasks.fill( VK_PIPELINE_STAGE_TRANSFER_BIT );
+    if (!m_Vulkan.QueueSubmit( { &pSlot->commandBuffer, 1 }, waitSemaphores, std::span( waitDstStageMasks ).subspan( 0, waitSemaphores.size() ), { &pSlot->semaphore, 1 }, Vulkan::eGraphicsQueue, pSlot->fence ))
+        return false;
+
+    pSlot->pollFence = pSlot->fence;
+    pSlot->state.store( SlotState::GpuPending, std::memory_order_release );
+    signalSemaphore = pSlot->semaphore;
+    return true;
+}
+
+
+bool AsyncImageCapture::RecordCapture( VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout, TextureFormat format, uint32_t width, uint32_t height, const char* pFileName, VkFence completionFence )
+{
+    Slot* pSlot = AcquireSlot( format, width, height, pFileName );
+    if (!pSlot)
+        return false;
+    RecordCopy( commandBuffer, *pSlot, image, imageLayout );
+    pSlot->pollFence = completionFence;
+    pSlot->state.store( SlotState::GpuPending, std::memory_order_release );
+    return true;
+}
+
+
+void AsyncImageCapture::Update()
+{
+    for (uint32_t slotIdx = 0; slotIdx < m_NumSlots; ++slotIdx)
+    {
+        auto& slot = m_Slots[slotIdx];
+        if (slot.state.load( std::memory_order_acquire ) != SlotState::GpuPending)
+            continue;
+        if (vkGetFenceStatus( m_Vulkan.m_VulkanDevice, slot.pollFence ) != VK_SUCCESS)
+            continue;
+        if (slot.pollFence == slot.fence)
+            vkResetFences( m_Vulkan.m_VulkanDevice, 1, &slot.fence );
+        slot.pollFence = VK_NULL_HANDLE;
+
+        m_Vulkan.GetMemoryManager().InvalidateMapped( *m_RingBufferMapped, slot.offset, m_SlotBytes );
+        slot.state.store( SlotState::Encoding, std::memory_order_release );
+        m_EncodeThreadWorker.DoWork2( []( AsyncImageCapture* pThis, Slot* pSlot ) { pThis->EncodeSlot( *pSlot ); }, this, &slot );
+    }
+}
+
+
+void AsyncImageCapture::Flush()
+{
+    for (uint32_t slotIdx = 0; slotIdx < m_NumSlots; ++slotIdx)
+    {
+        const auto& slot = m_Slots[slotIdx];
+        if (slot.state.load( std::memory_order_acquire ) == SlotState::GpuPending)
+            vkWaitForFences( m_Vulkan.m_VulkanDevice, 1, &slot.pollFence, VK_TRUE, UINT64_MAX );
+    }
+    Update();
+    m_EncodeThreadWorker.FinishAllWork();
+}
+
+
+void AsyncImageCapture::EncodeSlot( Slot& slot )
+{
+    // Runs on the encode thread, slot is not touched by the main thread while in the Encoding state.
+    const uint8_t* pData = m_RingBufferMapped->data() + slot.offset;
+    if (!SaveTextureData( slot.fileName.c_str(), slot.format, (int) slot.width, (int) slot.height, pData ))
+        LOGE( "AsyncImageCapture: unable to write %s", slot.fileName.c_str() );
+    slot.state.store( SlotState::Free, std::memory_order_release );
+}
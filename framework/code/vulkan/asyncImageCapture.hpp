@@ -0,0 +1,101 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file asyncImageCapture.hpp
+/// Asynchronous (non stalling) capture of images (eg screenshots) to file.
+/// @ingroup Vulkan
+
+#include "vulkan.hpp"
+#include "memory/vulkan/memoryManager.hpp"
+#include "system/Worker.h"
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+
+/// @brief Captures images to file without stalling the frame.
+/// Images are copied by the gpu in to a slot of a persistently mapped readback ring buffer, the copy's fence is polled (by Update) on later frames
+/// and once complete the format conversion and png encoding (SaveTextureData) is done on a background thread.
+/// If every slot is busy the capture is dropped (and counted) rather than waiting for a slot, so frame timings are not perturbed.
+class AsyncImageCapture
+{
+public:
+    AsyncImageCapture( Vulkan& vulkan ) noexcept;
+    AsyncImageCapture( const AsyncImageCapture& ) = delete;
+    AsyncImageCapture& operator=( const AsyncImageCapture& ) = delete;
+    ~AsyncImageCapture();
+
+    static constexpr uint32_t cDefaultNumSlots = 4;
+
+    /// @param maxImageBytes largest (tightly packed) image that can be captured, eg surface width * height * bytes per pixel
+    /// @param numSlots number of captures that can be in flight at once (waiting for the gpu or being encoded)
+    /// @return true on success
+    bool Initialize( size_t maxImageBytes, uint32_t numSlots = cDefaultNumSlots );
+
+    /// Waits for outstanding captures to be written and releases the Vulkan objects.
+    void Destroy();
+
+    /// @brief Submit (on the graphics queue) a copy of the given image in to a free readback slot.
+    /// @param image image to capture (created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+    /// @param imageLayout layout the image is in (and is left in), eg VK_IMAGE_LAYOUT_PRESENT_SRC_KHR for a swapchain image
+    /// @param pFileName file to write (png)
+    /// @param waitSemaphores semaphores signalled when the image is ready to be read (eg render complete)
+    /// @param signalSemaphore (output) semaphore signalled once the copy is done, wait on this (instead of waitSemaphores) before using the image again (eg present)
+    /// @return true if the capture was submitted, false if it was dropped (no free slot, image too big or submit error) in which case signalSemaphore is VK_NULL_HANDLE
+    bool Capture( VkImage image, VkImageLayout imageLayout, TextureFormat format, uint32_t width, uint32_t height, const char* pFileName, std::span<const VkSemaphore> waitSemaphores, VkSemaphore& signalSemaphore );
+
+    /// @brief Record a copy of the given image in to a free readback slot on the caller's command buffer.
+    /// @param completionFence fence signalled by (or after) the submit of commandBuffer, on the same queue (eg Vulkan::BufferIndexAndFence::fence).  Only polled, never reset.
+    /// @return true if the copy was recorded, false if the capture was dropped
+    bool RecordCapture( VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout, TextureFormat format, uint32_t width, uint32_t height, const char* pFileName, VkFence completionFence );
+
+    /// Poll the fences of submitted captures and pass the completed ones to the background thread to be written.  Call once per frame.
+    void Update();
+
+    /// Wait for all submitted captures to complete on the gpu and be written to file.
+    void Flush();
+
+    /// @return number of captures dropped because no slot was free
+    uint32_t GetNumDroppedCaptures() const { return m_NumDroppedCaptures; }
+
+private:
+    enum class SlotState : uint32_t {
+        Free,
+        GpuPending,     ///< copy submitted, waiting for pollFence
+        Encoding        ///< being converted/written on the background thread (back to Free when done)
+    };
+    struct Slot {
+        std::atomic<SlotState>  state = SlotState::Free;
+        size_t                  offset = 0;                         ///< offset of this slot in the ring buffer
+        VkFence                 fence = VK_NULL_HANDLE;             ///< owned, signalled by Capture's submit
+        VkSemaphore             semaphore = VK_NULL_HANDLE;         ///< owned, signalled by Capture's submit
+        VkCommandBuffer         commandBuffer = VK_NULL_HANDLE;     ///< used by Capture
+        VkFence                 pollFence = VK_NULL_HANDLE;         ///< fence being waited on (fence or the RecordCapture completionFence)
+        TextureFormat           format = TextureFormat::UNDEFINED;
+        uint32_t                width = 0;
+        uint32_t                height = 0;
+        std::string             fileName;
+    };
+
+    Slot* AcquireSlot( TextureFormat format, uint32_t width, uint32_t height, const char* pFileName );
+    void RecordCopy( VkCommandBuffer commandBuffer, const Slot& slot, VkImage image, VkImageLayout imageLayout ) const;
+    void EncodeSlot( Slot& slot );
+
+    Vulkan&                                         m_Vulkan;
+    MemoryAllocatedBuffer<Vulkan, VkBuffer>         m_RingBuffer;
+    std::optional<MemoryCpuMapped<Vulkan, uint8_t>> m_RingBufferMapped;     ///< mapped for the lifetime of the ring buffer
+    size_t                                          m_SlotBytes = 0;
+    std::unique_ptr<Slot[]>                         m_Slots;
+    uint32_t                                        m_NumSlots = 0;
+    uint32_t                                        m_NextSlot = 0;         ///< slots are used in ring order
+    uint32_t                                        m_NumDroppedCaptures = 0;
+    ThreadWorker                                    m_EncodeThreadWorker;
+};
@@ -95,6 +95,8 @@ public:
     operator T() const { return get(); }
     T get() const { return handle; }
     VkDevice getDevice() const { return device; }
+    /// @return number of RefHandles sharing this handle (0 if empty)
+    uint32_t use_count() const { return m_shared_ref_count ? m_shared_ref_count->load() : 0; }
 
     T handle = {};
 
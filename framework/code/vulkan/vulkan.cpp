@@ -11,15 +11,21 @@
 #include "extensionLib.hpp"
 #include "system/os_common.h"
 #include "system/config.h"
+#include "system/Worker.h"
+#include "material/vulkan/pipelineRegistry.hpp"
 #include "texture/vulkan/texture.hpp"
 #include "vulkan/renderContext.hpp"
 #include "vulkan/renderPass.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <thread>
 #if defined(OS_LINUX)
 #include <GLFW/glfw3.h>
 #endif // OS_LINUX
@@ -136,12 +142,18 @@ Vulkan::Vulkan()
     m_SetupCmdBuffer = VK_NULL_HANDLE;
 
     m_PipelineCache = VK_NULL_HANDLE;
+    m_PipelineRegistry = std::make_unique<PipelineRegistry<Vulkan>>();
+    m_PipelineCompileWorker = std::make_unique<ThreadWorker>();
+    m_PipelineCacheWriter = std::make_unique<ThreadWorker>();
 }
 
 //-----------------------------------------------------------------------------
 Vulkan::~Vulkan()
 //-----------------------------------------------------------------------------
 {
+    m_PipelineCompileWorker->Terminate();
+    m_PipelineCacheWriter->Terminate();     // finishes any in-flight periodic save before the final save below
+
     DestroyFrameBuffers();
     DestroySwapchainRenderPass();
     DestroySwapChain();
@@ -154,8 +166,13 @@ Vulkan::~Vulkan()
             vkDestroyCommandPool(m_VulkanDevice, queue.CommandPool, nullptr);
     }
 
+    // Registered pipelines must be released before the device.
+    m_PipelineRegistry->LogStats();
+    m_PipelineRegistry->Clear();
+
     if (m_PipelineCache != VK_NULL_HANDLE)
     {
+        SavePipelineCache();
         vkDestroyPipelineCache(m_VulkanDevice, m_PipelineCache, nullptr);
     }
 
@@ -191,6 +208,8 @@ Vulkan::~Vulkan()
 bool Vulkan::Init(uintptr_t windowHandle, uintptr_t hInst, const Vulkan::tSelectSurfaceFormatFn& SelectSurfaceFormatFn, const Vulkan::tConfigurationFn& CustomConfigurationFn)
 //-----------------------------------------------------------------------------
 {
+    m_InitStartTimeUS = OS_GetTimeUS();
+
     if (volkInitialize() != VK_SUCCESS)
     {
         return false;
@@ -2316,15 +2335,164 @@ bool Vulkan::InitPipelineCache()
 //-----------------------------------------------------------------------------
 {
     assert(m_PipelineCache == VK_NULL_HANDLE);
+    const auto initialData = LoadPipelineCacheData();
+
     VkPipelineCacheCreateInfo CreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    CreateInfo.initialDataSize = initialData.size();
+    CreateInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
     auto retVal = vkCreatePipelineCache( m_VulkanDevice, &CreateInfo, nullptr, &m_PipelineCache );
+    if (retVal != VK_SUCCESS && !initialData.empty())
+    {
+        // Driver rejected the saved data, start with an empty cache.
+        LOGW("vkCreatePipelineCache() failed with the saved pipeline cache data, starting with an empty cache");
+        CreateInfo.initialDataSize = 0;
+        CreateInfo.pInitialData = nullptr;
+        retVal = vkCreatePipelineCache( m_VulkanDevice, &CreateInfo, nullptr, &m_PipelineCache );
+    }
     if (!CheckVkError( "vkCreatePipelineCache()", retVal ))
     {
         return false;
     }
+    m_PipelineCacheWarm = CreateInfo.initialDataSize > 0;
+    m_PipelineCacheSavedBytes = CreateInfo.initialDataSize;
+    m_PipelineCacheSaveTimeUS = OS_GetTimeUS();
     return true;
 }
 
+//-----------------------------------------------------------------------------
+std::vector<uint8_t> Vulkan::LoadPipelineCacheData() const
+//-----------------------------------------------------------------------------
+{
+    if (!m_ConfigOverride.PipelineCacheFile || m_ConfigOverride.PipelineCacheFile->empty())
+        return {};
+    const std::string& fileName = *m_ConfigOverride.PipelineCacheFile;
+
+    std::vector<uint8_t> data;
+    if (FILE* fp = fopen(fileName.c_str(), "rb"))
+    {
+        if (fseek(fp, 0, SEEK_END) == 0)
+        {
+            const long fileSize = ftell(fp);
+            if (fileSize > 0 && fseek(fp, 0, SEEK_SET) == 0)
+            {
+                data.resize((size_t)fileSize);
+                if (fread(data.data(), 1, data.size(), fp) != data.size())
+                    data.clear();
+            }
+        }
+        fclose(fp);
+    }
+    if (data.empty())
+    {
+        LOGI("Pipeline cache %s not loaded (cold start)", fileName.c_str());
+        return {};
+    }
+
+    // Only give the driver data that was saved by this driver on this gpu (drivers should also check, not all do so robustly).
+    VkPipelineCacheHeaderVersionOne header;
+    const auto& gpuProperties = m_VulkanGpuProperties.Base.properties;
+    if (data.size() < sizeof(header))
+    {
+        LOGW("Pipeline cache %s is too small, ignoring", fileName.c_str());
+        return {};
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.headerSize < sizeof(header) || header.headerSize > data.size() || header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header.vendorID != gpuProperties.vendorID || header.deviceID != gpuProperties.deviceID ||
+        memcmp(header.pipelineCacheUUID, gpuProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+    {
+        LOGW("Pipeline cache %s is from a different gpu or driver, ignoring", fileName.c_str());
+        return {};
+    }
+    LOGI("Pipeline cache %s loaded (%zu bytes, warm start)", fileName.c_str(), data.size());
+    return data;
+}
+
+//-----------------------------------------------------------------------------
+bool Vulkan::SavePipelineCache()
+//-----------------------------------------------------------------------------
+{
+    if (m_PipelineCache == VK_NULL_HANDLE || !m_ConfigOverride.PipelineCacheFile || m_ConfigOverride.PipelineCacheFile->empty())
+        return true;
+
+    size_t dataSize = 0;
+    if (!CheckVkError("vkGetPipelineCacheData()", vkGetPipelineCacheData(m_VulkanDevice, m_PipelineCache, &dataSize, nullptr)))
+        return false;
+    if (dataSize == m_PipelineCacheSavedBytes)
+        return true;    // no new pipelines (the cache only grows)
+    std::vector<uint8_t> data(dataSize);
+    if (!CheckVkError("vkGetPipelineCacheData()", vkGetPipelineCacheData(m_VulkanDevice, m_PipelineCache, &dataSize, data.data())))
+        return false;
+    data.resize(dataSize);
+
+    // Write to a temporary file and rename, so an interrupted save never leaves a partially written cache file.
+    const std::filesystem::path path(*m_ConfigOverride.PipelineCacheFile);
+    auto tempPath = path;
+    tempPath += ".tmp";
+    std::error_code ec;
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+    bool written = false;
+    if (FILE* fp = fopen(tempPath.string().c_str(), "wb"))
+    {
+        written = fwrite(data.data(), 1, data.size(), fp) == data.size();
+        written = (fclose(fp) == 0) && written;
+    }
+    if (written)
+        std::filesystem::rename(tempPath, path, ec);
+    if (!written || ec)
+    {
+        LOGE("Unable to write pipeline cache file %s", path.string().c_str());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    m_PipelineCacheSavedBytes = data.size();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+ThreadWorker& Vulkan::GetPipelineCompileWorker()
+//-----------------------------------------------------------------------------
+{
+    std::call_once(m_PipelineCompileWorkerStarted, [this]() {
+        // The compiling thread creates pipelines too, so one less helper than there are cores (single core devices get no threads, everything is created by the caller).
+        const uint32_t numHelperThreads = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+        if (numHelperThreads > 0)
+            m_PipelineCompileWorker->Initialize("PipelineCompile", numHelperThreads);
+    });
+    return *m_PipelineCompileWorker;
+}
+
+//-----------------------------------------------------------------------------
+void Vulkan::UpdatePipelineCache()
+//-----------------------------------------------------------------------------
+{
+    constexpr uint64_t cPipelineCacheSaveIntervalUS = 30 * 1000 * 1000;
+
+    const uint64_t timeUS = OS_GetTimeUS();
+    if (!m_FirstPresentReported)
+    {
+        // Startup time (cold vs warm pipeline cache)
+        m_FirstPresentReported = true;
+        LOGI("Startup time (Vulkan::Init to first present) %.1fms, %s pipeline cache", float(timeUS - m_InitStartTimeUS) * 0.001f, m_PipelineCacheWarm ? "warm" : "cold");
+    }
+
+    // Periodic save (in case the app does not shut down cleanly).
+    // Getting the cache data and writing the file can take several milliseconds so is done on a background thread, never stalling the present.
+    if (timeUS - m_PipelineCacheSaveTimeUS >= cPipelineCacheSaveIntervalUS && !m_PipelineCacheSaveInFlight)
+    {
+        m_PipelineCacheSaveTimeUS = timeUS;
+        if (m_PipelineCacheWriter->NumThreads() == 0)
+            m_PipelineCacheWriter->Initialize("PipelineCacheWriter", 1);
+        m_PipelineCacheSaveInFlight = true;
+        m_PipelineCacheWriter->DoWork2([](Vulkan* pVulkan) {
+            pVulkan->SavePipelineCache();
+            pVulkan->m_PipelineCacheSaveInFlight = false;
+        }, this);
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 bool Vulkan::QuerySurfaceCapabilities(VkSurfaceCapabilitiesKHR& outVulkanSurfaceCaps)
@@ -2647,6 +2815,7 @@ bool Vulkan::InitSwapChain()
     {
         return false;
     }
+    m_SwapchainImageUsage = SwapchainInfo.imageUsage;
 
 #if defined (OS_WINDOWS) || defined (OS_LINUX)
     retVal = m_ExtSwapchain->m_vkGetSwapchainImagesKHR(m_VulkanDevice, m_VulkanSwapchain, &m_SwapchainImageCount, nullptr);
@@ -3463,6 +3632,8 @@ void Vulkan::DestroySwapchainRenderPass()
 //-----------------------------------------------------------------------------
 {
     m_SwapchainRenderPass = {};
+    // Release registered pipelines (and their reference to the old render pass) that nothing is using any more
+    m_PipelineRegistry->Prune();
 }
 
 //-----------------------------------------------------------------------------
@@ -4637,6 +4808,8 @@ bool Vulkan::PresentQueue(const std::span<const VkSemaphore> pWaitSemaphores, ui
         WaitUntilIdle();
     }
 
+    UpdatePipelineCache();
+
     return true;
 }
 
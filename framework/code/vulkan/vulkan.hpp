@@ -15,10 +15,12 @@
 #elif OS_ANDROID
 #endif // OS_WINDOWS | OS_WINDOWS
 
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <stdexcept>
@@ -370,6 +372,10 @@ namespace fvk
 } // namespace fvk;
 
 
+class Vulkan;
+template<> class PipelineRegistry<Vulkan>;
+class ThreadWorker;
+
 /// Vulkan API implementation
 /// Contains Vulkan top level (driver etc) objects and provides a simple initialization interface.
 class Vulkan : public ::GraphicsApiBase
@@ -399,6 +405,8 @@ public:
         std::optional<TextureFormat> SwapchainDepthFormat;
         /// (optional) presentation mode that this app would like.  If the requested mode is not available (or not requested) a 'fastest' default will be used.
         std::optional<VkPresentModeKHR> PresentMode;
+        /// (optional) file the pipeline cache is loaded from on startup and saved to on shutdown (and periodically).  If not set the pipeline cache starts empty every run.
+        std::optional<std::string> PipelineCacheFile;
 
         /// @brief Register the vulkan extension (templated) as required by this app
         /// @tparam T template class for the extension
@@ -473,6 +481,8 @@ public:
     const Framebuffer<Vulkan>& GetSwapchainFramebuffer(uint32_t index) const { return m_SwapchainBuffers[index].framebuffer; }
     VkImage GetSwapchainImage(uint32_t index) const { return m_SwapchainBuffers[index].image; }
     VkImageView GetSwapchainImageView(uint32_t index) const { return m_SwapchainBuffers[index].view; }
+    /// Usage the swapchain images were created with (VK_IMAGE_USAGE_TRANSFER_SRC_BIT only when the surface format supports being copied/blitted from)
+    VkImageUsageFlags GetSwapchainImageUsage() const { return m_SwapchainImageUsage; }
     TextureFormat GetSurfaceFormat() const { return m_SurfaceFormat; }
 
     TextureFormat GetSwapchainFormat() const { return m_SurfaceFormat; }
@@ -728,6 +738,19 @@ public:
     /// Pipeline cache may be VK_NULL_HANDLE (no cache)
     VkPipelineCache GetPipelineCache() const { return m_PipelineCache; }
 
+    /// @brief Return the registry used by CreatePipeline to share pipelines with identical state (never null)
+    PipelineRegistry<Vulkan>& GetPipelineRegistry() const { return *m_PipelineRegistry; }
+
+    /// @brief Return the worker whose threads help PipelineBatch::Compile create pipelines (one thread per additional cpu core).
+    /// Started on first use and kept for the lifetime of this Vulkan, so compiling small batches does not pay for spinning up threads.
+    ThreadWorker& GetPipelineCompileWorker();
+
+    /// @brief Save the pipeline cache to AppConfiguration::PipelineCacheFile (if set).
+    /// Written to a temporary file and renamed, so an interrupted save never leaves a partial cache file.  Does nothing if the cache has not grown since the last save.
+    /// Called on shutdown, and periodically (on a background thread) from PresentQueue.  Safe to call from any thread, the pipeline cache is internally synchronized.
+    /// @return true on success (or nothing to save)
+    bool SavePipelineCache();
+
     bool SetSwapchainHrdMetadata(const VkHdrMetadataEXT& RenderingHdrMetaData);
 
     // Accessors
@@ -823,6 +846,8 @@ private:
     bool InitCommandPools();
     bool InitMemoryManager();
     bool InitPipelineCache();
+    std::vector<uint8_t> LoadPipelineCacheData() const;
+    void UpdatePipelineCache();
     bool QuerySurfaceCapabilities();
     bool QuerySurfaceCapabilities(VkSurfaceCapabilitiesKHR& out);
     bool InitSwapChain();
@@ -1132,6 +1157,7 @@ private:
     VkSurfaceKHR                        m_VulkanSurface;        ///< Current surface format format
     VkSurfaceCapabilitiesKHR            m_VulkanSurfaceCaps;    ///< Capabilities of current surface format
     VkSurfaceTransformFlagBitsKHR       m_SwapchainPreTransform;///< Current swapchain pre-transform
+    VkImageUsageFlags                   m_SwapchainImageUsage = 0;///< Current swapchain image usage
     mutable std::unordered_map<VkFormat, VkFormatProperties> m_FormatProperties;///< Known format properties - filled in as new formats are queried by @GetFormatProperties
 
     MemoryManager                       m_MemoryManager;
@@ -1139,4 +1165,14 @@ private:
     VkCommandBuffer                     m_SetupCmdBuffer;
 
     VkPipelineCache                     m_PipelineCache;
+    size_t                              m_PipelineCacheSavedBytes = 0;      ///< size of the pipeline cache data when last loaded/saved
+    uint64_t                            m_PipelineCacheSaveTimeUS = 0;      ///< time of the last (periodic) save check
+    bool                                m_PipelineCacheWarm = false;        ///< pipeline cache was loaded from file (warm start)
+    std::unique_ptr<PipelineRegistry<Vulkan>> m_PipelineRegistry;           ///< pipelines created by CreatePipeline, keyed by their state
+    std::unique_ptr<ThreadWorker>       m_PipelineCompileWorker;            ///< see GetPipelineCompileWorker
+    std::once_flag                      m_PipelineCompileWorkerStarted;
+    std::unique_ptr<ThreadWorker>       m_PipelineCacheWriter;              ///< single thread running the periodic SavePipelineCache (keeps vkGetPipelineCacheData and the file write off the render thread)
+    std::atomic<bool>                   m_PipelineCacheSaveInFlight = false;///< periodic save queued on m_PipelineCacheWriter and not yet finished
+    uint64_t                            m_InitStartTimeUS = 0;              ///< for reporting the time from Init to the first present
+    bool                                m_FirstPresentReported = false;
 };
@@ -14,6 +14,7 @@
 #include "material/vulkan/computable.hpp"
 #include "material/vulkan/drawable.hpp"
 #include "material/vulkan/materialManager.hpp"
+#include "material/vulkan/pipelineRegistry.hpp"
 #include "material/vulkan/shader.hpp"
 #include "material/shaderManagerT.hpp"
 #include "memory/memoryManager.hpp"
@@ -22,7 +23,7 @@
 #include "memory/vulkan/vertexBufferObject.hpp"
 #include "mesh/meshHelper.hpp"
 #include "system/math_common.hpp"
-#include "texture/textureManager.hpp"
+#include "texture/vulkan/textureManager.hpp"
 #include "vulkan/vulkan.hpp"
 #include "vulkan/TextureFuncts.h"
 #include <glm/gtc/quaternion.hpp>
@@ -608,6 +609,9 @@ bool Application::LoadTextures()
 
     m_TextureManager->SetDefaultFilenameManipulators(PathManipulator_PrefixDirectory(TEXTURE_DESTINATION_PATH));
 
+    // Bistro style scenes reference many identical texture files under different names, load each only once (duplicates share the image).
+    apiCast<Vulkan>(m_TextureManager.get())->EnableContentDeduplication();
+
     const PathManipulator_PrefixDirectory prefixTextureDir{ TEXTURE_DESTINATION_PATH };
 
     // Load 'loose' textures
@@ -1638,6 +1642,8 @@ bool Application::ChangeSurfaceFormat(SurfaceFormat newSurfaceFormat)
     {
         return false;
     }
+    // Release the pipelines created for the old blit render pass
+    GetVulkan()->GetPipelineRegistry().Prune();
 
     // Rebuild the m_BlitCmdBuffer
 
@@ -21,6 +21,7 @@
 #include "mesh/meshHelper.hpp"
 #include "mesh/meshLoader.hpp"
 #include "system/math_common.hpp"
+#include "texture/textureFormatConvert.hpp"
 #include "texture/textureManager.hpp"
 #include "imgui.h"
 
@@ -171,13 +172,10 @@ bool BloomImageprocessing::Initialize(uintptr_t windowHandle, uintptr_t hInstanc
     //--------------------------------------------------------------------------
     // Setup Weight Array
     float* pRawTexData = new float[gBlurFilterSize];
-    float16* pHalfTexData = new float16[gBlurFilterSize];
+    uint16_t* pHalfTexData = new uint16_t[gBlurFilterSize];
     {
         BuildWeightArray(gBlurFilterSize, pRawTexData);
-        for (uint32_t ii = 0; ii < gBlurFilterSize; ++ii)
-        {
-            pHalfTexData[ii] = float16(pRawTexData[ii]);
-        }
+        ConvertFloat32ToFloat16({ pRawTexData, gBlurFilterSize }, { pHalfTexData, gBlurFilterSize });
     }
     //--------------------------------------------------------------------------
 
@@ -213,7 +211,7 @@ bool BloomImageprocessing::Initialize(uintptr_t windowHandle, uintptr_t hInstanc
             if (ii == 1) // H
             {
                 m_weightTextures[ii] = CreateTextureFromBuffer( *pVulkan,
-                                                                         pHalfTexData, gBlurFilterSize * sizeof( float16 ),
+                                                                         pHalfTexData, gBlurFilterSize * sizeof( uint16_t ),
                                                                          gBlurFilterSize, 1, 1, weightFormat,
                                                                          SamplerAddressMode::ClampEdge,
                                                                          SamplerFilter::Nearest,
@@ -227,7 +225,7 @@ bool BloomImageprocessing::Initialize(uintptr_t windowHandle, uintptr_t hInstanc
             else // V
             {
                 m_weightTextures[ii] = CreateTextureFromBuffer(
-                      *pVulkan, pHalfTexData, gBlurFilterSize * sizeof(float16),
+                      *pVulkan, pHalfTexData, gBlurFilterSize * sizeof(uint16_t),
                       1, gBlurFilterSize, 1, weightFormat,
                       SamplerAddressMode::ClampEdge,
                       SamplerFilter::Nearest,
@@ -61,19 +61,6 @@ private:
     };
     static const uint32_t kPassesThatNeedIntermediateRenderTargets_Count = Pass_Display;//last pass renders to swapchain image, requiring no intermediate render target
 
-    struct float16
-    {
-        float16() noexcept : v(0) {}
-        float16(const float16& f16) noexcept : v(f16.v) {}
-        float16(float f32) noexcept {
-            const uint32_t u = *((uint32_t*)&f32) + 0x00001000;    // bitwise cast to int, round up mantissa
-            const uint32_t e = (u & 0x7f800000) >> 23;              // exponent
-            const uint32_t m = u & 0x007FFFFF;                      // mantissa
-            v = uint16_t((u & 0x80000000) >> 16 | (e > 112) * ((((e - 112) << 10) & 0x7c00) | m >> 13) | ((e < 113) & (e > 101)) * ((((0x007ff000 + m) >> (125 - e)) + 1) >> 1) | (e > 143) * 0x7fff);
-        }
-        uint16_t v;
-    };
-
     enum ShaderPairs
     {
         ShaderPair_Downsample,
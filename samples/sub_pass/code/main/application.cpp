@@ -16,7 +16,9 @@
 #include "gui/imguiVulkan.hpp"
 #include "material/vulkan/drawable.hpp"
 #include "material/vulkan/materialManager.hpp"
+#include "material/vulkan/pipelineRegistry.hpp"
 #include "material/vulkan/shaderManager.hpp"
+#include "material/shaderBundle.hpp"
 #include "mesh/meshHelper.hpp"
 #include "system/math_common.hpp"
 #include "texture/vulkan/textureManager.hpp"
@@ -35,6 +37,8 @@ VAR(float,      gFarPlane, 80.0f, kVariableNonpersistent);
 VAR(bool,       gShaderResolve,     true, kVariableNonpersistent);
 VAR(bool,       gUseSubpasses,      false, kVariableNonpersistent);
 VAR(bool,       gUseRenderPassTransform,true, kVariableNonpersistent);
+VAR(float,      gLodMaxPixelError, 1.0f, kVariableNonpersistent);  // screen space error (pixels) allowed when selecting the scene mesh levels of detail
+VAR(char*,      gShaderBundleFile, "Cache/sub_pass.shaderbundle", kVariableNonpersistent);  // shader bundle loaded on startup (written on the first run, or when the shaders change), empty to disable
 
 namespace
 {
@@ -129,6 +133,16 @@ bool Application::LoadShaders()
 
     LOGI("Loading Shaders...");
 
+    // Load everything from the shader bundle in one go when we can (sizes are checked to catch shaders that changed since the bundle was written).
+    const bool useShaderBundle = gShaderBundleFile != nullptr && *gShaderBundleFile != '\0';
+    if (useShaderBundle && m_ShaderManager->AddShaderBundle(*m_AssetManager, gShaderBundleFile, true))
+    {
+        return true;
+    }
+
+    ShaderBundleWriter shaderBundleWriter;
+    bool shaderBundleComplete = useShaderBundle;
+
     typedef std::pair<std::string, std::string> tIdAndFilename;
     for (const tIdAndFilename& i :
           { tIdAndFilename { "Object",                        "Object.json" },
@@ -143,6 +157,22 @@ bool Application::LoadShaders()
         if (!m_ShaderManager->AddShader(*m_AssetManager, i.first, i.second, SHADER_DESTINATION_PATH))
         {
             LOGE("Error Loading shader %s from %s", i.first.c_str(), i.second.c_str());
+            shaderBundleComplete = false;
+        }
+        else if (shaderBundleComplete)
+        {
+            shaderBundleComplete = shaderBundleWriter.AddShader(*m_AssetManager, i.first, (std::filesystem::path(SHADER_DESTINATION_PATH) / i.second).string());
+        }
+    }
+
+    // Write the bundle for next time (only if every shader made it in, a partial bundle would be loaded in place of the missing shaders)
+    if (shaderBundleComplete)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(m_AssetManager->GetDevicePath(gShaderBundleFile)).parent_path(), ec);
+        if (!shaderBundleWriter.Save(*m_AssetManager, gShaderBundleFile))
+        {
+            LOGW("Unable to save shader bundle %s", gShaderBundleFile);
         }
     }
 
@@ -443,7 +473,7 @@ bool Application::LoadSceneDrawables( const RenderContext& renderContext)
 
     m_SceneObject.clear();
 
-    if( !DrawableLoader::LoadDrawables( *pVulkan, *m_AssetManager, renderContext, sceneAssetPath, materialLoader, m_SceneObject, DrawableLoader::LoaderFlags::None))
+    if( !DrawableLoader::LoadDrawables( *pVulkan, *m_AssetManager, renderContext, sceneAssetPath, materialLoader, m_SceneObject, DrawableLoader::LoaderFlags::GenerateLods))
     {
         LOGE( "Error loading Object mesh: %s", sceneAssetPath.c_str());
         return false;
@@ -552,6 +582,9 @@ void Application::Render(float fltDiffTime)
 
     UpdateUniforms( CurrentVulkanBuffer.idx );
 
+    // Command buffer is re-recorded every frame so picks up any level of detail changes.
+    UpdateLods();
+
     UpdateCommandBuffer( CurrentVulkanBuffer.idx );
 
     // ... submit the command buffer to the device queue
@@ -572,6 +605,21 @@ void Application::UpdateCamera(float elapsedTime)
 }
 
 
+//-----------------------------------------------------------------------------
+void Application::UpdateLods()
+//-----------------------------------------------------------------------------
+{
+    // Scene is drawn with an identity model matrix, so the mesh bounds are already in world space.
+    for (auto& sceneObjectDrawable : m_SceneObject)
+    {
+        const auto& mesh = sceneObjectDrawable.GetMeshObject();
+        const glm::vec3 boundsMin{ mesh.m_BoundsMin[0], mesh.m_BoundsMin[1], mesh.m_BoundsMin[2] };
+        const glm::vec3 boundsMax{ mesh.m_BoundsMax[0], mesh.m_BoundsMax[1], mesh.m_BoundsMax[2] };
+        sceneObjectDrawable.SetLod( sceneObjectDrawable.SelectLod( m_Camera, boundsMin, boundsMax, float(gRenderHeight), gLodMaxPixelError ) );
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 bool Application::UpdateUniforms( uint32_t bufferIdx )
 //-----------------------------------------------------------------------------
@@ -875,6 +923,8 @@ void Application::ChangeMsaaMode()
     pVulkan->RecreateSwapChain();
 
     InitFramebuffersRenderPassesAndDrawables();
+    // Release the pipelines created for the old render passes
+    pVulkan->GetPipelineRegistry().Prune();
 }
 
 
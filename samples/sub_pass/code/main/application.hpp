@@ -51,6 +51,7 @@ public:
     void Render( float fltDiffTime ) override;
 
     void UpdateCamera( float elapsedTime );
+    void UpdateLods();
     bool UpdateUniforms( uint32_t bufferIdx );
     bool UpdateCommandBuffer( uint32_t bufferIdx );
 
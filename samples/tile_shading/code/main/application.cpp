@@ -736,7 +736,8 @@ bool Application::LoadMeshObjects()
     };
 
 
-    const auto loaderFlags = 0; // No instancing
+    // Scene is static (and the shaders use a single model matrix, so node transforms are ignored); batch meshes by material to cut the draw count.
+    const uint32_t loaderFlags = DrawableLoader::LoaderFlags::StaticBatch | DrawableLoader::LoaderFlags::IgnoreHierarchy;
     const bool ignoreTransforms = (loaderFlags & DrawableLoader::LoaderFlags::IgnoreHierarchy) != 0;
 
     const auto sceneAssetPath = std::filesystem::path(MESH_DESTINATION_PATH).append(gSceneAssetModel).string();
@@ -8,6 +8,10 @@
 
 #include "application.hpp"
 #include "main/applicationEntrypoint.hpp"
+#include "occlusionCullerTest.hpp"
+#include "shaderBundleTest.hpp"
+#include "textureFormatConvertTest.hpp"
+#include "texturePackerTest.hpp"
 #include "material/materialProps.h"
 #include "system/math_common.hpp"
 #include "system/os_common.h"
@@ -18,6 +22,10 @@
 glm::vec4 gClearColor = glm::vec4(0.3f, 0.3f, 0.3f, 1.0f);
 
 VAR( char*, gSceneAssetModel, "UVSphere_Separate.gltf", kVariableNonpersistent );
+VAR( bool, gRunOcclusionCullerTest, false, kVariableNonpersistent );    // run the cpu occlusion culler correctness test and benchmark at startup
+VAR( bool, gRunTextureFormatConvertTest, false, kVariableNonpersistent );   // run the exhaustive texture format conversion test (vector vs scalar reference) at startup
+VAR( bool, gRunTexturePackerTest, false, kVariableNonpersistent );    // run the texture packing planner (atlas/array layout and uv remap) test at startup
+VAR( bool, gRunShaderBundleTest, false, kVariableNonpersistent );     // run the shader bundle write/read round trip test at startup
 
 // The vertex buffer bind id, used as a constant in various places in the sample
 #define VERTEX_BUFFER_BIND_ID 0
@@ -75,6 +83,18 @@ bool Application::Initialize( uintptr_t windowHandle, uintptr_t instanceHandle)
         return false;
     }
 
+    if (gRunOcclusionCullerTest && !RunOcclusionCullerTest())
+        return false;
+
+    if (gRunTextureFormatConvertTest && !RunTextureFormatConvertTest())
+        return false;
+
+    if (gRunTexturePackerTest && !RunTexturePackerTest())
+        return false;
+
+    if (gRunShaderBundleTest && !RunShaderBundleTest(*m_AssetManager))
+        return false;
+
     if (!LoadMeshObjects())
         return false;
 
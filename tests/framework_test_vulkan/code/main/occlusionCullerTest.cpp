@@ -0,0 +1,242 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "occlusionCullerTest.hpp"
+#include "system/glm_common.hpp"
+#include "mesh/occlusionCuller.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct TestBox
+    {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+    };
+
+    /// Brute force depth buffer, 1 float per pixel, cleared to the far plane.
+    struct ReferenceDepth
+    {
+        int32_t width = 0;
+        int32_t height = 0;
+        std::vector<float> depth;
+    };
+
+    void AddBoxMesh( std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices, const glm::vec3& boundsMin, const glm::vec3& boundsMax )
+    {
+        const uint32_t base = uint32_t( positions.size() );
+        for (uint32_t corner = 0; corner < 8; ++corner)
+            positions.push_back( glm::vec3( (corner & 1) ? boundsMax.x : boundsMin.x, (corner & 2) ? boundsMax.y : boundsMin.y, (corner & 4) ? boundsMax.z : boundsMin.z ) );
+        static const uint32_t cFaces[12][3] = { {0,1,3}, {0,3,2}, {4,6,7}, {4,7,5}, {0,4,5}, {0,5,1}, {2,3,7}, {2,7,6}, {0,2,6}, {0,6,4}, {1,5,7}, {1,7,3} };
+        for (const auto& face : cFaces)
+            for (uint32_t corner : face)
+                indices.push_back( base + corner );
+    }
+
+    /// Per pixel (center sampled) rasterization of every occluder triangle.
+    /// Scene occluders are all in front of the near plane so no clipping is done.
+    void RasterizeReference( ReferenceDepth& reference, const glm::mat4& viewProjection, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices )
+    {
+        reference.depth.assign( size_t( reference.width ) * reference.height, 1.0f );
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            float x[3], y[3], z[3];
+            bool behind = false;
+            for (int k = 0; k < 3; ++k)
+            {
+                const glm::vec4 clip = viewProjection * glm::vec4( positions[indices[i + k]], 1.0f );
+                behind |= clip.z < 0.0f;
+                x[k] = (clip.x / clip.w * 0.5f + 0.5f) * float( reference.width );
+                y[k] = (clip.y / clip.w * 0.5f + 0.5f) * float( reference.height );
+                z[k] = clip.z / clip.w;
+            }
+            const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (behind || std::abs( area ) < 1.0e-6f)
+                continue;
+            const float width = float( reference.width );
+            const float height = float( reference.height );
+            const int32_t px0 = int32_t( std::clamp( std::min( { x[0], x[1], x[2] } ), 0.0f, width ) );
+            const int32_t px1 = int32_t( std::clamp( std::max( { x[0], x[1], x[2] } ), -1.0f, width - 1.0f ) );
+            const int32_t py0 = int32_t( std::clamp( std::min( { y[0], y[1], y[2] } ), 0.0f, height ) );
+            const int32_t py1 = int32_t( std::clamp( std::max( { y[0], y[1], y[2] } ), -1.0f, height - 1.0f ) );
+            for (int32_t py = py0; py <= py1; ++py)
+            {
+                for (int32_t px = px0; px <= px1; ++px)
+                {
+                    const float sx = float( px ) + 0.5f;
+                    const float sy = float( py ) + 0.5f;
+                    const float w0 = ((x[1] - sx) * (y[2] - sy) - (x[2] - sx) * (y[1] - sy)) / area;
+                    const float w1 = ((x[2] - sx) * (y[0] - sy) - (x[0] - sx) * (y[2] - sy)) / area;
+                    const float w2 = 1.0f - w0 - w1;
+                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                        continue;
+                    float& d = reference.depth[size_t( py ) * reference.width + px];
+                    d = std::min( d, w0 * z[0] + w1 * z[1] + w2 * z[2] );
+                }
+            }
+        }
+    }
+
+    /// Box is visible if its nearest depth is in front of any reference pixel under its screen rectangle.
+    bool IsVisibleReference( const ReferenceDepth& reference, const glm::mat4& viewProjection, const TestBox& box )
+    {
+        float minX = 1.0e30f, maxX = -1.0e30f, minY = 1.0e30f, maxY = -1.0e30f, minZ = 1.0e30f;
+        for (uint32_t corner = 0; corner < 8; ++corner)
+        {
+            const glm::vec4 clip = viewProjection * glm::vec4( (corner & 1) ? box.boundsMax.x : box.boundsMin.x, (corner & 2) ? box.boundsMax.y : box.boundsMin.y, (corner & 4) ? box.boundsMax.z : box.boundsMin.z, 1.0f );
+            if (clip.z < 0.0f)
+                return true;
+            minX = std::min( minX, clip.x / clip.w );
+            maxX = std::max( maxX, clip.x / clip.w );
+            minY = std::min( minY, clip.y / clip.w );
+            maxY = std::max( maxY, clip.y / clip.w );
+            minZ = std::min( minZ, clip.z / clip.w );
+        }
+        if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || minZ > 1.0f)
+            return false;
+        const float width = float( reference.width );
+        const float height = float( reference.height );
+        const int32_t x0 = int32_t( std::clamp( std::floor( (minX * 0.5f + 0.5f) * width ), 0.0f, width - 1.0f ) );
+        const int32_t x1 = int32_t( std::clamp( std::floor( (maxX * 0.5f + 0.5f) * width ), 0.0f, width - 1.0f ) );
+        const int32_t y0 = int32_t( std::clamp( std::floor( (minY * 0.5f + 0.5f) * height ), 0.0f, height - 1.0f ) );
+        const int32_t y1 = int32_t( std::clamp( std::floor( (maxY * 0.5f + 0.5f) * height ), 0.0f, height - 1.0f ) );
+        for (int32_t y = y0; y <= y1; ++y)
+            for (int32_t x = x0; x <= x1; ++x)
+                if (minZ <= reference.depth[size_t( y ) * reference.width + x])
+                    return true;
+        return false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool RunOcclusionCullerTest()
+//-----------------------------------------------------------------------------
+{
+    std::mt19937 rng( 42 );
+    std::uniform_real_distribution<float> unit( 0.0f, 1.0f );
+
+    // Occluders: boxes in front of the camera (at the origin looking down -z) plus a dense ground grid.
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 60; ++i)
+    {
+        const glm::vec3 center( unit( rng ) * 60.0f - 30.0f, unit( rng ) * 30.0f - 15.0f, -10.0f - unit( rng ) * 60.0f );
+        const glm::vec3 halfSize( 1.0f + unit( rng ) * 5.0f, 1.0f + unit( rng ) * 5.0f, 0.5f + unit( rng ) * 3.0f );
+        AddBoxMesh( positions, indices, center - halfSize, center + halfSize );
+    }
+    constexpr uint32_t cGridSize = 64;
+    const uint32_t gridBase = uint32_t( positions.size() );
+    for (uint32_t z = 0; z <= cGridSize; ++z)
+        for (uint32_t x = 0; x <= cGridSize; ++x)
+            positions.push_back( glm::vec3( -80.0f + 160.0f * float( x ) / cGridSize, -16.0f + std::sin( float( x ) * 0.3f ) * 0.5f, -2.0f - 120.0f * float( z ) / cGridSize ) );
+    for (uint32_t z = 0; z < cGridSize; ++z)
+    {
+        for (uint32_t x = 0; x < cGridSize; ++x)
+        {
+            const uint32_t corner = gridBase + z * (cGridSize + 1) + x;
+            indices.insert( indices.end(), { corner, corner + 1, corner + cGridSize + 2, corner, corner + cGridSize + 2, corner + cGridSize + 1 } );
+        }
+    }
+    // Off screen triangles whose bounds overlap the screen but project far outside the int32 range (not trivially rejected, must not overflow the pixel bounds).
+    {
+        const uint32_t base = uint32_t( positions.size() );
+        for (float sign : { 1.0f, -1.0f })
+        {
+            positions.push_back( glm::vec3( sign * 1.0e9f, 0.0f, -1.0f ) );
+            positions.push_back( glm::vec3( 0.0f, sign * 1.0e9f, -1.0f ) );
+            positions.push_back( glm::vec3( sign * 1.0e9f, sign * 1.0e9f, -1.0f ) );
+        }
+        indices.insert( indices.end(), { base, base + 1, base + 2, base + 3, base + 4, base + 5 } );
+    }
+
+    // Occludees.
+    std::vector<TestBox> boxes;
+    boxes.reserve( 20002 );
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        const glm::vec3 center( unit( rng ) * 160.0f - 80.0f, unit( rng ) * 40.0f - 20.0f, -3.0f - unit( rng ) * 117.0f );
+        const glm::vec3 halfSize( 0.2f + unit( rng ), 0.2f + unit( rng ), 0.2f + unit( rng ) );
+        boxes.push_back( { center - halfSize, center + halfSize } );
+    }
+    // Occludees projecting far outside the int32 range.
+    boxes.push_back( { glm::vec3( -1.0e9f, -1.0e9f, -150.0f ), glm::vec3( 1.0e9f, -15.0f, -149.0f ) } );
+    boxes.push_back( { glm::vec3( 1.0e9f, -1.0f, -10.0f ), glm::vec3( 2.0e9f, 1.0f, -9.0f ) } );
+
+    const glm::mat4 viewProjection = glm::perspectiveRH( 1.0f, 16.0f / 9.0f, 0.5f, 200.0f );
+    const glm::mat4 identity( 1.0f );
+    LOGI( "OcclusionCuller test: %zu occluder triangles, %zu occludees", indices.size() / 3, boxes.size() );
+
+    bool passed = true;
+    const uint32_t numThreads = std::max( 2u, OS_GetNumCores() );
+    for (const auto [width, height] : { std::pair<uint32_t, uint32_t>{ 1920, 1080 }, std::pair<uint32_t, uint32_t>{ 320, 180 } })
+    {
+        ReferenceDepth reference{ int32_t( width ), int32_t( height ) };
+        RasterizeReference( reference, viewProjection, positions, indices );
+
+        for (uint32_t threads : { 1u, numThreads })
+        {
+            OcclusionCuller culler;
+            if (!culler.Init( width, height, threads ))
+                return false;
+
+            // Best of a few runs (first run includes allocations).
+            uint64_t bestRasterizeUS = ~0ull, bestTestUS = ~0ull;
+            size_t numVisible = 0;
+            for (uint32_t run = 0; run < 10; ++run)
+            {
+                const uint64_t startUS = OS_GetTimeUS();
+                culler.BeginFrame( viewProjection );
+                culler.AddOccluder( positions, indices, identity );
+                culler.RasterizeOccluders();
+                const uint64_t rasterizedUS = OS_GetTimeUS();
+                numVisible = 0;
+                for (const auto& box : boxes)
+                    numVisible += culler.IsVisible( box.boundsMin, box.boundsMax, identity ) ? 1 : 0;
+                const uint64_t testedUS = OS_GetTimeUS();
+                bestRasterizeUS = std::min( bestRasterizeUS, rasterizedUS - startUS );
+                bestTestUS = std::min( bestTestUS, testedUS - rasterizedUS );
+            }
+            LOGI( "OcclusionCuller %ux%u (%u threads): rasterize %.3fms (%zu triangles), test %zu boxes %.3fms, %zu visible", width, height, threads, float( bestRasterizeUS ) * 0.001f, culler.GetNumTriangles(), boxes.size(), float( bestTestUS ) * 0.001f, numVisible );
+
+            size_t numReferenceVisible = 0, numWronglyCulled = 0;
+            for (const auto& box : boxes)
+            {
+                const bool referenceVisible = IsVisibleReference( reference, viewProjection, box );
+                numReferenceVisible += referenceVisible ? 1 : 0;
+                if (referenceVisible && !culler.IsVisible( box.boundsMin, box.boundsMax, identity ))
+                    ++numWronglyCulled;
+            }
+
+            // Tile depth must be at or behind every reference pixel in the tile.
+            size_t numTileViolations = 0;
+            for (uint32_t tileY = 0; tileY < culler.GetNumTilesY(); ++tileY)
+            {
+                for (uint32_t tileX = 0; tileX < culler.GetNumTilesX(); ++tileX)
+                {
+                    const float tileDepth = culler.GetTileDepth( tileX, tileY );
+                    for (uint32_t y = tileY * OcclusionCuller::cTileHeight; y < std::min( (tileY + 1) * OcclusionCuller::cTileHeight, height ); ++y)
+                        for (uint32_t x = tileX * OcclusionCuller::cTileWidth; x < std::min( (tileX + 1) * OcclusionCuller::cTileWidth, width ); ++x)
+                            if (reference.depth[size_t( y ) * width + x] > tileDepth + 1.0e-5f)
+                                ++numTileViolations;
+                }
+            }
+
+            LOGI( "OcclusionCuller %ux%u (%u threads) reference: %zu visible, %zu wrongly culled, %zu conservatively kept, %zu tile depth violations", width, height, threads, numReferenceVisible, numWronglyCulled, numVisible - (numReferenceVisible - numWronglyCulled), numTileViolations );
+            if (numWronglyCulled != 0 || numTileViolations != 0)
+            {
+                LOGE( "OcclusionCuller test FAILED at %ux%u (%u threads)", width, height, threads );
+                passed = false;
+            }
+        }
+    }
+    return passed;
+}
@@ -0,0 +1,19 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// @file occlusionCullerTest.hpp
+/// @brief Correctness check and benchmark for the cpu OcclusionCuller.
+///
+
+/// Rasterize a synthetic scene (box occluders and a dense ground grid) with the OcclusionCuller and compare against a brute force per pixel reference.
+/// Fails if any occludee box is culled that the reference sees, or any tile depth is nearer than a reference pixel inside the tile.
+/// Also logs rasterize and test timings at 1920x1080 and 320x180 (single and multi threaded).
+/// @returns true if the culler output is conservative against the reference.
+bool RunOcclusionCullerTest();
@@ -0,0 +1,303 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "shaderBundleTest.hpp"
+#include "material/shaderBundle.hpp"
+#include "material/shaderDescription.hpp"
+#include "system/assetManager.hpp"
+#include "system/os_common.h"
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* const cTestDirectory = "Cache/ShaderBundleTest/";
+    const char* const cShaderFile    = "Cache/ShaderBundleTest/Test.json";
+    const char* const cVertFile      = "Cache/ShaderBundleTest/Test.vert.spv";
+    const char* const cFragFile      = "Cache/ShaderBundleTest/Test.frag.spv";
+    const char* const cShadowFile    = "Cache/ShaderBundleTest/TestShadow.frag.spv";
+    const char* const cBundleFile    = "Cache/ShaderBundleTest/Test.shaderbundle";
+
+    /// Two passes (sharing the vertex shader) and two vertex buffers, exercising most of what the bundle serializes.
+    const char* const cShaderJson = R"({
+  "Passes": [
+    {
+      "Name": "RP_OPAQUE",
+      "Shaders": {
+        "Vertex": "Cache/ShaderBundleTest/Test.vert.spv",
+        "Fragment": "Cache/ShaderBundleTest/Test.frag.spv"
+      },
+      "DescriptorSets": [
+        {
+          "Buffers": [
+            { "Type": "UniformBuffer", "Stages": [ "Vertex" ], "Names": [ "Vert" ] },
+            { "Type": "UniformBuffer", "Stages": [ "Fragment" ], "Names": [ "Frag" ] },
+            { "Type": "ImageSampler", "Stages": [ "Fragment" ], "Count": 1, "Names": [ "Diffuse" ] },
+            { "Type": "ImageSampler", "Stages": [ "Fragment" ], "Count": 4, "Names": [ "Shadows" ] }
+          ]
+        }
+      ],
+      "VertexBindings": [ "VB0", "INST0" ],
+      "FixedFunction": {
+        "CullBackFace": true,
+        "DepthTestEnable": true,
+        "DepthWriteEnable": true,
+        "DepthCompareOp": "Greater"
+      },
+      "Outputs": [
+        { "BlendEnable": true, "SrcColorBlendFactor": "One", "DstColorBlendFactor": "OneMinusSrcAlpha" },
+        { "ColorWriteMask": 7 }
+      ],
+      "SpecializationConstants": [
+        { "Name": "NumLights", "Type": "Int32" },
+        { "Name": "Exposure", "Type": "Float" }
+      ]
+    },
+    {
+      "Name": "RP_SHADOW",
+      "Shaders": {
+        "Vertex": "Cache/ShaderBundleTest/Test.vert.spv",
+        "Fragment": "Cache/ShaderBundleTest/TestShadow.frag.spv"
+      },
+      "DescriptorSets": [
+        {
+          "Buffers": [
+            { "Type": "UniformBuffer", "Stages": [ "Vertex", "Fragment" ], "Names": [ "Shadow" ] }
+          ]
+        }
+      ],
+      "VertexBindings": [ "VB0" ],
+      "FixedFunction": {
+        "DepthTestEnable": true,
+        "DepthWriteEnable": true,
+        "DepthBiasEnable": true,
+        "DepthBiasConstant": 1.25,
+        "DepthBiasSlope": 1.75
+      }
+    }
+  ],
+  "Vertex": [
+    {
+      "Span": 32,
+      "Name": "VB0",
+      "Elements": [
+        { "Name": "Position", "Offset": 0, "Type": "Vec3" },
+        { "Name": "Normal", "Offset": 12, "Type": "Vec3" },
+        { "Name": "UV", "Offset": 24, "Type": "Vec2" }
+      ]
+    },
+    {
+      "Span": 16,
+      "Name": "INST0",
+      "Rate": "Instance",
+      "Elements": [
+        { "Name": "Offset", "Offset": 0, "Type": "Vec4" }
+      ]
+    }
+  ]
+}
+)";
+
+    /// Counts (and logs) failed checks.
+    struct TestResults
+    {
+        const char* pTestName = "";
+        uint32_t    numFailed = 0;
+
+        bool Check( bool condition, const char* pWhat )
+        {
+            if (!condition)
+            {
+                LOGE( "ShaderBundleTest %s: %s", pTestName, pWhat );
+                ++numFailed;
+            }
+            return condition;
+        }
+    };
+
+    /// Placeholder shader module (never given to Vulkan): SPIR-V magic number followed by a few recognizable words.
+    std::vector<char> MakeModule( uint32_t seed, uint32_t numWords )
+    {
+        std::vector<uint32_t> words{ 0x07230203 };
+        for (uint32_t i = 1; i < numWords; ++i)
+            words.push_back( seed * 0x9E3779B9u + i );
+        std::vector<char> data( words.size() * sizeof( uint32_t ) );
+        std::memcpy( data.data(), words.data(), data.size() );
+        return data;
+    }
+
+    void CheckPassesMatch( TestResults& results, const ShaderPassDescription& bundled, const ShaderPassDescription& expected )
+    {
+        results.Check( bundled.m_vertexName == expected.m_vertexName && bundled.m_fragmentName == expected.m_fragmentName && bundled.m_computeName == expected.m_computeName, "shader module names" );
+        results.Check( bundled.m_taskName == expected.m_taskName && bundled.m_meshName == expected.m_meshName, "task/mesh shader names" );
+        results.Check( bundled.m_rayGenerationName == expected.m_rayGenerationName && bundled.m_rayClosestHitName == expected.m_rayClosestHitName &&
+                       bundled.m_rayAnyHitName == expected.m_rayAnyHitName && bundled.m_rayMissName == expected.m_rayMissName, "ray tracing shader names" );
+
+        if (results.Check( bundled.m_sets.size() == expected.m_sets.size(), "descriptor set count" ))
+        {
+            for (size_t setIdx = 0; setIdx < expected.m_sets.size(); ++setIdx)
+            {
+                const auto& bundledSet = bundled.m_sets[setIdx];
+                const auto& expectedSet = expected.m_sets[setIdx];
+                results.Check( bundledSet.m_name == expectedSet.m_name && bundledSet.m_setIndex == expectedSet.m_setIndex, "descriptor set name/index" );
+                if (!results.Check( bundledSet.m_descriptorTypes.size() == expectedSet.m_descriptorTypes.size(), "descriptor count" ))
+                    continue;
+                for (size_t descIdx = 0; descIdx < expectedSet.m_descriptorTypes.size(); ++descIdx)
+                {
+                    const auto& a = bundledSet.m_descriptorTypes[descIdx];
+                    const auto& b = expectedSet.m_descriptorTypes[descIdx];
+                    results.Check( a.type == b.type && DescriptorSetDescription::StageFlag::t( a.stages ) == DescriptorSetDescription::StageFlag::t( b.stages ), "descriptor type/stages" );
+                    results.Check( a.names == b.names && a.count == b.count && a.readOnly == b.readOnly && a.descriptorIndex == b.descriptorIndex, "descriptor names/count/flags" );
+                }
+            }
+        }
+
+        if (results.Check( bundled.m_outputs.size() == expected.m_outputs.size(), "output count" ))
+        {
+            for (size_t outputIdx = 0; outputIdx < expected.m_outputs.size(); ++outputIdx)
+            {
+                const auto& a = bundled.m_outputs[outputIdx];
+                const auto& b = expected.m_outputs[outputIdx];
+                results.Check( a.blendEnable == b.blendEnable && a.srcColorBlendFactor == b.srcColorBlendFactor && a.dstColorBlendFactor == b.dstColorBlendFactor &&
+                               a.srcAlphaBlendFactor == b.srcAlphaBlendFactor && a.dstAlphaBlendFactor == b.dstAlphaBlendFactor && a.colorWriteMask == b.colorWriteMask, "output blend state" );
+            }
+        }
+
+        const auto& ffA = bundled.m_fixedFunctionSettings;
+        const auto& ffB = expected.m_fixedFunctionSettings;
+        results.Check( ffA.depthTestEnable == ffB.depthTestEnable && ffA.depthWriteEnable == ffB.depthWriteEnable && ffA.depthCompareOp == ffB.depthCompareOp && ffA.depthClampEnable == ffB.depthClampEnable, "fixed function depth state" );
+        results.Check( ffA.depthBiasEnable == ffB.depthBiasEnable && ffA.depthBiasConstant == ffB.depthBiasConstant && ffA.depthBiasClamp == ffB.depthBiasClamp && ffA.depthBiasSlope == ffB.depthBiasSlope, "fixed function depth bias" );
+        results.Check( ffA.cullFrontFace == ffB.cullFrontFace && ffA.cullBackFace == ffB.cullBackFace, "fixed function culling" );
+
+        const auto& ssA = bundled.m_sampleShadingSettings;
+        const auto& ssB = expected.m_sampleShadingSettings;
+        results.Check( ssA.sampleShadingEnable == ssB.sampleShadingEnable && ssA.forceCenterSample == ssB.forceCenterSample && ssA.sampleShadingMask == ssB.sampleShadingMask, "sample shading settings" );
+        results.Check( bundled.m_workGroupSettings.localSize == expected.m_workGroupSettings.localSize && bundled.m_workGroupSettings.perTileDispatch == expected.m_workGroupSettings.perTileDispatch, "workgroup settings" );
+        results.Check( bundled.m_rayTracingSettings.maxRayRecursionDepth == expected.m_rayTracingSettings.maxRayRecursionDepth, "ray tracing settings" );
+        results.Check( bundled.m_vertexFormatBindings == expected.m_vertexFormatBindings, "vertex format bindings" );
+
+        if (results.Check( bundled.m_constants.size() == expected.m_constants.size(), "specialization constant count" ))
+        {
+            for (size_t constantIdx = 0; constantIdx < expected.m_constants.size(); ++constantIdx)
+            {
+                const auto& a = bundled.m_constants[constantIdx];
+                const auto& b = expected.m_constants[constantIdx];
+                results.Check( a.name == b.name && a.constantIndex == b.constantIndex && a.type == b.type, "specialization constant" );
+            }
+        }
+        results.Check( bundled.m_rootSamplers.size() == expected.m_rootSamplers.size(), "root sampler count" );
+    }
+
+    void CheckDescriptionsMatch( TestResults& results, const ShaderDescription& bundled, const ShaderDescription& expected )
+    {
+        results.Check( bundled.m_passNameToIndex == expected.m_passNameToIndex, "pass names" );
+
+        if (results.Check( bundled.m_vertexFormats.size() == expected.m_vertexFormats.size(), "vertex format count" ))
+        {
+            for (size_t formatIdx = 0; formatIdx < expected.m_vertexFormats.size(); ++formatIdx)
+            {
+                const auto& a = bundled.m_vertexFormats[formatIdx];
+                const auto& b = expected.m_vertexFormats[formatIdx];
+                results.Check( a.span == b.span && a.inputRate == b.inputRate, "vertex format span/rate" );
+                results.Check( a.elements == b.elements && a.elementIds == b.elementIds, "vertex format elements" );
+            }
+        }
+
+        if (results.Check( bundled.m_descriptionPerPass.size() == expected.m_descriptionPerPass.size(), "pass count" ))
+        {
+            for (size_t passIdx = 0; passIdx < expected.m_descriptionPerPass.size(); ++passIdx)
+                CheckPassesMatch( results, bundled.m_descriptionPerPass[passIdx], expected.m_descriptionPerPass[passIdx] );
+        }
+    }
+
+    void CheckModuleMatches( TestResults& results, const ShaderBundle& bundle, const char* pModuleName, const std::vector<char>& expected )
+    {
+        const auto code = bundle.GetShaderModuleCode( pModuleName );
+        results.Check( code.size_bytes() == expected.size() && std::memcmp( code.data(), expected.data(), expected.size() ) == 0, "shader module binary" );
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+bool RunShaderBundleTest( AssetManager& assetManager )
+//-----------------------------------------------------------------------------
+{
+    LOGI( "ShaderBundleTest: starting" );
+    TestResults results;
+
+    std::error_code ec;
+    std::filesystem::create_directories( assetManager.GetDevicePath( cTestDirectory ), ec );
+
+    const std::string shaderJson = cShaderJson;
+    const auto vertModule = MakeModule( 1, 64 );
+    const auto fragModule = MakeModule( 2, 48 );
+    const auto shadowModule = MakeModule( 3, 16 );
+    if (!assetManager.SaveMemoryToFile( cShaderFile, shaderJson ) || !assetManager.SaveMemoryToFile( cVertFile, vertModule ) ||
+        !assetManager.SaveMemoryToFile( cFragFile, fragModule ) || !assetManager.SaveMemoryToFile( cShadowFile, shadowModule ))
+    {
+        LOGE( "ShaderBundleTest: unable to write the test files to %s", cTestDirectory );
+        return false;
+    }
+
+    {
+        results.pTestName = "RoundTrip";
+        ShaderBundleWriter writer;
+        results.Check( writer.AddShader( assetManager, "Test", cShaderFile ), "ShaderBundleWriter::AddShader" );
+        results.Check( writer.Save( assetManager, cBundleFile ), "ShaderBundleWriter::Save" );
+
+        ShaderBundle bundle;
+        if (results.Check( bundle.Load( assetManager, cBundleFile, true ), "ShaderBundle::Load" ))
+        {
+            results.Check( bundle.GetShaderNames() == std::vector<std::string>{ "Test" }, "shader names" );
+            results.Check( bundle.VerifySourceHashes( assetManager ), "VerifySourceHashes on unchanged sources" );
+            results.Check( !bundle.GetShaderDescription( "Missing" ), "unknown shader name" );
+
+            auto expected = ShaderDescriptionLoader::Load( assetManager, cShaderFile );
+            auto bundled = bundle.GetShaderDescription( "Test" );
+            if (results.Check( expected.has_value() && bundled.has_value(), "shader description" ))
+                CheckDescriptionsMatch( results, *bundled, *expected );
+
+            CheckModuleMatches( results, bundle, cVertFile, vertModule );
+            CheckModuleMatches( results, bundle, cFragFile, fragModule );
+            CheckModuleMatches( results, bundle, cShadowFile, shadowModule );
+            results.Check( bundle.GetShaderModuleCode( "Missing.spv" ).empty(), "unknown shader module" );
+        }
+    }
+
+    {
+        // Same size, different contents: only the hash check can see this.
+        results.pTestName = "StaleSameSize";
+        const auto changedModule = MakeModule( 4, 48 );
+        assetManager.SaveMemoryToFile( cFragFile, changedModule );
+
+        ShaderBundle bundle;
+        if (results.Check( bundle.Load( assetManager, cBundleFile, true ), "size check passes a same size change" ))
+            results.Check( !bundle.VerifySourceHashes( assetManager ), "VerifySourceHashes rejects a changed source" );
+    }
+
+    {
+        results.pTestName = "StaleSize";
+        const auto changedModule = MakeModule( 2, 52 );
+        assetManager.SaveMemoryToFile( cFragFile, changedModule );
+
+        ShaderBundle bundle;
+        results.Check( !bundle.Load( assetManager, cBundleFile, true ), "size check rejects a resized source" );
+        results.Check( bundle.Load( assetManager, cBundleFile, false ), "unchecked load ignores the sources" );
+    }
+
+    for (const char* pFile : { cShaderFile, cVertFile, cFragFile, cShadowFile, cBundleFile })
+        std::filesystem::remove( assetManager.GetDevicePath( pFile ), ec );
+
+    if (results.numFailed == 0)
+        LOGI( "ShaderBundleTest: passed" );
+    else
+        LOGE( "ShaderBundleTest: %u checks failed", results.numFailed );
+    return results.numFailed == 0;
+}
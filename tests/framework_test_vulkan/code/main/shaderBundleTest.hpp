@@ -0,0 +1,21 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// @file shaderBundleTest.hpp
+/// @brief Round trip check of the shader bundle (ShaderBundleWriter / ShaderBundle).
+///
+
+class AssetManager;
+
+/// Write a json shader description (and some placeholder shader modules), build a bundle from them with ShaderBundleWriter, load it back with ShaderBundle
+/// and check every ShaderPassDescription (and the vertex formats and module binaries) matches the json loaded directly with ShaderDescriptionLoader.
+/// Also checks the stale bundle detection (Load's source size check and VerifySourceHashes).  Writes (and removes) a few small files under Cache/.
+/// @returns true if every check passed (failures are logged).
+bool RunShaderBundleTest( AssetManager& assetManager );
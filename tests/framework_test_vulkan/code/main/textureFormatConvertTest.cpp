@@ -0,0 +1,265 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "textureFormatConvertTest.hpp"
+#include "texture/textureFormatConvert.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace TextureFormatConvertScalar;
+
+namespace
+{
+    /// Values per conversion call in the exhaustive sweeps (keeps memory use small).
+    constexpr uint32_t cChunkSize = 1 << 20;
+
+    uint32_t FloatBits( float f )
+    {
+        uint32_t u;
+        memcpy( &u, &f, sizeof( u ) );
+        return u;
+    }
+
+    float BitsFloat( uint32_t u )
+    {
+        float f;
+        memcpy( &f, &u, sizeof( f ) );
+        return f;
+    }
+
+    /// Exact value of a small float with an implicit leading 1 (exponent bias 15, as used by half and the packed 10/11 bit floats).
+    /// @returns false for inf/nan encodings.
+    bool SmallFloatValue( uint32_t exponent, uint32_t mantissa, uint32_t mantissaBits, double& value )
+    {
+        if (exponent == 31)
+            return false;
+        const double fraction = double( mantissa ) / double( 1u << mantissaBits );
+        value = exponent ? std::ldexp( 1.0 + fraction, int( exponent ) - 15 ) : std::ldexp( fraction, -14 );
+        return true;
+    }
+
+    /// Log (the first few) mismatches and return the count.
+    template<typename T_VALUE, typename T_RESULT>
+    size_t CountMismatches( const char* pName, std::span<const T_VALUE> input, std::span<const T_RESULT> output, std::span<const T_RESULT> expected, size_t& numLogged )
+    {
+        size_t numMismatches = 0;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            if (output[i] == expected[i])
+                continue;
+            if (numLogged++ < 8)
+                LOGE( "%s mismatch: input 0x%08x, output 0x%08x, expected 0x%08x", pName, uint32_t( input[i] ), uint32_t( output[i] ), uint32_t( expected[i] ) );
+            ++numMismatches;
+        }
+        return numMismatches;
+    }
+
+    size_t TestByteShuffles()
+    {
+        std::mt19937 rng( 1 );
+        size_t numMismatches = 0;
+        // Lengths either side of the 16 and 64 byte vector steps.
+        for (size_t numPixels : { 0, 1, 5, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 4099 })
+        {
+            std::vector<uint8_t> rgb( numPixels * 3 );
+            for (auto& value : rgb)
+                value = uint8_t( rng() );
+            std::vector<uint8_t> rgba( numPixels * 4 ), rg( numPixels * 2 ), rgbBack( numPixels * 3 ), bgra( numPixels * 4 );
+            ConvertRgb8ToRgba8( rgb, rgba, 77 );
+            ConvertRgb8ToRg8( rgb, rg );
+            ConvertRgba8ToRgb8( rgba, rgbBack );
+            SwizzleRgba8Bgra8( rgba, bgra );
+            for (size_t i = 0; i < numPixels; ++i)
+            {
+                for (size_t c = 0; c < 3; ++c)
+                    numMismatches += (rgba[i * 4 + c] != rgb[i * 3 + c] || rgbBack[i * 3 + c] != rgb[i * 3 + c]) ? 1 : 0;
+                numMismatches += rgba[i * 4 + 3] != 77 ? 1 : 0;
+                numMismatches += (rg[i * 2] != rgb[i * 3] || rg[i * 2 + 1] != rgb[i * 3 + 1]) ? 1 : 0;
+                numMismatches += (bgra[i * 4] != rgba[i * 4 + 2] || bgra[i * 4 + 1] != rgba[i * 4 + 1] || bgra[i * 4 + 2] != rgba[i * 4] || bgra[i * 4 + 3] != rgba[i * 4 + 3]) ? 1 : 0;
+            }
+            // In place swizzle back.
+            SwizzleRgba8Bgra8( bgra, bgra );
+            numMismatches += bgra != rgba ? 1 : 0;
+        }
+        LOGI( "TextureFormatConvert byte shuffles: %zu mismatches", numMismatches );
+        return numMismatches;
+    }
+
+    size_t TestHalfToFloat()
+    {
+        // Every half value.
+        std::vector<uint16_t> halfs( 65536 );
+        for (uint32_t i = 0; i < 65536; ++i)
+            halfs[i] = uint16_t( i );
+        std::vector<float> floats( halfs.size() );
+        ConvertFloat16ToFloat32( halfs, floats );
+
+        std::vector<uint32_t> outputBits( halfs.size() ), expectedBits( halfs.size() );
+        size_t numMismatches = 0;
+        for (uint32_t i = 0; i < 65536; ++i)
+        {
+            outputBits[i] = FloatBits( floats[i] );
+            expectedBits[i] = FloatBits( HalfToFloat( uint16_t( i ) ) );
+            // Reference against the exact value.
+            double value;
+            if (SmallFloatValue( (i >> 10) & 31, i & 1023, 10, value ) && HalfToFloat( uint16_t( i ) ) != float( (i & 0x8000) ? -value : value ))
+                ++numMismatches;
+        }
+        size_t numLogged = 0;
+        numMismatches += CountMismatches<uint16_t, uint32_t>( "ConvertFloat16ToFloat32", halfs, outputBits, expectedBits, numLogged );
+        LOGI( "TextureFormatConvert half to float (all 65536 values): %zu mismatches", numMismatches );
+        return numMismatches;
+    }
+
+    size_t TestFloatToHalf()
+    {
+        size_t numMismatches = 0;
+        // Every half round trips exactly (other than nan payloads).
+        for (uint32_t i = 0; i < 65536; ++i)
+        {
+            const bool isNan = ((i >> 10) & 31) == 31 && (i & 1023) != 0;
+            if (!isNan && FloatToHalf( HalfToFloat( uint16_t( i ) ) ) != i)
+                ++numMismatches;
+        }
+
+        // Every 32bit float.
+        std::vector<uint32_t> inputBits( cChunkSize );
+        std::vector<float> floats( cChunkSize );
+        std::vector<uint16_t> output( cChunkSize ), expected( cChunkSize );
+        size_t numLogged = 0;
+        for (uint64_t chunkStart = 0; chunkStart <= std::numeric_limits<uint32_t>::max(); chunkStart += cChunkSize)
+        {
+            for (uint32_t i = 0; i < cChunkSize; ++i)
+            {
+                inputBits[i] = uint32_t( chunkStart + i );
+                floats[i] = BitsFloat( inputBits[i] );
+                expected[i] = FloatToHalf( floats[i] );
+            }
+            ConvertFloat32ToFloat16( floats, output );
+            numMismatches += CountMismatches<uint32_t, uint16_t>( "ConvertFloat32ToFloat16", inputBits, output, expected, numLogged );
+        }
+        LOGI( "TextureFormatConvert float to half (all 2^32 values): %zu mismatches", numMismatches );
+        return numMismatches;
+    }
+
+    size_t TestSrgb()
+    {
+        size_t numMismatches = 0;
+        size_t numLogged = 0;
+
+        // Every sRGB value to linear, and back (3 channels, and 4 with the alpha as unorm).
+        for (uint32_t numChannels : { 3u, 4u })
+        {
+            std::vector<uint8_t> srgb( 256 * numChannels );
+            for (size_t i = 0; i < srgb.size(); ++i)
+                srgb[i] = uint8_t( i / numChannels );
+            std::vector<float> linear( srgb.size() );
+            ConvertSrgb8ToLinearFloat( srgb, linear, numChannels );
+            std::vector<uint8_t> srgbBack( srgb.size() );
+            ConvertLinearFloatToSrgb8( linear, srgbBack, numChannels );
+            for (size_t i = 0; i < srgb.size(); ++i)
+            {
+                const bool isAlpha = numChannels == 4 && (i % 4) == 3;
+                numMismatches += linear[i] != (isAlpha ? float( srgb[i] ) * (1.0f / 255.0f) : Srgb8ToLinear( srgb[i] )) ? 1 : 0;
+                numMismatches += srgbBack[i] != srgb[i] ? 1 : 0;
+            }
+        }
+
+        // Every float in [0,1] (values outside clamp, checked with the specials below).
+        std::vector<uint32_t> inputBits( cChunkSize );
+        std::vector<float> floats( cChunkSize );
+        std::vector<uint8_t> output( cChunkSize ), expected( cChunkSize );
+        const uint32_t cOneBits = FloatBits( 1.0f );
+        for (uint32_t chunkStart = 0; chunkStart <= cOneBits; chunkStart += cChunkSize)
+        {
+            const uint32_t count = std::min( cChunkSize, cOneBits + 1 - chunkStart );
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                inputBits[i] = chunkStart + i;
+                floats[i] = BitsFloat( inputBits[i] );
+                expected[i] = LinearToSrgb8( floats[i] );
+            }
+            ConvertLinearFloatToSrgb8( std::span( floats ).first( count ), output, 1 );
+            numMismatches += CountMismatches<uint32_t, uint8_t>( "ConvertLinearFloatToSrgb8", std::span( inputBits ).first( count ), std::span( output ).first( count ), std::span( expected ).first( count ), numLogged );
+        }
+        const float specials[] = { -0.0f, -1.0f, 1.0000001f, 2.0f, 1.0e30f, -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min() };
+        for (float special : specials)
+        {
+            uint8_t value;
+            ConvertLinearFloatToSrgb8( { &special, 1 }, { &value, 1 }, 1 );
+            if (value != LinearToSrgb8( special ))
+            {
+                LOGE( "ConvertLinearFloatToSrgb8 mismatch: input 0x%08x, output %u, expected %u", FloatBits( special ), value, LinearToSrgb8( special ) );
+                ++numMismatches;
+            }
+        }
+        LOGI( "TextureFormatConvert sRGB (all 8bit values, all floats in [0,1]): %zu mismatches", numMismatches );
+        return numMismatches;
+    }
+
+    size_t TestB10G11R11()
+    {
+        size_t numMismatches = 0;
+        // Every 11 bit value in red and green, every 10 bit value in blue (lengths give vector tails), plus random packed values.
+        std::vector<uint32_t> packed;
+        for (uint32_t i = 0; i < 2048; ++i)
+            packed.push_back( i | (((i * 7) & 2047) << 11) | ((i & 1023) << 22) );
+        std::mt19937 rng( 1 );
+        for (uint32_t i = 0; i < 1001; ++i)
+            packed.push_back( uint32_t( rng() ) );
+        std::vector<float> rgba( packed.size() * 4 );
+        UnpackB10G11R11UfloatToRgba32f( packed, rgba );
+        for (size_t i = 0; i < packed.size(); ++i)
+        {
+            float rgb[3];
+            UnpackB10G11R11Ufloat( packed[i], rgb );
+            for (size_t c = 0; c < 3; ++c)
+                numMismatches += FloatBits( rgb[c] ) != FloatBits( rgba[i * 4 + c] ) ? 1 : 0;
+            numMismatches += rgba[i * 4 + 3] != 1.0f ? 1 : 0;
+        }
+
+        // Reference against the exact values.
+        for (uint32_t i = 0; i < 2048; ++i)
+        {
+            float rgb[3];
+            UnpackB10G11R11Ufloat( i | (i << 11) | ((i & 1023) << 22), rgb );
+            double value;
+            if (SmallFloatValue( i >> 6, i & 63, 6, value ))
+                numMismatches += (rgb[0] != float( value ) || rgb[1] != rgb[0]) ? 1 : 0;
+            if (SmallFloatValue( (i & 1023) >> 5, i & 31, 5, value ))
+                numMismatches += rgb[2] != float( value ) ? 1 : 0;
+        }
+        LOGI( "TextureFormatConvert B10G11R11 (all 10 and 11 bit values): %zu mismatches", numMismatches );
+        return numMismatches;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool RunTextureFormatConvertTest()
+//-----------------------------------------------------------------------------
+{
+    const uint64_t startUS = OS_GetTimeUS();
+    size_t numMismatches = 0;
+    numMismatches += TestByteShuffles();
+    numMismatches += TestHalfToFloat();
+    numMismatches += TestFloatToHalf();
+    numMismatches += TestSrgb();
+    numMismatches += TestB10G11R11();
+    if (numMismatches != 0)
+    {
+        LOGE( "TextureFormatConvert test FAILED (%zu mismatches)", numMismatches );
+        return false;
+    }
+    LOGI( "TextureFormatConvert test passed (%.1fs)", float( OS_GetTimeUS() - startUS ) * 0.000001f );
+    return true;
+}
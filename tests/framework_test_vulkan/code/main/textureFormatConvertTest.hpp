@@ -0,0 +1,20 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// @file textureFormatConvertTest.hpp
+/// @brief Bit exact check of the (vectorized) texture format conversions against the scalar reference.
+///
+
+/// Compare every bulk conversion in textureFormatConvert.hpp against TextureFormatConvertScalar (which is itself checked against the exact values).
+/// Exhaustive where the input domain allows: every half value, every 32bit float (float to half), every float in [0,1] (linear to sRGB) and every
+/// 10 and 11 bit packed float channel value.  Byte shuffles are checked at lengths either side of the vector widths (tail handling).
+/// Takes around 30 seconds on a desktop cpu (longer on mobile), mismatches are logged.
+/// @returns true if every conversion matched.
+bool RunTextureFormatConvertTest();
@@ -0,0 +1,286 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "texturePackerTest.hpp"
+#include "mesh/meshIntermediate.hpp"
+#include "texture/texturePacker.hpp"
+#include "system/os_common.h"
+#include <cmath>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    /// Counts (and logs) failed checks.
+    struct TestResults
+    {
+        const char* pTestName = "";
+        uint32_t    numFailed = 0;
+
+        bool Check( bool condition, const char* pWhat )
+        {
+            if (!condition)
+            {
+                LOGE( "TexturePackerTest %s: %s", pTestName, pWhat );
+                ++numFailed;
+            }
+            return condition;
+        }
+    };
+
+    bool NearlyEqual( const glm::vec4& a, const glm::vec4& b )
+    {
+        return std::abs( a.x - b.x ) < 1.0e-6f && std::abs( a.y - b.y ) < 1.0e-6f && std::abs( a.z - b.z ) < 1.0e-6f && std::abs( a.w - b.w ) < 1.0e-6f;
+    }
+
+    TexturePackerSet MakeSet( std::vector<TexturePackerTexture> textures, bool allowAtlas = true )
+    {
+        return TexturePackerSet{ std::move( textures ), allowAtlas };
+    }
+
+    /// Checks every plan must pass: regions inside their packed texture, no overlapping atlas regions, block aligned atlas regions, each source packed at most once
+    /// and TexturePackLayout::locations (and setUvScaleOffsets) agreeing with the regions.
+    void CheckLayoutConsistent( TestResults& results, std::span<const TexturePackerSet> sets, const TexturePackLayout& layout )
+    {
+        results.Check( layout.setUvScaleOffsets.size() == sets.size(), "one uv scale/offset per set" );
+
+        std::unordered_set<std::string> packedSlots;
+        for (uint32_t packedIdx = 0; packedIdx < (uint32_t) layout.packedTextures.size(); ++packedIdx)
+        {
+            const auto& packed = layout.packedTextures[packedIdx];
+            results.Check( packed.isAtlas ? packed.layers == 1 : packed.layers == packed.regions.size(), "packed texture layer count" );
+            for (size_t regionIdx = 0; regionIdx < packed.regions.size(); ++regionIdx)
+            {
+                const auto& region = packed.regions[regionIdx];
+                results.Check( packedSlots.insert( region.slotName ).second, "source texture packed more than once" );
+                results.Check( region.x + region.width <= packed.width && region.y + region.height <= packed.height && region.layer < packed.layers, "region outside its packed texture" );
+
+                auto locationIt = layout.locations.find( region.slotName );
+                if (!results.Check( locationIt != layout.locations.end(), "packed source missing from locations" ))
+                    continue;
+                const auto& location = locationIt->second;
+                results.Check( location.packedTextureIndex == packedIdx && location.layer == region.layer, "location does not match its region" );
+                if (packed.isAtlas)
+                {
+                    const glm::vec4 expected{ float( region.width ) / float( packed.width ), float( region.height ) / float( packed.height ), float( region.x ) / float( packed.width ), float( region.y ) / float( packed.height ) };
+                    results.Check( NearlyEqual( location.uvScaleOffset, expected ), "atlas uv scale/offset does not map 0-1 on to the region" );
+                    // Regions must stay 4x4 block aligned down to the smallest atlas mip.
+                    const uint32_t alignment = 4u << (packed.mipLevels - 1);
+                    results.Check( region.x % alignment == 0 && region.y % alignment == 0, "atlas region not aligned to the smallest mip's blocks" );
+                    for (size_t otherIdx = 0; otherIdx < regionIdx; ++otherIdx)
+                    {
+                        const auto& other = packed.regions[otherIdx];
+                        const bool overlap = region.x < other.x + other.width && other.x < region.x + region.width && region.y < other.y + other.height && other.y < region.y + region.height;
+                        results.Check( !overlap, "atlas regions overlap" );
+                    }
+                }
+                else
+                {
+                    results.Check( NearlyEqual( location.uvScaleOffset, glm::vec4( 1.0f, 1.0f, 0.0f, 0.0f ) ), "texture array uv scale/offset is not identity" );
+                    results.Check( region.x == 0 && region.y == 0 && region.width == packed.width && region.height == packed.height, "texture array region is not the whole layer" );
+                }
+            }
+        }
+        results.Check( packedSlots.size() == layout.locations.size(), "locations has textures that were not packed" );
+
+        // Every texture in an atlased set shares the set's uv remap.
+        for (size_t setIdx = 0; setIdx < sets.size(); ++setIdx)
+        {
+            for (const auto& texture : sets[setIdx].textures)
+            {
+                auto locationIt = layout.locations.find( texture.slotName );
+                if (locationIt != layout.locations.end() && layout.packedTextures[locationIt->second.packedTextureIndex].isAtlas)
+                    results.Check( NearlyEqual( locationIt->second.uvScaleOffset, layout.setUvScaleOffsets[setIdx] ), "atlased texture uv scale/offset differs from its set's" );
+            }
+        }
+    }
+
+    /// Four same sized single texture sets shelf pack in to a 2x2 atlas.
+    void TestShelfPackGrid( TestResults& results )
+    {
+        results.pTestName = "ShelfPackGrid";
+        std::vector<TexturePackerSet> sets;
+        for (uint32_t i = 0; i < 4; ++i)
+            sets.push_back( MakeSet( { { "grid" + std::to_string( i ), TextureFormat::BC7_UNORM_BLOCK, 128, 128, 8 } } ) );
+        const TexturePackLayout layout = PlanTexturePacking( sets, { .atlasMaxDimension = 128, .atlasSize = 256 } );
+        CheckLayoutConsistent( results, sets, layout );
+
+        if (!results.Check( layout.packedTextures.size() == 1, "expected a single atlas" ))
+            return;
+        const auto& atlas = layout.packedTextures[0];
+        results.Check( atlas.isAtlas && atlas.width == 256 && atlas.height == 256 && atlas.format == TextureFormat::BC7_UNORM_BLOCK, "atlas size/format" );
+        results.Check( atlas.mipLevels == 6, "atlas mips stop at 4x4 (128 -> 4 is 6 levels)" );
+        results.Check( atlas.regions.size() == 4, "all four textures atlased" );
+        const glm::vec4 expected[4] = { { 0.5f, 0.5f, 0.0f, 0.0f }, { 0.5f, 0.5f, 0.5f, 0.0f }, { 0.5f, 0.5f, 0.0f, 0.5f }, { 0.5f, 0.5f, 0.5f, 0.5f } };
+        for (uint32_t i = 0; i < 4; ++i)
+            results.Check( NearlyEqual( layout.setUvScaleOffsets[i], expected[i] ), "grid uv scale/offset (shelves fill left to right, then top to bottom)" );
+    }
+
+    /// Mixed sizes are packed tallest first, the used area is trimmed to a power of 2 and textures that do not fit start a new page.
+    void TestShelfPackMixedSizes( TestResults& results )
+    {
+        results.pTestName = "ShelfPackMixedSizes";
+        const uint32_t sizes[] = { 32, 64, 128, 64, 32, 64 };
+        std::vector<TexturePackerSet> sets;
+        for (uint32_t i = 0; i < std::size( sizes ); ++i)
+            sets.push_back( MakeSet( { { "mixed" + std::to_string( i ), TextureFormat::R8G8B8A8_UNORM, sizes[i], sizes[i], 1 } } ) );
+        const TexturePackLayout layout = PlanTexturePacking( sets, { .atlasMaxDimension = 128, .atlasSize = 256 } );
+        CheckLayoutConsistent( results, sets, layout );
+
+        if (!results.Check( layout.packedTextures.size() == 1 && layout.packedTextures[0].isAtlas, "expected a single atlas" ))
+            return;
+        const auto& atlas = layout.packedTextures[0];
+        results.Check( atlas.width == 256 && atlas.height == 256 && atlas.mipLevels == 1, "atlas size/mips" );
+        results.Check( atlas.regions.size() == std::size( sizes ), "all textures atlased" );
+        // 128 on the first shelf with two of the 64s, the last 64 and both 32s on the second shelf.
+        results.Check( NearlyEqual( layout.setUvScaleOffsets[2], { 0.5f, 0.5f, 0.0f, 0.0f } ), "tallest texture placed first" );
+        results.Check( NearlyEqual( layout.setUvScaleOffsets[5], { 0.25f, 0.25f, 0.0f, 0.5f } ), "texture that overflows the shelf starts the next shelf" );
+
+        // Same textures in to a smaller atlas; the 128 fills the first page on its own (not worth an atlas) so the rest go on a second page.
+        const TexturePackLayout pagedLayout = PlanTexturePacking( sets, { .atlasMaxDimension = 128, .atlasSize = 128 } );
+        CheckLayoutConsistent( results, sets, pagedLayout );
+        results.Check( pagedLayout.packedTextures.size() == 1 && pagedLayout.packedTextures[0].regions.size() == std::size( sizes ) - 1, "textures that do not fit the page start a new page" );
+        results.Check( pagedLayout.locations.count( "mixed2" ) == 0, "page with a single texture is not atlased" );
+    }
+
+    /// Multi texture sets get one atlas per texture, with the same layout in each.
+    void TestShelfPackMaterialSets( TestResults& results )
+    {
+        results.pTestName = "ShelfPackMaterialSets";
+        std::vector<TexturePackerSet> sets;
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            const std::string name = "material" + std::to_string( i );
+            sets.push_back( MakeSet( { { name + "_albedo", TextureFormat::BC7_SRGB_BLOCK, 64, 64, 7 }, { name + "_normal", TextureFormat::BC5_UNORM_BLOCK, 64, 64, 7 } } ) );
+        }
+        const TexturePackLayout layout = PlanTexturePacking( sets, { .atlasMaxDimension = 64, .atlasSize = 256 } );
+        CheckLayoutConsistent( results, sets, layout );
+
+        if (!results.Check( layout.packedTextures.size() == 2, "expected one atlas per texture in the set" ))
+            return;
+        results.Check( layout.packedTextures[0].format == TextureFormat::BC7_SRGB_BLOCK && layout.packedTextures[1].format == TextureFormat::BC5_UNORM_BLOCK, "atlas formats follow the set's texture order" );
+        results.Check( layout.packedTextures[0].mipLevels == 5, "atlas mips stop at 4x4 (64 -> 4 is 5 levels)" );
+        for (uint32_t regionIdx = 0; regionIdx < 3; ++regionIdx)
+        {
+            const auto& albedo = layout.packedTextures[0].regions[regionIdx];
+            const auto& normal = layout.packedTextures[1].regions[regionIdx];
+            results.Check( albedo.x == normal.x && albedo.y == normal.y && albedo.width == normal.width && albedo.height == normal.height, "set's textures in the same place in each atlas" );
+        }
+    }
+
+    /// Textures that are not atlased are grouped by format, size and mip count in to texture arrays (within the layer limits).
+    void TestArrayGrouping( TestResults& results )
+    {
+        results.pTestName = "ArrayGrouping";
+        std::vector<TexturePackerSet> sets;
+        for (uint32_t i = 0; i < 5; ++i)
+            sets.push_back( MakeSet( { { "array" + std::to_string( i ), TextureFormat::R8G8B8A8_UNORM, 512, 512, 10 } }, false ) );
+        sets.push_back( MakeSet( { { "otherMips", TextureFormat::R8G8B8A8_UNORM, 512, 512, 1 } }, false ) );
+        sets.push_back( MakeSet( { { "otherFormat", TextureFormat::BC7_UNORM_BLOCK, 512, 512, 10 } }, false ) );
+        sets.push_back( MakeSet( { { "array0", TextureFormat::R8G8B8A8_UNORM, 512, 512, 10 } }, false ) );  // same texture used by another set (only packed once)
+
+        const TexturePackLayout layout = PlanTexturePacking( sets, { .minArrayLayers = 2, .maxArrayLayers = 256 } );
+        CheckLayoutConsistent( results, sets, layout );
+        if (results.Check( layout.packedTextures.size() == 1, "expected a single texture array" ))
+        {
+            const auto& array = layout.packedTextures[0];
+            results.Check( !array.isAtlas && array.layers == 5 && array.width == 512 && array.height == 512 && array.mipLevels == 10, "array size/layers/mips" );
+        }
+        results.Check( layout.locations.count( "otherMips" ) == 0 && layout.locations.count( "otherFormat" ) == 0, "textures with no matching partners are left alone" );
+
+        // Limit the layers; 5 textures in arrays of at most 2 leaves one over (below minArrayLayers).
+        const TexturePackLayout limitedLayout = PlanTexturePacking( sets, { .minArrayLayers = 2, .maxArrayLayers = 2 } );
+        CheckLayoutConsistent( results, sets, limitedLayout );
+        results.Check( limitedLayout.packedTextures.size() == 2 && limitedLayout.locations.size() == 4, "arrays split at maxArrayLayers, remainder not packed" );
+    }
+
+    /// Sets that cannot be atlased fall back to texture arrays.
+    void TestAtlasRejection( TestResults& results )
+    {
+        results.pTestName = "AtlasRejection";
+        std::vector<TexturePackerSet> sets;
+        sets.push_back( MakeSet( { { "sharedA", TextureFormat::R8G8B8A8_UNORM, 64, 64, 1 }, { "shared", TextureFormat::R8G8B8A8_UNORM, 64, 64, 1 } } ) );
+        sets.push_back( MakeSet( { { "sharedB", TextureFormat::R8G8B8A8_UNORM, 64, 64, 1 }, { "shared", TextureFormat::R8G8B8A8_UNORM, 64, 64, 1 } } ) );
+        sets.push_back( MakeSet( { { "astc5x5A", TextureFormat::ASTC_5x5_UNORM_BLOCK, 64, 64, 1 } } ) );
+        sets.push_back( MakeSet( { { "astc5x5B", TextureFormat::ASTC_5x5_UNORM_BLOCK, 64, 64, 1 } } ) );
+        sets.push_back( MakeSet( { { "nonPow2A", TextureFormat::R8G8B8A8_UNORM, 48, 48, 1 } } ) );
+        sets.push_back( MakeSet( { { "nonPow2B", TextureFormat::R8G8B8A8_UNORM, 48, 48, 1 } } ) );
+        sets.push_back( MakeSet( { { "wrapsA", TextureFormat::R8G8B8A8_UNORM, 32, 32, 1 } }, false ) );
+        sets.push_back( MakeSet( { { "wrapsB", TextureFormat::R8G8B8A8_UNORM, 32, 32, 1 } }, false ) );
+
+        const TexturePackLayout layout = PlanTexturePacking( sets, { .atlasMaxDimension = 128, .atlasSize = 256 } );
+        CheckLayoutConsistent( results, sets, layout );
+        for (const auto& packed : layout.packedTextures)
+            results.Check( !packed.isAtlas, "shared, 5x5 block, non power of 2 and wrapping textures must not be atlased" );
+        for (const auto& uvScaleOffset : layout.setUvScaleOffsets)
+            results.Check( NearlyEqual( uvScaleOffset, glm::vec4( 1.0f, 1.0f, 0.0f, 0.0f ) ), "sets that were not atlased keep identity uvs" );
+        results.Check( layout.locations.size() == 9, "rejected textures are grouped in to arrays instead" );
+    }
+
+    /// Mesh uvs remapped with a set's uv scale/offset land inside the set's atlas region.
+    void TestUvRemap( TestResults& results )
+    {
+        results.pTestName = "UvRemap";
+        std::vector<TexturePackerSet> sets;
+        for (uint32_t i = 0; i < 4; ++i)
+            sets.push_back( MakeSet( { { "remap" + std::to_string( i ), TextureFormat::R8G8B8A8_UNORM, 64, 64, 1 } } ) );
+        const TexturePackLayout layout = PlanTexturePacking( sets, { .atlasMaxDimension = 64, .atlasSize = 128 } );
+        if (!results.Check( layout.packedTextures.size() == 1, "expected a single atlas" ))
+            return;
+
+        MeshObjectIntermediate mesh;
+        const float uvs[][2] = { { 0.0f, 0.0f }, { 1.0f, 1.0f }, { 0.25f, 0.75f }, { 2.0f, -1.0f } };
+        const int materials[] = { 0, 0, 0, 1 };
+        for (uint32_t i = 0; i < std::size( uvs ); ++i)
+        {
+            MeshObjectIntermediate::FatVertex vertex{};
+            vertex.uv0[0] = uvs[i][0];
+            vertex.uv0[1] = uvs[i][1];
+            vertex.material = materials[i];
+            mesh.m_VertexBuffer.push_back( vertex );
+        }
+        results.Check( mesh.UvsInUnitRange( 0 ), "material 0 uvs are in 0-1" );
+        results.Check( !mesh.UvsInUnitRange( 1 ), "material 1 uvs wrap" );
+
+        const auto& region = layout.packedTextures[0].regions[3];
+        const glm::vec4 uvScaleOffset = layout.setUvScaleOffsets[3];
+        mesh.RemapUvs( 0, uvScaleOffset );
+        const float atlasWidth = float( layout.packedTextures[0].width );
+        const float atlasHeight = float( layout.packedTextures[0].height );
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            const auto& vertex = mesh.m_VertexBuffer[i];
+            const float expectedU = (float( region.x ) + uvs[i][0] * float( region.width )) / atlasWidth;
+            const float expectedV = (float( region.y ) + uvs[i][1] * float( region.height )) / atlasHeight;
+            results.Check( std::abs( vertex.uv0[0] - expectedU ) < 1.0e-6f && std::abs( vertex.uv0[1] - expectedV ) < 1.0e-6f, "remapped uv not at the same place in the atlas region" );
+        }
+        results.Check( mesh.m_VertexBuffer[3].uv0[0] == 2.0f && mesh.m_VertexBuffer[3].uv0[1] == -1.0f, "other materials' uvs must not be remapped" );
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool RunTexturePackerTest()
+//-----------------------------------------------------------------------------
+{
+    TestResults results;
+    TestShelfPackGrid( results );
+    TestShelfPackMixedSizes( results );
+    TestShelfPackMaterialSets( results );
+    TestArrayGrouping( results );
+    TestAtlasRejection( results );
+    TestUvRemap( results );
+
+    if (results.numFailed != 0)
+    {
+        LOGE( "TexturePackerTest: %u checks failed", results.numFailed );
+        return false;
+    }
+    LOGI( "TexturePackerTest: passed" );
+    return true;
+}
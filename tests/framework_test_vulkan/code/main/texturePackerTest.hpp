@@ -0,0 +1,19 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// @file texturePackerTest.hpp
+/// @brief Checks of the texture packing planner (PlanTexturePacking) and the mesh uv remapping that goes with it.
+///
+
+/// Plan several small texture layouts and check the atlas shelf packing (placements, sizes, mip counts, uv scale/offset), the texture array grouping
+/// (format/size/mip matching, layer limits) and the cases that must not be atlased (shared textures, unsupported block sizes, sets with wrapping uvs).
+/// Also checks MeshObjectIntermediate::UvsInUnitRange and RemapUvs against the planned uv scale/offset.  Cpu only, runs in well under a second.
+/// @returns true if every check passed (failures are logged).
+bool RunTexturePackerTest();
@@ -29,6 +29,7 @@
 #include "mesh/meshLoader.hpp"
 #include "system/math_common.hpp"
 #include "texture/textureManager.hpp"
+#include "texture/vulkan/textureManager.hpp"
 #include "imgui/imgui.h"
 #include "vulkan/extensionLib.hpp"
 
@@ -44,6 +45,7 @@ namespace
     glm::vec3   gCameraStartRot    = glm::vec3(-10.0f, -20.0f, 0.0f);
     VAR(float,  gCameraRotateSpeed,  0.25f, kVariableNonpersistent);
     VAR(float,  gCameraMoveSpeed,    1.0f,  kVariableNonpersistent);
+    VAR(bool,   gMipStreaming,       true,  kVariableNonpersistent);   // scene textures load their mip tail first, more detailed mips are streamed in
 
     float   gFOV = PI_DIV_4;
     float   gNearPlane = 1.0f;
@@ -353,6 +355,8 @@ bool Application::LoadMeshObjects()
     LOGI("******************************");
 
     m_TextureManager->SetDefaultFilenameManipulators(PathManipulator_PrefixDirectory{TEXTURE_DESTINATION_PATH}, PathManipulator_ChangeExtension{".ktx"});
+    if (gMipStreaming)
+        apiCast<Vulkan>(m_TextureManager.get())->EnableMipStreaming({});
 
     auto MaterialLoader = [&](const MeshObjectIntermediate::MaterialDef& materialDef) ->std::optional<Material>
     {
@@ -511,37 +515,45 @@ bool Application::BuildCmdBuffers()
     LOGI("Building Command Buffers...");
     LOGI("****************************");
 
-    Vulkan* const pVulkan = GetVulkan();
-
-    // Begin recording secondary
-    for (auto& cmdBuffer: m_SecondaryObjectCommandLists)
+    for (uint32_t whichBuffer = 0; whichBuffer < (uint32_t)m_SecondaryObjectCommandLists.size(); ++whichBuffer)
     {
-        uint32_t targetWidth = m_ColorBuffer.Width;
-        uint32_t targetHeight = m_ColorBuffer.Height;
-        const VkViewport viewport = {.width = (float)targetWidth, .height = (float)targetHeight, .minDepth = 0.0f, .maxDepth = 1.0f};
-        const VkRect2D scissor = {.extent {.width = targetWidth, .height = targetHeight }};
-
-        if (!cmdBuffer.Begin( m_SceneRenderContext ))
+        if (!BuildSceneCmdBuffer(whichBuffer))
         {
             return false;
         }
-        vkCmdSetViewport( cmdBuffer, 0, 1, &viewport );
-        vkCmdSetScissor( cmdBuffer, 0, 1, &scissor );
     }
 
-    // Scene drawables
-    for (const auto& sceneDrawable : m_SceneDrawables)
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Application::BuildSceneCmdBuffer(uint32_t whichBuffer)
+//-----------------------------------------------------------------------------
+{
+    auto& cmdBuffer = m_SecondaryObjectCommandLists[whichBuffer];
+    cmdBuffer.Reset();
+
+    // Begin recording secondary
+    uint32_t targetWidth = m_ColorBuffer.Width;
+    uint32_t targetHeight = m_ColorBuffer.Height;
+    const VkViewport viewport = {.width = (float)targetWidth, .height = (float)targetHeight, .minDepth = 0.0f, .maxDepth = 1.0f};
+    const VkRect2D scissor = {.extent {.width = targetWidth, .height = targetHeight }};
+
+    if (!cmdBuffer.Begin( m_SceneRenderContext ))
     {
-        AddDrawableToCmdBuffers( sceneDrawable, m_SecondaryObjectCommandLists.data(), 1, (uint32_t)m_SecondaryObjectCommandLists.size() );
+        return false;
     }
+    vkCmdSetViewport( cmdBuffer, 0, 1, &viewport );
+    vkCmdSetScissor( cmdBuffer, 0, 1, &scissor );
 
-    // End recording
-    for (auto& cmdBuffer : m_SecondaryObjectCommandLists)
+    // Scene drawables
+    for (const auto& sceneDrawable : m_SceneDrawables)
     {
-        cmdBuffer.End();
+        AddDrawableToCmdBuffers( sceneDrawable, m_SecondaryObjectCommandLists.data(), 1, whichBuffer, 0, 0.0f );
     }
 
-
+    // End recording
+    cmdBuffer.End();
 
     return true;
 }
@@ -640,6 +652,16 @@ void Application::Render(float fltDiffTime)
     // Update uniform buffers with latest data
     UpdateUniforms(whichBuffer);
 
+    // Upload streamed texture mips.  Changed textures have a new image, so this buffer's descriptor sets (and the secondary command buffer binding them) are rebuilt.
+    if (gMipStreaming && !apiCast<Vulkan>(m_TextureManager.get())->UpdateMipStreaming(whichBuffer).empty())
+    {
+        for (auto& sceneDrawable : m_SceneDrawables)
+        {
+            sceneDrawable.GetMaterial().UpdateDescriptorSets(whichBuffer);
+        }
+        BuildSceneCmdBuffer(whichBuffer);
+    }
+
     auto& cmdBuffer = m_PrimaryCommandLists[whichBuffer];
     cmdBuffer.Reset();
     cmdBuffer.Begin();
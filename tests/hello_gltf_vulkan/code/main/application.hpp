@@ -115,6 +115,7 @@ private:
     bool InitCommandBuffers();
     bool InitLocalSemaphores();
     bool BuildCmdBuffers();
+    bool BuildSceneCmdBuffer(uint32_t whichBuffer);
 
 private:
 